@@ -0,0 +1,45 @@
+# Generates a c++ source file containing compiled spir-v shaders as constant arrays
+#
+# Usage: cmake -DSHADER_DIR=<dir> -DSHADERS=<name1,name2,...> -DOUTPUT_FILE=<file> -P EmbedShaders.cmake
+#
+# Each shader is read from "<SHADER_DIR>/<name>" and registered under the key "shaders/<name>", which matches the paths
+# passed to VulkanTextRenderer::_readShader(). The output file is rewritten only if its contents change, so the library
+# is not recompiled on every build.
+
+if(NOT DEFINED SHADER_DIR OR NOT DEFINED SHADERS OR NOT DEFINED OUTPUT_FILE)
+    message(FATAL_ERROR "vfont: EmbedShaders.cmake requires SHADER_DIR, SHADERS and OUTPUT_FILE")
+endif()
+
+string(REPLACE "," ";" SHADERS "${SHADERS}")
+
+set(SHADER_ARRAYS "")
+set(SHADER_ENTRIES "")
+set(SHADER_INDEX 0)
+
+foreach(SHADER ${SHADERS})
+    file(READ "${SHADER_DIR}/${SHADER}" SHADER_HEX HEX)
+    string(LENGTH "${SHADER_HEX}" SHADER_HEX_LENGTH)
+    math(EXPR SHADER_SIZE "${SHADER_HEX_LENGTH} / 2")
+
+    # Convert hex string into comma separated bytes, 16 bytes per line
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," SHADER_BYTES "${SHADER_HEX}")
+    string(REPEAT "0x[0-9a-f][0-9a-f]," 16 SHADER_LINE_PATTERN)
+    string(REGEX REPLACE "(${SHADER_LINE_PATTERN})" "\\1\n    " SHADER_BYTES "${SHADER_BYTES}")
+    string(STRIP "${SHADER_BYTES}" SHADER_BYTES)
+
+    string(APPEND SHADER_ARRAYS "alignas(4) const unsigned char shader${SHADER_INDEX}[] = {\n    ${SHADER_BYTES}\n};\n\n")
+    string(APPEND SHADER_ENTRIES "    {\"shaders/${SHADER}\", shader${SHADER_INDEX}, ${SHADER_SIZE}},\n")
+
+    math(EXPR SHADER_INDEX "${SHADER_INDEX} + 1")
+endforeach()
+
+set(SOURCE "// Generated by cmake/EmbedShaders.cmake, do not edit\n\n")
+string(APPEND SOURCE "#include \"embedded_shaders.h\"\n\n")
+string(APPEND SOURCE "namespace vft {\n\n")
+string(APPEND SOURCE "namespace {\n\n${SHADER_ARRAYS}}  // namespace\n\n")
+string(APPEND SOURCE "const std::vector<EmbeddedShaders::Shader> EmbeddedShaders::_shaders = {\n${SHADER_ENTRIES}};\n\n")
+string(APPEND SOURCE "}  // namespace vft\n")
+
+file(WRITE "${OUTPUT_FILE}.tmp" "${SOURCE}")
+file(COPY_FILE "${OUTPUT_FILE}.tmp" "${OUTPUT_FILE}" ONLY_IF_DIFFERENT)
+file(REMOVE "${OUTPUT_FILE}.tmp")
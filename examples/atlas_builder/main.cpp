@@ -0,0 +1,157 @@
+﻿/**
+ * @file main.cpp
+ * @author Christian Saloň
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <VFONT/font.h>
+#include <VFONT/font_atlas.h>
+#include <VFONT/unicode.h>
+
+/**
+ * @brief Parses range of unicode code points in format start-end, both given in hexadecimal
+ *
+ * @param range Range of unicode code points, e.g. 20-7e
+ *
+ * @return Parsed range
+ */
+vft::FontAtlas::CharacterRange parseCharacterRange(std::string range) {
+    std::size_t separator = range.find('-');
+    if (separator == std::string::npos) {
+        throw std::invalid_argument("Character range must be in format start-end");
+    }
+
+    char32_t start = std::stoul(range.substr(0, separator), nullptr, 16);
+    char32_t end = std::stoul(range.substr(separator + 1), nullptr, 16);
+    if (start > end) {
+        throw std::invalid_argument("Start of character range must not be larger than its end");
+    }
+
+    return vft::FontAtlas::CharacterRange{start, end};
+}
+
+/**
+ * @brief Builds font atlas of selected characters and writes it next to other atlases in output directory
+ *
+ * @param fontFile Path to .ttf font file
+ * @param outputDirectory Directory of font atlas file
+ * @param format Format of distance fields
+ * @param compress Whether texture is compressed into bc4 blocks
+ * @param characterRanges Ranges of unicode code points, all glyphs are built if there are no ranges and characters
+ * @param characters Utf-32 encoded characters
+ */
+void buildFontAtlas(std::string fontFile,
+                    std::string outputDirectory,
+                    vft::FontAtlas::Format format,
+                    bool compress,
+                    std::vector<vft::FontAtlas::CharacterRange> characterRanges,
+                    std::u32string characters) {
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+
+    for (const vft::FontAtlas::CharacterRange &range : characterRanges) {
+        for (char32_t codePoint = range.start; codePoint <= range.end; codePoint++) {
+            characters.push_back(codePoint);
+        }
+    }
+
+    // Every glyph is packed into texture once
+    std::sort(characters.begin(), characters.end());
+    characters.erase(std::unique(characters.begin(), characters.end()), characters.end());
+
+    vft::FontAtlas atlas = characters.empty() ? vft::FontAtlas{font, format} : vft::FontAtlas{font, characters, format};
+    if (compress) {
+        atlas.compress();
+    }
+
+    std::filesystem::path atlasFile =
+        std::filesystem::path{outputDirectory} / std::filesystem::path{fontFile}.filename().replace_extension(".atlas");
+    atlas.save(font, atlasFile.string());
+
+    std::cout << fontFile << " -> " << atlasFile.string() << " (" << atlas.getSize().x << " x " << atlas.getSize().y
+              << ", " << std::filesystem::file_size(atlasFile) << " B)" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    try {
+        vft::FontAtlas::Format format = vft::FontAtlas::Format::SDF;
+        bool compress = false;
+        std::vector<vft::FontAtlas::CharacterRange> characterRanges{};
+        std::u32string characters{};
+        std::string outputDirectory = ".";
+        std::vector<std::string> fontFiles{};
+
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "-h") == 0) {
+                // Show help message
+                std::cout << "./atlas_builder [-h] [-a <sdf/msdf/tiered>] [-b] [-r start-end] [-c characters] "
+                             "[-o output_directory] path_to_font..."
+                          << std::endl;
+                std::cout << "-h: Show help message" << std::endl;
+                std::cout << "-a: Select the format of distance fields" << std::endl;
+                std::cout << "-b: Compress texture into bc4 blocks, requires sdf or tiered" << std::endl;
+                std::cout << "-r: Add range of unicode code points in hexadecimal, can be repeated" << std::endl;
+                std::cout << "-c: Add utf-8 encoded characters, all glyphs are built if no -r or -c is given"
+                          << std::endl;
+                std::cout << "-o: Directory of font atlas files, each named after its font file with .atlas extension"
+                          << std::endl;
+                return EXIT_SUCCESS;
+            } else if (strcmp(argv[i], "-a") == 0) {
+                // Set format of distance fields
+                std::string type = argv[++i];
+
+                if (type == "sdf") {
+                    format = vft::FontAtlas::Format::SDF;
+                } else if (type == "msdf") {
+                    format = vft::FontAtlas::Format::MSDF;
+                } else if (type == "tiered") {
+                    format = vft::FontAtlas::Format::TIERED_SDF;
+                } else {
+                    std::cerr << "Format must be sdf, msdf or tiered" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            } else if (strcmp(argv[i], "-b") == 0) {
+                // Set if compress texture
+                compress = true;
+            } else if (strcmp(argv[i], "-r") == 0) {
+                // Add range of characters
+                characterRanges.push_back(parseCharacterRange(argv[++i]));
+            } else if (strcmp(argv[i], "-c") == 0) {
+                // Add characters
+                std::string text = argv[++i];
+                characters.append(vft::Unicode::utf8ToUtf32(std::u8string{text.begin(), text.end()}));
+            } else if (strcmp(argv[i], "-o") == 0) {
+                // Set output directory
+                outputDirectory = argv[++i];
+            } else if (argv[i][0] == '-') {
+                std::cerr << "Invalid argument at position " << i << std::endl;
+                return EXIT_FAILURE;
+            } else {
+                fontFiles.push_back(argv[i]);
+            }
+        }
+
+        if (fontFiles.empty()) {
+            std::cerr << "No font files given" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::create_directories(outputDirectory);
+        for (const std::string &fontFile : fontFiles) {
+            buildFontAtlas(fontFile, outputDirectory, format, compress, characterRanges, characters);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
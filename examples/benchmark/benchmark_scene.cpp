@@ -8,12 +8,41 @@
 const std::u8string BenchmarkScene::TEXT = u8"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
 
 BenchmarkScene::BenchmarkScene(CameraType cameraType,
-                               vft::TessellationStrategy tessellationAlgorithm,
+                               RendererType rendererType,
                                std::string font,
-                               bool measureTime)
-    : Scene{cameraType, tessellationAlgorithm, measureTime} {
+                               bool measureTime,
+                               bool gpuCulling,
+                               bool cpuCulling,
+                               bool secondaryCommandBuffers,
+                               vft::FontAtlas::Format atlasFormat,
+                               bool transferQueue,
+                               bool offscreenText)
+    : Scene{cameraType, rendererType, measureTime} {
     // this->_renderer->setCacheSize(0);
 
+    if (transferQueue) {
+        this->_enableTransferQueue();
+    }
+
+    this->_renderer->setCpuCulling(cpuCulling);
+    this->_renderer->setSecondaryCommandBuffers(secondaryCommandBuffers);
+
+    if (gpuCulling) {
+        vft::IVulkanTextRenderer *renderer = this->_renderer.get();
+        vft::VulkanTextRendererDecorator *decorator = dynamic_cast<vft::VulkanTextRendererDecorator *>(renderer);
+        if (decorator != nullptr) {
+            renderer = decorator->getRenderer();
+        }
+
+        // Renderers which can not replay one indirect draw per glyph throw
+        vft::VulkanTextRenderer *vulkanRenderer = dynamic_cast<vft::VulkanTextRenderer *>(renderer);
+        if (vulkanRenderer == nullptr) {
+            throw std::invalid_argument("Gpu culling is supported only by the cdt and wn algorithms");
+        }
+
+        vulkanRenderer->setGpuCulling(true);
+    }
+
     this->_font = std::make_shared<vft::Font>(font);
 
     this->_block1 = vft::TextBlockBuilder()
@@ -114,10 +143,27 @@ BenchmarkScene::BenchmarkScene(CameraType cameraType,
     this->_renderer->add(this->_block11);
     this->_renderer->add(this->_block12);
 
+    // Grid of text blocks below the scene and far to the right, so that almost all characters are outside of the view
+    if (offscreenText) {
+        for (unsigned int i = 0; i < OFFSCREEN_BLOCK_COUNT; i++) {
+            glm::vec3 position{(i % 10) * 8192.f, 1100.f + (i / 10) * 512.f, 0.f};
+            std::shared_ptr<vft::TextBlock> block = vft::TextBlockBuilder()
+                                                        .setFont(this->_font)
+                                                        .setFontSize(32)
+                                                        .setWidth(4096)
+                                                        .setColor(glm::vec4(1.f, 1.f, 1.f, 1.f))
+                                                        .setPosition(position)
+                                                        .build();
+
+            this->_offscreenBlocks.push_back(block);
+            this->_renderer->add(block);
+        }
+    }
+
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    if (tessellationAlgorithm == vft::TessellationStrategy::SDF) {
-        vft::FontAtlas atlas{this->_font, vft::Unicode::utf8ToUtf32(TEXT)};
+    if (rendererType == RendererType::SDF || rendererType == RendererType::HYBRID) {
+        vft::FontAtlas atlas{this->_font, vft::Unicode::utf8ToUtf32(TEXT), atlasFormat};
         this->_renderer->addFontAtlas(atlas);
     }
 
@@ -137,9 +183,31 @@ BenchmarkScene::BenchmarkScene(CameraType cameraType,
         this->_block12->add(TEXT);
     }
 
+    for (const std::shared_ptr<vft::TextBlock> &block : this->_offscreenBlocks) {
+        for (unsigned int i = 0; i < OFFSCREEN_TEXT_REPEATS; i++) {
+            block->add(TEXT);
+        }
+    }
+
     auto endTime = std::chrono::high_resolution_clock::now();
     auto time = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
     std::cout << "Tessellation time: " << time << " milliseconds" << std::endl;
+
+    unsigned int characterCount = 0;
+    for (const std::shared_ptr<vft::TextBlock> &block :
+         {this->_block1, this->_block2, this->_block3, this->_block4, this->_block5, this->_block6, this->_block7,
+          this->_block8, this->_block9, this->_block10, this->_block11, this->_block12}) {
+        characterCount += block->getCharacterCount();
+    }
+    for (const std::shared_ptr<vft::TextBlock> &block : this->_offscreenBlocks) {
+        characterCount += block->getCharacterCount();
+    }
+    std::cout << "Characters: " << characterCount << std::endl;
+
+    vft::VulkanMemoryStatistics memory = this->_renderer->getMemoryStatistics();
+    std::cout << "Buffer sub-allocations: " << memory.totalAllocationCount << std::endl;
+    std::cout << "Vulkan memory allocations: " << memory.deviceAllocationCount << std::endl;
+    std::cout << "Peak vulkan memory blocks: " << memory.peakBlockCount << std::endl;
 }
 
 BenchmarkScene::~BenchmarkScene() {}
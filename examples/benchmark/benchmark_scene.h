@@ -8,7 +8,9 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
@@ -19,12 +21,16 @@
 #include <VFONT/text_block_builder.h>
 #include <VFONT/text_renderer.h>
 #include <VFONT/unicode.h>
+#include <VFONT/vulkan_text_renderer.h>
+#include <VFONT/vulkan_text_renderer_decorator.h>
 
 #include "scene.h"
 
 class BenchmarkScene : public Scene {
 public:
     static const std::u8string TEXT;
+    static constexpr unsigned int OFFSCREEN_BLOCK_COUNT = 100;  /**< Text blocks of the off-screen scene */
+    static constexpr unsigned int OFFSCREEN_TEXT_REPEATS = 17; /**< Copies of text in every off-screen text block */
 
 private:
     std::shared_ptr<vft::Font> _font;
@@ -43,10 +49,18 @@ private:
     std::shared_ptr<vft::TextBlock> _block11;
     std::shared_ptr<vft::TextBlock> _block12;
 
+    std::vector<std::shared_ptr<vft::TextBlock>> _offscreenBlocks;
+
 public:
     BenchmarkScene(CameraType cameraType,
-                   vft::TessellationStrategy tessellationAlgorithm,
+                   RendererType rendererType,
                    std::string font,
-                   bool measureTime = true);
+                   bool measureTime = true,
+                   bool gpuCulling = false,
+                   bool cpuCulling = true,
+                   bool secondaryCommandBuffers = false,
+                   vft::FontAtlas::Format atlasFormat = vft::FontAtlas::Format::SDF,
+                   bool transferQueue = false,
+                   bool offscreenText = false);
     ~BenchmarkScene();
 };
@@ -3,9 +3,13 @@
  * @author Christian Saloň
  */
 
+#include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
+#include <VFONT/font_atlas.h>
+#include <VFONT/profiler.h>
 #include <VFONT/text_renderer.h>
 
 #include "base_camera.h"
@@ -14,16 +18,23 @@
 int main(int argc, char **argv) {
     try {
         CameraType cameraType = CameraType::PERSPECTIVE;
-        vft::TessellationStrategy tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+        RendererType rendererType = RendererType::WINDING_NUMBER;
         bool measureTime = true;
+        bool gpuCulling = false;
+        bool cpuCulling = true;
+        bool secondaryCommandBuffers = false;
+        bool transferQueue = false;
+        bool offscreenText = false;
+        vft::FontAtlas::Format atlasFormat = vft::FontAtlas::Format::SDF;
         std::string font = "assets/Roboto-Regular.ttf";
+        std::string traceFile = "";
 
         for (int i = 1; i < argc; i++) {
             if (strcmp(argv[i], "-h") == 0) {
                 // Show help message
-                std::cout
-                    << "./benchmark [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf>] [-t] [-f path_to_font]"
-                    << std::endl;
+                std::cout << "./benchmark [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf/msdf/tiered/hybrid>] "
+                             "[-t] [-g] [-n] [-s] [-q] [-o] [-p trace.json] [-f path_to_font]"
+                          << std::endl;
                 std::cout << "-h: Show help message" << std::endl;
                 std::cout << "-c: Select the type of camera used" << std::endl;
                 std::cout << "-a: Select the rendering algorithm" << std::endl;
@@ -32,7 +43,22 @@ int main(int argc, char **argv) {
                           << std::endl;
                 std::cout << "  wn - Winding number calculated in fragment shader" << std::endl;
                 std::cout << "  sdf - Signed distance field" << std::endl;
+                std::cout << "  msdf - Multi-channel signed distance field" << std::endl;
+                std::cout << "  tiered - Signed distance field with the atlas tier picked by projected character size"
+                          << std::endl;
+                std::cout << "  hybrid - Sdf, winding number or triangulation picked by projected character size"
+                          << std::endl;
                 std::cout << "-t: Measure the gpu draw time" << std::endl;
+                std::cout << "-g: Cull characters on the gpu and draw them indirectly, requires cdt or wn" << std::endl;
+                std::cout << "-n: Do not skip text blocks and lines outside of the view on the cpu" << std::endl;
+                std::cout << "-s: Reuse draw commands recorded in secondary command buffers while text is unchanged"
+                          << std::endl;
+                std::cout << "-q: Upload text buffers on a dedicated transfer queue if supported" << std::endl;
+                std::cout << "-o: Add over 100k characters, most of them outside of the view, to measure culling"
+                          << std::endl;
+                std::cout << "-p: Write cpu profiling zones and counters to chrome trace json file, requires library "
+                             "built with VFONT_PROFILING"
+                          << std::endl;
                 std::cout << "-f: Path to .ttf font file" << std::endl;
                 return EXIT_SUCCESS;
             } else if (strcmp(argv[i], "-c") == 0) {
@@ -52,20 +78,46 @@ int main(int argc, char **argv) {
                 std::string type = argv[++i];
 
                 if (type == "cdt") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
+                    rendererType = RendererType::TRIANGULATION;
                 } else if (type == "wn") {
-                    tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+                    rendererType = RendererType::WINDING_NUMBER;
                 } else if (type == "ts") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TESSELLATION_SHADERS;
+                    rendererType = RendererType::TESSELLATION_SHADERS;
                 } else if (type == "sdf") {
-                    tessellationAlgorithm = vft::TessellationStrategy::SDF;
+                    rendererType = RendererType::SDF;
+                } else if (type == "msdf") {
+                    rendererType = RendererType::SDF;
+                    atlasFormat = vft::FontAtlas::Format::MSDF;
+                } else if (type == "tiered") {
+                    rendererType = RendererType::SDF;
+                    atlasFormat = vft::FontAtlas::Format::TIERED_SDF;
+                } else if (type == "hybrid") {
+                    rendererType = RendererType::HYBRID;
+                    atlasFormat = vft::FontAtlas::Format::TIERED_SDF;
                 } else {
-                    std::cerr << "Tessellation algorithm must be cdt, ts, wn or sdf" << std::endl;
+                    std::cerr << "Tessellation algorithm must be cdt, ts, wn, sdf, msdf, tiered or hybrid" << std::endl;
                     return EXIT_FAILURE;
                 }
             } else if (strcmp(argv[i], "-t") == 0) {
                 // Set if measure time to render frame
                 measureTime = true;
+            } else if (strcmp(argv[i], "-g") == 0) {
+                // Set if cull characters on the gpu
+                gpuCulling = true;
+            } else if (strcmp(argv[i], "-n") == 0) {
+                // Set if cull text blocks and lines on the cpu
+                cpuCulling = false;
+            } else if (strcmp(argv[i], "-s") == 0) {
+                // Set if reuse draw commands in secondary command buffers
+                secondaryCommandBuffers = true;
+            } else if (strcmp(argv[i], "-q") == 0) {
+                transferQueue = true;
+            } else if (strcmp(argv[i], "-o") == 0) {
+                // Set if add text outside of the view
+                offscreenText = true;
+            } else if (strcmp(argv[i], "-p") == 0) {
+                // Set file for cpu profiling results
+                traceFile = argv[++i];
             } else if (strcmp(argv[i], "-f") == 0) {
                 // Set font used for rendering
                 font = argv[++i];
@@ -75,8 +127,23 @@ int main(int argc, char **argv) {
             }
         }
 
-        BenchmarkScene scene{cameraType, tessellationAlgorithm, font, measureTime};
+        BenchmarkScene scene{cameraType, rendererType, font, measureTime, gpuCulling, cpuCulling,
+                             secondaryCommandBuffers, atlasFormat, transferQueue, offscreenText};
         scene.run();
+
+        if (!traceFile.empty()) {
+#if !defined(VFONT_PROFILING)
+            std::cerr << "Library was built without VFONT_PROFILING, no zones were recorded" << std::endl;
+#endif
+            for (const auto &[name, time] : vft::Profiler::getZoneTimes()) {
+                std::cout << name << ": " << time << " ms" << std::endl;
+            }
+            for (const auto &[name, value] : vft::Profiler::getCounters()) {
+                std::cout << name << ": " << value << std::endl;
+            }
+
+            vft::Profiler::writeChromeTrace(traceFile);
+        }
     } catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
@@ -18,8 +18,8 @@ const std::u32string DemoScene::JAPANESE_TEXT = U"これはデモテキストで
 const std::u32string DemoScene::EMOJI_TEXT = {0x1F970, 0x1F480, 0x270C,  0x1F334, 0x1F422, 0x1F410,
                                               0x1F344, 0x26BD,  0x1F37B, 0x1F451, 0x1F4F8};
 
-DemoScene::DemoScene(CameraType cameraType, vft::TessellationStrategy tessellationAlgorithm, bool measureTime)
-    : Scene{cameraType, tessellationAlgorithm, measureTime} {
+DemoScene::DemoScene(CameraType cameraType, RendererType rendererType, bool measureTime)
+    : Scene{cameraType, rendererType, measureTime} {
     this->_jersey = std::make_shared<vft::Font>(JERSEY_PATH);
     this->_crimsontext = std::make_shared<vft::Font>(CRIMSON_TEXT_PATH);
     this->_font = std::make_shared<vft::Font>(ROBOTO_PATH);
@@ -27,14 +27,18 @@ DemoScene::DemoScene(CameraType cameraType, vft::TessellationStrategy tessellati
     this->_notosansjp = std::make_shared<vft::Font>(NOTO_SANS_JP_PATH);
     this->_notoemoji = std::make_shared<vft::Font>(NOTO_EMOJI_PATH);
 
-    if (tessellationAlgorithm == vft::TessellationStrategy::SDF) {
-        vft::FontAtlas jerseyAtlas{this->_jersey, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT)};
-        vft::FontAtlas crimsonTextAtlas{this->_crimsontext, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT)};
-        vft::FontAtlas robotoAtlas{
-            this->_font, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT).append(vft::Unicode::utf16ToUtf32(SLOVAK_TEXT))};
-        vft::FontAtlas robotoMonoAtlas{this->_robotomono, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT)};
-        vft::FontAtlas notoSansJpAtlas{this->_notosansjp, JAPANESE_TEXT};
-        vft::FontAtlas notoEmojiAtlas{this->_notoemoji, EMOJI_TEXT};
+    if (rendererType == RendererType::SDF || rendererType == RendererType::HYBRID) {
+        vft::FontAtlas jerseyAtlas =
+            this->_createFontAtlas(this->_jersey, JERSEY_PATH, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT));
+        vft::FontAtlas crimsonTextAtlas =
+            this->_createFontAtlas(this->_crimsontext, CRIMSON_TEXT_PATH, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT));
+        vft::FontAtlas robotoAtlas = this->_createFontAtlas(
+            this->_font, ROBOTO_PATH,
+            vft::Unicode::utf8ToUtf32(ENGLISH_TEXT).append(vft::Unicode::utf16ToUtf32(SLOVAK_TEXT)));
+        vft::FontAtlas robotoMonoAtlas =
+            this->_createFontAtlas(this->_robotomono, ROBOTO_MONO_PATH, vft::Unicode::utf8ToUtf32(ENGLISH_TEXT));
+        vft::FontAtlas notoSansJpAtlas = this->_createFontAtlas(this->_notosansjp, NOTO_SANS_JP_PATH, JAPANESE_TEXT);
+        vft::FontAtlas notoEmojiAtlas = this->_createFontAtlas(this->_notoemoji, NOTO_EMOJI_PATH, EMOJI_TEXT);
 
         this->_renderer->addFontAtlas(jerseyAtlas);
         this->_renderer->addFontAtlas(crimsonTextAtlas);
@@ -111,3 +115,29 @@ DemoScene::DemoScene(CameraType cameraType, vft::TessellationStrategy tessellati
 }
 
 DemoScene::~DemoScene() {}
+
+/**
+ * @brief Loads font atlas prebuilt by the atlas builder next to the font file, e.g. assets/Roboto-Regular.atlas,
+ * or generates it if the file does not exist or does not match the font
+ *
+ * @param font Font of font atlas
+ * @param fontPath Path to .ttf font file
+ * @param characters Characters which must be in generated font atlas
+ *
+ * @return Font atlas
+ */
+vft::FontAtlas DemoScene::_createFontAtlas(std::shared_ptr<vft::Font> font,
+                                           std::string fontPath,
+                                           std::u32string characters) {
+    std::string atlasPath = std::filesystem::path{fontPath}.replace_extension(".atlas").string();
+
+    if (std::filesystem::exists(atlasPath)) {
+        try {
+            return vft::FontAtlas::load(font, atlasPath);
+        } catch (const std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    return vft::FontAtlas{font, characters};
+}
@@ -6,7 +6,10 @@
 #pragma once
 
 #include <cstdint>
+#include <filesystem>
+#include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -14,6 +17,7 @@
 #include <glm/vec4.hpp>
 
 #include <VFONT/font.h>
+#include <VFONT/font_atlas.h>
 #include <VFONT/text_block.h>
 #include <VFONT/text_block_builder.h>
 #include <VFONT/text_renderer.h>
@@ -52,6 +56,9 @@ private:
     std::shared_ptr<vft::TextBlock> _block7;
 
 public:
-    DemoScene(CameraType cameraType, vft::TessellationStrategy tessellationAlgorithm, bool measureTime = false);
+    DemoScene(CameraType cameraType, RendererType rendererType, bool measureTime = false);
     ~DemoScene();
+
+private:
+    vft::FontAtlas _createFontAtlas(std::shared_ptr<vft::Font> font, std::string fontPath, std::u32string characters);
 };
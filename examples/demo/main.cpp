@@ -14,13 +14,14 @@
 int main(int argc, char **argv) {
     try {
         CameraType cameraType = CameraType::PERSPECTIVE;
-        vft::TessellationStrategy tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+        RendererType rendererType = RendererType::WINDING_NUMBER;
         bool measureTime = false;
 
         for (int i = 1; i < argc; i++) {
             if (strcmp(argv[i], "-h") == 0) {
                 // Show help message
-                std::cout << "./demo [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf>] [-t]" << std::endl;
+                std::cout << "./demo [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf/hybrid>] [-t]"
+                          << std::endl;
                 std::cout << "-h: Show help message" << std::endl;
                 std::cout << "-c: Select the type of camera used" << std::endl;
                 std::cout << "-a: Select the rendering algorithm" << std::endl;
@@ -29,6 +30,8 @@ int main(int argc, char **argv) {
                           << std::endl;
                 std::cout << "  wn - Winding number calculated in fragment shader" << std::endl;
                 std::cout << "  sdf - Signed distance field" << std::endl;
+                std::cout << "  hybrid - Sdf, winding number or triangulation picked by projected character size"
+                          << std::endl;
                 std::cout << "-t: Measure the gpu draw time" << std::endl;
                 return EXIT_SUCCESS;
             } else if (strcmp(argv[i], "-c") == 0) {
@@ -48,15 +51,17 @@ int main(int argc, char **argv) {
                 std::string type = argv[++i];
 
                 if (type == "cdt") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
+                    rendererType = RendererType::TRIANGULATION;
                 } else if (type == "wn") {
-                    tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+                    rendererType = RendererType::WINDING_NUMBER;
                 } else if (type == "ts") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TESSELLATION_SHADERS;
+                    rendererType = RendererType::TESSELLATION_SHADERS;
                 } else if (type == "sdf") {
-                    tessellationAlgorithm = vft::TessellationStrategy::SDF;
+                    rendererType = RendererType::SDF;
+                } else if (type == "hybrid") {
+                    rendererType = RendererType::HYBRID;
                 } else {
-                    std::cerr << "Tessellation algorithm must be cdt, ts, wn or sdf" << std::endl;
+                    std::cerr << "Tessellation algorithm must be cdt, ts, wn, sdf or hybrid" << std::endl;
                     return EXIT_FAILURE;
                 }
             } else if (strcmp(argv[i], "-t") == 0) {
@@ -68,7 +73,7 @@ int main(int argc, char **argv) {
             }
         }
 
-        DemoScene scene{cameraType, tessellationAlgorithm, measureTime};
+        DemoScene scene{cameraType, rendererType, measureTime};
         scene.run();
     } catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
@@ -6,13 +6,13 @@
 #include "editor_scene.h"
 
 EditorScene::EditorScene(CameraType cameraType,
-                         vft::TessellationStrategy tessellationAlgorithm,
+                         RendererType rendererType,
                          std::string font,
                          unsigned int fontSize,
                          bool measureTime)
-    : Scene{cameraType, tessellationAlgorithm, measureTime} {
+    : Scene{cameraType, rendererType, measureTime} {
     this->_font = std::make_shared<vft::Font>(font);
-    if (tessellationAlgorithm == vft::TessellationStrategy::SDF) {
+    if (rendererType == RendererType::SDF || rendererType == RendererType::HYBRID) {
         vft::FontAtlas atlas{this->_font};
         this->_renderer->addFontAtlas(atlas);
     }
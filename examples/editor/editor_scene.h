@@ -26,7 +26,7 @@ private:
 
 public:
     EditorScene(CameraType cameraType,
-                vft::TessellationStrategy tessellationAlgorithm,
+                RendererType rendererType,
                 std::string font,
                 unsigned int fontSize,
                 bool measureTime = false);
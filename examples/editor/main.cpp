@@ -14,7 +14,7 @@
 int main(int argc, char **argv) {
     try {
         CameraType cameraType = CameraType::ORTHOGRAPHIC;
-        vft::TessellationStrategy tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+        RendererType rendererType = RendererType::WINDING_NUMBER;
         bool measureTime = false;
         std::string font = "assets/Roboto-Regular.ttf";
         unsigned int fontSize = 32;
@@ -22,7 +22,7 @@ int main(int argc, char **argv) {
         for (int i = 1; i < argc; i++) {
             if (strcmp(argv[i], "-h") == 0) {
                 // Show help message
-                std::cout << "./editor [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf>] [-t] [-f "
+                std::cout << "./editor [-h] [-c <perspective/orthographic>] [-a <cdt/ts/wn/sdf/hybrid>] [-t] [-f "
                              "path_to_font] [-s font_size]"
                           << std::endl;
                 std::cout << "-h: Show help message" << std::endl;
@@ -33,6 +33,8 @@ int main(int argc, char **argv) {
                           << std::endl;
                 std::cout << "  wn - Winding number calculated in fragment shader" << std::endl;
                 std::cout << "  sdf - Signed distance field" << std::endl;
+                std::cout << "  hybrid - Sdf, winding number or triangulation picked by projected character size"
+                          << std::endl;
                 std::cout << "-t: Measure the gpu draw time" << std::endl;
                 std::cout << "-f: Path to .ttf font file" << std::endl;
                 std::cout << "-s: Font size used" << std::endl;
@@ -54,15 +56,17 @@ int main(int argc, char **argv) {
                 std::string type = argv[++i];
 
                 if (type == "cdt") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
+                    rendererType = RendererType::TRIANGULATION;
                 } else if (type == "wn") {
-                    tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+                    rendererType = RendererType::WINDING_NUMBER;
                 } else if (type == "ts") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TESSELLATION_SHADERS;
+                    rendererType = RendererType::TESSELLATION_SHADERS;
                 } else if (type == "sdf") {
-                    tessellationAlgorithm = vft::TessellationStrategy::SDF;
+                    rendererType = RendererType::SDF;
+                } else if (type == "hybrid") {
+                    rendererType = RendererType::HYBRID;
                 } else {
-                    std::cerr << "Tessellation algorithm must be cdt, ts, wn or sdf" << std::endl;
+                    std::cerr << "Tessellation algorithm must be cdt, ts, wn, sdf or hybrid" << std::endl;
                     return EXIT_FAILURE;
                 }
             } else if (strcmp(argv[i], "-t") == 0) {
@@ -80,7 +84,7 @@ int main(int argc, char **argv) {
             }
         }
 
-        EditorScene scene{cameraType, tessellationAlgorithm, font, fontSize, measureTime};
+        EditorScene scene{cameraType, rendererType, font, fontSize, measureTime};
         scene.run();
     } catch (const std::exception &e) {
         std::cerr << e.what() << std::endl;
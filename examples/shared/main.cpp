@@ -18,7 +18,7 @@ int main(int argc, char **argv) {
     try {
         CameraType cameraType = CameraType::PERSPECTIVE;
         std::string sceneType = "demo";
-        vft::TessellationStrategy tessellationAlgorithm = vft::TessellationStrategy::SDF;
+        RendererType rendererType = RendererType::SDF;
         bool measureTime = true;
 
         for(int i = 1; i < argc; i++) {
@@ -59,16 +59,16 @@ int main(int argc, char **argv) {
                 std::string type = argv[++i];
 
                 if (type == "cpu") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TRIANGULATION;
+                    rendererType = RendererType::TRIANGULATION;
                 }
                 else if (type == "gpu") {
-                    tessellationAlgorithm = vft::TessellationStrategy::WINDING_NUMBER;
+                    rendererType = RendererType::WINDING_NUMBER;
                 }
                 else if (type == "combined") {
-                    tessellationAlgorithm = vft::TessellationStrategy::TESSELLATION_SHADERS;
+                    rendererType = RendererType::TESSELLATION_SHADERS;
                 }
                 else if (type == "sdf") {
-                    tessellationAlgorithm = vft::TessellationStrategy::SDF;
+                    rendererType = RendererType::SDF;
                 }
                 else {
                     std::cerr << "Tessellation algorithm must be cpu or gpu or combined" << std::endl;
@@ -87,15 +87,15 @@ int main(int argc, char **argv) {
 
         std::cout << "App started" << std::endl;
         if(sceneType == "editor") {
-            EditorScene scene{cameraType, tessellationAlgorithm, measureTime};
+            EditorScene scene{cameraType, rendererType, measureTime};
             scene.run();
         }
         else if(sceneType == "demo") {
-            DemoScene scene{cameraType, tessellationAlgorithm, measureTime};
+            DemoScene scene{cameraType, rendererType, measureTime};
             scene.run();
         } 
         else {
-            BenchmarkScene scene{cameraType, tessellationAlgorithm, measureTime};
+            BenchmarkScene scene{cameraType, rendererType, measureTime};
             scene.run();
         }
     } catch(const std::exception &e) {
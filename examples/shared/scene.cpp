@@ -10,7 +10,7 @@
  * 
  * @param cameraType Type of camera used for rendering
  */
-Scene::Scene(CameraType cameraType, vft::TessellationStrategy tessellationAlgorithm, bool measureTime) : _cameraType{ cameraType }, _measureTime { measureTime } {
+Scene::Scene(CameraType cameraType, RendererType rendererType, bool measureTime) : _cameraType{ cameraType }, _measureTime { measureTime } {
 
     this->extensions = {
     "VK_KHR_surface",
@@ -69,67 +69,109 @@ Scene::Scene(CameraType cameraType, vft::TessellationStrategy tessellationAlgori
     // Initialize vulkan
     this->_initVulkan();
 
+    // Initialize pipeline cache, which is saved to file when scene is destroyed
+    this->_pipelineCache = std::make_unique<vft::VulkanPipelineCache>(this->_physicalDevice, this->_logicalDevice, "pipeline_cache.bin");
+    auto rendererCreationStart = std::chrono::steady_clock::now();
+
     // Initialize text renderer
     if (measureTime) {
         vft::VulkanTextRenderer *renderer = nullptr;
 
-        if (tessellationAlgorithm == vft::TessellationStrategy::TRIANGULATION) {
-            renderer = new vft::VulkanTriangulationTextRenderer(this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool, this->_renderPass, this->_commandBuffer);
+        if (rendererType == RendererType::TRIANGULATION) {
+            renderer = new vft::VulkanTriangulationTextRenderer(this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool, this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
-        else if(tessellationAlgorithm == vft::TessellationStrategy::TESSELLATION_SHADERS) {
+        else if(rendererType == RendererType::TESSELLATION_SHADERS) {
             renderer = new vft::VulkanTessellationShadersTextRenderer(this->_physicalDevice, this->_logicalDevice,
                                                                       this->_graphicsQueue, this->_commandPool,
-                                                                      this->_renderPass, this->_commandBuffer);
+                                                                      this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
-        else if(tessellationAlgorithm == vft::TessellationStrategy::WINDING_NUMBER) {
+        else if(rendererType == RendererType::WINDING_NUMBER) {
             renderer = new vft::VulkanWindingNumberTextRenderer(this->_physicalDevice, this->_logicalDevice,
                                                                 this->_graphicsQueue, this->_commandPool,
-                                                                this->_renderPass, this->_commandBuffer);
+                                                                this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
+        }
+        else if(rendererType == RendererType::HYBRID) {
+            renderer = new vft::VulkanHybridTextRenderer(this->_physicalDevice, this->_logicalDevice,
+                                                         this->_graphicsQueue, this->_commandPool,
+                                                         this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
         else {
             renderer = new vft::VulkanSdfTextRenderer(this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue,
-                                                      this->_commandPool, this->_renderPass, this->_commandBuffer);
+                                                      this->_commandPool, this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
 
-        this->_renderer = std::make_shared<vft::VulkanTimedRenderer>(renderer);
+        // Pipeline statistics are recorded only if the device enables them
+        this->_renderer = std::make_shared<vft::VulkanTimedRenderer>(renderer, this->_enabledFeatures.pipelineStatisticsQuery);
     }
     else {
-        if (tessellationAlgorithm == vft::TessellationStrategy::TRIANGULATION) {
+        if (rendererType == RendererType::TRIANGULATION) {
             this->_renderer = std::make_shared<vft::VulkanTriangulationTextRenderer>(
                 this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
-                this->_renderPass, this->_commandBuffer);
+                this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
-        else if (tessellationAlgorithm == vft::TessellationStrategy::TESSELLATION_SHADERS) {
+        else if (rendererType == RendererType::TESSELLATION_SHADERS) {
             this->_renderer = std::make_shared<vft::VulkanTessellationShadersTextRenderer>(
                 this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
-                this->_renderPass, this->_commandBuffer);
+                this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
-        else if (tessellationAlgorithm == vft::TessellationStrategy::WINDING_NUMBER) {
+        else if (rendererType == RendererType::WINDING_NUMBER) {
             this->_renderer = std::make_shared<vft::VulkanWindingNumberTextRenderer>(
                 this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
-                this->_renderPass, this->_commandBuffer);
+                this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
+        }
+        else if (rendererType == RendererType::HYBRID) {
+            this->_renderer = std::make_shared<vft::VulkanHybridTextRenderer>(
+                this->_physicalDevice, this->_logicalDevice, this->_graphicsQueue, this->_commandPool,
+                this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         } else {
             this->_renderer = std::make_shared<vft::VulkanSdfTextRenderer>(this->_physicalDevice, this->_logicalDevice,
                                                                            this->_graphicsQueue, this->_commandPool,
-                                                                           this->_renderPass, this->_commandBuffer);
+                                                                           this->_renderPass, this->_commandBuffers[0], this->_pipelineCache->getPipelineCache(), this->_enabledFeatures);
         }
     }
 
+    if (measureTime) {
+        std::chrono::duration<double, std::milli> rendererCreationTime = std::chrono::steady_clock::now() - rendererCreationStart;
+        std::cout << "Renderer creation time: " << rendererCreationTime.count() << " ms" << std::endl;
+    }
+
+    // Record next frame while the gpu renders the previous one
+    this->_renderer->setFramesInFlight(MAX_FRAMES_IN_FLIGHT);
+
     this->_renderer->setViewportSize(this->_window->getWidth(), this->_window->getHeight());
 }
 
+/**
+ * @brief Upload text buffers on dedicated transfer queue if supported, graphics submits wait for semaphores signaled by
+ * the uploads
+ */
+void Scene::_enableTransferQueue() {
+    if(this->_transferQueue == nullptr) {
+        return;
+    }
+
+    QueueFamilyIndices queueFamilyIndices = this->_findQueueFamilies(this->_physicalDevice);
+    this->_renderer->setTransferQueue(this->_transferQueue, this->_transferCommandPool, queueFamilyIndices.transferFamily.value(), queueFamilyIndices.graphicsFamily.value());
+}
+
 /**
  * @brief Scene destructor
  */
 Scene::~Scene() {
     this->_renderer.reset();
+    this->_pipelineCache.reset();
     this->_cleanupSwapChain();
 
-    vkDestroySemaphore(this->_logicalDevice, this->_imageAvailableSemaphore, nullptr);
-    vkDestroySemaphore(this->_logicalDevice, this->_renderFinishedSemaphore, nullptr);
-    vkDestroyFence(this->_logicalDevice, this->_inFlightFence, nullptr);
+    for(uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        vkDestroySemaphore(this->_logicalDevice, this->_imageAvailableSemaphores[i], nullptr);
+        vkDestroySemaphore(this->_logicalDevice, this->_renderFinishedSemaphores[i], nullptr);
+        vkDestroyFence(this->_logicalDevice, this->_inFlightFences[i], nullptr);
+    }
 
     vkDestroyCommandPool(this->_logicalDevice, this->_commandPool, nullptr);
+    if(this->_transferCommandPool != nullptr) {
+        vkDestroyCommandPool(this->_logicalDevice, this->_transferCommandPool, nullptr);
+    }
     vkDestroyRenderPass(this->_logicalDevice, this->_renderPass, nullptr);
     vkDestroyDevice(this->_logicalDevice, nullptr);
     vkDestroySurfaceKHR(this->_instance, this->_surface, nullptr);
@@ -456,6 +498,15 @@ Scene::QueueFamilyIndices Scene::_findQueueFamilies(VkPhysicalDevice physicalDev
         i++;
     }
 
+    // Dedicated transfer queue family lets buffer uploads run alongside rendering
+    for(uint32_t j = 0; j < queueFamilyCount; j++) {
+        VkQueueFlags flags = queueFamilies[j].queueFlags;
+        if((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) && !(flags & VK_QUEUE_COMPUTE_BIT)) {
+            indices.transferFamily = j;
+            break;
+        }
+    }
+
     return indices;
 }
 
@@ -542,6 +593,9 @@ void Scene::_createLogicalDevice() {
 
     std::vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies = { indices.graphicsFamily.value(), indices.presentFamily.value() };
+    if(indices.transferFamily.has_value()) {
+        uniqueQueueFamilies.insert(indices.transferFamily.value());
+    }
 
     float queuePriority = 1.0f;
     for(uint32_t queueFamily : uniqueQueueFamilies) {
@@ -553,14 +607,21 @@ void Scene::_createLogicalDevice() {
         deviceQueueCreateInfos.push_back(deviceQueueCreateInfo);
     }
 
-    VkPhysicalDeviceFeatures deviceFeatures{};
-    deviceFeatures.tessellationShader = VK_TRUE;
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(this->_physicalDevice, &supportedFeatures);
+
+    // Enabled features are passed to text renderers, which use optional features only if they are enabled
+    this->_enabledFeatures.tessellationShader = VK_TRUE;
+    this->_enabledFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+    this->_enabledFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+    this->_enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+    this->_enabledFeatures.shaderSampledImageArrayDynamicIndexing = supportedFeatures.shaderSampledImageArrayDynamicIndexing;
 
     VkDeviceCreateInfo deviceCreateInfo{};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(deviceQueueCreateInfos.size());
     deviceCreateInfo.pQueueCreateInfos = deviceQueueCreateInfos.data();
-    deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
+    deviceCreateInfo.pEnabledFeatures = &this->_enabledFeatures;
     deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
     deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
     deviceCreateInfo.enabledLayerCount = 0;
@@ -572,6 +633,9 @@ void Scene::_createLogicalDevice() {
 
     vkGetDeviceQueue(this->_logicalDevice, indices.graphicsFamily.value(), 0, &this->_graphicsQueue);
     vkGetDeviceQueue(this->_logicalDevice, indices.presentFamily.value(), 0, &this->_presentQueue);
+    if(indices.transferFamily.has_value()) {
+        vkGetDeviceQueue(this->_logicalDevice, indices.transferFamily.value(), 0, &this->_transferQueue);
+    }
 }
 
 /**
@@ -875,6 +939,17 @@ void Scene::_createCommandPool() {
     if(vkCreateCommandPool(this->_logicalDevice, &commandPoolCreateInfo, nullptr, &this->_commandPool) != VK_SUCCESS) {
         throw std::runtime_error("Error creating vulkan command pool");
     }
+
+    if(queueFamilyIndices.transferFamily.has_value()) {
+        VkCommandPoolCreateInfo transferCommandPoolCreateInfo{};
+        transferCommandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        transferCommandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        transferCommandPoolCreateInfo.queueFamilyIndex = queueFamilyIndices.transferFamily.value();
+
+        if(vkCreateCommandPool(this->_logicalDevice, &transferCommandPoolCreateInfo, nullptr, &this->_transferCommandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Error creating vulkan transfer command pool");
+        }
+    }
 }
 
 /**
@@ -885,9 +960,10 @@ void Scene::_createCommandBuffers() {
     commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     commandBufferAllocateInfo.commandPool = this->_commandPool;
     commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    commandBufferAllocateInfo.commandBufferCount = 1;
+    commandBufferAllocateInfo.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
 
-    if(vkAllocateCommandBuffers(this->_logicalDevice, &commandBufferAllocateInfo, &this->_commandBuffer) != VK_SUCCESS) {
+    this->_commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    if(vkAllocateCommandBuffers(this->_logicalDevice, &commandBufferAllocateInfo, this->_commandBuffers.data()) != VK_SUCCESS) {
         throw std::runtime_error("Error creating vulkan command buffer");
     }
 }
@@ -906,9 +982,8 @@ void Scene::_recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIn
         throw std::runtime_error("Error while recording vulkan command buffer");
     }
 
-    if(this->_measureTime) {
-        reinterpret_cast<vft::VulkanTimedRenderer*>(this->_renderer.get())->resetQueryPool();
-    }
+    // Record commands which must be executed outside of render pass, e.g. gpu culling or resetting timestamp queries
+    this->_renderer->prepare();
 
     VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
 
@@ -921,22 +996,26 @@ void Scene::_recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIn
     renderPassBeginInfo.clearValueCount = 1;
     renderPassBeginInfo.pClearValues = &clearColor;
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    // Renderer reusing draw commands in secondary command buffers sets viewport and scissor itself
+    VkSubpassContents subpassContents = this->_renderer->getSubpassContents();
+    vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, subpassContents);
     
-    VkViewport viewport{};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(this->_swapChainExtent.width);
-    viewport.height = static_cast<float>(this->_swapChainExtent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    VkRect2D scissor{};
-    scissor.offset = { 0, 0 };
-    scissor.extent = this->_swapChainExtent;
-
-    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    if(subpassContents == VK_SUBPASS_CONTENTS_INLINE) {
+        VkViewport viewport{};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = static_cast<float>(this->_swapChainExtent.width);
+        viewport.height = static_cast<float>(this->_swapChainExtent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+
+        VkRect2D scissor{};
+        scissor.offset = { 0, 0 };
+        scissor.extent = this->_swapChainExtent;
+
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    }
     
     this->_renderer->draw();
 
@@ -958,12 +1037,18 @@ void Scene::_createSynchronizationObjects() {
     fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    if(
-        vkCreateSemaphore(this->_logicalDevice, &semaphoreCreateInfo, nullptr, &this->_imageAvailableSemaphore) != VK_SUCCESS ||
-        vkCreateSemaphore(this->_logicalDevice, &semaphoreCreateInfo, nullptr, &this->_renderFinishedSemaphore) != VK_SUCCESS ||
-        vkCreateFence(this->_logicalDevice, &fenceCreateInfo, nullptr, &this->_inFlightFence) != VK_SUCCESS
-    ) {
-        throw std::runtime_error("Error creating vulkan synchronization objects");
+    this->_imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    this->_renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    this->_inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+
+    for(uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        if(
+            vkCreateSemaphore(this->_logicalDevice, &semaphoreCreateInfo, nullptr, &this->_imageAvailableSemaphores[i]) != VK_SUCCESS ||
+            vkCreateSemaphore(this->_logicalDevice, &semaphoreCreateInfo, nullptr, &this->_renderFinishedSemaphores[i]) != VK_SUCCESS ||
+            vkCreateFence(this->_logicalDevice, &fenceCreateInfo, nullptr, &this->_inFlightFences[i]) != VK_SUCCESS
+        ) {
+            throw std::runtime_error("Error creating vulkan synchronization objects");
+        }
     }
 }
 
@@ -971,14 +1056,15 @@ void Scene::_createSynchronizationObjects() {
  * @brief Records and executes the command buffer, presents output to screen
  */
 void Scene::_drawFrame() {
-    vkWaitForFences(this->_logicalDevice, 1, &this->_inFlightFence, true, UINT64_MAX);
+    // Wait until the gpu finished the frame which used the same command buffer and synchronization objects
+    vkWaitForFences(this->_logicalDevice, 1, &this->_inFlightFences[this->_currentFrame], true, UINT64_MAX);
 
     // Set uniform buffers used for rendering text
     vft::UniformBufferObject ubo{ this->_camera->getViewMatrix(), this->_camera->getProjectionMatrix() };
     this->_renderer->setUniformBuffers(ubo);
 
     uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(this->_logicalDevice, this->_swapChain, UINT64_MAX, this->_imageAvailableSemaphore, nullptr, &imageIndex);
+    VkResult result = vkAcquireNextImageKHR(this->_logicalDevice, this->_swapChain, UINT64_MAX, this->_imageAvailableSemaphores[this->_currentFrame], nullptr, &imageIndex);
     if(result == VK_ERROR_OUT_OF_DATE_KHR) {
         _recreateSwapChain();
         return;
@@ -987,26 +1073,34 @@ void Scene::_drawFrame() {
         throw std::runtime_error("Error acquiring vulkan swap chain image");
     }
 
-    vkResetFences(this->_logicalDevice, 1, &this->_inFlightFence);
+    vkResetFences(this->_logicalDevice, 1, &this->_inFlightFences[this->_currentFrame]);
+
+    VkCommandBuffer commandBuffer = this->_commandBuffers[this->_currentFrame];
+    vkResetCommandBuffer(commandBuffer, 0);
+    this->_renderer->setCommandBuffer(commandBuffer, this->_currentFrame);
+    this->_recordCommandBuffer(commandBuffer, imageIndex);
 
-    vkResetCommandBuffer(this->_commandBuffer, 0);
-    this->_recordCommandBuffer(this->_commandBuffer, imageIndex);
+    VkSemaphore signalSemaphores[] = { this->_renderFinishedSemaphores[this->_currentFrame] };
+    std::vector<VkSemaphore> waitSemaphores = { this->_imageAvailableSemaphores[this->_currentFrame] };
+    std::vector<VkPipelineStageFlags> waitStagees = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
 
-    VkSemaphore signalSemaphores[] = { this->_renderFinishedSemaphore };
-    VkSemaphore waitSemaphores[] = { this->_imageAvailableSemaphore };
-    VkPipelineStageFlags waitStagees[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+    // Uploads on the transfer queue must finish before text buffers are read
+    for(VkSemaphore transferSemaphore : this->_renderer->takeTransferSemaphores()) {
+        waitSemaphores.push_back(transferSemaphore);
+        waitStagees.push_back(VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT);
+    }
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStagees;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+    submitInfo.pWaitSemaphores = waitSemaphores.data();
+    submitInfo.pWaitDstStageMask = waitStagees.data();
     submitInfo.signalSemaphoreCount = 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &this->_commandBuffer;
+    submitInfo.pCommandBuffers = &commandBuffer;
 
-    if(vkQueueSubmit(this->_graphicsQueue, 1, &submitInfo, this->_inFlightFence) != VK_SUCCESS) {
+    if(vkQueueSubmit(this->_graphicsQueue, 1, &submitInfo, this->_inFlightFences[this->_currentFrame]) != VK_SUCCESS) {
         throw std::runtime_error("Error submiting draw command buffer");
     }
 
@@ -1021,6 +1115,8 @@ void Scene::_drawFrame() {
     presentInfo.pImageIndices = &imageIndex;
 
     result = vkQueuePresentKHR(this->_presentQueue, &presentInfo);
+    this->_currentFrame = (this->_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
     if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || this->_window->wasResized()) {
         this->_window->resetResized();
         this->_recreateSwapChain();
@@ -1030,8 +1126,17 @@ void Scene::_drawFrame() {
         throw std::runtime_error("Error presenting vulkan swap chain image");
     }
 
-    if(this->_measureTime) {
-        float time = reinterpret_cast<vft::VulkanTimedRenderer*>(this->_renderer.get())->readTimestamps() / 10e+3;
-        std::cout << "Draw time: " << time << " microseconds" << std::endl;
+    // Results are read without waiting for the gpu, print rolling statistics once in a while
+    if(this->_measureTime && ++this->_measuredFrames % 100 == 0) {
+        vft::VulkanTimedRenderer *timedRenderer = reinterpret_cast<vft::VulkanTimedRenderer*>(this->_renderer.get());
+
+        for(const auto &[name, statistics] : timedRenderer->getTimingStatistics()) {
+            std::cout << name << ": min " << statistics.min << ", avg " << statistics.average << ", p99 " << statistics.p99 << " microseconds" << std::endl;
+        }
+
+        vft::PipelineStatistics pipelineStatistics = timedRenderer->getPipelineStatistics();
+        std::cout << "Primitives: " << pipelineStatistics.inputAssemblyPrimitives << ", vertex shader invocations: " << pipelineStatistics.vertexShaderInvocations
+                  << ", clipped primitives: " << pipelineStatistics.clippingPrimitives << ", fragment shader invocations: " << pipelineStatistics.fragmentShaderInvocations
+                  << ", tessellation evaluation shader invocations: " << pipelineStatistics.tessellationEvaluationShaderInvocations << std::endl;
     }
 }
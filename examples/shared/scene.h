@@ -17,6 +17,7 @@
 #include <fstream>
 #include <memory>
 #include <cstring>
+#include <chrono>
 
 #include <vulkan/vulkan.h>
 #include <glm/mat4x4.hpp>
@@ -29,14 +30,27 @@
 #include <VFONT/vulkan_tessellation_shaders_text_renderer.h>
 #include <VFONT/vulkan_winding_number_text_renderer.h>
 #include <VFONT/vulkan_sdf_text_renderer.h>
+#include <VFONT/vulkan_hybrid_text_renderer.h>
 #include <VFONT/i_vulkan_text_renderer.h>
 #include <VFONT/vulkan_timed_renderer.h>
+#include <VFONT/vulkan_pipeline_cache.h>
 
 #include "window.h"
 #include "base_camera.h"
 #include "perspective_camera.h"
 #include "ortho_camera.h"
 
+/**
+ * @brief Defines all text renderers selectable in demo app
+ */
+enum class RendererType {
+    TRIANGULATION,
+    TESSELLATION_SHADERS,
+    WINDING_NUMBER,
+    SDF,
+    HYBRID
+};
+
 /**
  * @class Scene
  *
@@ -46,12 +60,15 @@ class Scene {
 
 protected:
 
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;    /**< Number of frames recorded while the gpu renders previous frames */
+
     /**
      * @brief Represents supported vulkan queue families of physical device
      */
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        std::optional<uint32_t> transferFamily;
 
         bool isComplete() {
             return
@@ -75,7 +92,9 @@ protected:
     std::vector<const char *> validationLayers;             /**< Selected vulkan validation layers */
 
     bool _measureTime;
+    unsigned long _measuredFrames{0};                       /**< Number of frames drawn while measuring time */
     std::shared_ptr<vft::IVulkanTextRenderer> _renderer;                            /**< Default text renderer */
+    std::unique_ptr<vft::VulkanPipelineCache> _pipelineCache;                      /**< Pipeline cache shared by text renderers */
     std::shared_ptr<MainWindow> _window;                    /**< Application window */
     std::unique_ptr<BaseCamera> _camera;                    /**< Camera object */
     CameraType _cameraType;                                 /**< Type of camera used for rendering */
@@ -84,8 +103,10 @@ protected:
     VkSurfaceKHR _surface;                                  /**< Vulkan surface */
     VkPhysicalDevice _physicalDevice;                       /**< Vulkan physical device */
     VkDevice _logicalDevice;                                /**< Vulkan logical device */
+    VkPhysicalDeviceFeatures _enabledFeatures{};            /**< Features enabled on vulkan logical device */
     VkQueue _graphicsQueue;                                 /**< Vulkan graphics queue */
     VkQueue _presentQueue;                                  /**< Vulkan present queue */
+    VkQueue _transferQueue{nullptr};                        /**< Dedicated vulkan transfer queue, if supported */
     VkSwapchainKHR _swapChain;                              /**< Vulkan swap chain */
     std::vector<VkImage> _swapChainImages;                  /**< Vulkan swap chain images */
     VkFormat _swapChainImageFormat;                         /**< Vulkan swap chain image format */
@@ -94,14 +115,16 @@ protected:
     VkRenderPass _renderPass;                               /**< Vulkan render pass */
     std::vector<VkFramebuffer> _framebuffers;               /**< Vulkan frame buffers */
     VkCommandPool _commandPool;                             /**< Vulkan command pool */
-    VkCommandBuffer _commandBuffer;           /**< Vulkan command buffers */
-    VkSemaphore _imageAvailableSemaphore;     /**< Semaphore to signal that an image was acquired from the swap chain */
-    VkSemaphore _renderFinishedSemaphore;     /**< Semaphore to signal if vulkan finished rendering and can begin presenting */
-    VkFence _inFlightFence;                   /**< Fence to ensure only one frame at a time is being rendered */
+    VkCommandPool _transferCommandPool{nullptr};            /**< Vulkan command pool of transfer queue family */
+    std::vector<VkCommandBuffer> _commandBuffers;           /**< Vulkan command buffers, one for each frame in flight */
+    std::vector<VkSemaphore> _imageAvailableSemaphores;     /**< Semaphores to signal that an image was acquired from the swap chain */
+    std::vector<VkSemaphore> _renderFinishedSemaphores;     /**< Semaphores to signal if vulkan finished rendering and can begin presenting */
+    std::vector<VkFence> _inFlightFences;                   /**< Fences to ensure at most MAX_FRAMES_IN_FLIGHT frames are being rendered */
+    uint32_t _currentFrame{0};                              /**< Index of frame in flight which is being recorded */
 
 public:
 
-    Scene(CameraType cameraType, vft::TessellationStrategy tessellationAlgorithm, bool measureTime = false);
+    Scene(CameraType cameraType, RendererType rendererType, bool measureTime = false);
     ~Scene();
 
     void run();
@@ -113,6 +136,7 @@ public:
 protected:
 
     void _initVulkan();
+    void _enableTransferQueue();
     void _createWindow();
     void _mainLoop();
 
@@ -0,0 +1,56 @@
+/**
+ * @file bc4_encoder.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "profiler.h"
+
+namespace vft {
+
+/**
+ * @brief Compresses one channel textures into bc4 blocks, each block of 4 x 4 pixels is stored in 8 bytes as two
+ * endpoints and a 3 bit index of one of eight values between them for every pixel. Rows of blocks are encoded in
+ * parallel and pixels of a block are processed together, so the loops can be vectorized
+ */
+class Bc4Encoder {
+public:
+    /** Width and height of block in pixels */
+    static constexpr unsigned int BLOCK_SIZE = 4;
+    /** Number of pixels in block */
+    static constexpr unsigned int BLOCK_PIXELS = BLOCK_SIZE * BLOCK_SIZE;
+    /** Size of encoded block in bytes */
+    static constexpr unsigned int BLOCK_BYTES = 8;
+    /** Maximal number of least squares refinements of endpoints of one block */
+    static constexpr unsigned int REFINEMENT_ITERATIONS = 2;
+
+    static std::vector<uint8_t> encode(std::span<const uint8_t> pixels, unsigned int width, unsigned int height);
+    static std::vector<uint8_t> decode(std::span<const uint8_t> blocks, unsigned int width, unsigned int height);
+
+protected:
+    static void _encodeRows(std::span<const uint8_t> pixels,
+                            unsigned int width,
+                            unsigned int firstRow,
+                            unsigned int lastRow,
+                            std::vector<uint8_t> &blocks);
+    static void _encodeBlock(const std::array<uint8_t, BLOCK_PIXELS> &pixels, uint8_t *block);
+    static float _getSteps(const std::array<uint8_t, BLOCK_PIXELS> &pixels,
+                           uint8_t max,
+                           uint8_t min,
+                           std::array<uint8_t, BLOCK_PIXELS> &steps);
+    static std::array<uint8_t, 8> _getPalette(uint8_t red0, uint8_t red1);
+    static void _checkSize(unsigned int width, unsigned int height);
+};
+
+}  // namespace vft
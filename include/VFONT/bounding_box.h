@@ -0,0 +1,37 @@
+/**
+ * @file bounding_box.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <limits>
+
+#include <glm/common.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace vft {
+
+/**
+ * @brief Axis aligned bounding box in 3D space
+ */
+class BoundingBox {
+public:
+    glm::vec3 min{std::numeric_limits<float>::max()};    /**< Corner with the smallest coordinates */
+    glm::vec3 max{std::numeric_limits<float>::lowest()}; /**< Corner with the largest coordinates */
+
+    BoundingBox() = default;
+    BoundingBox(glm::vec3 min, glm::vec3 max);
+
+    void add(glm::vec3 point);
+    void add(const BoundingBox &boundingBox);
+
+    BoundingBox transform(const glm::mat4 &matrix) const;
+
+    bool isEmpty() const;
+    glm::vec3 getCenter() const;
+};
+
+}  // namespace vft
@@ -0,0 +1,48 @@
+/**
+ * @file bounding_volume_hierarchy.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "bounding_box.h"
+#include "view_frustum.h"
+
+namespace vft {
+
+/**
+ * @brief Binary tree of bounding boxes, whole subtrees outside of view frustum are skipped when querying visible boxes
+ */
+class BoundingVolumeHierarchy {
+public:
+    /** Maximum number of bounding boxes stored in one leaf node */
+    static constexpr unsigned int MAX_LEAF_SIZE = 4;
+
+protected:
+    /**
+     * @brief Node of hierarchy, leaf nodes reference a range of bounding box indices
+     */
+    struct Node {
+        BoundingBox boundingBox{}; /**< Bounding box of all boxes in subtree */
+        unsigned int left{0};      /**< Index of left child node */
+        unsigned int right{0};     /**< Index of right child node */
+        unsigned int start{0};     /**< Index of first bounding box in leaf node */
+        unsigned int count{0};     /**< Number of bounding boxes in leaf node, 0 for inner nodes */
+    };
+
+    std::vector<Node> _nodes{};           /**< Nodes of hierarchy, first node is the root */
+    std::vector<unsigned int> _indices{}; /**< Indices of bounding boxes ordered by leaf nodes */
+
+public:
+    void build(const std::vector<BoundingBox> &boundingBoxes);
+    std::vector<unsigned int> query(const ViewFrustum &frustum) const;
+
+protected:
+    unsigned int _buildNode(const std::vector<BoundingBox> &boundingBoxes, unsigned int start, unsigned int count);
+};
+
+}  // namespace vft
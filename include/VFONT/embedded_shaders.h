@@ -0,0 +1,35 @@
+/**
+ * @file embedded_shaders.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vft {
+
+/**
+ * @brief Provides access to compiled spir-v shaders embedded into the library at build time
+ */
+class EmbeddedShaders {
+public:
+    /**
+     * @brief Compiled shader stored in the library
+     */
+    struct Shader {
+        const char *fileName;      /**< Path of shader file relative to the executable, e.g. "shaders/sdf-vert.spv" */
+        const unsigned char *code; /**< Spir-v code of shader */
+        size_t size;               /**< Size of spir-v code in bytes */
+    };
+
+protected:
+    static const std::vector<Shader> _shaders; /**< All embedded shaders, generated by cmake/EmbedShaders.cmake */
+
+public:
+    static const Shader *find(const std::string &fileName);
+};
+
+}  // namespace vft
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
@@ -34,6 +36,7 @@ public:
     glm::vec2 getScalingVector(unsigned int fontSize) const;
     unsigned int getPixelSize() const;
     std::string getFontFamily() const;
+    uint64_t getContentHash() const;
     FT_Face getFace() const;
 };
 
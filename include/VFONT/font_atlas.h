@@ -5,24 +5,55 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <memory>
+#include <span>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <glm/vec2.hpp>
 
+#include "bc4_encoder.h"
 #include "font.h"
 #include "glyph.h"
 #include "glyph_mesh.h"
+#include "mapped_file.h"
+#include "msdf_generator.h"
+#include "sdf_generator.h"
+#include "winding_number_tessellator.h"
 
 namespace vft {
 
 /**
- * @brief Font atlas containing sdfs of selected glyphs
+ * @brief Font atlas containing sdfs or multi-channel sdfs of selected glyphs
  */
 class FontAtlas {
 public:
+    /**
+     * @brief Format of distance fields stored in font atlas
+     */
+    enum class Format {
+        SDF,       /**< One channel sdfs rasterized by freetype */
+        MSDF,      /**< Four channel multi-channel sdfs, alpha contains the true sdf */
+        TIERED_SDF /**< One channel sdfs of every glyph at each tier pixel size, renderer picks a tier per character */
+    };
+
+    /** Size of em square in pixels of glyphs in multi-channel sdf font atlases */
+    static constexpr unsigned int MSDF_PIXEL_SIZE = 32;
+    /** Sizes of em square in pixels of tiers in tiered sdf font atlases, from the smallest */
+    static constexpr std::array<unsigned int, 3> TIER_PIXEL_SIZES = {16, 32, 64};
+    /** Version of font atlas file format, files with other versions are rejected */
+    static constexpr uint32_t FILE_VERSION = 1;
+    /** Alignment in bytes of texture in font atlas files */
+    static constexpr uint64_t FILE_TEXTURE_ALIGNMENT = 64;
+
     /**
      * @brief Range of unicode characters
      */
@@ -45,31 +76,74 @@ public:
     };
 
 protected:
-    std::string _fontFamily{};  /**< Font family of font atlas */
-    unsigned int _width{1024};  /**< Width of font atlas */
-    unsigned int _height{1024}; /**< Height of font atlas */
+    /**
+     * @brief Header of font atlas file. It is followed by tier pixel sizes, glyph ids with UVs of every tier and the
+     * texture. Values are stored in native byte order
+     */
+    struct FileHeader {
+        std::array<char, 4> magic{'V', 'F', 'A', 'T'}; /**< Identifies font atlas files */
+        uint32_t version{FILE_VERSION};                /**< Version of file format */
+        uint64_t fontHash{0};                          /**< Content hash of font the atlas was generated from */
+        uint32_t format{0};                            /**< Format of distance fields */
+        uint32_t compressed{0};                        /**< Whether texture is stored as bc4 blocks */
+        uint32_t width{0};                             /**< Width of texture */
+        uint32_t height{0};                            /**< Height of texture */
+        uint32_t pixelSize{0};                         /**< Pixel size of font the glyph bounds were generated at */
+        uint32_t spread{0};                            /**< Distance range of sdfs in pixels of font pixel size */
+        uint32_t tierCount{0};                         /**< Number of tiers */
+        uint32_t glyphCount{0};                        /**< Number of glyphs */
+        uint64_t textureOffset{0};                     /**< Offset of texture from start of file */
+        uint64_t textureSize{0};                       /**< Size of texture in bytes */
+    };
 
-    std::vector<uint8_t> _texture{}; /**< Texture containing sdfs of selected glyphs */
+    std::string _fontFamily{};                   /**< Font family of font atlas */
+    Format _format{Format::SDF};                 /**< Format of distance fields */
+    unsigned int _width{1024};                   /**< Width of font atlas */
+    unsigned int _height{1024};                  /**< Height of font atlas */
+    std::vector<unsigned int> _tierPixelSizes{}; /**< Sizes of em square in pixels of each tier */
+    bool _compressed{false};                     /**< Whether texture is stored as bc4 blocks */
+    unsigned int _pixelSize{64};                 /**< Pixel size of font the glyph bounds were generated at */
+
+    std::vector<uint8_t> _texture{};           /**< Texture containing sdfs of selected glyphs */
+    std::shared_ptr<MappedFile> _mappedFile{}; /**< Font atlas file containing texture if atlas was loaded */
+    std::span<const uint8_t> _mappedTexture{}; /**< Texture in mapped font atlas file */
     /**
-     * Hash map containing UVs of selected glyphs stored in texture (key: glyphId, value: UV).
-     * Because new lines have glyphId 0, we need to make sure we insert a default record with glyphId 0
+     * Hash map containing UVs of selected glyphs in each tier stored in texture (key: glyphId, value: UV of each
+     * tier). Because new lines have glyphId 0, we need to make sure we insert a default record with glyphId 0
      */
-    std::unordered_map<uint32_t, GlyphInfo> _glyphs{{0, GlyphInfo{glm::vec2{0, 0}, glm::vec2{0, 0}}}};
+    std::unordered_map<uint32_t, std::vector<GlyphInfo>> _glyphs{};
 
 public:
-    FontAtlas(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds);
-    FontAtlas(std::shared_ptr<Font> font, std::vector<CharacterRange> characterRanges);
-    FontAtlas(std::shared_ptr<Font> font, std::u32string characters);
-    FontAtlas(std::shared_ptr<Font> font);
+    FontAtlas(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds, Format format = Format::SDF);
+    FontAtlas(std::shared_ptr<Font> font, std::vector<CharacterRange> characterRanges, Format format = Format::SDF);
+    FontAtlas(std::shared_ptr<Font> font, std::u32string characters, Format format = Format::SDF);
+    FontAtlas(std::shared_ptr<Font> font, Format format = Format::SDF);
     ~FontAtlas() = default;
 
-    GlyphInfo getGlyph(uint32_t glyphId) const;
+    static FontAtlas load(std::shared_ptr<Font> font, std::string fileName);
+    void save(std::shared_ptr<Font> font, std::string fileName) const;
+
+    void compress();
+
+    GlyphInfo getGlyph(uint32_t glyphId, unsigned int tier = 0) const;
 
     std::string getFontFamily() const;
+    Format getFormat() const;
+    unsigned int getChannelCount() const;
+    const std::vector<unsigned int> &getTierPixelSizes() const;
+    bool isCompressed() const;
     glm::uvec2 getSize() const;
-    const std::vector<uint8_t> &getTexture() const;
+    std::span<const uint8_t> getTexture() const;
 
 protected:
+    FontAtlas() = default;
+
+    void _generateTiers(std::shared_ptr<Font> font,
+                        const std::vector<uint32_t> &glyphIds,
+                        glm::uvec2 &pen,
+                        unsigned int &currentRowHeight);
+    GlyphInfo _packBitmap(const MsdfGenerator::Bitmap &bitmap, glm::uvec2 &pen, unsigned int &currentRowHeight);
+
     std::vector<uint32_t> _getAllGlyphIds(std::shared_ptr<Font> font) const;
     std::vector<uint32_t> _getRangesGlyphIds(std::shared_ptr<Font> font,
                                              std::vector<CharacterRange> characterRanges) const;
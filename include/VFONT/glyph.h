@@ -6,13 +6,9 @@
 #pragma once
 
 #include <array>
-#include <cstdint>
-#include <vector>
 
 #include <glm/vec2.hpp>
 
-#include "curve.h"
-#include "edge.h"
 #include "glyph_mesh.h"
 
 namespace vft {
@@ -25,9 +21,6 @@ public:
     GlyphMesh mesh{}; /**< Mesh storing vertex and index buffers used for rendering */
 
 protected:
-    std::vector<Curve> _curveSegments{}; /**< Curve segments of glyph */
-    std::vector<Edge> _lineSegments{};   /**< Line segment of glyph */
-
     long _width{0};  /**< Width of glyph */
     long _height{0}; /**< Height of glyph */
 
@@ -50,9 +43,6 @@ protected:
 public:
     Glyph() = default;
 
-    void addLineSegment(Edge edge);
-    void addCurveSegment(Curve curve);
-
     void setWidth(long width);
     void setHeight(long height);
     void setBearingX(long bearingX);
@@ -62,11 +52,6 @@ public:
 
     std::array<glm::vec2, 4> getBoundingBox() const;
 
-    const std::vector<Edge> &getLineSegmentsIndices() const;
-    const std::vector<Curve> &getCurveSegmentsIndices() const;
-    uint32_t getLineSegmentsIndexCount() const;
-    uint32_t getCurveSegmentsIndexCount() const;
-
     long getWidth() const;
     long getHeight() const;
     long getBearingX() const;
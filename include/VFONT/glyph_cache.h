@@ -10,24 +10,29 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "glyph.h"
+#include "tessellation_strategy.h"
 
 namespace vft {
 
 /**
- * @brief Key for glyphs stored in glyph cache
+ * @brief Key for glyphs stored in glyph cache. Glyphs composed by different strategies have different meshes, so
+ * renderers of different strategies can share one cache
  */
 class GlyphKey {
 public:
-    std::string fontName;  /**< Font name of glyph */
-    uint32_t glyphId;      /**< Glyph */
-    unsigned int fontSize; /**< Font size of glyph */
+    TessellationStrategy strategy; /**< Strategy which composed glyph */
+    std::string fontName;          /**< Font name of glyph */
+    uint32_t glyphId;              /**< Glyph */
+    unsigned int fontSize;         /**< Level of detail given by font size, 0 if mesh does not depend on font size */
 
-    GlyphKey(std::string fontName, uint32_t glyphId, unsigned int fontSize);
+    GlyphKey(TessellationStrategy strategy, std::string fontName, uint32_t glyphId, unsigned int fontSize);
 
     bool operator==(const GlyphKey &rhs) const = default;
 };
@@ -40,18 +45,20 @@ struct GlyphKeyHash {
         std::size_t fontNameHash = std::hash<std::string>()(key.fontName);
         std::size_t glyphIdHash = std::hash<uint32_t>()(key.glyphId);
         std::size_t fontSizeHash = std::hash<unsigned int>()(key.fontSize);
-        return fontSizeHash ^ (glyphIdHash << 1) ^ (fontNameHash << 2);
+        std::size_t strategyHash = std::hash<TessellationStrategy>()(key.strategy);
+        return fontSizeHash ^ (glyphIdHash << 1) ^ (fontNameHash << 2) ^ (strategyHash << 3);
     }
 };
 
 /**
- * @brief LRU cache for glyphs
+ * @brief LRU cache for glyphs. Glyphs are immutable and shared, so renderers can share one cache and keep using glyphs
+ * evicted from it
  */
 class GlyphCache {
 private:
     unsigned long _maxSize{ULONG_MAX}; /**< Maximum size of cache */
 
-    std::unordered_map<GlyphKey, Glyph, GlyphKeyHash> _cache{}; /**< Hash map used to store glyphs */
+    std::unordered_map<GlyphKey, std::shared_ptr<const Glyph>, GlyphKeyHash> _cache{}; /**< Hash map storing glyphs */
     std::list<GlyphKey> _used{}; /**< Linked list of glyphs in cache ordered by most recently used glyph */
 
 public:
@@ -59,8 +66,8 @@ public:
     GlyphCache();
     ~GlyphCache() = default;
 
-    void setGlyph(GlyphKey key, Glyph glyph);
-    const Glyph &getGlyph(GlyphKey key);
+    void setGlyph(GlyphKey key, std::shared_ptr<const Glyph> glyph);
+    std::shared_ptr<const Glyph> getGlyph(GlyphKey key);
     bool exists(GlyphKey key) const;
 
     void clearGlyph(GlyphKey key);
@@ -11,6 +11,7 @@
 #include <glm/vec2.hpp>
 
 #include "edge.h"
+#include "profiler.h"
 
 namespace vft {
 
@@ -5,38 +5,72 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include <glm/ext/vector_int2_sized.hpp>
 #include <glm/vec2.hpp>
 
 namespace vft {
 
 /**
- * @brief Stores vertex and index buffers used for rendering expressed in font units
+ * @brief Stores vertex and index buffers used for rendering expressed in font units. Vertices and indices of all index
+ * buffers are stored in one allocation, index buffers are ranges of the indices following the vertices
  */
 class GlyphMesh {
+public:
+    /** Maximum number of index buffers of one mesh */
+    static constexpr unsigned int MAX_DRAW_COUNT = 8;
+
+    /**
+     * @brief Range of one index buffer in indices of all index buffers
+     */
+    struct DrawRange {
+        uint32_t offset{0}; /**< Index of the first index of index buffer */
+        uint32_t count{0};  /**< Number of indices of index buffer */
+    };
+
 protected:
-    std::vector<glm::vec2> _vertices{};            /**< Vertex buffer */
-    std::vector<std::vector<uint32_t>> _indices{}; /**< Index buffers */
+    std::unique_ptr<std::byte[]> _data{nullptr};        /**< Vertices followed by indices of all index buffers */
+    uint32_t _vertexCount{0};                            /**< Number of vertices */
+    uint32_t _indexCount{0};                             /**< Number of indices of all index buffers */
+    unsigned int _drawCount{0};                          /**< Number of index buffers */
+    std::array<DrawRange, MAX_DRAW_COUNT> _drawRanges{}; /**< Ranges of index buffers */
 
 public:
-    GlyphMesh(std::vector<glm::vec2> vertices, std::vector<std::vector<uint32_t>> indices);
-    GlyphMesh();
+    GlyphMesh(std::span<const glm::vec2> vertices, std::initializer_list<std::span<const uint32_t>> indices);
+    GlyphMesh() = default;
+    GlyphMesh(const GlyphMesh &mesh);
+    GlyphMesh(GlyphMesh &&) = default;
     ~GlyphMesh() = default;
 
-    void addVertex(glm::vec2 vertex);
+    GlyphMesh &operator=(const GlyphMesh &mesh);
+    GlyphMesh &operator=(GlyphMesh &&) = default;
 
-    void setVertices(std::vector<glm::vec2> vertices);
-    void setIndices(unsigned int drawIndex, std::vector<uint32_t> indices);
+    std::span<const glm::vec2> getVertices() const;
+    std::span<const uint32_t> getIndices(unsigned int drawIndex) const;
+    std::span<const uint32_t> getAllIndices() const;
+    DrawRange getDrawRange(unsigned int drawIndex) const;
 
-    const std::vector<glm::vec2> &getVertices() const;
-    const std::vector<uint32_t> &getIndices(unsigned int drawIndex) const;
+    std::vector<glm::i16vec2> getQuantizedVertices() const;
+    std::vector<uint16_t> getCompactIndices(unsigned int drawIndex) const;
 
     uint32_t getVertexCount() const;
     uint32_t getIndexCount(unsigned int drawIndex) const;
     unsigned int getDrawCount() const;
+
+protected:
+    std::size_t _getSize() const;
 };
 
 }  // namespace vft
@@ -5,9 +5,12 @@
 
 #pragma once
 
+#include <vector>
+
 #include <vulkan/vulkan.h>
 
 #include "text_renderer.h"
+#include "vulkan_memory_allocator.h"
 
 namespace vft {
 
@@ -18,10 +21,18 @@ class IVulkanTextRenderer : public virtual TextRenderer {
 public:
     virtual ~IVulkanTextRenderer() = default;
 
+    virtual void prepare() = 0;
     virtual void draw() = 0;
+    virtual std::vector<VkSemaphore> takeTransferSemaphores() = 0;
 
     // Setters for vulkan objects
-    virtual void setCommandBuffer(VkCommandBuffer commandBuffer) = 0;
+    virtual void setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) = 0;
+    virtual void setTransferQueue(VkQueue transferQueue,
+                                  VkCommandPool transferCommandPool,
+                                  uint32_t transferQueueFamilyIndex,
+                                  uint32_t graphicsQueueFamilyIndex) = 0;
+    virtual void setFramesInFlight(uint32_t framesInFlight) = 0;
+    virtual void setSecondaryCommandBuffers(bool secondaryCommandBuffers) = 0;
 
     // Getters for vulkan objects
     virtual VkPhysicalDevice getPhysicalDevice() = 0;
@@ -30,6 +41,10 @@ public:
     virtual VkQueue getGraphicsQueue() = 0;
     virtual VkRenderPass getRenderPass() = 0;
     virtual VkCommandBuffer getCommandBuffer() = 0;
+    virtual uint32_t getFramesInFlight() = 0;
+    virtual VkSubpassContents getSubpassContents() = 0;
+
+    virtual VulkanMemoryStatistics getMemoryStatistics() = 0;
 };
 
 }  // namespace vft
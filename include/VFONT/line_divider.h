@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "character.h"
+#include "profiler.h"
 #include "unicode.h"
 
 namespace vft {
@@ -0,0 +1,33 @@
+/**
+ * @file mapped_file.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace vft {
+
+/**
+ * @brief Read-only file mapped into memory, pages of file are loaded by the operating system when they are accessed
+ */
+class MappedFile {
+protected:
+    const uint8_t *_data{nullptr}; /**< Start of mapped file */
+    size_t _size{0};               /**< Size of file in bytes */
+
+public:
+    MappedFile(std::string fileName);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    std::span<const uint8_t> getData() const;
+};
+
+}  // namespace vft
@@ -0,0 +1,58 @@
+/**
+ * @file mesh_optimizer.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace vft {
+
+/**
+ * @brief Statistics of the post-transform vertex cache collected while optimizing meshes
+ */
+struct VertexCacheStatistics {
+    uint64_t triangleCount{0};     /**< Number of optimized triangles */
+    uint64_t cacheMissesBefore{0}; /**< Number of vertex cache misses before optimization */
+    uint64_t cacheMissesAfter{0};  /**< Number of vertex cache misses after optimization */
+
+    float getAcmrBefore() const;
+    float getAcmrAfter() const;
+};
+
+/**
+ * @brief Reorders triangle meshes for better locality in the post-transform vertex cache and in vertex fetch
+ */
+class MeshOptimizer {
+public:
+    /** Number of vertices in the simulated post-transform vertex cache */
+    static constexpr unsigned int DEFAULT_CACHE_SIZE = 16;
+
+    static std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t> &indices,
+                                                     uint32_t vertexCount,
+                                                     unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+    static void optimizeVertexFetch(std::vector<glm::vec2> &vertices, std::vector<uint32_t> &indices);
+
+    static uint64_t computeCacheMissCount(const std::vector<uint32_t> &indices,
+                                          unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+    static float computeAcmr(const std::vector<uint32_t> &indices, unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+
+protected:
+    static int64_t _getNextVertex(const std::vector<uint32_t> &candidates,
+                                  const std::vector<uint32_t> &liveTriangles,
+                                  const std::vector<uint32_t> &cacheTimestamps,
+                                  uint32_t timestamp,
+                                  unsigned int cacheSize,
+                                  std::vector<uint32_t> &deadEndStack,
+                                  uint32_t &cursor);
+};
+
+}  // namespace vft
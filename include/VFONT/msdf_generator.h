@@ -0,0 +1,126 @@
+/**
+ * @file msdf_generator.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#include <glm/glm.hpp>
+
+#include "font.h"
+#include "profiler.h"
+
+namespace vft {
+
+/**
+ * @brief Generates multi-channel signed distance fields of glyphs from their line segments and quadratic bezier
+ * curves. Edges of every contour are colored so that edges meeting at a corner never share all channels, the median of
+ * the three channels then reconstructs sharp corners even at low resolutions
+ */
+class MsdfGenerator {
+public:
+    /** Distance range in pixels of the font pixel size, same as the default spread of the freetype sdf rasterizer */
+    static constexpr unsigned int SPREAD = 8;
+    /** Minimal angle in radians between directions of two edges to consider their common point a corner */
+    static constexpr double CORNER_ANGLE_THRESHOLD = 3.0;
+
+    /**
+     * @brief Multi-channel signed distance field of one glyph, red, green and blue channels contain the
+     * multi-channel distance and alpha contains the true distance
+     */
+    struct Bitmap {
+        unsigned int width{0};         /**< Width of bitmap in pixels */
+        unsigned int height{0};        /**< Height of bitmap in pixels */
+        glm::vec2 size{0.f, 0.f};      /**< Exact size of the glyph's area in pixels, width and height are rounded up */
+        std::vector<uint8_t> pixels{}; /**< Rgba pixels from top left corner */
+    };
+
+protected:
+    /**
+     * @brief Channels of distance field an edge contributes to
+     */
+    enum EdgeColor : uint8_t {
+        BLACK = 0,
+        RED = 1,
+        GREEN = 2,
+        YELLOW = 3,
+        BLUE = 4,
+        MAGENTA = 5,
+        CYAN = 6,
+        WHITE = 7,
+    };
+
+    /**
+     * @brief Line segment or quadratic bezier curve of contour
+     */
+    struct Edge {
+        std::array<glm::dvec2, 3> points{}; /**< Start, control and end point, control point is unused by lines */
+        bool isCurve{false};                /**< Whether edge is a quadratic bezier curve */
+        uint8_t color{WHITE};               /**< Channels edge contributes to */
+    };
+
+    /**
+     * @brief Signed distance to edge, ties are resolved by how orthogonal the edge is to the direction to the point
+     */
+    struct SignedDistance {
+        double distance{-std::numeric_limits<double>::max()}; /**< Signed distance */
+        double dot{1};                                         /**< Absolute cosine between edge and point */
+
+        bool operator<(const SignedDistance &other) const {
+            return std::abs(distance) < std::abs(other.distance) ||
+                   (std::abs(distance) == std::abs(other.distance) && dot < other.dot);
+        }
+    };
+
+    /**
+     * @brief Edge closest to a pixel in one channel
+     */
+    struct ChannelDistance {
+        SignedDistance minDistance{}; /**< Distance to closest edge */
+        const Edge *edge{nullptr};    /**< Closest edge or nullptr if no edge has the channel */
+        double parameter{0};          /**< Parameter of closest point on edge */
+    };
+
+    FT_Outline_MoveToFunc _moveToFunc{nullptr};   /**< Freetype moveTo function */
+    FT_Outline_LineToFunc _lineToFunc{nullptr};   /**< Freetype lineTo function */
+    FT_Outline_ConicToFunc _conicToFunc{nullptr}; /**< Freetype conicTo function */
+    FT_Outline_CubicToFunc _cubicToFunc{nullptr}; /**< Freetype cubicTo function */
+
+    std::vector<std::vector<Edge>> _contours{}; /**< Contours of currently generated glyph */
+    glm::dvec2 _lastPoint{0, 0};                /**< Last processed point of outline */
+
+public:
+    MsdfGenerator();
+    ~MsdfGenerator() = default;
+
+    Bitmap generate(uint32_t glyphId, std::shared_ptr<Font> font, unsigned int pixelSize);
+
+protected:
+    void _colorEdges(std::vector<Edge> &contour) const;
+
+    SignedDistance _getSignedDistance(const Edge &edge, glm::dvec2 point, double &parameter) const;
+    double _getPseudoDistance(const Edge &edge, glm::dvec2 point, SignedDistance distance, double parameter) const;
+    glm::dvec2 _getDirection(const Edge &edge, double parameter) const;
+
+    static bool _isCorner(glm::dvec2 a, glm::dvec2 b);
+    static double _cross(glm::dvec2 a, glm::dvec2 b);
+    static double _median(double a, double b, double c);
+    static int _solveCubic(std::array<double, 3> &roots, double a, double b, double c, double d);
+    static int _solveQuadratic(std::array<double, 3> &roots, double a, double b, double c);
+    static uint8_t _encodeDistance(double distance, double range);
+};
+
+}  // namespace vft
@@ -16,6 +16,7 @@
 
 #include "circular_dll.h"
 #include "edge.h"
+#include "profiler.h"
 
 namespace vft {
 
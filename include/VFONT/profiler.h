@@ -0,0 +1,96 @@
+/**
+ * @file profiler.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(VFONT_PROFILING)
+#define VFONT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VFONT_PROFILE_CONCAT(a, b) VFONT_PROFILE_CONCAT_IMPL(a, b)
+/** Measures time spent in the rest of the enclosing scope */
+#define VFONT_PROFILE_ZONE(name) vft::ProfilerZone VFONT_PROFILE_CONCAT(vftProfilerZone, __LINE__)(name)
+/** Increases named counter by given value */
+#define VFONT_PROFILE_COUNTER(name, value) vft::Profiler::addCounter(name, value)
+#else
+#define VFONT_PROFILE_ZONE(name)
+#define VFONT_PROFILE_COUNTER(name, value)
+#endif
+
+namespace vft {
+
+/**
+ * @brief Collects cpu time spent in named zones and values of named counters, the results can be exported to chrome
+ * trace json format. Zones and counters are only recorded if the library is built with VFONT_PROFILING defined
+ */
+class Profiler {
+protected:
+    /**
+     * @brief Time spent in one zone
+     */
+    struct Zone {
+        const char *name{nullptr}; /**< Name of zone */
+        int64_t start{0};          /**< Start of zone in microseconds since the start of profiling */
+        int64_t duration{0};       /**< Duration of zone in microseconds */
+        unsigned int thread{0};    /**< Index of thread which executed zone */
+    };
+
+    /**
+     * @brief Value of counter after it was increased
+     */
+    struct CounterSample {
+        const char *name{nullptr}; /**< Name of counter */
+        int64_t time{0};           /**< Time of change in microseconds since the start of profiling */
+        uint64_t value{0};         /**< Value of counter after change */
+    };
+
+    static std::mutex _mutex;                                      /**< Guards all recorded data */
+    static std::chrono::steady_clock::time_point _epoch;           /**< Start of profiling */
+    static std::vector<Zone> _zones;                               /**< Recorded zones */
+    static std::vector<CounterSample> _counterSamples;             /**< Recorded changes of counters */
+    static std::map<std::string, uint64_t> _counters;              /**< Current values of counters */
+    static std::map<std::thread::id, unsigned int> _threadIndices; /**< Small indices of threads */
+
+public:
+    static void addZone(const char *name,
+                        std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end);
+    static void addCounter(const char *name, uint64_t value);
+
+    static std::map<std::string, uint64_t> getCounters();
+    static std::map<std::string, double> getZoneTimes();
+
+    static void reset();
+    static void writeChromeTrace(const std::string &fileName);
+
+protected:
+    static int64_t _getTime(std::chrono::steady_clock::time_point time);
+    static std::string _escape(const char *text);
+};
+
+/**
+ * @brief Records time between its construction and destruction as a zone of profiler
+ */
+class ProfilerZone {
+protected:
+    const char *_name{nullptr};                     /**< Name of zone */
+    std::chrono::steady_clock::time_point _start{}; /**< Time when zone was entered */
+
+public:
+    explicit ProfilerZone(const char *name);
+    ProfilerZone(const ProfilerZone &) = delete;
+    ProfilerZone &operator=(const ProfilerZone &) = delete;
+    ~ProfilerZone();
+};
+
+}  // namespace vft
@@ -0,0 +1,90 @@
+/**
+ * @file sdf_generator.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/vec2.hpp>
+
+#include "glyph.h"
+#include "profiler.h"
+#include "winding_number_tessellator.h"
+
+namespace vft {
+
+/**
+ * @brief Generates signed distance fields of glyphs composed by the winding number tessellator. Distances to line
+ * segments and quadratic bezier curves are computed exactly for a row of LANES pixels at once, and only segments
+ * closer than the spread to a cell of pixels are tested. Signs are given by the nonzero winding rule
+ */
+class SdfGenerator {
+public:
+    /** Number of neighbouring pixels in a row whose distances are computed together */
+    static constexpr unsigned int LANES = 8;
+    /** Width and height in pixels of one cell of the spatial grid of segments */
+    static constexpr unsigned int CELL_SIZE = LANES;
+    /** Default distance range in pixels, same as the default spread of the freetype sdf rasterizer */
+    static constexpr unsigned int SPREAD = 8;
+
+    /**
+     * @brief Signed distance field of one glyph
+     */
+    struct Bitmap {
+        unsigned int width{0};         /**< Width of bitmap in pixels */
+        unsigned int height{0};        /**< Height of bitmap in pixels */
+        std::vector<uint8_t> pixels{}; /**< Distances from top left corner, 128 is the edge and inside is brighter */
+    };
+
+protected:
+    /**
+     * @brief Segment transformed to pixel coordinates of bitmap
+     */
+    struct Segment {
+        glm::vec2 start{0, 0};   /**< Start point */
+        glm::vec2 control{0, 0}; /**< Control point, unused by line segments */
+        glm::vec2 end{0, 0};     /**< End point */
+    };
+
+    std::vector<Segment> _lines{};  /**< Line segments of currently generated glyph */
+    std::vector<Segment> _curves{}; /**< Y-monotonic curve segments of currently generated glyph */
+
+    std::vector<std::vector<uint32_t>> _cellLines{};  /**< Indices of lines closer than spread to each grid cell */
+    std::vector<std::vector<uint32_t>> _cellCurves{}; /**< Indices of curves closer than spread to each grid cell */
+
+    std::vector<std::pair<float, float>> _crossings{}; /**< Intersections of current row with segments and windings */
+
+public:
+    SdfGenerator() = default;
+    ~SdfGenerator() = default;
+
+    Bitmap generate(const Glyph &glyph, glm::vec2 scale, unsigned int spread = SPREAD);
+    Bitmap generate(const Glyph &glyph, glm::vec2 scale, glm::vec2 min, glm::vec2 max, float spread);
+
+protected:
+    void _createGrid(unsigned int columns, unsigned int rows, float spread);
+    void _findCrossings(float y);
+
+    static void _getLineDistances(const Segment &line,
+                                  const std::array<float, LANES> &x,
+                                  float y,
+                                  std::array<float, LANES> &distances);
+    static void _getCurveDistances(const Segment &curve,
+                                   const std::array<float, LANES> &x,
+                                   float y,
+                                   std::array<float, LANES> &distances);
+    static uint8_t _encodeDistance(float distance, float spread);
+};
+
+}  // namespace vft
@@ -13,6 +13,7 @@
 #include "font.h"
 #include "glyph.h"
 #include "glyph_mesh.h"
+#include "profiler.h"
 #include "tessellator.h"
 
 namespace vft {
@@ -28,7 +29,9 @@ public:
     SdfTessellator();
     ~SdfTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    std::shared_ptr<const Glyph> composeGlyph(uint32_t glyphId,
+                                              std::shared_ptr<vft::Font> font,
+                                              unsigned int fontSize = 0) override;
 };
 
 }  // namespace vft
@@ -16,6 +16,7 @@
 
 #include "font_atlas.h"
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "sdf_tessellator.h"
 #include "text_renderer.h"
 
@@ -26,6 +27,9 @@ namespace vft {
  */
 class SdfTextRenderer : public virtual TextRenderer {
 public:
+    /** Number of vertices of glyph's bounding box, vertices of the next tier of font atlas follow after them */
+    static constexpr uint32_t BOUNDING_BOX_VERTEX_COUNT = 4;
+
     /**
      * @brief Index count and offset of glyph indices in index buffers
      */
@@ -13,6 +13,7 @@
 #include <hb.h>
 
 #include "font.h"
+#include "profiler.h"
 #include "unicode.h"
 
 namespace vft {
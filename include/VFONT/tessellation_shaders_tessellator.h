@@ -18,6 +18,7 @@
 #include "glyph_compositor.h"
 #include "glyph_mesh.h"
 #include "polygon_operator.h"
+#include "profiler.h"
 #include "tessellator.h"
 
 namespace vft {
@@ -41,7 +42,9 @@ public:
     TessellationShadersTessellator();
     ~TessellationShadersTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    std::shared_ptr<const Glyph> composeGlyph(uint32_t glyphId,
+                                              std::shared_ptr<vft::Font> font,
+                                              unsigned int fontSize = 0) override;
 
 protected:
     bool _isOnLeftSide(const glm::vec2 &lineStartingPoint, const glm::vec2 &lineEndingPoint, const glm::vec2 &point);
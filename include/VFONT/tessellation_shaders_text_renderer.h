@@ -11,7 +11,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include <glm/ext/vector_int2_sized.hpp>
+
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "tessellation_shaders_tessellator.h"
 #include "text_renderer.h"
 
@@ -30,6 +33,7 @@ public:
         uint32_t lineSegmentsCount;   /**< Count of the glyph's line segments indices */
         uint32_t curveSegmentsOffset; /**< Offset in the glyph's curve segments index buffer */
         uint32_t curveSegmentsCount;  /**< Count of the glyph's curve segments indices */
+        int32_t vertexOffset;         /**< Offset in the vertex buffer added to the glyph's indices */
     };
 
 protected:
@@ -39,9 +43,9 @@ protected:
      */
     std::unordered_map<GlyphKey, GlyphInfo, GlyphKeyHash> _offsets{};
 
-    std::vector<glm::vec2> _vertices{};            /**< Vertex buffer */
-    std::vector<uint32_t> _lineSegmentsIndices{};  /**< Index buffer */
-    std::vector<uint32_t> _curveSegmentsIndices{}; /**< Index buffer */
+    std::vector<glm::i16vec2> _vertices{};         /**< Vertex buffer in font units */
+    std::vector<uint16_t> _lineSegmentsIndices{};  /**< Index buffer, relative to the glyph's vertex offset */
+    std::vector<uint16_t> _curveSegmentsIndices{}; /**< Index buffer, relative to the glyph's vertex offset */
 
 public:
     TessellationShadersTextRenderer();
@@ -0,0 +1,15 @@
+/**
+ * @file tessellation_strategy.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+namespace vft {
+
+/**
+ * @brief Lists all available algorithms for rendering text
+ */
+enum class TessellationStrategy { SDF, TRIANGULATION, TESSELLATION_SHADERS, WINDING_NUMBER };
+
+}  // namespace vft
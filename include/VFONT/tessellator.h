@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <ft2build.h>
@@ -38,16 +39,23 @@ protected:
     uint32_t lastVertexIndex{0};         /**< Index of last processed vertex */
     unsigned int contourCount{0};        /**< Number of processed contours */
 
+    std::vector<glm::vec2> _vertices{};  /**< Outline vertices of currently composed glyph, reused between glyphs */
+    std::vector<Edge> _lineSegments{};   /**< Line segments of currently composed glyph, reused between glyphs */
+    std::vector<Curve> _curveSegments{}; /**< Curve segments of currently composed glyph, reused between glyphs */
+
     Glyph _currentGlyph{}; /**< Glyph that is currently being composed */
 
 public:
     Tessellator();
     ~Tessellator() = default;
 
-    virtual Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) = 0;
+    virtual std::shared_ptr<const Glyph> composeGlyph(uint32_t glyphId,
+                                                      std::shared_ptr<vft::Font> font,
+                                                      unsigned int fontSize = 0) = 0;
 
 protected:
-    Glyph _composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font);
+    void _composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font);
+    std::shared_ptr<const Glyph> _releaseGlyph();
     uint32_t _getVertexIndex(const glm::vec2 &vertex);
 };
 
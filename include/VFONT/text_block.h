@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <iostream>
@@ -20,15 +21,26 @@
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
+#include "bounding_box.h"
 #include "character.h"
 #include "font.h"
 #include "line_divider.h"
+#include "profiler.h"
 #include "shaper.h"
 #include "text_align_strategy.h"
 #include "text_segment.h"
 
 namespace vft {
 
+/**
+ * @brief Characters on one line of text block and their bounding box
+ */
+typedef struct {
+    unsigned int start;      /**< Index of first character on line */
+    unsigned int count;      /**< Number of characters on line */
+    BoundingBox boundingBox; /**< Bounding box of line in world space */
+} LineBoundingBox;
+
 /**
  * @brief Groups together characters which are rendered
  */
@@ -50,6 +62,11 @@ protected:
     std::list<TextSegment> _segments{}; /**< Text segments which include characters to render */
     LineDivider _lineDivider{};         /**< Used to divide characters into lines */
 
+    std::vector<LineBoundingBox> _lineBoundingBoxes{}; /**< Bounding boxes of lines */
+    BoundingBox _boundingBox{};                        /**< Bounding box of all lines */
+
+    uint64_t _version{0}; /**< Incremented whenever characters, their transforms or color change */
+
 public:
     TextBlock();
 
@@ -97,6 +114,7 @@ public:
     void setTextAlign(std::unique_ptr<TextAlignStrategy> textAlign);
 
     std::vector<Character> getCharacters();
+    std::vector<Character> getCharacters(unsigned int start, unsigned int count);
     unsigned int getCharacterCount();
     std::u32string getUtf32Text();
     unsigned int getCodePointCount();
@@ -108,12 +126,16 @@ public:
     glm::vec3 getPosition() const;
     glm::mat4 getTransform() const;
     int getWidth() const;
+    const BoundingBox &getBoundingBox() const;
+    const std::vector<LineBoundingBox> &getLineBoundingBoxes() const;
+    uint64_t getVersion() const;
 
 protected:
     void _updateCharacters();
     void _updateTransform();
 
     void _updateCharacterPositions(unsigned int start);
+    void _updateBoundingBoxes();
     std::list<TextSegment>::iterator _mergeSegmentsIfPossible(std::list<TextSegment>::iterator first,
                                                               std::list<TextSegment>::iterator second);
 
@@ -7,23 +7,22 @@
 
 #include <cstdint>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <vector>
 
 #include <glm/mat4x4.hpp>
 
+#include "bounding_volume_hierarchy.h"
 #include "font_atlas.h"
 #include "glyph_cache.h"
+#include "tessellation_strategy.h"
 #include "tessellator.h"
 #include "text_block.h"
+#include "view_frustum.h"
 
 namespace vft {
 
-/**
- * @brief Lists all available algorithms for rendering text
- */
-enum class TessellationStrategy { SDF, TRIANGULATION, TESSELLATION_SHADERS, WINDING_NUMBER };
-
 /**
  * @brief Uniform buffer object
  */
@@ -49,6 +48,11 @@ protected:
     std::shared_ptr<GlyphCache> _cache{nullptr}; /**< Glyph cache stores glyphs and reads them before rendering */
     std::unique_ptr<Tessellator> _tessellator{nullptr}; /**< Tessellator to compose glyphs for rendering */
 
+    bool _cpuCulling{true};                              /**< Skip text blocks and lines outside of view frustum */
+    ViewFrustum _viewFrustum{};                          /**< View frustum of current uniform buffer object */
+    BoundingVolumeHierarchy _textBlockHierarchy{};       /**< Hierarchy of text block bounding boxes */
+    std::vector<uint64_t> _textBlockHierarchyVersions{}; /**< Versions of text blocks the hierarchy was built from */
+
 public:
     TextRenderer();
     virtual ~TextRenderer() = default;
@@ -61,6 +65,11 @@ public:
     virtual void setUniformBuffers(UniformBufferObject ubo);
     virtual void setViewportSize(unsigned int width, unsigned int height);
     virtual void setCache(std::shared_ptr<GlyphCache> cache);
+    virtual void setCpuCulling(bool cpuCulling);
+
+protected:
+    std::vector<unsigned int> _getVisibleTextBlocks();
+    std::vector<bool> _getVisibleLines();
 };
 
 }  // namespace vft
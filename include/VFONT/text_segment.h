@@ -14,6 +14,7 @@
 
 #include "character.h"
 #include "font.h"
+#include "profiler.h"
 #include "shaper.h"
 
 namespace vft {
@@ -22,7 +22,9 @@
 #include "glyph_cache.h"
 #include "glyph_compositor.h"
 #include "glyph_mesh.h"
+#include "mesh_optimizer.h"
 #include "polygon_operator.h"
+#include "profiler.h"
 #include "tessellator.h"
 
 namespace vft {
@@ -42,11 +44,20 @@ protected:
     std::vector<CircularDLL<Edge>> _firstPolygon{};  /**< Polygon containing processed glyph contours */
     std::vector<CircularDLL<Edge>> _secondPolygon{}; /**< Polygon containing current contour */
 
+    bool _optimizeMesh{false}; /**< Indicates whether triangles and vertices are reordered for the vertex cache */
+    VertexCacheStatistics _vertexCacheStatistics{}; /**< Vertex cache statistics of all optimized glyphs */
+
 public:
     TriangulationTessellator();
     ~TriangulationTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    std::shared_ptr<const Glyph> composeGlyph(uint32_t glyphId,
+                                              std::shared_ptr<vft::Font> font,
+                                              unsigned int fontSize = 0) override;
+
+    void setMeshOptimization(bool optimizeMesh);
+    bool getMeshOptimization() const;
+    const VertexCacheStatistics &getVertexCacheStatistics() const;
 
 protected:
     std::set<float> _subdivideQuadraticBezier(const std::array<glm::vec2, 3> curve);
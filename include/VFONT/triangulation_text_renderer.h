@@ -5,15 +5,18 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
-#include <glm/vec2.hpp>
+#include <glm/ext/vector_int2_sized.hpp>
+#include <glm/vec4.hpp>
 
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "text_renderer.h"
 #include "triangulation_tessellator.h"
 
@@ -33,6 +36,8 @@ public:
     struct GlyphInfo {
         uint32_t indicesOffset; /**< Offset in the glyph's triangle index buffer */
         uint32_t indicesCount;  /**< Count of the glyph's triangle indices */
+        int32_t vertexOffset;   /**< Offset in the vertex buffer added to the glyph's indices */
+        glm::vec4 boundingBox;  /**< Bounding box of glyph in font units (min x, min y, max x, max y) */
     };
 
 protected:
@@ -42,14 +47,17 @@ protected:
      */
     std::unordered_map<GlyphKey, GlyphInfo, GlyphKeyHash> _offsets{};
 
-    std::vector<glm::vec2> _vertices{}; /**< Vertex buffer */
-    std::vector<uint32_t> _indices{};   /**< Index buffer */
+    std::vector<glm::i16vec2> _vertices{}; /**< Vertex buffer in font units */
+    std::vector<uint16_t> _indices{};      /**< Index buffer, indices are relative to the glyph's vertex offset */
 
 public:
     TriangulationTextRenderer();
     virtual ~TriangulationTextRenderer() = default;
 
     void update() override;
+
+    void setMeshOptimization(bool optimizeMesh);
+    const VertexCacheStatistics &getVertexCacheStatistics() const;
 };
 
 }  // namespace vft
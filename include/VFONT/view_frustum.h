@@ -0,0 +1,32 @@
+/**
+ * @file view_frustum.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <array>
+
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "bounding_box.h"
+
+namespace vft {
+
+/**
+ * @brief View volume of camera bounded by six planes, used to skip geometry which is not visible
+ */
+class ViewFrustum {
+protected:
+    std::array<glm::vec4, 6> _planes{}; /**< Planes in world space, normals point inside of frustum */
+
+public:
+    ViewFrustum();
+    explicit ViewFrustum(const glm::mat4 &viewProjection);
+
+    bool intersects(const BoundingBox &boundingBox) const;
+};
+
+}  // namespace vft
@@ -0,0 +1,114 @@
+/**
+ * @file vulkan_gpu_timer.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace vft {
+
+/**
+ * @brief Rolling statistics of one timing scope, times are in microseconds
+ */
+struct TimingStatistics {
+    double min{0};               /**< Shortest measured time */
+    double average{0};           /**< Average measured time */
+    double p99{0};               /**< 99th percentile of measured times */
+    double last{0};              /**< Most recently measured time */
+    unsigned int sampleCount{0}; /**< Number of samples the statistics are computed from */
+};
+
+/**
+ * @brief Pipeline statistics of the last measured frame
+ */
+struct PipelineStatistics {
+    uint64_t inputAssemblyPrimitives{0};                 /**< Number of primitives assembled from vertices */
+    uint64_t vertexShaderInvocations{0};                 /**< Number of vertex shader invocations */
+    uint64_t clippingPrimitives{0};                      /**< Number of primitives output by clipping */
+    uint64_t fragmentShaderInvocations{0};               /**< Number of fragment shader invocations */
+    uint64_t tessellationEvaluationShaderInvocations{0}; /**< Number of tessellation evaluation shader invocations */
+};
+
+/**
+ * @brief Measures named scopes of command buffers with timestamp queries. Every frame in flight has its own query
+ * pools, results are read back without waiting when the pools are reused, which happens after the gpu finished the
+ * frame
+ */
+class VulkanGpuTimer {
+public:
+    /** Maximum number of timestamps written in one frame, each scope uses two timestamps */
+    static constexpr uint32_t MAX_TIMESTAMPS = 64;
+    /** Number of most recent samples of each scope used to compute statistics */
+    static constexpr unsigned int SAMPLE_COUNT = 256;
+
+protected:
+    /**
+     * @brief Named range of commands measured by two timestamps
+     */
+    struct Scope {
+        std::string name{};     /**< Name of scope */
+        uint32_t beginQuery{0}; /**< Index of timestamp written at the start of scope */
+        uint32_t endQuery{0};   /**< Index of timestamp written at the end of scope */
+    };
+
+    /**
+     * @brief Queries of one frame in flight
+     */
+    struct Frame {
+        VkQueryPool timestampPool{nullptr};  /**< Vulkan query pool with timestamps */
+        VkQueryPool statisticsPool{nullptr}; /**< Vulkan query pool with pipeline statistics or nullptr */
+        std::vector<Scope> scopes{};         /**< Scopes recorded in frame */
+        uint32_t timestampCount{0};          /**< Number of timestamps written in frame */
+        bool hasStatistics{false};           /**< Whether pipeline statistics were recorded in frame */
+        bool isPending{false};               /**< Whether results of frame were not read yet */
+    };
+
+    VkDevice _logicalDevice{nullptr}; /**< Vulkan logical device */
+    double _timestampPeriod{1};       /**< Nanoseconds per timestamp tick */
+
+    std::vector<Frame> _frames{};            /**< Queries of all frames in flight */
+    uint32_t _frameIndex{0};                 /**< Number of started frames */
+    Frame *_currentFrame{nullptr};           /**< Frame being recorded or nullptr if no frame is recorded */
+    VkCommandBuffer _commandBuffer{nullptr}; /**< Command buffer of frame being recorded */
+    std::vector<int> _openScopes{};          /**< Indices of open scopes, -1 if scope did not fit into query pool */
+
+    std::map<std::string, std::deque<double>> _samples{}; /**< Most recent samples of scopes in microseconds */
+    PipelineStatistics _pipelineStatistics{};             /**< Pipeline statistics of last measured frame */
+
+public:
+    VulkanGpuTimer(VkPhysicalDevice physicalDevice,
+                   VkDevice logicalDevice,
+                   uint32_t frameCount,
+                   bool pipelineStatistics = false);
+    VulkanGpuTimer(const VulkanGpuTimer &) = delete;
+    VulkanGpuTimer &operator=(const VulkanGpuTimer &) = delete;
+    ~VulkanGpuTimer();
+
+    void beginFrame(VkCommandBuffer commandBuffer, uint32_t framesInFlight);
+    void endFrame();
+
+    void beginScope(const std::string &name);
+    void endScope();
+    void beginPipelineStatistics();
+    void endPipelineStatistics();
+    void addSample(const std::string &name, double microseconds);
+
+    std::map<std::string, TimingStatistics> getTimingStatistics() const;
+    PipelineStatistics getPipelineStatistics() const;
+
+protected:
+    void _collectResults(Frame &frame);
+};
+
+}  // namespace vft
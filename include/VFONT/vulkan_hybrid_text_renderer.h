@@ -0,0 +1,112 @@
+﻿/**
+ * @file vulkan_hybrid_text_renderer.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+#include <glm/mat4x4.hpp>
+
+#include "font_atlas.h"
+#include "glyph_cache.h"
+#include "profiler.h"
+#include "text_block.h"
+#include "vulkan_sdf_text_renderer.h"
+#include "vulkan_text_renderer.h"
+#include "vulkan_triangulation_text_renderer.h"
+#include "vulkan_winding_number_text_renderer.h"
+
+namespace vft {
+
+/**
+ * @brief Vulkan text renderer which draws every character with the strategy suited to its projected size. Small
+ * characters are drawn using sdfs, medium characters using the winding number algorithm and large characters using
+ * triangulation. Every backend renderer tracks all text blocks, so characters switch strategies without uploads, and
+ * characters are assigned again every frame
+ */
+class VulkanHybridTextRenderer : public VulkanTextRenderer {
+public:
+    /** Number of backend renderers */
+    static constexpr unsigned int BACKEND_COUNT = 3;
+
+    /**
+     * @brief Projected sizes of em square in pixels where characters switch strategies
+     */
+    struct Thresholds {
+        float sdfMaxSize{64.f};            /**< Larger characters are not drawn using sdfs */
+        float windingNumberMaxSize{192.f}; /**< Larger characters are drawn using triangulation */
+        float hysteresis{0.15f};           /**< Relative distance past a threshold a character must reach to switch */
+    };
+
+protected:
+    /**
+     * @brief Data of character needed to compute its projected size
+     */
+    struct CharacterSize {
+        glm::mat4 model{1.f}; /**< Model matrix of character */
+        float emSize{0};      /**< Size of em square in font units */
+    };
+
+    /** Backend of characters which were not assigned yet */
+    static constexpr uint8_t UNASSIGNED = BACKEND_COUNT;
+
+    /** Backend renderers ordered by the projected size of characters they draw, from the smallest */
+    std::array<std::unique_ptr<VulkanTextRenderer>, BACKEND_COUNT> _backends{};
+    Thresholds _thresholds{}; /**< Projected sizes where characters switch strategies */
+
+    std::vector<CharacterSize> _characterSizes{};                       /**< Sizes of characters of all text blocks */
+    std::vector<uint8_t> _assignments{};                                /**< Index of backend drawing each character */
+    std::array<std::vector<bool>, BACKEND_COUNT> _characterMasks{};     /**< Characters drawn by each backend */
+    std::array<unsigned int, BACKEND_COUNT> _assignedCharacterCounts{}; /**< Number of characters of each backend */
+
+public:
+    VulkanHybridTextRenderer(VkPhysicalDevice physicalDevice,
+                             VkDevice logicalDevice,
+                             VkQueue graphicsQueue,
+                             VkCommandPool commandPool,
+                             VkRenderPass renderPass,
+                             VkCommandBuffer commandBuffer = nullptr,
+                             VkPipelineCache pipelineCache = nullptr,
+                             const VkPhysicalDeviceFeatures &enabledFeatures = {});
+    ~VulkanHybridTextRenderer() override = default;
+
+    void add(std::shared_ptr<TextBlock> text) override;
+    void prepare() override;
+    void draw() override;
+    std::vector<VkSemaphore> takeTransferSemaphores() override;
+    void update() override;
+
+    void addFontAtlas(const FontAtlas &atlas) override;
+
+    void setUniformBuffers(UniformBufferObject ubo) override;
+    void setViewportSize(unsigned int width, unsigned int height) override;
+    void setCache(std::shared_ptr<GlyphCache> cache) override;
+    void setCpuCulling(bool cpuCulling) override;
+
+    void setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) override;
+    void setTransferQueue(VkQueue transferQueue,
+                          VkCommandPool transferCommandPool,
+                          uint32_t transferQueueFamilyIndex,
+                          uint32_t graphicsQueueFamilyIndex) override;
+    void setFramesInFlight(uint32_t framesInFlight) override;
+    void setGpuTimer(VulkanGpuTimer *gpuTimer) override;
+    void setSecondaryCommandBuffers(bool secondaryCommandBuffers) override;
+    void setThresholds(Thresholds thresholds);
+
+    VulkanMemoryStatistics getMemoryStatistics() override;
+    Thresholds getThresholds() const;
+    std::array<unsigned int, BACKEND_COUNT> getAssignedCharacterCounts() const;
+
+protected:
+    void _compileDrawRecords() override;
+    void _assignCharacters();
+};
+
+}  // namespace vft
@@ -0,0 +1,97 @@
+/**
+ * @file vulkan_memory_allocator.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace vft {
+
+/**
+ * @brief Range of vulkan device memory sub-allocated from a larger memory block
+ */
+struct VulkanMemoryAllocation {
+    VkDeviceMemory memory{nullptr}; /**< Vulkan memory block containing the allocation */
+    VkDeviceSize offset{0};         /**< Offset of allocation in memory block */
+    VkDeviceSize size{0};           /**< Size of allocation in bytes */
+    void *mapped{nullptr};          /**< Pointer to mapped allocation or nullptr if memory is not host visible */
+};
+
+/**
+ * @brief Statistics of vulkan memory allocator
+ */
+struct VulkanMemoryStatistics {
+    uint32_t blockCount{0};             /**< Number of currently allocated memory blocks */
+    uint32_t allocationCount{0};        /**< Number of currently sub-allocated ranges */
+    VkDeviceSize blockBytes{0};         /**< Total size of allocated memory blocks */
+    VkDeviceSize allocatedBytes{0};     /**< Total size of sub-allocated ranges */
+    uint64_t deviceAllocationCount{0};  /**< Number of vkAllocateMemory calls since creation of allocator */
+    uint64_t deviceFreeCount{0};        /**< Number of vkFreeMemory calls since creation of allocator */
+    uint64_t totalAllocationCount{0};   /**< Number of sub-allocations since creation of allocator */
+    uint32_t peakBlockCount{0};         /**< Highest number of memory blocks allocated at once */
+    VkDeviceSize peakAllocatedBytes{0}; /**< Highest number of sub-allocated bytes at once */
+};
+
+/**
+ * @brief Sub-allocates vulkan buffers from a few large memory blocks, each block manages its free ranges in a free list
+ * ordered by offset so that neighbouring free ranges are merged when memory is freed
+ */
+class VulkanMemoryAllocator {
+public:
+    /** Size of memory blocks allocated from vulkan, larger allocations get their own block */
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+protected:
+    /**
+     * @brief Memory block allocated from vulkan
+     */
+    struct Block {
+        VkDeviceMemory memory{nullptr};                    /**< Vulkan device memory */
+        VkDeviceSize size{0};                              /**< Size of memory block */
+        uint32_t memoryTypeIndex{0};                       /**< Vulkan memory type of block */
+        void *mapped{nullptr};                             /**< Persistently mapped memory if host visible */
+        std::map<VkDeviceSize, VkDeviceSize> freeRanges{}; /**< Free ranges of block (key: offset, value: size) */
+        uint32_t allocationCount{0};                       /**< Number of ranges allocated from block */
+    };
+
+    VkPhysicalDevice _physicalDevice{nullptr}; /**< Vulkan physical device */
+    VkDevice _logicalDevice{nullptr};          /**< Vulkan logical device */
+
+    VkPhysicalDeviceMemoryProperties _memoryProperties{}; /**< Memory properties of physical device */
+    VkDeviceSize _blockSize{DEFAULT_BLOCK_SIZE};          /**< Size of memory blocks */
+
+    std::vector<std::unique_ptr<Block>> _blocks{}; /**< Allocated memory blocks */
+    VulkanMemoryStatistics _statistics{};          /**< Allocator statistics */
+
+public:
+    VulkanMemoryAllocator(VkPhysicalDevice physicalDevice,
+                          VkDevice logicalDevice,
+                          VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);
+    VulkanMemoryAllocator(const VulkanMemoryAllocator &) = delete;
+    VulkanMemoryAllocator &operator=(const VulkanMemoryAllocator &) = delete;
+    ~VulkanMemoryAllocator();
+
+    VulkanMemoryAllocation allocate(VkMemoryRequirements requirements, VkMemoryPropertyFlags properties);
+    void free(VulkanMemoryAllocation &allocation);
+
+    uint32_t selectMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties);
+
+    VulkanMemoryStatistics getStatistics();
+
+protected:
+    Block &_createBlock(VkDeviceSize size, uint32_t memoryTypeIndex);
+    void _destroyBlock(unsigned int blockIndex);
+    bool _allocateFromBlock(Block &block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset);
+};
+
+}  // namespace vft
@@ -0,0 +1,46 @@
+/**
+ * @file vulkan_pipeline_cache.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace vft {
+
+/**
+ * @brief Vulkan pipeline cache persisted in a file. Cache data is loaded when created and saved when destroyed, data
+ * created by a different driver or device is ignored
+ */
+class VulkanPipelineCache {
+protected:
+    VkPhysicalDevice _physicalDevice{nullptr}; /**< Vulkan physical device */
+    VkDevice _logicalDevice{nullptr};          /**< Vulkan logical device */
+    VkPipelineCache _pipelineCache{nullptr};   /**< Vulkan pipeline cache */
+
+    std::string _fileName{}; /**< Path to file containing pipeline cache data */
+
+public:
+    VulkanPipelineCache(VkPhysicalDevice physicalDevice, VkDevice logicalDevice, std::string fileName);
+    VulkanPipelineCache(const VulkanPipelineCache &) = delete;
+    VulkanPipelineCache &operator=(const VulkanPipelineCache &) = delete;
+    ~VulkanPipelineCache();
+
+    void save();
+
+    VkPipelineCache getPipelineCache();
+
+protected:
+    std::vector<char> _loadCacheData();
+    bool _isCacheDataValid(const std::vector<char> &data);
+};
+
+}  // namespace vft
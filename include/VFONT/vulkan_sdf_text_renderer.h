@@ -5,18 +5,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <vulkan/vulkan.h>
+#include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
 #include "font_atlas.h"
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "sdf_tessellator.h"
 #include "sdf_text_renderer.h"
 #include "vulkan_text_renderer.h"
@@ -25,10 +31,15 @@ namespace vft {
 
 /**
  * @brief Basic implementation of vulkan text renderer where charactrers are rendered using signed distance fields
- * stored in font atlases
+ * stored in font atlases. If the logical device enables shaderSampledImageArrayDynamicIndexing, textures of all font
+ * atlases are in one descriptor array indexed by push constants, so characters of different fonts are drawn without
+ * rebinding descriptor sets. Otherwise every font atlas has its own descriptor set
  */
 class VulkanSdfTextRenderer : public VulkanTextRenderer, public SdfTextRenderer {
 public:
+    /** Maximum number of font atlases, must match the size of font atlas array in sdf array fragment shaders */
+    static constexpr uint32_t MAX_FONT_ATLASES = 16;
+
     /**
      * @brief Represents a font atlas texture containing vulkan objects used to render charcaters
      */
@@ -38,33 +49,66 @@ public:
         VkDeviceMemory memory{nullptr};         /**< Vulkan memory containing the font texture */
         VkImageView imageView{nullptr};         /**< Vulkan image view of font texture */
         VkSampler sampler{nullptr};             /**< Vulkan sampler of font texture */
-        VkDescriptorSet descriptorSet{nullptr}; /**< Vulkan descriptor set of font texure */
+        uint32_t index{0};                      /**< Index of font texture in descriptor array of font atlases */
+        VkDescriptorSet descriptorSet{nullptr}; /**< Descriptor set of font texture, null in array */
+        VkPipeline pipeline{nullptr};           /**< Vulkan pipeline matching format of font texture */
 
         FontTexture(VkImage image,
                     VkDeviceMemory memory,
                     VkImageView imageView,
                     VkSampler sampler,
-                    VkDescriptorSet descriptorSet)
-            : image{image}, memory{memory}, imageView{imageView}, sampler{sampler}, descriptorSet{descriptorSet} {}
+                    uint32_t index,
+                    VkDescriptorSet descriptorSet,
+                    VkPipeline pipeline)
+            : image{image},
+              memory{memory},
+              imageView{imageView},
+              sampler{sampler},
+              index{index},
+              descriptorSet{descriptorSet},
+              pipeline{pipeline} {}
     };
 
 protected:
+    /**
+     * @brief Push constants used by vulkan for rendering characters using sdfs
+     */
+    struct SdfPushConstants {
+        glm::mat4 model{1}; /**< Model matrix of character */
+        glm::vec4 color{1}; /**< Color of character */
+        uint32_t atlas{0};  /**< Index of font texture of character in descriptor array of font atlases */
+    };
+
+    /**
+     * @brief Data of drawn character needed to select the tier of its font atlas
+     */
+    struct TierSelection {
+        float emSize{0};                                          /**< Size of em square in font units */
+        const std::vector<unsigned int> *tierPixelSizes{nullptr}; /**< Tier pixel sizes of character's font atlas */
+    };
+
     /**
      * Hash map containing font textures of selected font atlases containng info about glyphs (key: Font family, value:
      * FontTexture object)
      */
     std::unordered_map<std::string, FontTexture> _fontTextures{};
 
-    VkBuffer _vertexBuffer{nullptr};                       /**< Vulkan vertex buffer */
-    VkDeviceMemory _vertexBufferMemory{nullptr};           /**< Vulkan vertex buffer memory */
-    VkBuffer _boundingBoxIndexBuffer{nullptr};             /**< Vulkan index buffer for bonding boxes */
-    VkDeviceMemory _boundingBoxIndexBufferMemory{nullptr}; /**< Vulkan index buffer memory for bonding boxes  */
+    VkBuffer _vertexBuffer{nullptr};                        /**< Vulkan vertex buffer */
+    VulkanMemoryAllocation _vertexBufferMemory{};           /**< Vulkan vertex buffer memory */
+    VkBuffer _boundingBoxIndexBuffer{nullptr};              /**< Vulkan index buffer for bonding boxes */
+    VulkanMemoryAllocation _boundingBoxIndexBufferMemory{}; /**< Vulkan index buffer memory for bonding boxes  */
 
     VkPipelineLayout _pipelineLayout{nullptr}; /**< Vulkan pipeline layout for rendering glyphs using sdfs */
     VkPipeline _pipeline{nullptr};             /**< Vulkan pipeline for rendering glyphs using sdfs */
+    VkPipeline _msdfPipeline{nullptr};         /**< Vulkan pipeline for rendering glyphs using multi-channel sdfs */
+    bool _bc4Supported{false};                 /**< Whether device can sample bc4 compressed font atlases */
+    bool _fontAtlasArrayEnabled{false};        /**< Whether font textures are indexed in one descriptor array */
 
     VkDescriptorSetLayout _fontAtlasDescriptorSetLayout{nullptr}; /**< Vulkan descriptor set layout for font atlases */
-    std::vector<VkDescriptorSet> _fontAtlasDescriptorSets{};      /**< Vulkan descriptor sets for font atlases */
+    VkDescriptorSet _fontAtlasDescriptorSet{nullptr};             /**< Vulkan descriptor set of all font atlases */
+
+    std::vector<SdfPushConstants> _drawInstances{}; /**< Push constants of characters in draw records */
+    std::vector<TierSelection> _tierSelections{};   /**< Tier selection data of characters in draw records */
 
 public:
     VulkanSdfTextRenderer(VkPhysicalDevice physicalDevice,
@@ -72,7 +116,9 @@ public:
                           VkQueue graphicsQueue,
                           VkCommandPool commandPool,
                           VkRenderPass renderPass,
-                          VkCommandBuffer commandBuffer = nullptr);
+                          VkCommandBuffer commandBuffer = nullptr,
+                          VkPipelineCache pipelineCache = nullptr,
+                          const VkPhysicalDeviceFeatures &enabledFeatures = {});
     virtual ~VulkanSdfTextRenderer();
 
     void draw() override;
@@ -82,14 +128,26 @@ public:
 
 protected:
     void _createVertexAndIndexBuffers();
-    void _createPipeline();
+    void _createPipeline(const std::string &fragmentShaderFile, VkPipeline &pipeline);
+    void _compileDrawRecords() override;
+    bool _selectTiers();
 
     void _createDescriptorPool() override;
     void _createFontAtlasDescriptorSetLayout();
-    VkDescriptorSet _createFontAtlasDescriptorSet(VkImageView imageView, VkSampler sampler);
-
-    void _copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
-    void _transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
+    void _createFontAtlasDescriptorSet();
+    void _updateFontAtlasDescriptorSet();
+    VkDescriptorSet _createFontTextureDescriptorSet(VkImageView imageView, VkSampler sampler);
+
+    void _copyBufferToImage(VkCommandBuffer commandBuffer,
+                            VkBuffer buffer,
+                            VkImage image,
+                            uint32_t width,
+                            uint32_t height);
+    void _transitionImageLayout(VkCommandBuffer commandBuffer,
+                                VkImage image,
+                                VkFormat format,
+                                VkImageLayout oldLayout,
+                                VkImageLayout newLayout);
 };
 
 }  // namespace vft
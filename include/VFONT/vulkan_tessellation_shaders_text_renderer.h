@@ -14,6 +14,7 @@
 #include <vulkan/vulkan.h>
 
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "tessellation_shaders_tessellator.h"
 #include "tessellation_shaders_text_renderer.h"
 #include "vulkan_text_renderer.h"
@@ -35,26 +36,30 @@ public:
     };
 
 protected:
-    VkBuffer _vertexBuffer{nullptr};             /**< Vulkan vertex buffer */
-    VkDeviceMemory _vertexBufferMemory{nullptr}; /**< Vulkan vertex buffer memory */
-    VkBuffer _lineSegmentsIndexBuffer{nullptr};  /**< Vulkan index buffer for line segments forming inner triangles */
-    VkDeviceMemory _lineSegmentsIndexBufferMemory{
-        nullptr}; /**< Vulkan index buffer memory for line segments forming inner triangles */
-    VkBuffer _curveSegmentsIndexBuffer{nullptr};             /**< Vulkan index buffer for curve segments */
-    VkDeviceMemory _curveSegmentsIndexBufferMemory{nullptr}; /**< Vulkan index buffer memory for curve segments */
+    VkBuffer _vertexBuffer{nullptr};              /**< Vulkan vertex buffer */
+    VulkanMemoryAllocation _vertexBufferMemory{}; /**< Vulkan vertex buffer memory */
+    VkBuffer _lineSegmentsIndexBuffer{nullptr};   /**< Vulkan index buffer for line segments forming inner triangles */
+    VulkanMemoryAllocation
+        _lineSegmentsIndexBufferMemory{}; /**< Vulkan index buffer memory for line segments forming inner triangles */
+    VkBuffer _curveSegmentsIndexBuffer{nullptr};              /**< Vulkan index buffer for curve segments */
+    VulkanMemoryAllocation _curveSegmentsIndexBufferMemory{}; /**< Vulkan index buffer memory for curve segments */
 
     VkPipelineLayout _lineSegmentsPipelineLayout{nullptr};  /**< Vulkan pipeline layout for glpyh's triangles */
     VkPipeline _lineSegmentsPipeline{nullptr};              /**< Vulkan pipeline for glpyh's triangles */
     VkPipelineLayout _curveSegmentsPipelineLayout{nullptr}; /**< Vulkan pipeline layout for glpyh's curve segments */
     VkPipeline _curveSegmentsPipeline{nullptr};             /**< Vulkan pipeline for glpyh's curve segments */
 
+    std::vector<CharacterPushConstants> _drawInstances{}; /**< Push constants of characters in draw records */
+
 public:
     VulkanTessellationShadersTextRenderer(VkPhysicalDevice physicalDevice,
                                           VkDevice logicalDevice,
                                           VkQueue graphicsQueue,
                                           VkCommandPool commandPool,
                                           VkRenderPass renderPass,
-                                          VkCommandBuffer commandBuffer = nullptr);
+                                          VkCommandBuffer commandBuffer = nullptr,
+                                          VkPipelineCache pipelineCache = nullptr,
+                                          const VkPhysicalDeviceFeatures &enabledFeatures = {});
     virtual ~VulkanTessellationShadersTextRenderer();
 
     void draw() override;
@@ -63,6 +68,7 @@ public:
 protected:
     void _createLineSegmentsPipeline();
     void _createCurveSegmentsPipeline();
+    void _compileDrawRecords() override;
 };
 
 }  // namespace vft
@@ -5,15 +5,27 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <vulkan/vulkan.h>
+#include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
+#include "embedded_shaders.h"
 #include "i_vulkan_text_renderer.h"
+#include "vulkan_gpu_timer.h"
+#include "vulkan_memory_allocator.h"
+#include "vulkan_upload_manager.h"
 
 namespace vft {
 
@@ -33,22 +45,140 @@ public:
  * @brief Base class for basic implementations of vulkan text renderers
  */
 class VulkanTextRenderer : public IVulkanTextRenderer {
+public:
+    /** Maximum number of frames in flight, descriptor pools reserve per-frame descriptor sets for this many frames */
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+    /** Number of characters tested for visibility by one compute shader work group */
+    static constexpr uint32_t CULLING_WORK_GROUP_SIZE = 64;
+
+    /**
+     * @brief Character tested for visibility by the culling compute shader, matches std430 layout of the shaders
+     */
+    struct CullingInstance {
+        glm::mat4 model;           /**< Model matrix of character */
+        glm::vec4 color;           /**< Color of character */
+        glm::vec4 boundingBox;     /**< Bounding box of glyph in font units (min x, min y, max x, max y) */
+        uint32_t drawCommandIndex; /**< Index of indirect draw command of character's glyph */
+        uint32_t glyphData;        /**< Renderer specific data of glyph read by the culled vertex shader */
+        uint32_t padding[2];       /**< Padding to the std430 alignment of struct */
+    };
+
+    /**
+     * @brief Push constants used by the culling compute shader
+     */
+    struct CullingPushConstants {
+        glm::mat4 viewProjection; /**< Product of projection and view matrix */
+        uint32_t instanceCount;   /**< Number of characters to test */
+    };
+
 protected:
-    VkPhysicalDevice _physicalDevice{nullptr}; /**< Vulkan physical device */
-    VkDevice _logicalDevice{nullptr};          /**< Vulkan logical device */
-    VkQueue _graphicsQueue{nullptr};           /**< Vulkan graphics queue */
-    VkCommandPool _commandPool{nullptr};       /**< Vulkan command pool */
-    VkRenderPass _renderPass{nullptr};         /**< Vulkan render pass */
-    VkCommandBuffer _commandBuffer{nullptr};   /**< Vulkan command buffer used in draw calls */
+    /**
+     * @brief Everything outside of vulkan buffers and pipelines which recorded draw commands depend on
+     */
+    struct DrawState {
+        std::vector<uint64_t> textBlockVersions{}; /**< Versions of tracked text blocks */
+        glm::mat4 viewProjection{1.f};              /**< View projection matrix used for culling on the cpu */
+        unsigned int viewportWidth{0};              /**< Viewport width */
+        unsigned int viewportHeight{0};             /**< Viewport height */
+        bool cpuCulling{false};                     /**< Whether text blocks and lines were culled on the cpu */
+        std::vector<bool> characterMask{};          /**< Characters drawn by renderer */
+
+        bool operator==(const DrawState &) const = default;
+    };
+
+    /**
+     * @brief Draw command of one character compiled after a change of text and replayed by every draw
+     */
+    struct DrawRecord {
+        VkPipeline pipeline{nullptr};           /**< Vulkan pipeline the character is drawn with */
+        VkDescriptorSet descriptorSet{nullptr}; /**< Vulkan descriptor set bound after the ubo or nullptr */
+        uint32_t indexCount{0};                 /**< Number of drawn indices */
+        uint32_t firstIndex{0};                 /**< Offset in the index buffer */
+        int32_t vertexOffset{0};                /**< Offset in the vertex buffer added to the indices */
+        uint32_t instance{0};                   /**< Index of push constants of the character */
+        uint32_t line{0};                       /**< Index of line of the character in all text blocks */
+        uint32_t character{0};                  /**< Index of the character among characters of all text blocks */
+    };
+
+    /**
+     * @brief Consecutive draw records
+     */
+    struct DrawRecordRange {
+        uint32_t first{0}; /**< Index of first draw record */
+        uint32_t count{0}; /**< Number of draw records */
+    };
+
+    VkPhysicalDevice _physicalDevice{nullptr};   /**< Vulkan physical device */
+    VkDevice _logicalDevice{nullptr};            /**< Vulkan logical device */
+    VkQueue _graphicsQueue{nullptr};             /**< Vulkan graphics queue */
+    VkCommandPool _commandPool{nullptr};         /**< Vulkan command pool */
+    VkRenderPass _renderPass{nullptr};           /**< Vulkan render pass */
+    VkCommandBuffer _commandBuffer{nullptr};     /**< Vulkan command buffer used in draw calls */
+    VkPipelineCache _pipelineCache{nullptr};     /**< Vulkan pipeline cache used when creating pipelines */
+    VkPhysicalDeviceFeatures _enabledFeatures{}; /**< Features enabled on vulkan logical device */
+
+    std::unique_ptr<VulkanMemoryAllocator> _memoryAllocator{nullptr}; /**< Allocator of memory for vulkan buffers */
+    std::unique_ptr<VulkanUploadManager> _uploadManager{nullptr};     /**< Uploads data to vulkan buffers */
 
     VkDescriptorPool _descriptorPool{nullptr}; /**< Vulkan descriptor pool */
 
     VkDescriptorSetLayout _uboDescriptorSetLayout{nullptr}; /**< Uniform buffer descriptor set layout */
     VkDescriptorSet _uboDescriptorSet{nullptr};             /**< Uniform buffer descriptor set */
 
-    VkBuffer _uboBuffer{nullptr};       /**< Vulkan buffer for the uniform buffer object */
-    VkDeviceMemory _uboMemory{nullptr}; /**< Vulkan memory for the uniform buffer object */
-    void *_mappedUbo{nullptr};          /**< Pointer to the mapped memory for the uniform buffer object */
+    VkBuffer _uboBuffer{nullptr};        /**< Vulkan buffer with one uniform buffer object per frame in flight */
+    VulkanMemoryAllocation _uboMemory{}; /**< Vulkan memory for the uniform buffer objects */
+    void *_mappedUbo{nullptr};           /**< Pointer to the mapped memory for the uniform buffer objects */
+    VkDeviceSize _uboStride{0};          /**< Distance between uniform buffer objects of consecutive frames */
+    uint32_t _uboOffset{0};              /**< Dynamic offset of uniform buffer object used by current frame */
+
+    uint32_t _framesInFlight{1};  /**< Number of frames that can be processed by the gpu concurrently */
+    uint32_t _frameSlot{0};       /**< Index of per-frame data used by current frame, set by the application */
+    bool _isFramePrepared{false}; /**< Whether prepare() already started the current frame */
+
+    VulkanGpuTimer *_gpuTimer{nullptr}; /**< Timer measuring named scopes or nullptr if not measured */
+
+    bool _useSecondaryCommandBuffers{false};          /**< Whether draw commands are reused by following frames */
+    VkCommandBuffer _recordingCommandBuffer{nullptr}; /**< Command buffer which draw commands are recorded into */
+    std::array<VkCommandBuffer, MAX_FRAMES_IN_FLIGHT>
+        _secondaryCommandBuffers{}; /**< Vulkan secondary command buffers with draw commands, one for each frame */
+    std::array<DrawState, MAX_FRAMES_IN_FLIGHT>
+        _recordedDrawStates{}; /**< State which secondary command buffer of each frame was recorded with */
+    std::array<bool, MAX_FRAMES_IN_FLIGHT>
+        _secondaryCommandBuffersOutdated{}; /**< Whether secondary command buffer of frame uses replaced objects */
+
+    std::vector<DrawRecord> _drawRecords{};      /**< Draw records sorted by pipeline and descriptor set */
+    std::vector<std::vector<DrawRecordRange>>
+        _lineDrawRecordRanges{}; /**< Draw records of every line in runs with the same pipeline and descriptor set */
+    std::vector<uint64_t> _drawRecordVersions{}; /**< Versions of text blocks the draw records were compiled from */
+    bool _drawRecordsOutdated{true};             /**< Whether draw records use replaced offsets or descriptor sets */
+    std::vector<bool> _characterMask{};          /**< Characters drawn by renderer, empty if all are drawn */
+
+    bool _gpuCulling{false};           /**< Whether characters are culled by a compute shader and drawn indirectly */
+    bool _isCullingRecorded{false};    /**< Whether prepare() recorded culling commands for current frame */
+    bool _isCulledDrawRecorded{false}; /**< Whether secondary command buffers draw characters culled on the gpu */
+    uint32_t _cullingInstanceCount{0}; /**< Number of characters tested by the culling compute shader */
+    uint32_t _drawCommandCount{0};     /**< Number of indirect draw commands, one for each glyph */
+
+    VkBuffer _instanceBuffer{nullptr};                         /**< Vulkan buffer with all characters */
+    VulkanMemoryAllocation _instanceBufferMemory{};            /**< Vulkan memory with all characters */
+    VkBuffer _visibleInstanceBuffer{nullptr};                  /**< Vulkan buffer with indices of visible characters */
+    VulkanMemoryAllocation _visibleInstanceBufferMemory{};     /**< Vulkan memory with indices of visible characters */
+    VkBuffer _drawCommandBuffer{nullptr};                      /**< Vulkan buffer with indirect draw commands */
+    VulkanMemoryAllocation _drawCommandBufferMemory{};         /**< Vulkan memory with indirect draw commands */
+    VkBuffer _drawCommandTemplateBuffer{nullptr};              /**< Indirect draw commands with zero instances */
+    VulkanMemoryAllocation _drawCommandTemplateBufferMemory{}; /**< Memory of draw commands with zero instances */
+
+    VkDescriptorSetLayout _cullingDescriptorSetLayout{nullptr}; /**< Descriptor set layout for culling buffers */
+    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT>
+        _cullingDescriptorSets{}; /**< Descriptor sets for culling buffers, one for each frame in flight */
+    std::array<bool, MAX_FRAMES_IN_FLIGHT>
+        _cullingDescriptorSetsOutdated{}; /**< Whether descriptor set of frame still points to replaced buffers */
+
+    VkPipelineLayout _cullingPipelineLayout{nullptr}; /**< Vulkan pipeline layout for culling compute shader */
+    VkPipeline _cullingPipeline{nullptr};             /**< Vulkan compute pipeline culling characters */
+    VkPipelineLayout _culledPipelineLayout{nullptr};  /**< Vulkan pipeline layout for visible characters */
+    VkPipeline _culledPipeline{nullptr};              /**< Vulkan pipeline drawing visible characters indirectly */
 
 public:
     VulkanTextRenderer(VkPhysicalDevice physicalDevice,
@@ -56,11 +186,25 @@ public:
                        VkQueue graphicsQueue,
                        VkCommandPool commandPool,
                        VkRenderPass renderPass,
-                       VkCommandBuffer commandBuffer = nullptr);
+                       VkCommandBuffer commandBuffer = nullptr,
+                       VkPipelineCache pipelineCache = nullptr,
+                       const VkPhysicalDeviceFeatures &enabledFeatures = {});
     virtual ~VulkanTextRenderer();
 
-    void setUniformBuffers(UniformBufferObject ubo) override;
-    void setCommandBuffer(VkCommandBuffer commandBuffer) override;
+    void prepare() override;
+    void draw() override;
+    std::vector<VkSemaphore> takeTransferSemaphores() override;
+
+    void setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) override;
+    void setTransferQueue(VkQueue transferQueue,
+                          VkCommandPool transferCommandPool,
+                          uint32_t transferQueueFamilyIndex,
+                          uint32_t graphicsQueueFamilyIndex) override;
+    void setFramesInFlight(uint32_t framesInFlight) override;
+    virtual void setGpuTimer(VulkanGpuTimer *gpuTimer);
+    void setSecondaryCommandBuffers(bool secondaryCommandBuffers) override;
+    void setCharacterMask(std::vector<bool> characterMask);
+    void setGpuCulling(bool gpuCulling);
 
     VkPhysicalDevice getPhysicalDevice() override;
     VkDevice getLogicalDevice() override;
@@ -68,30 +212,63 @@ public:
     VkQueue getGraphicsQueue() override;
     VkRenderPass getRenderPass() override;
     VkCommandBuffer getCommandBuffer() override;
+    uint32_t getFramesInFlight() override;
+    VkSubpassContents getSubpassContents() override;
+
+    VulkanMemoryStatistics getMemoryStatistics() override;
 
 protected:
     void _initialize();
+    void _beginFrame();
+    void _beginTimingScope(const std::string &name);
+    void _endTimingScope();
+
+    bool _beginDrawCommands();
+    void _endDrawCommands();
+    void _invalidateSecondaryCommandBuffers();
+    DrawState _getDrawState();
+
+    void _updateDrawRecords();
+    void _invalidateDrawRecords();
+    virtual void _compileDrawRecords() = 0;
+    void _createLineDrawRecordRanges();
+    std::vector<DrawRecordRange> _getVisibleDrawRecordRanges();
+    bool _isCharacterDrawn(const DrawRecord &record) const;
+    float _getProjectedSize(const glm::mat4 &model, float size) const;
+
+    virtual bool _supportsGpuCulling() const;
+    void _initializeCulling();
+    virtual void _createCulledPipeline();
+    virtual void _collectCullingInstances(std::vector<CullingInstance> &instances,
+                                          std::vector<VkDrawIndexedIndirectCommand> &drawCommands);
+    void _createCullingBuffers();
+    void _destroyCullingBuffers();
+    void _updateCullingDescriptorSet(uint32_t frameSlot);
+    void _recordCulling();
+    bool _takeCullingRecorded();
+    void _drawCulledCommands();
 
     virtual void _createDescriptorPool();
     void _createUbo();
     void _createUboDescriptorSetLayout();
     void _createUboDescriptorSet();
+    void _updateUboDescriptorSet();
 
     std::vector<char> _readFile(std::string fileName);
+    std::vector<char> _readShader(std::string fileName);
     VkShaderModule _createShaderModule(const std::vector<char> &shaderCode);
 
     void _stageAndCreateVulkanBuffer(void *data,
                                      VkDeviceSize size,
                                      VkBufferUsageFlags destinationUsage,
                                      VkBuffer &destinationBuffer,
-                                     VkDeviceMemory &destinationMemory);
+                                     VulkanMemoryAllocation &destinationMemory);
     void _createBuffer(VkDeviceSize size,
                        VkBufferUsageFlags usage,
                        VkMemoryPropertyFlags properties,
                        VkBuffer &buffer,
-                       VkDeviceMemory &bufferMemory);
-    void _copyBuffer(VkBuffer sourceBuffer, VkBuffer destinationBuffer, VkDeviceSize size);
-    void _destroyBuffer(VkBuffer &buffer, VkDeviceMemory &bufferMemory);
+                       VulkanMemoryAllocation &bufferMemory);
+    void _destroyBuffer(VkBuffer &buffer, VulkanMemoryAllocation &bufferMemory);
     uint32_t _selectMemoryType(uint32_t memoryType, VkMemoryPropertyFlags properties);
     VkCommandBuffer _beginOneTimeCommands();
     void _endOneTimeCommands(VkCommandBuffer commandBuffer);
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include <vulkan/vulkan.h>
 
@@ -29,14 +30,23 @@ public:
     virtual ~VulkanTextRendererDecorator() override;
 
     void add(std::shared_ptr<TextBlock> text) override;
+    void prepare() override;
     void draw() override;
+    std::vector<VkSemaphore> takeTransferSemaphores() override;
     void update() override;
 
     void setUniformBuffers(UniformBufferObject ubo) override;
     void setViewportSize(unsigned int width, unsigned int height) override;
     void setCache(std::shared_ptr<GlyphCache> cache) override;
+    void setCpuCulling(bool cpuCulling) override;
 
-    void setCommandBuffer(VkCommandBuffer commandBuffer) override;
+    void setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) override;
+    void setTransferQueue(VkQueue transferQueue,
+                          VkCommandPool transferCommandPool,
+                          uint32_t transferQueueFamilyIndex,
+                          uint32_t graphicsQueueFamilyIndex) override;
+    void setFramesInFlight(uint32_t framesInFlight) override;
+    void setSecondaryCommandBuffers(bool secondaryCommandBuffers) override;
 
     VkPhysicalDevice getPhysicalDevice() override;
     VkDevice getLogicalDevice() override;
@@ -44,8 +54,14 @@ public:
     VkQueue getGraphicsQueue() override;
     VkRenderPass getRenderPass() override;
     VkCommandBuffer getCommandBuffer() override;
+    uint32_t getFramesInFlight() override;
+    VkSubpassContents getSubpassContents() override;
+
+    VulkanMemoryStatistics getMemoryStatistics() override;
 
     void addFontAtlas(const FontAtlas &atlas) override;
+
+    VulkanTextRenderer *getRenderer();
 };
 
 }  // namespace vft
@@ -5,36 +5,38 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <vulkan/vulkan.h>
 
+#include "vulkan_gpu_timer.h"
 #include "vulkan_text_renderer.h"
 #include "vulkan_text_renderer_decorator.h"
 
 namespace vft {
 
 /**
- * @brief Vulkan text renderer that tracks draw time using timestamps
+ * @brief Vulkan text renderer that measures gpu time of recorded commands using timestamps. Queries are reset in
+ * prepare(), so frames are measured only if prepare() is called before the render pass begins
  */
 class VulkanTimedRenderer : public VulkanTextRendererDecorator {
 protected:
-    double _timestampPeriod{1e-9}; /**< Vulkan timestamp period */
-
-    VkQueryPool _queryPool{nullptr}; /**< Vulkan query pool to read timestamps from */
+    std::unique_ptr<VulkanGpuTimer> _gpuTimer{nullptr}; /**< Timer with query pools of all frames in flight */
+    bool _isFramePrepared{false};                       /**< Whether prepare() started measuring the current frame */
 
 public:
-    VulkanTimedRenderer(VulkanTextRenderer *renderer);
+    VulkanTimedRenderer(VulkanTextRenderer *renderer, bool pipelineStatistics = false);
     ~VulkanTimedRenderer() override;
 
+    void prepare() override;
     void draw() override;
 
-    double readTimestamps();
-    void resetQueryPool();
-
-protected:
-    double _getTimestampPeriod();
+    std::map<std::string, TimingStatistics> getTimingStatistics();
+    PipelineStatistics getPipelineStatistics();
 };
 
 }  // namespace vft
@@ -5,16 +5,21 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <vulkan/vulkan.h>
+#include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "triangulation_tessellator.h"
 #include "triangulation_text_renderer.h"
 #include "vulkan_text_renderer.h"
@@ -26,28 +31,43 @@ namespace vft {
  */
 class VulkanTriangulationTextRenderer : public VulkanTextRenderer, public TriangulationTextRenderer {
 protected:
-    VkBuffer _vertexBuffer{nullptr};             /**< Vulkan vertex buffer */
-    VkDeviceMemory _vertexBufferMemory{nullptr}; /**< Vulkan vertex buffer memory */
-    VkBuffer _indexBuffer{nullptr};              /**< Vulkan index buffer for glyph's triangles */
-    VkDeviceMemory _indexBufferMemory{nullptr};  /**< Vulkan index buffer memory for glyph's triangles */
+    VkBuffer _vertexBuffer{nullptr};              /**< Vulkan vertex buffer */
+    VulkanMemoryAllocation _vertexBufferMemory{}; /**< Vulkan vertex buffer memory */
+    VkBuffer _indexBuffer{nullptr};               /**< Vulkan index buffer for glyph's triangles */
+    VulkanMemoryAllocation _indexBufferMemory{};  /**< Vulkan index buffer memory for glyph's triangles */
 
     VkPipelineLayout _pipelineLayout{nullptr}; /**< Vulkan pipeline layout for glpyh's triangles */
     VkPipeline _pipeline{nullptr};             /**< Vulkan pipeline for glpyh's triangles */
 
+    std::vector<CharacterPushConstants> _drawInstances{}; /**< Push constants of characters in draw records */
+
 public:
     VulkanTriangulationTextRenderer(VkPhysicalDevice physicalDevice,
                                     VkDevice logicalDevice,
                                     VkQueue graphicsQueue,
                                     VkCommandPool commandPool,
                                     VkRenderPass renderPass,
-                                    VkCommandBuffer commandBuffer = nullptr);
+                                    VkCommandBuffer commandBuffer = nullptr,
+                                    VkPipelineCache pipelineCache = nullptr,
+                                    const VkPhysicalDeviceFeatures &enabledFeatures = {});
     virtual ~VulkanTriangulationTextRenderer();
 
     void draw() override;
     void update() override;
 
 protected:
+    void _createDescriptorPool() override;
     void _createPipeline();
+    void _createGraphicsPipeline(const std::string &vertexShaderFile,
+                                 VkPipelineLayout pipelineLayout,
+                                 VkPipeline &pipeline);
+    void _compileDrawRecords() override;
+
+    bool _supportsGpuCulling() const override;
+    void _createCulledPipeline() override;
+    void _collectCullingInstances(std::vector<CullingInstance> &instances,
+                                  std::vector<VkDrawIndexedIndirectCommand> &drawCommands) override;
+    void _drawCulled();
 };
 
 }  // namespace vft
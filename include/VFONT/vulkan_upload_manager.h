@@ -0,0 +1,120 @@
+/**
+ * @file vulkan_upload_manager.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "profiler.h"
+#include "vulkan_memory_allocator.h"
+
+namespace vft {
+
+/**
+ * @brief Uploads data to device local vulkan buffers without stalling the gpu. Copies are batched into one command
+ * buffer which is submitted once per frame and tracked by a fence, staging buffers and destroyed buffers are freed
+ * only after the gpu stopped using them. Copies submitted to a dedicated transfer queue signal semaphores which the
+ * application waits for in its next graphics submit, see takeTransferSemaphores()
+ */
+class VulkanUploadManager {
+protected:
+    /**
+     * @brief Copy commands submitted together in one command buffer
+     */
+    struct Batch {
+        uint64_t serial{0};                                  /**< Serial number of batch, batches are numbered from 1 */
+        VkCommandBuffer commandBuffer{nullptr};              /**< Command buffer containing copy commands */
+        VkCommandPool commandPool{nullptr};                  /**< Command pool the command buffer was allocated from */
+        VkFence fence{nullptr};                              /**< Fence signaled when batch is executed */
+        std::vector<VkBuffer> stagingBuffers{};              /**< Staging buffers used as copy sources */
+        std::vector<VulkanMemoryAllocation> stagingMemory{}; /**< Memory of staging buffers */
+    };
+
+    /**
+     * @brief Buffer which is no longer used by the renderer, but can still be used by the gpu
+     */
+    struct RetiredBuffer {
+        VkBuffer buffer{nullptr};        /**< Vulkan buffer */
+        VulkanMemoryAllocation memory{}; /**< Memory of vulkan buffer */
+        uint64_t frame{0};               /**< Last frame which could use the buffer */
+        uint64_t batchSerial{0};         /**< Last batch which could copy data into the buffer */
+    };
+
+    /**
+     * @brief Semaphore signaled by copies on the transfer queue and waited for by graphics submit of a frame
+     */
+    struct UsedSemaphore {
+        VkSemaphore semaphore{nullptr}; /**< Vulkan semaphore */
+        uint64_t frame{0};              /**< Frame whose graphics submit waits for the semaphore */
+    };
+
+    VkDevice _logicalDevice{nullptr};                 /**< Vulkan logical device */
+    VulkanMemoryAllocator *_memoryAllocator{nullptr}; /**< Allocator of memory for vulkan buffers */
+
+    VkQueue _graphicsQueue{nullptr};             /**< Vulkan graphics queue */
+    VkCommandPool _graphicsCommandPool{nullptr}; /**< Vulkan command pool of graphics queue family */
+    VkQueue _transferQueue{nullptr};             /**< Dedicated vulkan transfer queue or nullptr if not used */
+    VkCommandPool _transferCommandPool{nullptr}; /**< Vulkan command pool of transfer queue family */
+    std::vector<uint32_t> _queueFamilyIndices{}; /**< Queue families sharing buffers if transfer queue is used */
+
+    uint32_t _framesInFlight{1}; /**< Number of frames that can be processed by the gpu concurrently */
+    uint64_t _frame{0};          /**< Number of started frames */
+
+    Batch _recordingBatch{};                     /**< Batch which is being recorded */
+    std::deque<Batch> _pendingBatches{};         /**< Submitted batches not yet executed by the gpu */
+    uint64_t _submittedSerial{0};                /**< Serial number of last submitted batch */
+    uint64_t _completedSerial{0};                /**< All batches up to this serial number were executed */
+    std::vector<VkFence> _freeFences{};          /**< Fences which can be reused for next batches */
+    std::deque<RetiredBuffer> _retiredBuffers{}; /**< Buffers waiting to be destroyed */
+
+    std::vector<VkSemaphore> _transferSemaphores{}; /**< Signaled semaphores not yet taken by the application */
+    std::deque<UsedSemaphore> _usedSemaphores{};    /**< Semaphores which can still be waited for by the gpu */
+    std::vector<VkSemaphore> _freeSemaphores{};     /**< Semaphores which can be reused for next batches */
+
+public:
+    VulkanUploadManager(VkDevice logicalDevice,
+                        VkQueue graphicsQueue,
+                        VkCommandPool graphicsCommandPool,
+                        VulkanMemoryAllocator *memoryAllocator,
+                        uint32_t framesInFlight = 1);
+    VulkanUploadManager(const VulkanUploadManager &) = delete;
+    VulkanUploadManager &operator=(const VulkanUploadManager &) = delete;
+    ~VulkanUploadManager();
+
+    void upload(const void *data, VkDeviceSize size, VkBuffer destinationBuffer, VkDeviceSize destinationOffset = 0);
+    void flush();
+    void submit(VkCommandBuffer commandBuffer, VkCommandPool commandPool);
+    void beginFrame();
+    void destroyBuffer(VkBuffer &buffer, VulkanMemoryAllocation &bufferMemory);
+
+    void setTransferQueue(VkQueue transferQueue,
+                          VkCommandPool transferCommandPool,
+                          uint32_t transferQueueFamilyIndex,
+                          uint32_t graphicsQueueFamilyIndex);
+    void setFramesInFlight(uint32_t framesInFlight);
+
+    const std::vector<uint32_t> &getQueueFamilyIndices();
+    std::vector<VkSemaphore> takeTransferSemaphores();
+    uint32_t getFramesInFlight();
+
+protected:
+    void _beginBatch();
+    void _submitBatch(Batch &batch, VkQueue queue, VkSemaphore signalSemaphore);
+    VkFence _acquireFence();
+    VkSemaphore _acquireSemaphore();
+    void _collectCompletedBatches();
+    void _recycleSemaphores();
+    void _releaseBatch(Batch &batch);
+    void _destroyRetiredBuffers();
+};
+
+}  // namespace vft
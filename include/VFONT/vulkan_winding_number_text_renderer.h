@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +18,7 @@
 #include <glm/vec2.hpp>
 
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "vulkan_text_renderer.h"
 #include "winding_number_tessellator.h"
 #include "winding_number_text_renderer.h"
@@ -32,40 +35,44 @@ public:
      * @brief Vulkan push constants
      */
     struct CharacterPushConstants {
-        glm::mat4 model;                  /**< Model matrix of character */
-        glm::vec4 color;                  /**< Color of character */
-        uint32_t lineSegmentsStartIndex;  /**< Index into the ssbo where glyph's line segments start */
-        uint32_t lineSegmentsCount;       /**< Number of glyph's line segments */
-        uint32_t curveSegmentsStartIndex; /**< Index into the ssbo where glyph's curve segments start */
-        uint32_t curveSegmentsCount;      /**< Number of glyph's curve segments */
+        glm::mat4 model;             /**< Model matrix of character */
+        glm::vec4 color;             /**< Color of character */
+        uint32_t segmentsStartIndex; /**< Index into the ssbo where glyph's quantized segments start */
     };
 
 protected:
-    VkBuffer _vertexBuffer{nullptr};                       /**< Vulkan vertex buffer */
-    VkDeviceMemory _vertexBufferMemory{nullptr};           /**< Vulkan vertex buffer memory */
-    VkBuffer _boundingBoxIndexBuffer{nullptr};             /**< Vulkan index buffer for bonding boxes */
-    VkDeviceMemory _boundingBoxIndexBufferMemory{nullptr}; /**< Vulkan index buffer memory for bonding boxes  */
-    VkBuffer _segmentsBuffer{nullptr};                     /**< Vulkan vertex buffer for line and curve segments */
-    VkDeviceMemory _segmentsBufferMemory{nullptr}; /**< Vulkan vertex buffer memory for line and curve segments */
+    VkBuffer _vertexBuffer{nullptr};                        /**< Vulkan vertex buffer */
+    VulkanMemoryAllocation _vertexBufferMemory{};           /**< Vulkan vertex buffer memory */
+    VkBuffer _boundingBoxIndexBuffer{nullptr};              /**< Vulkan index buffer for bonding boxes */
+    VulkanMemoryAllocation _boundingBoxIndexBufferMemory{}; /**< Vulkan index buffer memory for bonding boxes  */
+    VkBuffer _segmentsBuffer{nullptr};                      /**< Vulkan buffer for quantized segments and bands */
+    VulkanMemoryAllocation _segmentsBufferMemory{};         /**< Vulkan memory for quantized segments and bands */
 
     VkPipelineLayout _segmentsPipelineLayout{
         nullptr};                          /**< Vulkan pipeline layout for glpyh's line and curve segments */
     VkPipeline _segmentsPipeline{nullptr}; /**< Vulkan pipeline for glpyh's line and curve segments */
 
     VkDescriptorSetLayout _segmentsDescriptorSetLayout{nullptr}; /**< Vulkan descriptor set layout for segments info */
-    VkDescriptorSet _segmentsDescriptorSet{nullptr};             /**< Vulkan descriptor set for segments info */
+    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT>
+        _segmentsDescriptorSets{}; /**< Vulkan descriptor sets for segments info, one for each frame in flight */
+    std::array<bool, MAX_FRAMES_IN_FLIGHT>
+        _segmentsDescriptorSetsOutdated{}; /**< Whether descriptor set of frame still points to replaced buffer */
 
     VkBuffer _ssbo{nullptr};             /**< Vulkan buffer containing line and curve segments of all glyphs */
     VkDeviceMemory _ssboMemory{nullptr}; /**< Vulkan memory containing line and curve segments of all glyphs */
     void *_mappedSSBO{nullptr};          /**< Pointer to the mapped memory for line and curve segments of all glyphs */
 
+    std::vector<CharacterPushConstants> _drawInstances{}; /**< Push constants of characters in draw records */
+
 public:
     VulkanWindingNumberTextRenderer(VkPhysicalDevice physicalDevice,
                                     VkDevice logicalDevice,
                                     VkQueue graphicsQueue,
                                     VkCommandPool commandPool,
                                     VkRenderPass renderPass,
-                                    VkCommandBuffer commandBuffer = nullptr);
+                                    VkCommandBuffer commandBuffer = nullptr,
+                                    VkPipelineCache pipelineCache = nullptr,
+                                    const VkPhysicalDeviceFeatures &enabledFeatures = {});
     virtual ~VulkanWindingNumberTextRenderer();
 
     void draw() override;
@@ -77,9 +84,20 @@ protected:
 
     void _createDescriptorPool() override;
     void _createSegmentsDescriptorSetLayout();
-    void _createSegmentsDescriptorSet();
+    void _createSegmentsDescriptorSets();
+    void _updateSegmentsDescriptorSet(uint32_t frameSlot);
 
     void _createSegmentsPipeline();
+    void _createGraphicsPipeline(const std::string &vertexShaderFile,
+                                 VkPipelineLayout pipelineLayout,
+                                 VkPipeline &pipeline);
+    void _compileDrawRecords() override;
+
+    bool _supportsGpuCulling() const override;
+    void _createCulledPipeline() override;
+    void _collectCullingInstances(std::vector<CullingInstance> &instances,
+                                  std::vector<VkDrawIndexedIndirectCommand> &drawCommands) override;
+    void _drawCulled();
 };
 
 }  // namespace vft
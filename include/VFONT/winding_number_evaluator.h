@@ -0,0 +1,69 @@
+/**
+ * @file winding_number_evaluator.h
+ * @author Christian Saloň
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "glyph.h"
+#include "winding_number_tessellator.h"
+
+namespace vft {
+
+/**
+ * @brief Selects which segments and which algorithm are used to compute the winding number
+ */
+enum class WindingNumberMethod {
+    OUTLINE,  /**< Original outline segments with curves solved for both roots */
+    SEGMENTS, /**< All y-monotonic segments, each solved for a single root */
+    BANDS     /**< Y-monotonic segments in the horizontal band of the position, same as the fragment shader */
+};
+
+/**
+ * @brief Reference cpu implementation of the winding number algorithm used in the winding number fragment shader.
+ * Works with glyphs composed by the winding number tessellator
+ */
+class WindingNumberEvaluator {
+public:
+    static float computeOutlineWindingNumber(const Glyph &glyph, glm::vec2 position);
+    static float computeWindingNumber(const Glyph &glyph, glm::vec2 position);
+    static float computeBandedWindingNumber(const Glyph &glyph, glm::vec2 position);
+
+    static std::vector<uint8_t> rasterize(const Glyph &glyph,
+                                          unsigned int width,
+                                          unsigned int height,
+                                          WindingNumberMethod method = WindingNumberMethod::BANDS);
+
+    static float rayIntersectsLineSegment(glm::vec2 position, glm::vec2 start, glm::vec2 end);
+    static float rayIntersectsCurveSegment(glm::vec2 position, glm::vec2 start, glm::vec2 control, glm::vec2 end);
+
+protected:
+    static float _rayIntersectsOutlineLineSegment(glm::vec2 position, glm::vec2 start, glm::vec2 end);
+    static float _rayIntersectsOutlineCurveSegment(glm::vec2 position,
+                                                   glm::vec2 start,
+                                                   glm::vec2 control,
+                                                   glm::vec2 end);
+    static float _getQuadraticDerivativeWinding(double t, double a, double b);
+    static float _getWindingForQuadraticRoot(double t,
+                                             glm::vec2 position,
+                                             glm::vec2 start,
+                                             glm::vec2 control,
+                                             glm::vec2 end,
+                                             double a,
+                                             double b);
+    static float _unpackUnorm16(uint32_t value);
+    static glm::vec2 _unpackPoint(uint32_t point);
+};
+
+}  // namespace vft
@@ -5,9 +5,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <memory>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include "curve.h"
@@ -17,6 +22,7 @@
 #include "glyph_cache.h"
 #include "glyph_compositor.h"
 #include "glyph_mesh.h"
+#include "profiler.h"
 #include "tessellator.h"
 
 namespace vft {
@@ -28,15 +34,44 @@ class WindingNumberTessellator : public Tessellator {
 public:
     /** Index of index buffer containing the bounding box in glyph's vector of index buffers */
     static constexpr unsigned int GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX = 0;
-    /** Index of index buffer containing curve segments in glyph's vector of index buffers */
+    /** Index of index buffer containing curve segments monotonic in y in glyph's vector of index buffers */
     static constexpr unsigned int GLYPH_MESH_CURVE_BUFFER_INDEX = 1;
     /** Index of index buffer containing line segments in glyph's vector of index buffers */
     static constexpr unsigned int GLYPH_MESH_LINE_BUFFER_INDEX = 2;
+    /** Index of buffer containing quantized segments split into horizontal bands in glyph's vector of index buffers */
+    static constexpr unsigned int GLYPH_MESH_SEGMENTS_BUFFER_INDEX = 3;
+    /** Index of index buffer containing unsplit curve segments of the outline in glyph's vector of index buffers */
+    static constexpr unsigned int GLYPH_MESH_OUTLINE_CURVE_BUFFER_INDEX = 4;
+
+    /** Number of values (band count, points offset, bounds min and size) preceding band ranges in segments buffer */
+    static constexpr unsigned int SEGMENTS_HEADER_SIZE = 6;
+    /** Maximum value of a quantized coordinate relative to the bounds of glyph's segments */
+    static constexpr unsigned int QUANTIZATION_SCALE = 65535;
+    /** Set in the band count of segments buffer if entries store point index and max x in two separate values */
+    static constexpr uint32_t WIDE_ENTRIES_FLAG = 1u << 31;
+    /** Maximum number of points whose indices fit into the low 16 bits of a packed entry */
+    static constexpr unsigned int MAX_PACKED_POINT_COUNT = 65536;
+    /** Marks a segment without a control point */
+    static constexpr uint32_t NO_CONTROL_POINT = UINT32_MAX;
+    /** Maximum number of horizontal bands per glyph */
+    static constexpr unsigned int MAX_BAND_COUNT = 16;
+    /** Average number of segments per band used to pick the band count of a glyph */
+    static constexpr unsigned int SEGMENTS_PER_BAND = 4;
+    /** Tolerance in band units used to also assign segments to neighbouring bands they touch */
+    static constexpr float BAND_EPSILON = 1e-3f;
 
     WindingNumberTessellator();
     ~WindingNumberTessellator() = default;
 
-    Glyph composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize = 0) override;
+    std::shared_ptr<const Glyph> composeGlyph(uint32_t glyphId,
+                                              std::shared_ptr<vft::Font> font,
+                                              unsigned int fontSize = 0) override;
+
+protected:
+    void _splitCurveAtExtremum(Curve curve, std::vector<glm::vec2> &vertices, std::vector<uint32_t> &curveIndices);
+    std::vector<uint32_t> _createSegmentsBuffer(const std::vector<glm::vec2> &vertices,
+                                                const std::vector<uint32_t> &lineIndices,
+                                                const std::vector<uint32_t> &curveIndices);
 };
 
 }  // namespace vft
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
@@ -14,8 +15,10 @@
 #include <vulkan/vulkan.h>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
 #include "glyph_cache.h"
+#include "profiler.h"
 #include "text_renderer.h"
 #include "winding_number_tessellator.h"
 
@@ -38,17 +41,8 @@ public:
     struct GlyphInfo {
         uint32_t boundingBoxOffset;  /**< Offset in the glyph's bounding box index buffer */
         uint32_t boundingBoxCount;   /**< Count of the glyph's bounding box indices */
-        uint32_t segmentsInfoOffset; /**< Offset in the glyph's segments info buffer */
-    };
-
-    /**
-     * @brief Represents a glyph's information about line and curve segments stored in ssbo
-     */
-    struct SegmentsInfo {
-        uint32_t lineSegmentsStartIndex;  /**< Index into the ssbo where glyph's line segments start */
-        uint32_t lineSegmentsCount;       /**< Number of glyph's line segments */
-        uint32_t curveSegmentsStartIndex; /**< Index into the ssbo where glyph's curve segments start */
-        uint32_t curveSegmentsCount;      /**< Number of glyph's curve segments */
+        uint32_t segmentsStartIndex; /**< Index into the segments buffer where glyph's segments start */
+        glm::vec4 boundingBox;       /**< Bounding box of glyph in font units (min x, min y, max x, max y) */
     };
 
     /**
@@ -77,8 +71,7 @@ protected:
 
     std::vector<glm::vec2> _vertices{};          /**< Vertex buffer */
     std::vector<uint32_t> _boundingBoxIndices{}; /**< Index buffer containing boundig box indices */
-    std::vector<glm::vec2> _segments{};          /**< Contains line and curve segments of all glpyhs */
-    std::vector<SegmentsInfo> _segmentsInfo{};   /**< Contains segment info of all glpyhs */
+    std::vector<uint32_t> _segments{};           /**< Contains quantized segments and bands of all glyphs */
 
 public:
     WindingNumberTextRenderer();
@@ -1,6 +1,6 @@
 #version 450
 
-layout(location = 0) in vec2 inPosition;
+layout(location = 0) in ivec2 inPosition;
 
 layout(push_constant) uniform constants {
 	mat4 model;
@@ -8,5 +8,5 @@ layout(push_constant) uniform constants {
 } PushConstants;
 
 void main() {
-    gl_Position = PushConstants.model * vec4(inPosition, 0.0, 1.0);
+    gl_Position = PushConstants.model * vec4(vec2(inPosition), 0.0, 1.0);
 }
@@ -0,0 +1,25 @@
+#version 450
+
+layout(location = 0) in vec2 fragUv;
+
+layout(location = 0) out vec4 outColor;
+
+layout(push_constant) uniform constants {
+	mat4 model;
+    vec4 color;
+    uint atlas;
+} PushConstants;
+
+layout(set = 1, binding = 0) uniform sampler2D fontAtlas;
+
+float median(float r, float g, float b) {
+    return max(min(r, g), min(max(r, g), b));
+}
+
+void main() {
+    vec4 distances = texture(fontAtlas, fragUv);
+    float distance = median(distances.r, distances.g, distances.b);
+    float alpha = distance > 0.5f ? 1.f : 0.f;
+    // float alpha = smoothstep(0.4, 0.6, distance);
+    outColor = PushConstants.color * vec4(1.f, 1.f, 1.f, alpha);
+}
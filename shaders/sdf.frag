@@ -7,6 +7,7 @@ layout(location = 0) out vec4 outColor;
 layout(push_constant) uniform constants {
 	mat4 model;
     vec4 color;
+    uint atlas;
 } PushConstants;
 
 layout(set = 1, binding = 0) uniform sampler2D fontAtlas;
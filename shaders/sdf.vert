@@ -8,6 +8,7 @@ layout(location = 0) out vec2 fragUv;
 layout(push_constant) uniform constants {
 	mat4 model;
     vec4 color;
+    uint atlas;
 } PushConstants;
 
 layout(set = 0, binding = 0) uniform UniformBufferObject {
@@ -0,0 +1,21 @@
+#version 450
+
+layout(location = 0) in vec2 fragUv;
+
+layout(location = 0) out vec4 outColor;
+
+layout(push_constant) uniform constants {
+	mat4 model;
+    vec4 color;
+    uint atlas;
+} PushConstants;
+
+// Size must match VulkanSdfTextRenderer::MAX_FONT_ATLASES
+layout(set = 1, binding = 0) uniform sampler2D fontAtlases[16];
+
+void main() {
+    float distance = texture(fontAtlases[PushConstants.atlas], fragUv).r;
+    float alpha = distance > 0.5f ? 1.f : 0.f;
+    // float alpha = smoothstep(0.4, 0.6, distance);
+    outColor = PushConstants.color * vec4(1.f, 1.f, 1.f, alpha);
+}
@@ -1,6 +1,6 @@
 #version 450
 
-layout(location = 0) in vec2 inPosition;
+layout(location = 0) in ivec2 inPosition;
 layout(location = 0) out vec4 fragColor;
 
 layout(push_constant) uniform constants {
@@ -14,6 +14,6 @@ layout(binding = 0) uniform UniformBufferObject {
 } ubo;
 
 void main() {
-    gl_Position = ubo.projection * ubo.view * PushConstants.model * vec4(inPosition, 0.0, 1.0);
+    gl_Position = ubo.projection * ubo.view * PushConstants.model * vec4(vec2(inPosition), 0.0, 1.0);
     fragColor = PushConstants.color;
 }
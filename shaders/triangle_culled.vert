@@ -0,0 +1,32 @@
+#version 450
+
+layout(location = 0) in ivec2 inPosition;
+layout(location = 0) out vec4 fragColor;
+
+struct Instance {
+    mat4 model;
+    vec4 color;
+    vec4 boundingBox;
+    uint drawCommandIndex;
+    uint glyphData;
+};
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+layout(std430, set = 1, binding = 0) readonly buffer Instances {
+    Instance instances[];
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer VisibleInstances {
+    uint visibleInstances[];
+};
+
+void main() {
+    Instance instance = instances[visibleInstances[gl_InstanceIndex]];
+
+    gl_Position = ubo.projection * ubo.view * instance.model * vec4(vec2(inPosition), 0.0, 1.0);
+    fragColor = instance.color;
+}
@@ -1,195 +1,79 @@
 #version 450
 
 layout(location = 0) in vec2 fragmentPosition;
+layout(location = 1) flat in vec4 fragmentColor;
+layout(location = 2) flat in uint segmentsStartIndex;
 
 layout(location = 0) out vec4 outColor;
 
-layout(push_constant) uniform constants {
-	mat4 model;
-    vec4 color;
-    uint lineSegmentsStartIndex;
-    uint lineSegmentsCount;
-    uint curveSegmentsStartIndex;
-    uint curveSegmentsCount;
-} PushConstants;
-
+// Quantized segments and horizontal bands, see WindingNumberTessellator::_createSegmentsBuffer() for layout
 layout(set = 1, binding = 0) buffer Segments {
-    vec2 segments[];
+    uint segments[];
 };
 
-float rayIntersectsLineSegment(vec2 position, vec2 start, vec2 end) {
-    // Check if ray and line segment are parallel
-    // Winding should be unchanged
-    if(start.y == end.y) {
-        return 0.f;
-    }
-
-    vec2 directionVector = end - start;
-    float directionConstant = directionVector.y > 0 ? 1 : -1;
-
-    // Intersection is at line's start point
-    if(position.y == start.y) {
-        // Check if line segment is pointing up
-        // That means the contour defines a fill
-        if(directionConstant > 0.f) {
-            if(position.x > start.x) {
-                // Ray is on the right of line segment
-                return 0.f;
-            }
-            
-            // Return winding of 0.5 based on direction vector
-            return 0.5f;
-        }
-        else {
-            if(position.x > start.x) {
-                // Ray is on the right of line segment
-                return 0.f;
-            }
-            
-            // Return winding of -0.5 based on direction vector
-            return -0.5f;
-        }
-    }
-    
-    // Intersection is at line's end point
-    if(position.y == end.y) {
-        // Check if line segment is pointing up
-        // That means the contour defines a fill
-        if(directionConstant > 0.f) {
-            if(position.x > end.x) {
-                // Ray is on the right of line segment
-                return 0.f;
-            }
-            
-            // Return winding of 0.5 based on direction vector
-            return 0.5f;
-        }
-        else {
-            if(position.x > end.x) {
-                // Ray is on the right of line segment
-                return 0.f;
-            }
-            
-            // Return winding of -0.5 based on direction vector
-            return -0.5f;
-        }
-    }
-
-    // Ensure line's start point is below end point
-    if(start.y > end.y) {
-        vec2 temp = start;
-        start = end;
-        end = temp;
-    }
-
-    // Ray is above or below line
-    if(position.y < start.y || position.y > end.y) {
-        return 0.f;
-    }
-
-    // Check if intersection is to the right of ray
-    // If true return winding of 1 or -1 depending on direction vector
-    float xIntersection = start.x + (position.y - start.y) * (end.x - start.x) / (end.y - start.y);
-    if(abs(position.x - xIntersection) <= 0.1) {
-        return 0.f;
-    }
-    else if(xIntersection > position.x) {
-        return directionConstant;
-    }
-
-    return 0.f;
-}
-
-float getQuadraticDerivativeWinding(double t, double a, double b) {
-    double d = 2 * a * t + b;
-
-    if(d > 0) {
-        // Curve is pointing up
-       return 1;
-    }
-    else if(d < 0) {
-        // Curve is pointing down
-        return -1;
-    }
-
-    return 0;
-}
-
-float getWindingForQuadraticRoot(double t, vec2 position, vec2 start, vec2 control, vec2 end, double a, double b) {
-    float winding = 0;
-    
-    // X coordinate of intersection
-    double xIntersection = (1 - t) * (1 - t) * start.x + 2 * (1 - t) * t * control.x + t * t * end.x;
-
-    // Check if intersection is on curve start or end points
-    // If true return winding 0.5 or -0.5
-    if(position.y == start.y && xIntersection >= position.x && t >= -0.1 && t <= 0.1) {
-        return getQuadraticDerivativeWinding(0, a, b) / 2;
-    }
-    else if(position.y == end.y && xIntersection >= position.x && t >= 0.9 && t <= 1.1) {
-        return getQuadraticDerivativeWinding(1, a, b) / 2;
-    }
-
-    // Check if root is in range (0, 1)
-    if(t > 0 && t < 1) {
-
-        // Check if intersection is on the right from ray
-        if(xIntersection >= position.x) {
-            winding += getQuadraticDerivativeWinding(t, a, b);
-        }
-    }
-
-    return winding;
-}
-
+// Curves are split at y extrema by the tessellator, so every curve is monotonic in y and crosses the ray at most once
 float rayIntersectsCurveSegment(vec2 position, vec2 start, vec2 control, vec2 end) {
-    float winding = 0.f;
-
-    // Check if ray is above or below curve
-    if(
-        (position.y < start.y && position.y < control.y && position.y < end.y) ||
-        (position.y > start.y && position.y > control.y && position.y > end.y)
-    ) {
-        return winding;
+    // Check if ray crosses curve segment
+    if((start.y <= position.y) == (end.y <= position.y)) {
+        return 0.f;
     }
 
     // Quadratic formula coefficients
-    double a = start.y - 2 * control.y + end.y;
-    double b = 2 * (control.y - start.y);
-    double c = start.y - position.y;
-
-    // Curve is actually a line
-    if(a == 0) {
-        return rayIntersectsLineSegment(position, start, end);
-    }
+    float direction = sign(end.y - start.y);
+    float a = start.y - 2 * control.y + end.y;
+    float b = 2 * (control.y - start.y);
+    float c = start.y - position.y;
 
-    // Quadratic formula roots
-    double sqrtD = sqrt(b * b - 4 * a * c);
-    double t0 = (-b + sqrtD) / (2 * a);
-    double t1 = (-b - sqrtD) / (2 * a);
+    // Single root in range [0, 1] given by the numerically stable form of the quadratic formula
+    // The sign of b always matches the direction of a monotonic curve
+    float t = clamp(-2 * direction * c / max(abs(b) + sqrt(max(b * b - 4 * a * c, 0.f)), 1e-20), 0.f, 1.f);
 
-    // Compute winding for roots
-    winding += getWindingForQuadraticRoot(t0, position, start, control, end, a, b);
-    winding += getWindingForQuadraticRoot(t1, position, start, control, end, a, b);
-
-    return winding;
+    // Check if intersection is to the right of ray
+    // If true return winding of 1 or -1 depending on direction of curve segment
+    float xIntersection = mix(mix(start.x, control.x, t), mix(control.x, end.x, t), t);
+    return xIntersection > position.x ? direction : 0.f;
 }
 
 void main() {
     float windingNumber = 0;
 
-    // Compute winding for line segments
-    for(uint i = PushConstants.lineSegmentsStartIndex; i < PushConstants.lineSegmentsStartIndex + 2 * PushConstants.lineSegmentsCount; i += 2) {
-        windingNumber += rayIntersectsLineSegment(fragmentPosition, segments[i], segments[i + 1]);
-    }
-    
-    // Compute winding for curve segments
-    for(uint i = PushConstants.curveSegmentsStartIndex; i < PushConstants.curveSegmentsStartIndex + 3 * PushConstants.curveSegmentsCount; i += 3) {
-        windingNumber += rayIntersectsCurveSegment(fragmentPosition, segments[i], segments[i + 1], segments[i + 2]);
+    uint glyphStart = segmentsStartIndex;
+    // Glyphs with too many points for 16-bit indices store point index and max x of a segment in separate entries
+    uint bandCount = segments[glyphStart] & 0x7fffffffu;
+    bool wideEntries = (segments[glyphStart] & 0x80000000u) != 0;
+    uint entrySize = wideEntries ? 2 : 1;
+
+    if(bandCount > 0) {
+        // Transform fragment position into space of quantized points
+        uint pointsStart = glyphStart + segments[glyphStart + 1];
+        vec2 boundsMin = uintBitsToFloat(uvec2(segments[glyphStart + 2], segments[glyphStart + 3]));
+        vec2 boundsSize = uintBitsToFloat(uvec2(segments[glyphStart + 4], segments[glyphStart + 5]));
+        vec2 position = (fragmentPosition - boundsMin) / boundsSize;
+
+        // Select band containing the fragment
+        uint band = uint(clamp(int(floor(position.y * float(bandCount))), 0, int(bandCount) - 1));
+
+        uint entriesStart = glyphStart + segments[glyphStart + 6 + 2 * band];
+        uint entriesCount = segments[glyphStart + 7 + 2 * band];
+
+        // Compute winding only for segments in band
+        for(uint i = entriesStart; i < entriesStart + entriesCount * entrySize; i += entrySize) {
+            uint startPointIndex = wideEntries ? segments[i] : segments[i] & 0xffff;
+            uint maxX = wideEntries ? segments[i + 1] : segments[i] >> 16;
+
+            // Segments are sorted by max x, so all remaining segments are on the left of the fragment
+            if(float(maxX) / 65535.f < position.x) {
+                break;
+            }
+
+            // Line segments are stored as curves with the control point in the middle
+            uint index = pointsStart + startPointIndex;
+            windingNumber += rayIntersectsCurveSegment(position, unpackUnorm2x16(segments[index]), unpackUnorm2x16(segments[index + 1]), unpackUnorm2x16(segments[index + 2]));
+        }
     }
 
     if(windingNumber != 0) {
-        outColor = PushConstants.color;
+        outColor = fragmentColor;
     }
     else {
         discard;
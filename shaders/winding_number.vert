@@ -3,10 +3,13 @@
 layout(location = 0) in vec2 inPosition;
 
 layout(location = 0) out vec2 fragmentPosition;
+layout(location = 1) flat out vec4 fragmentColor;
+layout(location = 2) flat out uint segmentsStartIndex;
 
 layout(push_constant) uniform constants {
 	mat4 model;
     vec4 color;
+    uint segmentsStartIndex;
 } PushConstants;
 
 layout(binding = 0) uniform UniformBufferObject {
@@ -16,5 +19,7 @@ layout(binding = 0) uniform UniformBufferObject {
 
 void main() {
     fragmentPosition = inPosition;
+    fragmentColor = PushConstants.color;
+    segmentsStartIndex = PushConstants.segmentsStartIndex;
     gl_Position = ubo.projection * ubo.view * PushConstants.model * vec4(inPosition, 0.0, 1.0);
 }
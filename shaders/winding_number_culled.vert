@@ -0,0 +1,37 @@
+#version 450
+
+layout(location = 0) in vec2 inPosition;
+
+layout(location = 0) out vec2 fragmentPosition;
+layout(location = 1) flat out vec4 fragmentColor;
+layout(location = 2) flat out uint segmentsStartIndex;
+
+struct Instance {
+    mat4 model;
+    vec4 color;
+    vec4 boundingBox;
+    uint drawCommandIndex;
+    uint glyphData;
+};
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 projection;
+} ubo;
+
+layout(std430, set = 2, binding = 0) readonly buffer Instances {
+    Instance instances[];
+};
+
+layout(std430, set = 2, binding = 1) readonly buffer VisibleInstances {
+    uint visibleInstances[];
+};
+
+void main() {
+    Instance instance = instances[visibleInstances[gl_InstanceIndex]];
+
+    fragmentPosition = inPosition;
+    fragmentColor = instance.color;
+    segmentsStartIndex = instance.glyphData;
+    gl_Position = ubo.projection * ubo.view * instance.model * vec4(inPosition, 0.0, 1.0);
+}
@@ -0,0 +1,257 @@
+/**
+ * @file bc4_encoder.cpp
+ * @author Christian Saloň
+ */
+
+#include "bc4_encoder.h"
+
+namespace vft {
+
+/**
+ * @brief Compresses one channel texture into bc4 blocks, blocks are stored row by row like pixels
+ *
+ * @param pixels Pixels of texture from top left corner
+ * @param width Width of texture, must be a multiple of block size
+ * @param height Height of texture, must be a multiple of block size
+ *
+ * @return Encoded blocks
+ */
+std::vector<uint8_t> Bc4Encoder::encode(std::span<const uint8_t> pixels, unsigned int width, unsigned int height) {
+    VFONT_PROFILE_ZONE("Bc4Encoder::encode");
+
+    Bc4Encoder::_checkSize(width, height);
+    if (pixels.size() < width * height) {
+        throw std::invalid_argument("Bc4Encoder::encode(): Texture has less pixels than its size");
+    }
+
+    unsigned int rows = height / BLOCK_SIZE;
+    std::vector<uint8_t> blocks(rows * (width / BLOCK_SIZE) * BLOCK_BYTES);
+
+    // Every thread encodes a contiguous range of rows of blocks
+    unsigned int threadCount = std::clamp(std::thread::hardware_concurrency(), 1u, rows);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < threadCount; i++) {
+        threads.emplace_back(Bc4Encoder::_encodeRows, pixels, width, rows * i / threadCount,
+                             rows * (i + 1) / threadCount, std::ref(blocks));
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    return blocks;
+}
+
+/**
+ * @brief Decompresses bc4 blocks into one channel texture, values between endpoints are rounded like in 8 bit unorm
+ * textures
+ *
+ * @param blocks Encoded blocks stored row by row
+ * @param width Width of texture, must be a multiple of block size
+ * @param height Height of texture, must be a multiple of block size
+ *
+ * @return Pixels of texture from top left corner
+ */
+std::vector<uint8_t> Bc4Encoder::decode(std::span<const uint8_t> blocks, unsigned int width, unsigned int height) {
+    VFONT_PROFILE_ZONE("Bc4Encoder::decode");
+
+    Bc4Encoder::_checkSize(width, height);
+    unsigned int columns = width / BLOCK_SIZE;
+    unsigned int rows = height / BLOCK_SIZE;
+    if (blocks.size() < columns * rows * BLOCK_BYTES) {
+        throw std::invalid_argument("Bc4Encoder::decode(): Texture has less blocks than its size");
+    }
+
+    std::vector<uint8_t> pixels(width * height);
+    for (unsigned int row = 0; row < rows; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            const uint8_t *block = blocks.data() + (row * columns + column) * BLOCK_BYTES;
+            std::array<uint8_t, 8> palette = Bc4Encoder::_getPalette(block[0], block[1]);
+
+            uint64_t indices = 0;
+            for (unsigned int i = 0; i < 6; i++) {
+                indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+            }
+
+            for (unsigned int i = 0; i < BLOCK_PIXELS; i++) {
+                unsigned int x = column * BLOCK_SIZE + i % BLOCK_SIZE;
+                unsigned int y = row * BLOCK_SIZE + i / BLOCK_SIZE;
+                pixels[y * width + x] = palette[(indices >> (3 * i)) & 0x7];
+            }
+        }
+    }
+
+    return pixels;
+}
+
+/**
+ * @brief Encodes a range of rows of blocks
+ *
+ * @param pixels Pixels of texture from top left corner
+ * @param width Width of texture
+ * @param firstRow First encoded row of blocks
+ * @param lastRow Row of blocks after the last encoded row
+ * @param blocks Encoded blocks of whole texture
+ */
+void Bc4Encoder::_encodeRows(std::span<const uint8_t> pixels,
+                             unsigned int width,
+                             unsigned int firstRow,
+                             unsigned int lastRow,
+                             std::vector<uint8_t> &blocks) {
+    VFONT_PROFILE_ZONE("Bc4Encoder::_encodeRows");
+
+    unsigned int columns = width / BLOCK_SIZE;
+    std::array<uint8_t, BLOCK_PIXELS> blockPixels{};
+
+    for (unsigned int row = firstRow; row < lastRow; row++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            for (unsigned int y = 0; y < BLOCK_SIZE; y++) {
+                std::copy_n(pixels.begin() + (row * BLOCK_SIZE + y) * width + column * BLOCK_SIZE, BLOCK_SIZE,
+                            blockPixels.begin() + y * BLOCK_SIZE);
+            }
+
+            Bc4Encoder::_encodeBlock(blockPixels, blocks.data() + (row * columns + column) * BLOCK_BYTES);
+        }
+    }
+}
+
+/**
+ * @brief Encodes one block using the mode with eight values. Endpoints start at the maximum and minimum of block, so
+ * every pixel is at most 1/14 of the block's range from the closest value, and are then refined by least squares
+ *
+ * @param pixels Pixels of block row by row
+ * @param block Destination of encoded block
+ */
+void Bc4Encoder::_encodeBlock(const std::array<uint8_t, BLOCK_PIXELS> &pixels, uint8_t *block) {
+    uint8_t max = *std::max_element(pixels.begin(), pixels.end());
+    uint8_t min = *std::min_element(pixels.begin(), pixels.end());
+
+    std::array<uint8_t, BLOCK_PIXELS> steps{};
+    if (max > min) {
+        float error = Bc4Encoder::_getSteps(pixels, max, min, steps);
+
+        for (unsigned int iteration = 0; iteration < REFINEMENT_ITERATIONS; iteration++) {
+            // Pixel with step s is approximated by (1 - s / 7) * max + s / 7 * min, solve the normal equations
+            float aa = 0, ab = 0, bb = 0, ap = 0, bp = 0;
+            for (unsigned int i = 0; i < BLOCK_PIXELS; i++) {
+                float b = steps[i] / 7.f;
+                float a = 1.f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                ap += a * pixels[i];
+                bp += b * pixels[i];
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (determinant == 0) {
+                break;
+            }
+
+            int refinedMax = static_cast<int>(std::round((ap * bb - bp * ab) / determinant));
+            int refinedMin = static_cast<int>(std::round((bp * aa - ap * ab) / determinant));
+            refinedMax = std::clamp(refinedMax, 0, 255);
+            refinedMin = std::clamp(refinedMin, 0, 255);
+            if (refinedMax <= refinedMin || (refinedMax == max && refinedMin == min)) {
+                break;
+            }
+
+            std::array<uint8_t, BLOCK_PIXELS> refinedSteps{};
+            float refinedError = Bc4Encoder::_getSteps(pixels, refinedMax, refinedMin, refinedSteps);
+            if (refinedError >= error) {
+                break;
+            }
+
+            max = static_cast<uint8_t>(refinedMax);
+            min = static_cast<uint8_t>(refinedMin);
+            steps = refinedSteps;
+            error = refinedError;
+        }
+    }
+
+    block[0] = max;
+    block[1] = min;
+
+    // Endpoints have indices 0 and 1, values between them have indices 2 to 7
+    uint64_t indices = 0;
+    if (max > min) {
+        for (unsigned int i = 0; i < BLOCK_PIXELS; i++) {
+            uint64_t index = steps[i] == 0 ? 0 : (steps[i] == 7 ? 1 : steps[i] + 1);
+            indices |= index << (3 * i);
+        }
+    }
+
+    for (unsigned int i = 0; i < 6; i++) {
+        block[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    }
+}
+
+/**
+ * @brief Finds the closest of eight evenly spaced values between endpoints for every pixel of block. Values outside
+ * the endpoints are clamped to them
+ *
+ * @param pixels Pixels of block row by row
+ * @param max First endpoint, must be larger than the second endpoint
+ * @param min Second endpoint
+ * @param steps Number of steps from the first endpoint of the closest value of every pixel
+ *
+ * @return Sum of squared errors of pixels
+ */
+float Bc4Encoder::_getSteps(const std::array<uint8_t, BLOCK_PIXELS> &pixels,
+                            uint8_t max,
+                            uint8_t min,
+                            std::array<uint8_t, BLOCK_PIXELS> &steps) {
+    float stepsPerValue = 7.f / (max - min);
+    float valuesPerStep = (max - min) / 7.f;
+
+    float error = 0;
+    for (unsigned int i = 0; i < BLOCK_PIXELS; i++) {
+        float step = std::clamp(std::round((max - pixels[i]) * stepsPerValue), 0.f, 7.f);
+        float difference = max - step * valuesPerStep - pixels[i];
+        steps[i] = static_cast<uint8_t>(step);
+        error += difference * difference;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Get values of all indices of block. If the first endpoint is larger, there are six values between endpoints,
+ * otherwise there are four values between endpoints and the values 0 and 255
+ *
+ * @param red0 First endpoint
+ * @param red1 Second endpoint
+ *
+ * @return Values of indices
+ */
+std::array<uint8_t, 8> Bc4Encoder::_getPalette(uint8_t red0, uint8_t red1) {
+    std::array<uint8_t, 8> palette{red0, red1};
+
+    if (red0 > red1) {
+        for (unsigned int i = 2; i < 8; i++) {
+            palette[i] = static_cast<uint8_t>(((8 - i) * red0 + (i - 1) * red1) / 7.f + 0.5f);
+        }
+    } else {
+        for (unsigned int i = 2; i < 6; i++) {
+            palette[i] = static_cast<uint8_t>(((6 - i) * red0 + (i - 1) * red1) / 5.f + 0.5f);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    return palette;
+}
+
+/**
+ * @brief Checks if texture can be divided into blocks
+ *
+ * @param width Width of texture
+ * @param height Height of texture
+ */
+void Bc4Encoder::_checkSize(unsigned int width, unsigned int height) {
+    if (width == 0 || height == 0 || width % BLOCK_SIZE != 0 || height % BLOCK_SIZE != 0) {
+        throw std::invalid_argument("Bc4Encoder::_checkSize(): Size of texture must be a non-zero multiple of 4");
+    }
+}
+
+}  // namespace vft
@@ -0,0 +1,82 @@
+/**
+ * @file bounding_box.cpp
+ * @author Christian Saloň
+ */
+
+#include "bounding_box.h"
+
+namespace vft {
+
+/**
+ * @brief BoundingBox constructor
+ *
+ * @param min Corner with the smallest coordinates
+ * @param max Corner with the largest coordinates
+ */
+BoundingBox::BoundingBox(glm::vec3 min, glm::vec3 max) : min{min}, max{max} {}
+
+/**
+ * @brief Enlarge bounding box so that it contains given point
+ *
+ * @param point Point in 3D space
+ */
+void BoundingBox::add(glm::vec3 point) {
+    this->min = glm::min(this->min, point);
+    this->max = glm::max(this->max, point);
+}
+
+/**
+ * @brief Enlarge bounding box so that it contains given bounding box
+ *
+ * @param boundingBox Bounding box to include
+ */
+void BoundingBox::add(const BoundingBox &boundingBox) {
+    if (boundingBox.isEmpty()) {
+        return;
+    }
+
+    this->add(boundingBox.min);
+    this->add(boundingBox.max);
+}
+
+/**
+ * @brief Transform all corners of bounding box and compute a bounding box containing them
+ *
+ * @param matrix Transform matrix
+ *
+ * @return Bounding box of transformed corners
+ */
+BoundingBox BoundingBox::transform(const glm::mat4 &matrix) const {
+    if (this->isEmpty()) {
+        return BoundingBox{};
+    }
+
+    BoundingBox transformed{};
+    for (unsigned int i = 0; i < 8; i++) {
+        glm::vec3 corner{(i & 1) ? this->max.x : this->min.x, (i & 2) ? this->max.y : this->min.y,
+                         (i & 4) ? this->max.z : this->min.z};
+        transformed.add(glm::vec3(matrix * glm::vec4(corner, 1.f)));
+    }
+
+    return transformed;
+}
+
+/**
+ * @brief Check whether bounding box contains no points
+ *
+ * @return True if bounding box is empty
+ */
+bool BoundingBox::isEmpty() const {
+    return this->min.x > this->max.x || this->min.y > this->max.y || this->min.z > this->max.z;
+}
+
+/**
+ * @brief Get center of bounding box
+ *
+ * @return Center point
+ */
+glm::vec3 BoundingBox::getCenter() const {
+    return (this->min + this->max) * 0.5f;
+}
+
+}  // namespace vft
@@ -0,0 +1,127 @@
+/**
+ * @file bounding_volume_hierarchy.cpp
+ * @author Christian Saloň
+ */
+
+#include "bounding_volume_hierarchy.h"
+
+namespace vft {
+
+/**
+ * @brief Builds hierarchy over given bounding boxes. Boxes are split by the median of their centers along the longest
+ * axis, empty bounding boxes are never visible and are left out
+ *
+ * @param boundingBoxes Bounding boxes, their indices are returned by queries
+ */
+void BoundingVolumeHierarchy::build(const std::vector<BoundingBox> &boundingBoxes) {
+    this->_nodes.clear();
+    this->_indices.clear();
+
+    for (unsigned int i = 0; i < boundingBoxes.size(); i++) {
+        if (!boundingBoxes[i].isEmpty()) {
+            this->_indices.push_back(i);
+        }
+    }
+
+    if (this->_indices.empty()) {
+        return;
+    }
+
+    this->_nodes.reserve(2 * this->_indices.size());
+    this->_buildNode(boundingBoxes, 0, this->_indices.size());
+}
+
+/**
+ * @brief Finds all bounding boxes which intersect view frustum
+ *
+ * @param frustum View frustum
+ *
+ * @return Indices of visible bounding boxes in ascending order
+ */
+std::vector<unsigned int> BoundingVolumeHierarchy::query(const ViewFrustum &frustum) const {
+    std::vector<unsigned int> visible;
+    if (this->_nodes.empty()) {
+        return visible;
+    }
+
+    std::vector<unsigned int> stack{0};
+    while (!stack.empty()) {
+        const Node &node = this->_nodes[stack.back()];
+        stack.pop_back();
+
+        if (!frustum.intersects(node.boundingBox)) {
+            continue;
+        }
+
+        if (node.count == 0) {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+            continue;
+        }
+
+        for (unsigned int i = node.start; i < node.start + node.count; i++) {
+            visible.push_back(this->_indices[i]);
+        }
+    }
+
+    // Keep the order in which bounding boxes were added
+    std::sort(visible.begin(), visible.end());
+    return visible;
+}
+
+/**
+ * @brief Recursively builds subtree over a range of bounding box indices
+ *
+ * @param boundingBoxes All bounding boxes
+ * @param start Index of first bounding box index in range
+ * @param count Number of bounding boxes in range
+ *
+ * @return Index of created node
+ */
+unsigned int BoundingVolumeHierarchy::_buildNode(const std::vector<BoundingBox> &boundingBoxes,
+                                                 unsigned int start,
+                                                 unsigned int count) {
+    unsigned int nodeIndex = this->_nodes.size();
+    this->_nodes.push_back(Node{});
+
+    BoundingBox boundingBox{};
+    BoundingBox centers{};
+    for (unsigned int i = start; i < start + count; i++) {
+        boundingBox.add(boundingBoxes[this->_indices[i]]);
+        centers.add(boundingBoxes[this->_indices[i]].getCenter());
+    }
+
+    this->_nodes[nodeIndex].boundingBox = boundingBox;
+
+    if (count <= MAX_LEAF_SIZE) {
+        this->_nodes[nodeIndex].start = start;
+        this->_nodes[nodeIndex].count = count;
+        return nodeIndex;
+    }
+
+    // Split along the axis in which centers of bounding boxes are spread the most
+    glm::vec3 extent = centers.max - centers.min;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    auto first = this->_indices.begin() + start;
+    std::nth_element(first, first + count / 2, first + count,
+                     [&boundingBoxes, axis](unsigned int a, unsigned int b) {
+                         return boundingBoxes[a].getCenter()[axis] < boundingBoxes[b].getCenter()[axis];
+                     });
+
+    // Nodes can be reallocated while building children
+    unsigned int left = this->_buildNode(boundingBoxes, start, count / 2);
+    unsigned int right = this->_buildNode(boundingBoxes, start + count / 2, count - count / 2);
+    this->_nodes[nodeIndex].left = left;
+    this->_nodes[nodeIndex].right = right;
+
+    return nodeIndex;
+}
+
+}  // namespace vft
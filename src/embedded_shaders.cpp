@@ -0,0 +1,27 @@
+/**
+ * @file embedded_shaders.cpp
+ * @author Christian Saloň
+ */
+
+#include "embedded_shaders.h"
+
+namespace vft {
+
+/**
+ * @brief Finds an embedded shader by the path of its shader file
+ *
+ * @param fileName Path of shader file relative to the executable, e.g. "shaders/sdf-vert.spv"
+ *
+ * @return Embedded shader or nullptr if shader is not embedded
+ */
+const EmbeddedShaders::Shader *EmbeddedShaders::find(const std::string &fileName) {
+    for (const Shader &shader : EmbeddedShaders::_shaders) {
+        if (fileName == shader.fileName) {
+            return &shader;
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace vft
@@ -92,6 +92,36 @@ std::string Font::getFontFamily() const {
     return std::string(this->_face->family_name);
 }
 
+/**
+ * @brief Computes 64 bit FNV-1a hash of content of font file, which identifies the font in prebuilt font atlas files.
+ * Content is read through the freetype stream of font face
+ *
+ * @return Hash of font file
+ */
+uint64_t Font::getContentHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    auto hashBytes = [&hash](const unsigned char *bytes, unsigned long count) {
+        for (unsigned long i = 0; i < count; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+
+    // Streams without read function are stored in memory
+    FT_Stream stream = this->_face->stream;
+    if (stream->read == nullptr) {
+        hashBytes(stream->base, stream->size);
+        return hash;
+    }
+
+    std::array<unsigned char, 4096> buffer{};
+    for (unsigned long offset = 0; offset < stream->size; offset += buffer.size()) {
+        unsigned long count = std::min<unsigned long>(buffer.size(), stream->size - offset);
+        hashBytes(buffer.data(), stream->read(stream, offset, buffer.data(), count));
+    }
+
+    return hash;
+}
+
 /**
  * @brief Getter for freetype font face
  *
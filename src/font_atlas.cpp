@@ -8,20 +8,33 @@
 namespace vft {
 
 /**
- * @brief Construct texture containing sdfs of selected glyphs using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of selected glyphs using the freetype sdf rasterizer, multi-channel sdfs
+ * using the msdf generator or sdfs at every tier pixel size using the sdf generator
  *
  * @param font Font used to rasterize glyphs into sdfs
  * @param glyphIds Glyph indices to rasterize
+ * @param format Format of distance fields
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds) : _fontFamily{font->getFontFamily()} {
-    // Set size of each glyph bitmap to approximetly 64 x 64
+FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds, Format format)
+    : _fontFamily{font->getFontFamily()}, _format{format}, _pixelSize{font->getPixelSize()} {
+    // Set size of each glyph bitmap to approximetly 64 x 64, multi-channel sdfs need smaller bitmaps
     // Freetype does not produce exact size of bitmap
+    unsigned int glyphSize = format == Format::MSDF ? MSDF_PIXEL_SIZE : 64;
     unsigned int oldPixelSize = font->getPixelSize();
     font->setPixelSize(64);
 
-    // Get the size of texture needed to store all glyphs
+    if (format == Format::TIERED_SDF) {
+        this->_tierPixelSizes.assign(TIER_PIXEL_SIZES.begin(), TIER_PIXEL_SIZES.end());
+    } else {
+        this->_tierPixelSizes = {glyphSize};
+    }
+
+    // Get the size of texture needed to store all glyphs in all tiers
     // Texture is a square where length is a power of two
-    unsigned area = glyphIds.size() * 64 * 64;
+    unsigned area = 0;
+    for (unsigned int tierPixelSize : this->_tierPixelSizes) {
+        area += glyphIds.size() * tierPixelSize * tierPixelSize;
+    }
     unsigned int size = 128;
     while (area * 1.5 > size * size) {
         size *= 2;
@@ -35,95 +48,279 @@ FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::vector<uint32_t> glyphIds)
     this->_height = size;
 
     // Initialize texture to zeros
-    this->_texture.assign(this->_width * this->_height, 0);
+    unsigned int channels = this->getChannelCount();
+    this->_texture.assign(this->_width * this->_height * channels, 0);
 
     glm::uvec2 pen{0, 0};  // Current position in texture
     unsigned int currentRowHeight = 0;
 
-    // Load all glyphs
-    for (uint32_t glyphId : glyphIds) {
-        // Generate sdf bitmap for glyph
-        if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_RENDER)) {
-            throw std::runtime_error("FontAtlas::FontAtlas(): Error loading glyph");
-        }
-        if (FT_Render_Glyph(font->getFace()->glyph, FT_RENDER_MODE_SDF)) {
-            throw std::runtime_error("FontAtlas::FontAtlas(): Error rasterizing sdf bitmap");
-        }
-        FT_GlyphSlot slot = font->getFace()->glyph;
-        const FT_Bitmap &bitmap = slot->bitmap;
+    // Because new lines have glyphId 0, insert a default record with glyphId 0 in every tier
+    this->_glyphs.insert(
+        {0, std::vector<GlyphInfo>(this->_tierPixelSizes.size(), GlyphInfo{glm::vec2{0, 0}, glm::vec2{0, 0}})});
 
-        if (bitmap.width == 0 || bitmap.rows == 0) {
-            this->_glyphs.insert({glyphId, GlyphInfo{glm::vec2{0, 0}, glm::vec2{0, 0}}});
-            continue;
-        }
+    if (format == Format::TIERED_SDF) {
+        this->_generateTiers(font, glyphIds, pen, currentRowHeight);
+        return;
+    }
 
-        // Check if glyph will fit on current row in texture
-        if (pen.x + bitmap.width > this->_width) {
-            pen.x = 0;
-            pen.y += currentRowHeight;
-            currentRowHeight = 0;
-        }
+    MsdfGenerator msdfGenerator{};
 
-        // Write bitmap data into atlas texture
-        for (unsigned int y = 0; y < bitmap.rows; y++) {
-            for (unsigned int x = 0; x < bitmap.width; x++) {
-                uint8_t pixel = bitmap.buffer[y * bitmap.width + x];
-                this->_texture[(pen.y + y) * this->_width + (pen.x + x)] = pixel;
+    // Load all glyphs
+    for (uint32_t glyphId : glyphIds) {
+        MsdfGenerator::Bitmap bitmap{};
+
+        if (format == Format::MSDF) {
+            // Generate multi-channel sdf bitmap for glyph
+            bitmap = msdfGenerator.generate(glyphId, font, MSDF_PIXEL_SIZE);
+        } else {
+            // Generate sdf bitmap for glyph
+            if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_RENDER)) {
+                throw std::runtime_error("FontAtlas::FontAtlas(): Error loading glyph");
             }
+            if (FT_Render_Glyph(font->getFace()->glyph, FT_RENDER_MODE_SDF)) {
+                throw std::runtime_error("FontAtlas::FontAtlas(): Error rasterizing sdf bitmap");
+            }
+            FT_GlyphSlot slot = font->getFace()->glyph;
+            bitmap.width = slot->bitmap.width;
+            bitmap.height = slot->bitmap.rows;
+            bitmap.size = glm::vec2{static_cast<float>(bitmap.width), static_cast<float>(bitmap.height)};
+            bitmap.pixels.assign(slot->bitmap.buffer, slot->bitmap.buffer + bitmap.width * bitmap.height);
         }
 
-        // Calculate uvs
-        glm::vec2 uvTopLeft{pen.x / static_cast<float>(this->_width), pen.y / static_cast<float>(this->_height)};
-        glm::vec2 uvBottomRight{(pen.x + bitmap.width) / static_cast<float>(this->_width),
-                                (pen.y + bitmap.rows) / static_cast<float>(this->_height)};
-
         // Insert glyph data
-        this->_glyphs.insert({glyphId, GlyphInfo{uvTopLeft, uvBottomRight}});
-
-        // Update texture pen position
-        pen.x += bitmap.width;
-        currentRowHeight = std::max(currentRowHeight, bitmap.rows);
+        this->_glyphs.insert({glyphId, {this->_packBitmap(bitmap, pen, currentRowHeight)}});
     }
 }
 
 /**
- * @brief Construct texture containing sdfs of selected unicode code points using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of selected unicode code points
  *
  * @param font Font used to rasterize glyphs into sdfs
  * @param characterRanges Ranges of unicode code points to rasterize
+ * @param format Format of distance fields
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::vector<CharacterRange> characterRanges)
-    : FontAtlas{font, this->_getRangesGlyphIds(font, characterRanges)} {}
+FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::vector<CharacterRange> characterRanges, Format format)
+    : FontAtlas{font, this->_getRangesGlyphIds(font, characterRanges), format} {}
 
 /**
- * @brief Construct texture containing sdfs of selected utf-32 encoded characters using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of selected utf-32 encoded characters
  *
  * @param font Font used to rasterize glyphs into sdfs
  * @param characters Utf-32 encoded characters to rasterize
+ * @param format Format of distance fields
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::u32string characters)
-    : FontAtlas{font, this->_getUtf32GlyphIds(font, characters)} {}
+FontAtlas::FontAtlas(std::shared_ptr<Font> font, std::u32string characters, Format format)
+    : FontAtlas{font, this->_getUtf32GlyphIds(font, characters), format} {}
 
 /**
- * @brief Construct texture containing sdfs of all glyphs in font file using the freetype sdf rasterizer
+ * @brief Construct texture containing sdfs of all glyphs in font file
  *
  * @param font Font used to rasterize glyphs into sdfs
+ * @param format Format of distance fields
+ */
+FontAtlas::FontAtlas(std::shared_ptr<Font> font, Format format)
+    : FontAtlas{font, this->_getAllGlyphIds(font), format} {}
+
+/**
+ * @brief Loads font atlas from file written by save(). The file is mapped into memory and the texture is not copied,
+ * so it can be uploaded to gpu straight from the mapping
+ *
+ * @param font Font the atlas was generated from, its content and pixel size must match the file
+ * @param fileName Path to font atlas file
+ *
+ * @return Loaded font atlas
+ */
+FontAtlas FontAtlas::load(std::shared_ptr<Font> font, std::string fileName) {
+    VFONT_PROFILE_ZONE("FontAtlas::load");
+
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(fileName);
+    std::span<const uint8_t> data = file->getData();
+
+    FileHeader header{};
+    if (data.size() < sizeof(FileHeader)) {
+        throw std::runtime_error("FontAtlas::load(): File is not a font atlas");
+    }
+    std::memcpy(&header, data.data(), sizeof(FileHeader));
+
+    if (header.magic != FileHeader{}.magic) {
+        throw std::runtime_error("FontAtlas::load(): File is not a font atlas");
+    }
+    if (header.version != FILE_VERSION) {
+        throw std::runtime_error("FontAtlas::load(): Unsupported version of font atlas file");
+    }
+    if (header.fontHash != font->getContentHash()) {
+        throw std::runtime_error("FontAtlas::load(): Font atlas was generated from a different font");
+    }
+    if (header.pixelSize != font->getPixelSize()) {
+        throw std::runtime_error("FontAtlas::load(): Font atlas was generated at a different pixel size");
+    }
+    if (header.format > static_cast<uint32_t>(Format::TIERED_SDF) || header.tierCount == 0) {
+        throw std::runtime_error("FontAtlas::load(): Font atlas file is corrupted");
+    }
+    unsigned int spread = header.format == static_cast<uint32_t>(Format::MSDF) ? MsdfGenerator::SPREAD
+                                                                               : SdfGenerator::SPREAD;
+    if (header.spread != spread) {
+        throw std::runtime_error("FontAtlas::load(): Font atlas was generated with a different spread");
+    }
+
+    uint64_t glyphSize = sizeof(uint32_t) + header.tierCount * 4 * sizeof(float);
+    uint64_t tableSize = header.tierCount * sizeof(uint32_t) + header.glyphCount * glyphSize;
+    if (sizeof(FileHeader) + tableSize > header.textureOffset || header.textureOffset > data.size() ||
+        header.textureSize > data.size() - header.textureOffset) {
+        throw std::runtime_error("FontAtlas::load(): Font atlas file is corrupted");
+    }
+
+    FontAtlas atlas{};
+    atlas._fontFamily = font->getFontFamily();
+    atlas._format = static_cast<Format>(header.format);
+    atlas._width = header.width;
+    atlas._height = header.height;
+    atlas._compressed = header.compressed != 0;
+    atlas._pixelSize = header.pixelSize;
+
+    const uint8_t *current = data.data() + sizeof(FileHeader);
+    atlas._tierPixelSizes.resize(header.tierCount);
+    for (unsigned int &tierPixelSize : atlas._tierPixelSizes) {
+        uint32_t value = 0;
+        std::memcpy(&value, current, sizeof(uint32_t));
+        tierPixelSize = value;
+        current += sizeof(uint32_t);
+    }
+
+    atlas._glyphs.reserve(header.glyphCount);
+    for (uint32_t i = 0; i < header.glyphCount; i++) {
+        uint32_t glyphId = 0;
+        std::memcpy(&glyphId, current, sizeof(uint32_t));
+        current += sizeof(uint32_t);
+
+        std::vector<GlyphInfo> tiers(header.tierCount);
+        for (GlyphInfo &glyphInfo : tiers) {
+            std::array<float, 4> uvs{};
+            std::memcpy(uvs.data(), current, sizeof(uvs));
+            glyphInfo = GlyphInfo{glm::vec2{uvs[0], uvs[1]}, glm::vec2{uvs[2], uvs[3]}};
+            current += sizeof(uvs);
+        }
+
+        atlas._glyphs.insert({glyphId, std::move(tiers)});
+    }
+
+    atlas._mappedFile = file;
+    atlas._mappedTexture = data.subspan(header.textureOffset, header.textureSize);
+
+    uint64_t expectedSize = static_cast<uint64_t>(atlas._width) * atlas._height * atlas.getChannelCount();
+    if (atlas._compressed) {
+        expectedSize /= 2;
+    }
+    if (header.textureSize != expectedSize) {
+        throw std::runtime_error("FontAtlas::load(): Font atlas file is corrupted");
+    }
+
+    return atlas;
+}
+
+/**
+ * @brief Writes font atlas with the parameters it was generated with to file, so it can be built offline and loaded
+ * by load(). Glyphs are stored sorted by glyph id and the texture is aligned, so it can be uploaded from the mapping
+ *
+ * @param font Font the atlas was generated from
+ * @param fileName Path to font atlas file
+ */
+void FontAtlas::save(std::shared_ptr<Font> font, std::string fileName) const {
+    VFONT_PROFILE_ZONE("FontAtlas::save");
+
+    std::ofstream file{fileName, std::ios::binary};
+    if (!file.is_open()) {
+        throw std::runtime_error("FontAtlas::save(): Error opening font atlas file");
+    }
+
+    std::span<const uint8_t> texture = this->getTexture();
+
+    FileHeader header{};
+    header.fontHash = font->getContentHash();
+    header.format = static_cast<uint32_t>(this->_format);
+    header.compressed = this->_compressed ? 1 : 0;
+    header.width = this->_width;
+    header.height = this->_height;
+    header.pixelSize = this->_pixelSize;
+    header.spread = this->_format == Format::MSDF ? MsdfGenerator::SPREAD : SdfGenerator::SPREAD;
+    header.tierCount = this->_tierPixelSizes.size();
+    header.glyphCount = this->_glyphs.size();
+    header.textureSize = texture.size();
+
+    uint64_t glyphSize = sizeof(uint32_t) + header.tierCount * 4 * sizeof(float);
+    uint64_t tableEnd = sizeof(FileHeader) + header.tierCount * sizeof(uint32_t) + header.glyphCount * glyphSize;
+    header.textureOffset = (tableEnd + FILE_TEXTURE_ALIGNMENT - 1) / FILE_TEXTURE_ALIGNMENT * FILE_TEXTURE_ALIGNMENT;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+
+    for (unsigned int tierPixelSize : this->_tierPixelSizes) {
+        uint32_t value = tierPixelSize;
+        file.write(reinterpret_cast<const char *>(&value), sizeof(uint32_t));
+    }
+
+    std::vector<uint32_t> glyphIds;
+    glyphIds.reserve(this->_glyphs.size());
+    for (const auto &[glyphId, tiers] : this->_glyphs) {
+        glyphIds.push_back(glyphId);
+    }
+    std::sort(glyphIds.begin(), glyphIds.end());
+
+    for (uint32_t glyphId : glyphIds) {
+        file.write(reinterpret_cast<const char *>(&glyphId), sizeof(uint32_t));
+        for (const GlyphInfo &glyphInfo : this->_glyphs.at(glyphId)) {
+            std::array<float, 4> uvs{glyphInfo.uvTopLeft.x, glyphInfo.uvTopLeft.y, glyphInfo.uvBottomRight.x,
+                                     glyphInfo.uvBottomRight.y};
+            file.write(reinterpret_cast<const char *>(uvs.data()), sizeof(uvs));
+        }
+    }
+
+    std::vector<char> padding(header.textureOffset - tableEnd, 0);
+    file.write(padding.data(), padding.size());
+    file.write(reinterpret_cast<const char *>(texture.data()), texture.size());
+
+    if (!file) {
+        throw std::runtime_error("FontAtlas::save(): Error writing font atlas file");
+    }
+}
+
+/**
+ * @brief Compresses texture into bc4 blocks, which take half of the size of one channel texture. Only font atlases
+ * with one channel sdfs can be compressed
  */
-FontAtlas::FontAtlas(std::shared_ptr<Font> font) : FontAtlas{font, this->_getAllGlyphIds(font)} {}
+void FontAtlas::compress() {
+    if (this->_compressed) {
+        return;
+    }
+
+    if (this->getChannelCount() != 1) {
+        throw std::runtime_error("FontAtlas::compress(): Only font atlases with one channel sdfs can be compressed");
+    }
+
+    this->_texture = Bc4Encoder::encode(this->getTexture(), this->_width, this->_height);
+    this->_compressed = true;
+
+    // Texture is no longer in the mapped file
+    this->_mappedTexture = {};
+    this->_mappedFile.reset();
+}
 
 /**
  * @brief Get glyph info (UVs) of selected glyph
  *
  * @param glyphId Glyph index of selected glyph
+ * @param tier Index of tier, font atlases which are not tiered have only tier 0
  *
  * @return Glyph info of selected glyph
  */
-FontAtlas::GlyphInfo FontAtlas::getGlyph(uint32_t glyphId) const {
+FontAtlas::GlyphInfo FontAtlas::getGlyph(uint32_t glyphId, unsigned int tier) const {
     if (!this->_glyphs.contains(glyphId)) {
         throw std::invalid_argument("FontAtlas::getGlyph(): Font atlas does not contain glyph with given glyph id");
     }
+    if (tier >= this->_tierPixelSizes.size()) {
+        throw std::out_of_range("FontAtlas::getGlyph(): Font atlas does not contain tier with given index");
+    }
 
-    return this->_glyphs.at(glyphId);
+    return this->_glyphs.at(glyphId).at(tier);
 }
 
 /**
@@ -135,6 +332,42 @@ std::string FontAtlas::getFontFamily() const {
     return this->_fontFamily;
 }
 
+/**
+ * @brief Getter for format of distance fields in font atlas
+ *
+ * @return Format of distance fields
+ */
+FontAtlas::Format FontAtlas::getFormat() const {
+    return this->_format;
+}
+
+/**
+ * @brief Get number of 8 bit channels of one texel in texture
+ *
+ * @return 4 for multi-channel sdfs, 1 for sdfs
+ */
+unsigned int FontAtlas::getChannelCount() const {
+    return this->_format == Format::MSDF ? 4 : 1;
+}
+
+/**
+ * @brief Getter for sizes of em square in pixels of tiers, font atlases which are not tiered have one tier
+ *
+ * @return Tier pixel sizes from the smallest
+ */
+const std::vector<unsigned int> &FontAtlas::getTierPixelSizes() const {
+    return this->_tierPixelSizes;
+}
+
+/**
+ * @brief Getter for whether texture is stored as bc4 blocks
+ *
+ * @return True if texture is compressed
+ */
+bool FontAtlas::isCompressed() const {
+    return this->_compressed;
+}
+
 /**
  * @brief Getter for the size of final texture
  *
@@ -145,14 +378,130 @@ glm::uvec2 FontAtlas::getSize() const {
 }
 
 /**
- * @brief Get raw bytes of texture
+ * @brief Get raw bytes of texture, bc4 blocks stored row by row if texture is compressed. Texture of loaded font
+ * atlases points into the mapped file
  *
- * @return Vector of bytes containing texture data
+ * @return Bytes containing texture data
  */
-const std::vector<uint8_t> &FontAtlas::getTexture() const {
+std::span<const uint8_t> FontAtlas::getTexture() const {
+    if (this->_mappedFile) {
+        return this->_mappedTexture;
+    }
+
     return this->_texture;
 }
 
+/**
+ * @brief Generates sdfs of selected glyphs at every tier pixel size. Sdfs in all tiers cover the same area as the
+ * freetype sdf at the font's pixel size, so every tier fits the bounding boxes composed by the sdf tessellator. Tiers
+ * are stored one after another, so sdfs of small characters lie close together in texture
+ *
+ * @param font Font used to compose glyphs
+ * @param glyphIds Glyph indices to generate
+ * @param pen Current position in texture
+ * @param currentRowHeight Height of current row in texture
+ */
+void FontAtlas::_generateTiers(std::shared_ptr<Font> font,
+                               const std::vector<uint32_t> &glyphIds,
+                               glm::uvec2 &pen,
+                               unsigned int &currentRowHeight) {
+    WindingNumberTessellator tessellator{};
+    SdfGenerator sdfGenerator{};
+
+    glm::vec2 scale = font->getScalingVector(font->getPixelSize());
+    std::vector<std::shared_ptr<const Glyph>> glyphs(glyphIds.size());
+    std::vector<std::pair<glm::vec2, glm::vec2>> bounds(glyphIds.size());
+
+    for (unsigned int i = 0; i < glyphIds.size(); i++) {
+        // Bounds of freetype sdf are the hinted bounding box rounded to whole pixels and padded by spread
+        if (FT_Load_Glyph(font->getFace(), glyphIds[i], FT_LOAD_DEFAULT)) {
+            throw std::runtime_error("FontAtlas::_generateTiers(): Error loading glyph");
+        }
+        if (font->getFace()->glyph->outline.n_points == 0) {
+            continue;
+        }
+
+        FT_BBox boundingBox;
+        FT_Outline_Get_CBox(&font->getFace()->glyph->outline, &boundingBox);
+        float spread = static_cast<float>(SdfGenerator::SPREAD);
+        glm::vec2 min{std::floor(boundingBox.xMin / 64.f) - spread, std::floor(boundingBox.yMin / 64.f) - spread};
+        glm::vec2 max{std::ceil(boundingBox.xMax / 64.f) + spread, std::ceil(boundingBox.yMax / 64.f) + spread};
+
+        glyphs[i] = tessellator.composeGlyph(glyphIds[i], font);
+        bounds[i] = {min / scale, max / scale};
+    }
+
+    std::vector<std::vector<GlyphInfo>> glyphInfos(glyphIds.size());
+    for (unsigned int tierPixelSize : this->_tierPixelSizes) {
+        // Spread is the same part of em square in every tier
+        float tierScale = static_cast<float>(tierPixelSize) / font->getPixelSize();
+        float spread = SdfGenerator::SPREAD * tierScale;
+
+        for (unsigned int i = 0; i < glyphIds.size(); i++) {
+            glm::vec2 min = bounds[i].first * scale * tierScale;
+            glm::vec2 max = bounds[i].second * scale * tierScale;
+
+            SdfGenerator::Bitmap sdf{};
+            if (glyphs[i] != nullptr) {
+                sdf = sdfGenerator.generate(*glyphs[i], scale * tierScale, min, max, spread);
+            }
+            if (sdf.width == 0 || sdf.height == 0) {
+                glyphInfos[i].push_back(GlyphInfo{glm::vec2{0, 0}, glm::vec2{0, 0}});
+                continue;
+            }
+
+            MsdfGenerator::Bitmap bitmap{sdf.width, sdf.height, max - min, std::move(sdf.pixels)};
+            glyphInfos[i].push_back(this->_packBitmap(bitmap, pen, currentRowHeight));
+        }
+    }
+
+    for (unsigned int i = 0; i < glyphIds.size(); i++) {
+        this->_glyphs.insert({glyphIds[i], glyphInfos[i]});
+    }
+}
+
+/**
+ * @brief Writes bitmap into texture at the pen position, or at the start of next row if it does not fit on current row
+ *
+ * @param bitmap Bitmap of glyph
+ * @param pen Current position in texture
+ * @param currentRowHeight Height of current row in texture
+ *
+ * @return UVs of bitmap in texture
+ */
+FontAtlas::GlyphInfo FontAtlas::_packBitmap(const MsdfGenerator::Bitmap &bitmap,
+                                            glm::uvec2 &pen,
+                                            unsigned int &currentRowHeight) {
+    if (bitmap.width == 0 || bitmap.height == 0) {
+        return GlyphInfo{glm::vec2{0, 0}, glm::vec2{0, 0}};
+    }
+
+    // Check if glyph will fit on current row in texture
+    if (pen.x + bitmap.width > this->_width) {
+        pen.x = 0;
+        pen.y += currentRowHeight;
+        currentRowHeight = 0;
+    }
+
+    // Write bitmap data into atlas texture
+    unsigned int channels = this->getChannelCount();
+    for (unsigned int y = 0; y < bitmap.height; y++) {
+        std::copy_n(bitmap.pixels.begin() + y * bitmap.width * channels, bitmap.width * channels,
+                    this->_texture.begin() + ((pen.y + y) * this->_width + pen.x) * channels);
+    }
+
+    // Calculate uvs
+    glm::vec2 uvTopLeft{pen.x / static_cast<float>(this->_width), pen.y / static_cast<float>(this->_height)};
+    glm::vec2 uvBottomRight{(pen.x + bitmap.size.x) / static_cast<float>(this->_width),
+                            (pen.y + bitmap.size.y) / static_cast<float>(this->_height)};
+
+    // Update texture pen position
+    pen.x += bitmap.width;
+    currentRowHeight = std::max(currentRowHeight, bitmap.height);
+
+    return GlyphInfo{uvTopLeft, uvBottomRight};
+}
+
 /**
  * @brief Get all glyph indices in selected font
  *
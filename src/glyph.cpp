@@ -7,24 +7,6 @@
 
 namespace vft {
 
-/**
- * @brief Store line segment of glyph
- *
- * @param edge Line segment
- */
-void Glyph::addLineSegment(Edge edge) {
-    this->_lineSegments.push_back(edge);
-}
-
-/**
- * @brief Store curve segment of glyph
- *
- * @param curve Curve segment
- */
-void Glyph::addCurveSegment(Curve curve) {
-    this->_curveSegments.push_back(curve);
-}
-
 /**
  * @brief Get bounding box of glyph
  * 
@@ -46,42 +28,6 @@ std::array<glm::vec2, 4> Glyph::getBoundingBox() const {
     return {glm::vec2(xMin, yMin), glm::vec2(xMin, yMax), glm::vec2(xMax, yMax), glm::vec2(xMax, yMin)};
 }
 
-/**
- * @brief Get all line segments of glyph
- *
- * @return Line segments
- */
-const std::vector<Edge> &Glyph::getLineSegmentsIndices() const {
-    return this->_lineSegments;
-}
-
-/**
- * @brief Get all curve segments of glyph
- *
- * @return Curve segments
- */
-const std::vector<Curve> &Glyph::getCurveSegmentsIndices() const {
-    return this->_curveSegments;
-}
-
-/**
- * @brief Get count of indices used by all line segments. Each line segment consists of two indices
- *
- * @return Index count
- */
-uint32_t Glyph::getLineSegmentsIndexCount() const {
-    return this->_lineSegments.size() * 2;
-}
-
-/**
- * @brief Get count of indices used by all curve segments. Each curve segment consists of three indices
- *
- * @return Index count
- */
-uint32_t Glyph::getCurveSegmentsIndexCount() const {
-    return this->_curveSegments.size() * 3;
-}
-
 /**
  * @brief Setter for width of glyph
  *
@@ -10,12 +10,13 @@ namespace vft {
 /**
  * @brief GlyphKey constructor
  *
+ * @param strategy Strategy which composed glyph
  * @param fontName Fonat name of glyph
  * @param glyphId Glyph id of glyph
- * @param fontSize Font size of glyph
+ * @param fontSize Font size of glyph, 0 if mesh does not depend on font size
  */
-GlyphKey::GlyphKey(std::string fontName, uint32_t glyphId, unsigned int fontSize)
-    : fontName{fontName}, glyphId{glyphId}, fontSize{fontSize} {}
+GlyphKey::GlyphKey(TessellationStrategy strategy, std::string fontName, uint32_t glyphId, unsigned int fontSize)
+    : strategy{strategy}, fontName{fontName}, glyphId{glyphId}, fontSize{fontSize} {}
 
 /**
  * @brief GlyphCache constructor
@@ -35,7 +36,7 @@ GlyphCache::GlyphCache() : _maxSize{ULONG_MAX} {}
  * @param key Key of glyph to be added
  * @param glyph Glyph to be added
  */
-void GlyphCache::setGlyph(GlyphKey key, Glyph glyph) {
+void GlyphCache::setGlyph(GlyphKey key, std::shared_ptr<const Glyph> glyph) {
     if (this->_maxSize <= 0) {
         return;
     }
@@ -50,7 +51,7 @@ void GlyphCache::setGlyph(GlyphKey key, Glyph glyph) {
         this->_eraseLRU();
     }
 
-    this->_cache.insert({key, glyph});
+    this->_cache.insert({key, std::move(glyph)});
     this->_used.push_front(key);
 }
 
@@ -59,9 +60,9 @@ void GlyphCache::setGlyph(GlyphKey key, Glyph glyph) {
  *
  * @param key Key of glyph
  *
- * @return Glyph stored in cache
+ * @return Glyph stored in cache, it stays valid after it is evicted
  */
-const Glyph &GlyphCache::getGlyph(GlyphKey key) {
+std::shared_ptr<const Glyph> GlyphCache::getGlyph(GlyphKey key) {
     if (!this->exists(key)) {
         throw std::runtime_error("GlyphCache::getGlyph(): Glyph cache does not contain selected glyph");
     }
@@ -106,6 +107,7 @@ void GlyphCache::clearGlyph(GlyphKey key) {
  */
 void GlyphCache::clearAll() {
     this->_cache.clear();
+    this->_used.clear();
 }
 
 /**
@@ -13,6 +13,7 @@ namespace vft {
  * @brief Performs constrained delaunay triangulation on a glyph
  */
 std::vector<uint32_t> GlyphCompositor::triangulate(std::vector<glm::vec2> &vertices, std::vector<Edge> &edges) {
+    VFONT_PROFILE_ZONE("GlyphCompositor::triangulate");
     // CDT uses Constrained Delaunay Triangulation algorithm
     CDT::Triangulation<float> cdt{CDT::VertexInsertionOrder::Auto, CDT::IntersectingConstraintEdges::TryResolve,
                                   1.0e-6};
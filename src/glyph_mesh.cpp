@@ -8,71 +8,151 @@
 namespace vft {
 
 /**
- * @brief GlyphMesh constructor
+ * @brief GlyphMesh constructor, copies vertices and all index buffers into one allocation
  *
  * @param vertices Glyph's vertex buffer
  * @param indices Glyph's index buffers
  */
-GlyphMesh::GlyphMesh(std::vector<glm::vec2> vertices, std::vector<std::vector<uint32_t>> indices)
-    : _vertices{vertices}, _indices{indices} {}
+GlyphMesh::GlyphMesh(std::span<const glm::vec2> vertices, std::initializer_list<std::span<const uint32_t>> indices)
+    : _vertexCount{static_cast<uint32_t>(vertices.size())}, _drawCount{static_cast<unsigned int>(indices.size())} {
+    if (indices.size() > MAX_DRAW_COUNT) {
+        throw std::invalid_argument("GlyphMesh::GlyphMesh(): Mesh has more than MAX_DRAW_COUNT index buffers");
+    }
+
+    unsigned int drawIndex = 0;
+    for (std::span<const uint32_t> drawIndices : indices) {
+        this->_drawRanges[drawIndex++] = DrawRange{this->_indexCount, static_cast<uint32_t>(drawIndices.size())};
+        this->_indexCount += drawIndices.size();
+    }
+
+    if (this->_getSize() == 0) {
+        return;
+    }
+
+    // Objects of implicit-lifetime types are created in the byte array, indices are aligned as they follow vertices
+    this->_data = std::make_unique_for_overwrite<std::byte[]>(this->_getSize());
+    std::copy(vertices.begin(), vertices.end(), reinterpret_cast<glm::vec2 *>(this->_data.get()));
+
+    uint32_t *indexData = reinterpret_cast<uint32_t *>(this->_data.get() + vertices.size_bytes());
+    for (std::span<const uint32_t> drawIndices : indices) {
+        indexData = std::copy(drawIndices.begin(), drawIndices.end(), indexData);
+    }
+}
 
 /**
- * @brief GlyphMesh constructor
+ * @brief GlyphMesh copy constructor
+ *
+ * @param mesh Copied mesh
  */
-GlyphMesh::GlyphMesh() {
-    // Resize indices array to prevent index out of range exception in getIndices()
-    this->_indices.resize(10);
+GlyphMesh::GlyphMesh(const GlyphMesh &mesh)
+    : _vertexCount{mesh._vertexCount},
+      _indexCount{mesh._indexCount},
+      _drawCount{mesh._drawCount},
+      _drawRanges{mesh._drawRanges} {
+    if (mesh._data != nullptr) {
+        this->_data = std::make_unique_for_overwrite<std::byte[]>(this->_getSize());
+        std::copy_n(mesh._data.get(), this->_getSize(), this->_data.get());
+    }
 }
 
 /**
- * @brief Add vertex to vertex buffer
+ * @brief GlyphMesh copy assignment
+ *
+ * @param mesh Copied mesh
  *
- * @param vertex New Vertex
+ * @return This mesh
  */
-void GlyphMesh::addVertex(glm::vec2 vertex) {
-    this->_vertices.push_back(vertex);
+GlyphMesh &GlyphMesh::operator=(const GlyphMesh &mesh) {
+    if (this != &mesh) {
+        *this = GlyphMesh{mesh};
+    }
+
+    return *this;
 }
 
 /**
- * @brief Set vertex buffer of glyph
+ * @brief Get vertex buffer of glyph
  *
- * @param vertices New vertex buffer
+ * @return Vertex buffer
  */
-void GlyphMesh::setVertices(std::vector<glm::vec2> vertices) {
-    this->_vertices = vertices;
+std::span<const glm::vec2> GlyphMesh::getVertices() const {
+    return {reinterpret_cast<const glm::vec2 *>(this->_data.get()), this->_vertexCount};
 }
 
 /**
- * @brief Set one index buffer of glyph
- * @param drawIndex Index pointing to which index buffer to set from vector of index buffers
- * @param indices New index buffer
+ * @brief Get index buffer at given index
+ *
+ * @param drawIndex Index pointing to which index buffer to get, index buffers which were not set are empty
+ *
+ * @return Index buffer
  */
-void GlyphMesh::setIndices(unsigned int drawIndex, std::vector<uint32_t> indices) {
-    this->_indices.at(drawIndex) = indices;
+std::span<const uint32_t> GlyphMesh::getIndices(unsigned int drawIndex) const {
+    DrawRange range = this->getDrawRange(drawIndex);
+    return this->getAllIndices().subspan(range.offset, range.count);
 }
 
 /**
- * @brief Get vertex buffer of glyph
+ * @brief Get indices of all index buffers, which follow each other in order of their draw indices
  *
- * @return Vertex buffer
+ * @return Indices of all index buffers
  */
-const std::vector<glm::vec2> &GlyphMesh::getVertices() const {
-    return this->_vertices;
+std::span<const uint32_t> GlyphMesh::getAllIndices() const {
+    const std::byte *indexData = this->_data.get() + this->_vertexCount * sizeof(glm::vec2);
+    return {reinterpret_cast<const uint32_t *>(indexData), this->_indexCount};
 }
 
 /**
- * @brief Get index buffer at given index
+ * @brief Get range of index buffer at given index in indices of all index buffers
  *
- * @param drawIndex Index pointing to which index buffer to get from vector of index buffers
+ * @param drawIndex Index pointing to one specific index buffer
  *
- * @return Index buffer
+ * @return Offset and count of indices
+ */
+GlyphMesh::DrawRange GlyphMesh::getDrawRange(unsigned int drawIndex) const {
+    if (drawIndex >= MAX_DRAW_COUNT) {
+        throw std::out_of_range("GlyphMesh::getDrawRange(): Index is out of range");
+    }
+
+    return this->_drawRanges[drawIndex];
+}
+
+/**
+ * @brief Get vertex buffer of glyph with vertices rounded to whole font units and stored as 16-bit integers
+ *
+ * @return Quantized vertex buffer
  */
-const std::vector<uint32_t> &GlyphMesh::getIndices(unsigned int drawIndex) const {
-    if (drawIndex >= this->_indices.size()) {
-        throw std::out_of_range("GlyphMesh::getIndices(): Index is out of range");
+std::vector<glm::i16vec2> GlyphMesh::getQuantizedVertices() const {
+    std::vector<glm::i16vec2> vertices;
+    vertices.reserve(this->_vertexCount);
+
+    for (glm::vec2 vertex : this->getVertices()) {
+        glm::vec2 rounded{std::round(vertex.x), std::round(vertex.y)};
+        if (rounded.x < std::numeric_limits<int16_t>::min() || rounded.x > std::numeric_limits<int16_t>::max() ||
+            rounded.y < std::numeric_limits<int16_t>::min() || rounded.y > std::numeric_limits<int16_t>::max()) {
+            throw std::out_of_range("GlyphMesh::getQuantizedVertices(): Vertex does not fit into 16-bit integer");
+        }
+
+        vertices.push_back(glm::i16vec2{static_cast<int16_t>(rounded.x), static_cast<int16_t>(rounded.y)});
     }
 
-    return this->_indices.at(drawIndex);
+    return vertices;
+}
+
+/**
+ * @brief Get index buffer at given index with indices stored as 16-bit integers. Indices are relative to the start of
+ * glyph's vertex buffer, so the glyph can not have more than 65536 vertices
+ *
+ * @param drawIndex Index pointing to which index buffer to get
+ *
+ * @return Index buffer with 16-bit indices
+ */
+std::vector<uint16_t> GlyphMesh::getCompactIndices(unsigned int drawIndex) const {
+    if (this->_vertexCount > std::numeric_limits<uint16_t>::max() + 1) {
+        throw std::out_of_range("GlyphMesh::getCompactIndices(): Glyph has too many vertices for 16-bit indices");
+    }
+
+    std::span<const uint32_t> indices = this->getIndices(drawIndex);
+    return std::vector<uint16_t>(indices.begin(), indices.end());
 }
 
 /**
@@ -81,7 +161,7 @@ const std::vector<uint32_t> &GlyphMesh::getIndices(unsigned int drawIndex) const
  * @return Vertex count
  */
 uint32_t GlyphMesh::getVertexCount() const {
-    return this->_vertices.size();
+    return this->_vertexCount;
 }
 
 /**
@@ -91,7 +171,7 @@ uint32_t GlyphMesh::getVertexCount() const {
  * @return
  */
 uint32_t GlyphMesh::getIndexCount(unsigned int drawIndex) const {
-    return this->_indices.at(drawIndex).size();
+    return this->getDrawRange(drawIndex).count;
 }
 
 /**
@@ -100,7 +180,16 @@ uint32_t GlyphMesh::getIndexCount(unsigned int drawIndex) const {
  * @return Index buffer count
  */
 unsigned int GlyphMesh::getDrawCount() const {
-    return this->_indices.size();
+    return this->_drawCount;
+}
+
+/**
+ * @brief Get size of allocation storing vertices and indices
+ *
+ * @return Size in bytes
+ */
+std::size_t GlyphMesh::_getSize() const {
+    return this->_vertexCount * sizeof(glm::vec2) + this->_indexCount * sizeof(uint32_t);
 }
 
 }  // namespace vft
@@ -15,6 +15,7 @@ namespace vft {
  * @return Divided lines
  */
 const std::map<unsigned int, LineData> &LineDivider::divide(unsigned int startCharacterIndex) {
+    VFONT_PROFILE_ZONE("LineDivider::divide");
     if (startCharacterIndex >= this->_characters.size()) {
         throw std::out_of_range("LineDivider::divide(): Start index is out of bounds");
     }
@@ -0,0 +1,97 @@
+/**
+ * @file mapped_file.cpp
+ * @author Christian Saloň
+ */
+
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vft {
+
+/**
+ * @brief Maps whole file into memory for reading, the file is closed and only the mapping is kept
+ *
+ * @param fileName Path to file
+ */
+MappedFile::MappedFile(std::string fileName) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("MappedFile::MappedFile(): Error opening file " + fileName);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        throw std::runtime_error("MappedFile::MappedFile(): File " + fileName + " is empty");
+    }
+    this->_size = static_cast<size_t>(size.QuadPart);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        throw std::runtime_error("MappedFile::MappedFile(): Error mapping file " + fileName);
+    }
+
+    // View keeps the mapping alive after its handle is closed
+    this->_data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (this->_data == nullptr) {
+        throw std::runtime_error("MappedFile::MappedFile(): Error mapping file " + fileName);
+    }
+#else
+    int file = open(fileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("MappedFile::MappedFile(): Error opening file " + fileName);
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0) {
+        close(file);
+        throw std::runtime_error("MappedFile::MappedFile(): File " + fileName + " is empty");
+    }
+    this->_size = static_cast<size_t>(status.st_size);
+
+    // Mapping stays valid after the file descriptor is closed
+    void *data = mmap(nullptr, this->_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("MappedFile::MappedFile(): Error mapping file " + fileName);
+    }
+    this->_data = static_cast<const uint8_t *>(data);
+#endif
+}
+
+/**
+ * @brief Unmaps file
+ */
+MappedFile::~MappedFile() {
+#if defined(_WIN32)
+    UnmapViewOfFile(this->_data);
+#else
+    munmap(const_cast<uint8_t *>(this->_data), this->_size);
+#endif
+}
+
+/**
+ * @brief Getter for content of file
+ *
+ * @return Bytes of mapped file
+ */
+std::span<const uint8_t> MappedFile::getData() const {
+    return std::span<const uint8_t>{this->_data, this->_size};
+}
+
+}  // namespace vft
@@ -0,0 +1,253 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @author Christian Saloň
+ */
+
+#include "mesh_optimizer.h"
+
+namespace vft {
+
+/**
+ * @brief Computes average cache miss ratio before optimization
+ *
+ * @return Number of transformed vertices per triangle
+ */
+float VertexCacheStatistics::getAcmrBefore() const {
+    return this->triangleCount == 0 ? 0.f : static_cast<float>(this->cacheMissesBefore) / this->triangleCount;
+}
+
+/**
+ * @brief Computes average cache miss ratio after optimization
+ *
+ * @return Number of transformed vertices per triangle
+ */
+float VertexCacheStatistics::getAcmrAfter() const {
+    return this->triangleCount == 0 ? 0.f : static_cast<float>(this->cacheMissesAfter) / this->triangleCount;
+}
+
+/**
+ * @brief Reorders triangles for the post-transform vertex cache using the Tipsify algorithm. Triangles around a fanning
+ * vertex are emitted together and the next fanning vertex is chosen among vertices that are still in the cache.
+ *
+ * @param indices Index buffer of triangle list
+ * @param vertexCount Number of vertices referenced by index buffer
+ * @param cacheSize Number of vertices in the post-transform vertex cache
+ *
+ * @return Index buffer with reordered triangles
+ */
+std::vector<uint32_t> MeshOptimizer::optimizeVertexCache(const std::vector<uint32_t> &indices,
+                                                         uint32_t vertexCount,
+                                                         unsigned int cacheSize) {
+    if (indices.size() % 3 != 0) {
+        throw std::invalid_argument("MeshOptimizer::optimizeVertexCache(): Index count must be a multiple of 3");
+    }
+
+    uint32_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return indices;
+    }
+
+    // Count triangles adjacent to each vertex
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) {
+            throw std::out_of_range("MeshOptimizer::optimizeVertexCache(): Index is out of range");
+        }
+
+        liveTriangles.at(index)++;
+    }
+
+    // Create vertex to triangle adjacency list
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        adjacencyOffsets.at(i + 1) = adjacencyOffsets.at(i) + liveTriangles.at(i);
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32_t i = 0; i < indices.size(); i++) {
+        adjacency.at(adjacencyFill.at(indices.at(i))++) = i / 3;
+    }
+
+    std::vector<uint32_t> cacheTimestamps(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEndStack;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> optimizedIndices;
+    optimizedIndices.reserve(indices.size());
+
+    uint32_t timestamp = cacheSize + 1;
+    uint32_t cursor = 0;
+    int64_t fanningVertex = indices.at(0);
+
+    while (fanningVertex >= 0) {
+        candidates.clear();
+
+        // Emit all triangles around the fanning vertex
+        for (uint32_t i = adjacencyOffsets.at(fanningVertex); i < adjacencyOffsets.at(fanningVertex + 1); i++) {
+            uint32_t triangle = adjacency.at(i);
+            if (emitted.at(triangle)) {
+                continue;
+            }
+
+            for (uint32_t j = 0; j < 3; j++) {
+                uint32_t vertex = indices.at(3 * triangle + j);
+
+                optimizedIndices.push_back(vertex);
+                deadEndStack.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles.at(vertex)--;
+
+                // Vertex is transformed again only if it was evicted from the cache
+                if (timestamp - cacheTimestamps.at(vertex) > cacheSize) {
+                    cacheTimestamps.at(vertex) = timestamp++;
+                }
+            }
+
+            emitted.at(triangle) = true;
+        }
+
+        fanningVertex = MeshOptimizer::_getNextVertex(candidates, liveTriangles, cacheTimestamps, timestamp, cacheSize,
+                                                      deadEndStack, cursor);
+    }
+
+    return optimizedIndices;
+}
+
+/**
+ * @brief Reorders vertices in the order of their first use in index buffer and removes unused vertices
+ *
+ * @param vertices Vertex buffer to reorder
+ * @param indices Index buffer, indices are remapped to the reordered vertex buffer
+ */
+void MeshOptimizer::optimizeVertexFetch(std::vector<glm::vec2> &vertices, std::vector<uint32_t> &indices) {
+    constexpr uint32_t unused = UINT32_MAX;
+
+    std::vector<uint32_t> remap(vertices.size(), unused);
+    std::vector<glm::vec2> optimizedVertices;
+    optimizedVertices.reserve(vertices.size());
+
+    for (uint32_t &index : indices) {
+        if (remap.at(index) == unused) {
+            remap.at(index) = optimizedVertices.size();
+            optimizedVertices.push_back(vertices.at(index));
+        }
+
+        index = remap.at(index);
+    }
+
+    vertices = std::move(optimizedVertices);
+}
+
+/**
+ * @brief Simulates a fifo post-transform vertex cache and counts vertices that have to be transformed
+ *
+ * @param indices Index buffer of triangle list
+ * @param cacheSize Number of vertices in the post-transform vertex cache
+ *
+ * @return Number of cache misses
+ */
+uint64_t MeshOptimizer::computeCacheMissCount(const std::vector<uint32_t> &indices, unsigned int cacheSize) {
+    std::deque<uint32_t> cache;
+    uint64_t cacheMisses = 0;
+
+    for (uint32_t index : indices) {
+        if (std::find(cache.begin(), cache.end(), index) != cache.end()) {
+            continue;
+        }
+
+        cacheMisses++;
+        cache.push_back(index);
+        if (cache.size() > cacheSize) {
+            cache.pop_front();
+        }
+    }
+
+    return cacheMisses;
+}
+
+/**
+ * @brief Computes average cache miss ratio of fifo post-transform vertex cache. The ratio is between 0.5 for an ideal
+ * ordering of a large mesh and 3 for no vertex reuse
+ *
+ * @param indices Index buffer of triangle list
+ * @param cacheSize Number of vertices in the post-transform vertex cache
+ *
+ * @return Number of transformed vertices per triangle
+ */
+float MeshOptimizer::computeAcmr(const std::vector<uint32_t> &indices, unsigned int cacheSize) {
+    if (indices.size() < 3) {
+        return 0.f;
+    }
+
+    return static_cast<float>(MeshOptimizer::computeCacheMissCount(indices, cacheSize)) / (indices.size() / 3);
+}
+
+/**
+ * @brief Selects the next fanning vertex for the Tipsify algorithm. Prefers the oldest candidate vertex that stays in
+ * the cache after emitting all of its remaining triangles
+ *
+ * @param candidates Vertices of triangles emitted around the last fanning vertex
+ * @param liveTriangles Number of not yet emitted triangles adjacent to each vertex
+ * @param cacheTimestamps Time when each vertex entered the cache
+ * @param timestamp Current time
+ * @param cacheSize Number of vertices in the post-transform vertex cache
+ * @param deadEndStack Recently emitted vertices used when no candidate has remaining triangles
+ * @param cursor Position of the sequential search for vertices with remaining triangles
+ *
+ * @return Next fanning vertex or -1 if all triangles were emitted
+ */
+int64_t MeshOptimizer::_getNextVertex(const std::vector<uint32_t> &candidates,
+                                      const std::vector<uint32_t> &liveTriangles,
+                                      const std::vector<uint32_t> &cacheTimestamps,
+                                      uint32_t timestamp,
+                                      unsigned int cacheSize,
+                                      std::vector<uint32_t> &deadEndStack,
+                                      uint32_t &cursor) {
+    int64_t bestVertex = -1;
+    int64_t bestPriority = -1;
+
+    for (uint32_t vertex : candidates) {
+        if (liveTriangles.at(vertex) == 0) {
+            continue;
+        }
+
+        // Vertex is prioritized by its age in the cache if it stays in the cache while fanning
+        int64_t priority = 0;
+        if (timestamp - cacheTimestamps.at(vertex) + 2 * liveTriangles.at(vertex) <= cacheSize) {
+            priority = timestamp - cacheTimestamps.at(vertex);
+        }
+
+        if (priority > bestPriority) {
+            bestPriority = priority;
+            bestVertex = vertex;
+        }
+    }
+
+    if (bestVertex >= 0) {
+        return bestVertex;
+    }
+
+    // Dead end, continue with the most recently emitted vertex that has remaining triangles
+    while (!deadEndStack.empty()) {
+        uint32_t vertex = deadEndStack.back();
+        deadEndStack.pop_back();
+
+        if (liveTriangles.at(vertex) > 0) {
+            return vertex;
+        }
+    }
+
+    // Continue with any vertex that has remaining triangles
+    while (cursor < liveTriangles.size()) {
+        if (liveTriangles.at(cursor) > 0) {
+            return cursor;
+        }
+
+        cursor++;
+    }
+
+    return -1;
+}
+
+}  // namespace vft
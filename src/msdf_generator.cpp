@@ -0,0 +1,481 @@
+/**
+ * @file msdf_generator.cpp
+ * @author Christian Saloň
+ */
+
+#include "msdf_generator.h"
+
+namespace vft {
+
+/**
+ * @brief MsdfGenerator constructor, initializes freetype outline decompose functions which split outline into
+ * contours of edges
+ */
+MsdfGenerator::MsdfGenerator() {
+    this->_moveToFunc = [](const FT_Vector *to, void *user) {
+        MsdfGenerator *pThis = reinterpret_cast<MsdfGenerator *>(user);
+
+        // Start processing new contour
+        pThis->_contours.push_back({});
+        pThis->_lastPoint = glm::dvec2{static_cast<double>(to->x), static_cast<double>(to->y)};
+
+        return 0;
+    };
+
+    this->_lineToFunc = [](const FT_Vector *to, void *user) {
+        MsdfGenerator *pThis = reinterpret_cast<MsdfGenerator *>(user);
+
+        // Skip edges with zero length, their direction is not defined
+        glm::dvec2 endPoint{static_cast<double>(to->x), static_cast<double>(to->y)};
+        if (endPoint != pThis->_lastPoint) {
+            pThis->_contours.back().push_back(Edge{{pThis->_lastPoint, pThis->_lastPoint, endPoint}, false});
+        }
+
+        pThis->_lastPoint = endPoint;
+
+        return 0;
+    };
+
+    this->_conicToFunc = [](const FT_Vector *control, const FT_Vector *to, void *user) {
+        MsdfGenerator *pThis = reinterpret_cast<MsdfGenerator *>(user);
+
+        glm::dvec2 controlPoint{static_cast<double>(control->x), static_cast<double>(control->y)};
+        glm::dvec2 endPoint{static_cast<double>(to->x), static_cast<double>(to->y)};
+        if (endPoint != pThis->_lastPoint || controlPoint != pThis->_lastPoint) {
+            pThis->_contours.back().push_back(Edge{{pThis->_lastPoint, controlPoint, endPoint}, true});
+        }
+
+        pThis->_lastPoint = endPoint;
+
+        return 0;
+    };
+
+    this->_cubicToFunc = [](const FT_Vector *control1, const FT_Vector *control2, const FT_Vector *to, void *user) {
+        throw std::runtime_error("MsdfGenerator::_cubicToFunc(): Fonts with cubic bezier curves are not supported");
+        return 0;
+    };
+}
+
+/**
+ * @brief Generates multi-channel signed distance field of glyph. The area of bitmap in font units matches the bitmap
+ * of the freetype sdf rasterizer at the font's pixel size, so that glyphs composed by SdfTessellator are covered by
+ * the whole bitmap
+ *
+ * @param glyphId Id of glyph
+ * @param font Font of glyph
+ * @param pixelSize Size of em square in pixels of generated bitmap
+ *
+ * @return Multi-channel signed distance field, empty if glyph has no outline
+ */
+MsdfGenerator::Bitmap MsdfGenerator::generate(uint32_t glyphId, std::shared_ptr<Font> font, unsigned int pixelSize) {
+    VFONT_PROFILE_ZONE("MsdfGenerator::generate");
+
+    // Get glyph outline in font units from .ttf file
+    if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_NO_SCALE)) {
+        throw std::runtime_error("MsdfGenerator::generate(): Error loading glyph");
+    }
+    FT_Outline &outline = font->getFace()->glyph->outline;
+
+    // Decompose outline to contours of line segments and quadratic bezier curves
+    this->_contours.clear();
+    FT_Outline_Funcs outlineFunctions{.move_to = this->_moveToFunc,
+                                      .line_to = this->_lineToFunc,
+                                      .conic_to = this->_conicToFunc,
+                                      .cubic_to = this->_cubicToFunc,
+                                      .shift = 0,
+                                      .delta = 0};
+    FT_Outline_Decompose(&outline, &outlineFunctions, this);
+
+    std::erase_if(this->_contours, [](const std::vector<Edge> &contour) { return contour.empty(); });
+    if (this->_contours.empty()) {
+        return Bitmap{};
+    }
+
+    for (std::vector<Edge> &contour : this->_contours) {
+        this->_colorEdges(contour);
+    }
+
+    // Distances are positive on the right side of edges, which is the inside of truetype outlines
+    double orientation = FT_Outline_Get_Orientation(&outline) == FT_ORIENTATION_POSTSCRIPT ? -1 : 1;
+
+    // Bounds are rounded to whole pixels and padded by spread at the font's pixel size like in freetype
+    FT_BBox boundingBox;
+    FT_Outline_Get_CBox(&outline, &boundingBox);
+    glm::dvec2 scale{font->getScalingVector(font->getPixelSize())};
+    glm::dvec2 min{(std::floor(boundingBox.xMin * scale.x) - SPREAD) / scale.x,
+                   (std::floor(boundingBox.yMin * scale.y) - SPREAD) / scale.y};
+    glm::dvec2 max{(std::ceil(boundingBox.xMax * scale.x) + SPREAD) / scale.x,
+                   (std::ceil(boundingBox.yMax * scale.y) + SPREAD) / scale.y};
+
+    glm::dvec2 bitmapScale = scale * (static_cast<double>(pixelSize) / font->getPixelSize());
+    double range = SPREAD / scale.x;
+
+    Bitmap bitmap{};
+    bitmap.size = glm::vec2{(max - min) * bitmapScale};
+    bitmap.width = static_cast<unsigned int>(std::ceil(bitmap.size.x));
+    bitmap.height = static_cast<unsigned int>(std::ceil(bitmap.size.y));
+    bitmap.pixels.assign(bitmap.width * bitmap.height * 4, 0);
+
+    for (unsigned int y = 0; y < bitmap.height; y++) {
+        for (unsigned int x = 0; x < bitmap.width; x++) {
+            // Rows of bitmap are stored from top to bottom
+            glm::dvec2 point{min.x + (x + 0.5) / bitmapScale.x, max.y - (y + 0.5) / bitmapScale.y};
+
+            // Find closest edge of every channel
+            std::array<ChannelDistance, 3> channels{};
+            SignedDistance trueDistance{};
+            for (const std::vector<Edge> &contour : this->_contours) {
+                for (const Edge &edge : contour) {
+                    double parameter = 0;
+                    SignedDistance distance = this->_getSignedDistance(edge, point, parameter);
+                    if (distance < trueDistance) {
+                        trueDistance = distance;
+                    }
+
+                    for (unsigned int i = 0; i < channels.size(); i++) {
+                        if ((edge.color & (1 << i)) && distance < channels[i].minDistance) {
+                            channels[i] = ChannelDistance{distance, &edge, parameter};
+                        }
+                    }
+                }
+            }
+
+            std::array<double, 3> distances{};
+            for (unsigned int i = 0; i < channels.size(); i++) {
+                distances[i] = channels[i].edge == nullptr
+                                   ? trueDistance.distance
+                                   : this->_getPseudoDistance(*channels[i].edge, point, channels[i].minDistance,
+                                                              channels[i].parameter);
+            }
+
+            // Pixels where median of channels is on the other side of outline would produce artifacts
+            if ((_median(distances[0], distances[1], distances[2]) > 0) != (trueDistance.distance > 0)) {
+                distances.fill(trueDistance.distance);
+            }
+
+            uint8_t *pixel = &bitmap.pixels[(y * bitmap.width + x) * 4];
+            for (unsigned int i = 0; i < distances.size(); i++) {
+                pixel[i] = _encodeDistance(orientation * distances[i], range);
+            }
+            pixel[3] = _encodeDistance(orientation * trueDistance.distance, range);
+        }
+    }
+
+    return bitmap;
+}
+
+/**
+ * @brief Assigns colors to edges of contour. Edges between two corners form a spline with one color, neighbouring
+ * splines always share exactly one channel
+ *
+ * @param contour Edges of closed contour
+ */
+void MsdfGenerator::_colorEdges(std::vector<Edge> &contour) const {
+    std::vector<unsigned int> corners;
+    glm::dvec2 previousDirection = this->_getDirection(contour.back(), 1);
+    for (unsigned int i = 0; i < contour.size(); i++) {
+        if (_isCorner(glm::normalize(previousDirection), glm::normalize(this->_getDirection(contour[i], 0)))) {
+            corners.push_back(i);
+        }
+
+        previousDirection = this->_getDirection(contour[i], 1);
+    }
+
+    // Smooth contour does not need multiple channels
+    unsigned int edgeCount = contour.size();
+    if (corners.empty() || (corners.size() == 1 && edgeCount < 3)) {
+        for (Edge &edge : contour) {
+            edge.color = WHITE;
+        }
+
+        return;
+    }
+
+    // Contour with one corner is split into three parts, the corner lies between the first and the last one
+    if (corners.size() == 1) {
+        const std::array<uint8_t, 3> colors{MAGENTA, WHITE, YELLOW};
+        for (unsigned int i = 0; i < edgeCount; i++) {
+            int part = static_cast<int>(3 + 2.875 * i / (edgeCount - 1) - 1.4375 + 0.5) - 3;
+            contour[(corners[0] + i) % edgeCount].color = colors[1 + part];
+        }
+
+        return;
+    }
+
+    const std::array<uint8_t, 3> colors{CYAN, MAGENTA, YELLOW};
+    unsigned int spline = 0;
+    for (unsigned int i = 0; i < edgeCount; i++) {
+        unsigned int index = (corners[0] + i) % edgeCount;
+        if (spline + 1 < corners.size() && corners[spline + 1] == index) {
+            spline++;
+        }
+
+        // Last spline neighbours the first one, so both of them can not have the same color
+        uint8_t color = colors[spline % 3];
+        if (spline == corners.size() - 1 && corners.size() % 3 == 1) {
+            color = colors[1];
+        }
+
+        contour[index].color = color;
+    }
+}
+
+/**
+ * @brief Computes signed distance from point to edge, it is positive if point lies on the right side of edge
+ *
+ * @param edge Line segment or quadratic bezier curve
+ * @param point Point in font units
+ * @param parameter Parameter of the closest point on edge, outside of [0, 1] if closest point is an end point
+ *
+ * @return Signed distance
+ */
+MsdfGenerator::SignedDistance MsdfGenerator::_getSignedDistance(const Edge &edge,
+                                                                glm::dvec2 point,
+                                                                double &parameter) const {
+    const glm::dvec2 &p0 = edge.points[0];
+    const glm::dvec2 &p1 = edge.points[1];
+    const glm::dvec2 &p2 = edge.points[2];
+
+    if (!edge.isCurve) {
+        glm::dvec2 aq = point - p0;
+        glm::dvec2 ab = p2 - p0;
+        parameter = glm::dot(aq, ab) / glm::dot(ab, ab);
+
+        glm::dvec2 eq = (parameter > 0.5 ? p2 : p0) - point;
+        double endPointDistance = glm::length(eq);
+        if (parameter > 0 && parameter < 1) {
+            double orthogonalDistance = _cross(aq, ab) / glm::length(ab);
+            if (std::abs(orthogonalDistance) < endPointDistance) {
+                return SignedDistance{orthogonalDistance, 0};
+            }
+        }
+
+        double dot = endPointDistance > 0 ? std::abs(glm::dot(glm::normalize(ab), eq / endPointDistance)) : 0;
+        return SignedDistance{(_cross(aq, ab) > 0 ? 1 : -1) * endPointDistance, dot};
+    }
+
+    // Closest point on curve is a root of cubic equation or one of the end points
+    glm::dvec2 qa = p0 - point;
+    glm::dvec2 ab = p1 - p0;
+    glm::dvec2 br = p2 - p1 - ab;
+    std::array<double, 3> roots{};
+    int rootCount = _solveCubic(roots, glm::dot(br, br), 3 * glm::dot(ab, br),
+                                2 * glm::dot(ab, ab) + glm::dot(qa, br), glm::dot(qa, ab));
+
+    glm::dvec2 startDirection = this->_getDirection(edge, 0);
+    double minDistance = (_cross(startDirection, qa) > 0 ? 1 : -1) * glm::length(qa);
+    parameter = -glm::dot(qa, startDirection) / glm::dot(startDirection, startDirection);
+
+    glm::dvec2 endDirection = this->_getDirection(edge, 1);
+    double endDistance = glm::length(p2 - point);
+    if (endDistance < std::abs(minDistance)) {
+        minDistance = (_cross(endDirection, p2 - point) > 0 ? 1 : -1) * endDistance;
+        parameter = glm::dot(point - p1, endDirection) / glm::dot(endDirection, endDirection);
+    }
+
+    for (int i = 0; i < rootCount; i++) {
+        double t = roots[i];
+        if (t <= 0 || t >= 1) {
+            continue;
+        }
+
+        glm::dvec2 qe = qa + 2 * t * ab + t * t * br;
+        double distance = glm::length(qe);
+        if (distance <= std::abs(minDistance)) {
+            minDistance = (_cross(ab + t * br, qe) > 0 ? 1 : -1) * distance;
+            parameter = t;
+        }
+    }
+
+    if (parameter >= 0 && parameter <= 1) {
+        return SignedDistance{minDistance, 0};
+    }
+
+    glm::dvec2 endPointVector = parameter < 0.5 ? qa : p2 - point;
+    glm::dvec2 direction = parameter < 0.5 ? startDirection : endDirection;
+    double length = glm::length(endPointVector);
+    double dot = length > 0 ? std::abs(glm::dot(glm::normalize(direction), endPointVector / length)) : 0;
+    return SignedDistance{minDistance, dot};
+}
+
+/**
+ * @brief Computes pseudo-distance, which is the distance to edge extended by tangents at its end points
+ *
+ * @param edge Line segment or quadratic bezier curve
+ * @param point Point in font units
+ * @param distance Signed distance from point to edge
+ * @param parameter Parameter of the closest point on edge
+ *
+ * @return Signed pseudo-distance
+ */
+double MsdfGenerator::_getPseudoDistance(const Edge &edge,
+                                         glm::dvec2 point,
+                                         SignedDistance distance,
+                                         double parameter) const {
+    if (parameter < 0) {
+        glm::dvec2 direction = glm::normalize(this->_getDirection(edge, 0));
+        glm::dvec2 aq = point - edge.points[0];
+        if (glm::dot(aq, direction) < 0) {
+            double pseudoDistance = _cross(aq, direction);
+            if (std::abs(pseudoDistance) <= std::abs(distance.distance)) {
+                return pseudoDistance;
+            }
+        }
+    } else if (parameter > 1) {
+        glm::dvec2 direction = glm::normalize(this->_getDirection(edge, 1));
+        glm::dvec2 bq = point - edge.points[2];
+        if (glm::dot(bq, direction) > 0) {
+            double pseudoDistance = _cross(bq, direction);
+            if (std::abs(pseudoDistance) <= std::abs(distance.distance)) {
+                return pseudoDistance;
+            }
+        }
+    }
+
+    return distance.distance;
+}
+
+/**
+ * @brief Get direction of edge at given parameter
+ *
+ * @param edge Line segment or quadratic bezier curve
+ * @param parameter Parameter in range [0, 1]
+ *
+ * @return Tangent direction, not normalized
+ */
+glm::dvec2 MsdfGenerator::_getDirection(const Edge &edge, double parameter) const {
+    if (!edge.isCurve) {
+        return edge.points[2] - edge.points[0];
+    }
+
+    // Control point can coincide with an end point
+    glm::dvec2 direction = glm::mix(edge.points[1] - edge.points[0], edge.points[2] - edge.points[1], parameter);
+    if (direction == glm::dvec2{0, 0}) {
+        return edge.points[2] - edge.points[0];
+    }
+
+    return direction;
+}
+
+/**
+ * @brief Checks whether two directions meeting at a point form a corner
+ *
+ * @param a Normalized direction at the end of first edge
+ * @param b Normalized direction at the start of second edge
+ *
+ * @return True if directions form a corner, else false
+ */
+bool MsdfGenerator::_isCorner(glm::dvec2 a, glm::dvec2 b) {
+    return glm::dot(a, b) <= 0 || std::abs(_cross(a, b)) > std::sin(CORNER_ANGLE_THRESHOLD);
+}
+
+/**
+ * @brief Computes z coordinate of cross product of two 2D vectors
+ *
+ * @param a First vector
+ * @param b Second vector
+ *
+ * @return Cross product
+ */
+double MsdfGenerator::_cross(glm::dvec2 a, glm::dvec2 b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+/**
+ * @brief Computes median of three values
+ *
+ * @return Median
+ */
+double MsdfGenerator::_median(double a, double b, double c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+/**
+ * @brief Finds real roots of equation ax^3 + bx^2 + cx + d = 0
+ *
+ * @param roots Found roots
+ *
+ * @return Number of found roots
+ */
+int MsdfGenerator::_solveCubic(std::array<double, 3> &roots, double a, double b, double c, double d) {
+    // Numerical error is smaller if equations with very small a are solved as quadratic
+    if (a == 0 || std::abs(b / a) >= 1e6) {
+        return _solveQuadratic(roots, b, c, d);
+    }
+
+    // Normalize equation to x^3 + bx^2 + cx + d = 0 and solve it using the trigonometric or cardano's method
+    b /= a;
+    c /= a;
+    d /= a;
+
+    double q = (b * b - 3 * c) / 9;
+    double r = (b * (2 * b * b - 9 * c) + 27 * d) / 54;
+    double q3 = q * q * q;
+    b /= 3;
+
+    if (r * r < q3) {
+        double t = std::acos(std::clamp(r / std::sqrt(q3), -1.0, 1.0));
+        double m = -2 * std::sqrt(q);
+        roots[0] = m * std::cos(t / 3) - b;
+        roots[1] = m * std::cos((t + 2 * std::numbers::pi) / 3) - b;
+        roots[2] = m * std::cos((t - 2 * std::numbers::pi) / 3) - b;
+        return 3;
+    }
+
+    double u = (r < 0 ? 1 : -1) * std::pow(std::abs(r) + std::sqrt(r * r - q3), 1.0 / 3);
+    double v = u == 0 ? 0 : q / u;
+    roots[0] = u + v - b;
+    if (u == v || std::abs(u - v) < 1e-12 * std::abs(u + v)) {
+        roots[1] = -0.5 * (u + v) - b;
+        return 2;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Finds real roots of equation ax^2 + bx + c = 0
+ *
+ * @param roots Found roots
+ *
+ * @return Number of found roots
+ */
+int MsdfGenerator::_solveQuadratic(std::array<double, 3> &roots, double a, double b, double c) {
+    if (a == 0 || std::abs(b) > 1e12 * std::abs(a)) {
+        if (b == 0) {
+            return 0;
+        }
+
+        roots[0] = -c / b;
+        return 1;
+    }
+
+    double discriminant = b * b - 4 * a * c;
+    if (discriminant > 0) {
+        discriminant = std::sqrt(discriminant);
+        roots[0] = (-b + discriminant) / (2 * a);
+        roots[1] = (-b - discriminant) / (2 * a);
+        return 2;
+    }
+
+    if (discriminant == 0) {
+        roots[0] = -0.5 * b / a;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Maps signed distance to byte, zero distance is mapped to the middle of the range
+ *
+ * @param distance Signed distance in font units
+ * @param range Distance in font units which is mapped to the maximal value
+ *
+ * @return Encoded distance
+ */
+uint8_t MsdfGenerator::_encodeDistance(double distance, double range) {
+    return static_cast<uint8_t>(std::clamp(0.5 + distance / (2 * range), 0.0, 1.0) * 255.0 + 0.5);
+}
+
+}  // namespace vft
@@ -19,6 +19,7 @@ namespace vft {
 void PolygonOperator::join(const std::vector<glm::vec2> &vertices,
                            const std::vector<CircularDLL<Edge>> &first,
                            const std::vector<CircularDLL<Edge>> &second) {
+    VFONT_PROFILE_ZONE("PolygonOperator::join");
     this->_initializeContours(vertices, first, second);
     this->_resolveOverlappingEdges();
     this->_resolveIntersectingEdges();
@@ -0,0 +1,164 @@
+/**
+ * @file profiler.cpp
+ * @author Christian Saloň
+ */
+
+#include "profiler.h"
+
+namespace vft {
+
+std::mutex Profiler::_mutex{};
+std::chrono::steady_clock::time_point Profiler::_epoch{std::chrono::steady_clock::now()};
+std::vector<Profiler::Zone> Profiler::_zones{};
+std::vector<Profiler::CounterSample> Profiler::_counterSamples{};
+std::map<std::string, uint64_t> Profiler::_counters{};
+std::map<std::thread::id, unsigned int> Profiler::_threadIndices{};
+
+/**
+ * @brief Records time spent in a zone
+ *
+ * @param name Name of zone, must outlive the profiler
+ * @param start Time when zone was entered
+ * @param end Time when zone was left
+ */
+void Profiler::addZone(const char *name,
+                       std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto thread = _threadIndices.try_emplace(std::this_thread::get_id(), _threadIndices.size()).first;
+    int64_t startTime = _getTime(start);
+    _zones.push_back(Zone{name, startTime, _getTime(end) - startTime, thread->second});
+}
+
+/**
+ * @brief Increases value of a counter
+ *
+ * @param name Name of counter, must outlive the profiler
+ * @param value Value added to counter
+ */
+void Profiler::addCounter(const char *name, uint64_t value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t &counter = _counters[name];
+    counter += value;
+    _counterSamples.push_back(CounterSample{name, _getTime(std::chrono::steady_clock::now()), counter});
+}
+
+/**
+ * @brief Get current values of all counters
+ *
+ * @return Values of counters by their name
+ */
+std::map<std::string, uint64_t> Profiler::getCounters() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _counters;
+}
+
+/**
+ * @brief Get total time spent in zones with the same name
+ *
+ * @return Total times in milliseconds by name of zone
+ */
+std::map<std::string, double> Profiler::getZoneTimes() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::map<std::string, double> times;
+    for (const Zone &zone : _zones) {
+        times[zone.name] += zone.duration / 1000.0;
+    }
+
+    return times;
+}
+
+/**
+ * @brief Removes all recorded zones and counters and restarts time of profiling
+ */
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _epoch = std::chrono::steady_clock::now();
+    _zones.clear();
+    _counterSamples.clear();
+    _counters.clear();
+}
+
+/**
+ * @brief Writes recorded zones and counters into a file in chrome trace json format, which can be opened in
+ * chrome://tracing or perfetto
+ *
+ * @param fileName Path of output file
+ */
+void Profiler::writeChromeTrace(const std::string &fileName) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::ofstream file(fileName);
+    if (!file.is_open()) {
+        throw std::runtime_error("Profiler::writeChromeTrace(): Could not open file " + fileName);
+    }
+
+    file << "{\"traceEvents\":[";
+
+    bool isFirst = true;
+    for (const Zone &zone : _zones) {
+        file << (isFirst ? "\n" : ",\n");
+        file << "{\"name\":\"" << _escape(zone.name) << "\",\"cat\":\"vfont\",\"ph\":\"X\",\"ts\":" << zone.start
+             << ",\"dur\":" << zone.duration << ",\"pid\":0,\"tid\":" << zone.thread << "}";
+        isFirst = false;
+    }
+
+    for (const CounterSample &sample : _counterSamples) {
+        file << (isFirst ? "\n" : ",\n");
+        file << "{\"name\":\"" << _escape(sample.name) << "\",\"cat\":\"vfont\",\"ph\":\"C\",\"ts\":" << sample.time
+             << ",\"pid\":0,\"args\":{\"value\":" << sample.value << "}}";
+        isFirst = false;
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+/**
+ * @brief Converts time point to microseconds since the start of profiling, mutex must be locked
+ *
+ * @param time Time point
+ *
+ * @return Microseconds since the start of profiling
+ */
+int64_t Profiler::_getTime(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - _epoch).count();
+}
+
+/**
+ * @brief Escapes quotes and backslashes so that text can be written into json string
+ *
+ * @param text Text to escape
+ *
+ * @return Escaped text
+ */
+std::string Profiler::_escape(const char *text) {
+    std::string escaped;
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(*c);
+    }
+
+    return escaped;
+}
+
+/**
+ * @brief Enters zone
+ *
+ * @param name Name of zone, must outlive the profiler
+ */
+ProfilerZone::ProfilerZone(const char *name) : _name{name}, _start{std::chrono::steady_clock::now()} {}
+
+/**
+ * @brief Leaves zone and records it
+ */
+ProfilerZone::~ProfilerZone() {
+    Profiler::addZone(this->_name, this->_start, std::chrono::steady_clock::now());
+}
+
+}  // namespace vft
@@ -0,0 +1,356 @@
+/**
+ * @file sdf_generator.cpp
+ * @author Christian Saloň
+ */
+
+#include "sdf_generator.h"
+
+namespace vft {
+
+/**
+ * @brief Generates signed distance field of glyph. Bitmap is the bounding box of glyph rounded to whole pixels and
+ * padded by spread on every side, same as the bitmap of the freetype sdf rasterizer
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param scale Scale from font units to pixels
+ * @param spread Maximal distance in pixels, larger distances are clamped
+ *
+ * @return Signed distance field, empty if glyph has no segments
+ */
+SdfGenerator::Bitmap SdfGenerator::generate(const Glyph &glyph, glm::vec2 scale, unsigned int spread) {
+    std::span<const glm::vec2> vertices = glyph.mesh.getVertices();
+    std::span<const uint32_t> lineIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
+    std::span<const uint32_t> curveIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+
+    if (lineIndices.empty() && curveIndices.empty()) {
+        return Bitmap{};
+    }
+
+    // Bounds of control points are rounded to whole pixels and padded by spread like in freetype, which first rounds
+    // points to 1/64 of pixel
+    glm::vec2 min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    glm::vec2 max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for (std::span<const uint32_t> indices : {lineIndices, curveIndices}) {
+        for (uint32_t index : indices) {
+            min = glm::min(min, vertices[index] * scale);
+            max = glm::max(max, vertices[index] * scale);
+        }
+    }
+    glm::vec2 padding{static_cast<float>(spread), static_cast<float>(spread)};
+    min = glm::floor(glm::round(min * 64.f) / 64.f) - padding;
+    max = glm::ceil(glm::round(max * 64.f) / 64.f) + padding;
+
+    return this->generate(glyph, scale, min, max, static_cast<float>(spread));
+}
+
+/**
+ * @brief Generates signed distance field of glyph in given bounds. Width and height of bitmap are the size of bounds
+ * rounded up, so that sdfs of one glyph at different scales can cover the same area
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param scale Scale from font units to pixels
+ * @param min Bottom left corner of bitmap in pixels
+ * @param max Top right corner of bitmap in pixels
+ * @param spread Maximal distance in pixels, larger distances are clamped
+ *
+ * @return Signed distance field, empty if glyph has no segments
+ */
+SdfGenerator::Bitmap SdfGenerator::generate(const Glyph &glyph,
+                                            glm::vec2 scale,
+                                            glm::vec2 min,
+                                            glm::vec2 max,
+                                            float spread) {
+    VFONT_PROFILE_ZONE("SdfGenerator::generate");
+
+    std::span<const glm::vec2> vertices = glyph.mesh.getVertices();
+    std::span<const uint32_t> lineIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
+    std::span<const uint32_t> curveIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+
+    if (lineIndices.empty() && curveIndices.empty()) {
+        return Bitmap{};
+    }
+
+    Bitmap bitmap{};
+    bitmap.width = static_cast<unsigned int>(std::ceil(max.x - min.x));
+    bitmap.height = static_cast<unsigned int>(std::ceil(max.y - min.y));
+    bitmap.pixels.assign(bitmap.width * bitmap.height, 0);
+
+    // Transform segments to pixel coordinates of bitmap, where rows are stored from top to bottom
+    auto transform = [&](uint32_t index) {
+        glm::vec2 vertex = vertices[index];
+        return glm::vec2{vertex.x * scale.x - min.x, max.y - vertex.y * scale.y};
+    };
+
+    this->_lines.clear();
+    for (unsigned int i = 0; i < lineIndices.size(); i += 2) {
+        glm::vec2 start = transform(lineIndices[i]);
+        glm::vec2 end = transform(lineIndices[i + 1]);
+        this->_lines.push_back(Segment{start, start, end});
+    }
+
+    this->_curves.clear();
+    for (unsigned int i = 0; i < curveIndices.size(); i += 3) {
+        Segment curve{transform(curveIndices[i]), transform(curveIndices[i + 1]), transform(curveIndices[i + 2])};
+
+        // Curves with control point close to the middle of start and end are almost lines, and the cubic equation of
+        // their closest points would lose precision
+        glm::vec2 curvature = curve.start - 2.f * curve.control + curve.end;
+        if (curvature.x * curvature.x + curvature.y * curvature.y < 1e-4f) {
+            this->_lines.push_back(Segment{curve.start, curve.start, curve.end});
+        } else {
+            this->_curves.push_back(curve);
+        }
+    }
+
+    unsigned int columns = (bitmap.width + CELL_SIZE - 1) / CELL_SIZE;
+    unsigned int rows = (bitmap.height + CELL_SIZE - 1) / CELL_SIZE;
+    this->_createGrid(columns, rows, spread);
+
+    std::array<float, LANES> x{};
+    std::array<float, LANES> distances{};
+    float maxDistance = spread * spread;
+
+    for (unsigned int y = 0; y < bitmap.height; y++) {
+        float centerY = y + 0.5f;
+
+        // Winding number of pixel is the sum of windings of crossings on the right side of the pixel
+        this->_findCrossings(centerY);
+        float totalWinding = 0;
+        for (const std::pair<float, float> &crossing : this->_crossings) {
+            totalWinding += crossing.second;
+        }
+        float leftWinding = 0;
+        unsigned int crossing = 0;
+
+        for (unsigned int column = 0; column < columns; column++) {
+            unsigned int cell = (y / CELL_SIZE) * columns + column;
+            for (unsigned int lane = 0; lane < LANES; lane++) {
+                x[lane] = column * CELL_SIZE + lane + 0.5f;
+                distances[lane] = maxDistance;
+            }
+
+            // Only segments closer than spread to the cell can be closer than spread to its pixels
+            for (uint32_t line : this->_cellLines[cell]) {
+                SdfGenerator::_getLineDistances(this->_lines[line], x, centerY, distances);
+            }
+            for (uint32_t curve : this->_cellCurves[cell]) {
+                SdfGenerator::_getCurveDistances(this->_curves[curve], x, centerY, distances);
+            }
+
+            for (unsigned int lane = 0; lane < LANES && column * CELL_SIZE + lane < bitmap.width; lane++) {
+                while (crossing < this->_crossings.size() && this->_crossings[crossing].first <= x[lane]) {
+                    leftWinding += this->_crossings[crossing].second;
+                    crossing++;
+                }
+
+                float distance = std::sqrt(distances[lane]);
+                bool isInside = totalWinding - leftWinding != 0;
+                bitmap.pixels[y * bitmap.width + column * CELL_SIZE + lane] =
+                    SdfGenerator::_encodeDistance(isInside ? distance : -distance, spread);
+            }
+        }
+    }
+
+    return bitmap;
+}
+
+/**
+ * @brief Assigns segments to cells of grid whose pixels can be closer than spread to them
+ *
+ * @param columns Number of cells in a row of grid
+ * @param rows Number of cells in a column of grid
+ * @param spread Maximal distance in pixels
+ */
+void SdfGenerator::_createGrid(unsigned int columns, unsigned int rows, float spread) {
+    this->_cellLines.resize(columns * rows);
+    this->_cellCurves.resize(columns * rows);
+    for (unsigned int i = 0; i < columns * rows; i++) {
+        this->_cellLines[i].clear();
+        this->_cellCurves[i].clear();
+    }
+
+    auto assign = [&](const std::vector<Segment> &segments, std::vector<std::vector<uint32_t>> &cells) {
+        for (uint32_t i = 0; i < segments.size(); i++) {
+            const Segment &segment = segments[i];
+
+            // Curve lies in the bounding box of its control points
+            glm::vec2 min{std::min({segment.start.x, segment.control.x, segment.end.x}) - spread,
+                          std::min({segment.start.y, segment.control.y, segment.end.y}) - spread};
+            glm::vec2 max{std::max({segment.start.x, segment.control.x, segment.end.x}) + spread,
+                          std::max({segment.start.y, segment.control.y, segment.end.y}) + spread};
+
+            int firstColumn = std::max(static_cast<int>(std::floor(min.x / CELL_SIZE)), 0);
+            int lastColumn = std::min(static_cast<int>(std::floor(max.x / CELL_SIZE)), static_cast<int>(columns) - 1);
+            int firstRow = std::max(static_cast<int>(std::floor(min.y / CELL_SIZE)), 0);
+            int lastRow = std::min(static_cast<int>(std::floor(max.y / CELL_SIZE)), static_cast<int>(rows) - 1);
+
+            for (int row = firstRow; row <= lastRow; row++) {
+                for (int column = firstColumn; column <= lastColumn; column++) {
+                    cells[row * columns + column].push_back(i);
+                }
+            }
+        }
+    };
+
+    assign(this->_lines, this->_cellLines);
+    assign(this->_curves, this->_cellCurves);
+}
+
+/**
+ * @brief Finds intersections of a horizontal line with all segments sorted by x. Segments are crossed on a half-open
+ * interval in y, so endpoints shared by consecutive segments are counted once
+ *
+ * @param y Y coordinate of horizontal line
+ */
+void SdfGenerator::_findCrossings(float y) {
+    this->_crossings.clear();
+
+    for (const Segment &line : this->_lines) {
+        if ((line.start.y <= y) == (line.end.y <= y)) {
+            continue;
+        }
+
+        float x = line.start.x + (y - line.start.y) * (line.end.x - line.start.x) / (line.end.y - line.start.y);
+        this->_crossings.push_back({x, line.end.y > line.start.y ? 1.f : -1.f});
+    }
+
+    for (const Segment &curve : this->_curves) {
+        if ((curve.start.y <= y) == (curve.end.y <= y)) {
+            continue;
+        }
+
+        // Single root of y-monotonic curve given by the numerically stable form of the quadratic formula
+        float direction = curve.end.y > curve.start.y ? 1.f : -1.f;
+        float a = curve.start.y - 2 * curve.control.y + curve.end.y;
+        float b = 2 * (curve.control.y - curve.start.y);
+        float c = curve.start.y - y;
+        float t = -2 * direction * c / std::max(std::abs(b) + std::sqrt(std::max(b * b - 4 * a * c, 0.f)), 1e-20f);
+        t = std::clamp(t, 0.f, 1.f);
+
+        float x = (1 - t) * (1 - t) * curve.start.x + 2 * (1 - t) * t * curve.control.x + t * t * curve.end.x;
+        this->_crossings.push_back({x, direction});
+    }
+
+    std::sort(this->_crossings.begin(), this->_crossings.end());
+}
+
+/**
+ * @brief Updates squared distances of pixels in a row to the closest point on line segment
+ *
+ * @param line Line segment
+ * @param x X coordinates of pixels
+ * @param y Y coordinate of pixels
+ * @param distances Squared distances of pixels, which are lowered if line segment is closer
+ */
+void SdfGenerator::_getLineDistances(const Segment &line,
+                                     const std::array<float, LANES> &x,
+                                     float y,
+                                     std::array<float, LANES> &distances) {
+    glm::vec2 direction = line.end - line.start;
+    float inverseLength = 1.f / std::max(direction.x * direction.x + direction.y * direction.y, 1e-12f);
+    float dy = y - line.start.y;
+
+    // Local copy tells the compiler that distances do not alias coordinates, so lanes can be vectorized
+    std::array<float, LANES> result = distances;
+    for (unsigned int lane = 0; lane < LANES; lane++) {
+        float dx = x[lane] - line.start.x;
+        float t = std::clamp((dx * direction.x + dy * direction.y) * inverseLength, 0.f, 1.f);
+        float ex = dx - t * direction.x;
+        float ey = dy - t * direction.y;
+        result[lane] = std::min(result[lane], ex * ex + ey * ey);
+    }
+    distances = result;
+}
+
+/**
+ * @brief Updates squared distances of pixels in a row to the closest point on quadratic bezier curve. Closest points
+ * are roots of a cubic equation, which are computed in closed form
+ *
+ * @param curve Quadratic bezier curve
+ * @param x X coordinates of pixels
+ * @param y Y coordinate of pixels
+ * @param distances Squared distances of pixels, which are lowered if curve is closer
+ */
+void SdfGenerator::_getCurveDistances(const Segment &curve,
+                                      const std::array<float, LANES> &x,
+                                      float y,
+                                      std::array<float, LANES> &distances) {
+    // Curve is start + 2at + bt^2
+    glm::vec2 a = curve.control - curve.start;
+    glm::vec2 b = curve.start - 2.f * curve.control + curve.end;
+
+    // Cubic equation of parameter of closest point normalized to t^3 + 3kx t^2 + 3ky t + kz
+    float k = 1.f / (b.x * b.x + b.y * b.y);
+    float kx = k * (a.x * b.x + a.y * b.y);
+    float kyBase = k * 2.f * (a.x * a.x + a.y * a.y);
+    float dy = curve.start.y - y;
+
+    // Coefficients of depressed cubic equation
+    std::array<float, LANES> p{};
+    std::array<float, LANES> q{};
+    for (unsigned int lane = 0; lane < LANES; lane++) {
+        float dx = curve.start.x - x[lane];
+        float ky = (kyBase + k * (dx * b.x + dy * b.y)) / 3.f;
+        float kz = k * (dx * a.x + dy * a.y);
+        p[lane] = ky - kx * kx;
+        q[lane] = kx * (2.f * kx * kx - 3.f * ky) + kz;
+    }
+
+    // Roots need cube roots or trigonometric functions, which are evaluated separately for each lane
+    std::array<float, LANES> t0{};
+    std::array<float, LANES> t1{};
+    for (unsigned int lane = 0; lane < LANES; lane++) {
+        float h = q[lane] * q[lane] + 4.f * p[lane] * p[lane] * p[lane];
+
+        if (h >= 0) {
+            // One real root
+            float sqrtH = std::sqrt(h);
+            t0[lane] = std::cbrt((sqrtH - q[lane]) / 2.f) + std::cbrt((-sqrtH - q[lane]) / 2.f) - kx;
+            t1[lane] = t0[lane];
+        } else {
+            // Three real roots, the middle one is never the closest point
+            float z = std::sqrt(-p[lane]);
+            float angle = std::acos(std::clamp(q[lane] / (2.f * p[lane] * z), -1.f, 1.f)) / 3.f;
+            float m = std::cos(angle);
+            float n = std::sin(angle) * std::numbers::sqrt3_v<float>;
+            t0[lane] = (m + m) * z - kx;
+            t1[lane] = (-n - m) * z - kx;
+        }
+    }
+
+    // Local copy tells the compiler that distances do not alias coordinates, so lanes can be vectorized
+    std::array<float, LANES> result = distances;
+    for (unsigned int lane = 0; lane < LANES; lane++) {
+        float dx = curve.start.x - x[lane];
+
+        float t = std::clamp(t0[lane], 0.f, 1.f);
+        float ex = dx + (2.f * a.x + b.x * t) * t;
+        float ey = dy + (2.f * a.y + b.y * t) * t;
+        result[lane] = std::min(result[lane], ex * ex + ey * ey);
+
+        t = std::clamp(t1[lane], 0.f, 1.f);
+        ex = dx + (2.f * a.x + b.x * t) * t;
+        ey = dy + (2.f * a.y + b.y * t) * t;
+        result[lane] = std::min(result[lane], ex * ex + ey * ey);
+    }
+    distances = result;
+}
+
+/**
+ * @brief Maps signed distance to byte the same way as the freetype sdf rasterizer
+ *
+ * @param distance Signed distance in pixels, positive inside of glyph
+ * @param spread Distance in pixels which is mapped to the maximal value
+ *
+ * @return Encoded distance, 128 is the edge
+ */
+uint8_t SdfGenerator::_encodeDistance(float distance, float spread) {
+    int value = std::min(static_cast<int>(std::abs(distance) / spread * 128.f), 127);
+    return static_cast<uint8_t>(distance > 0 ? 128 + value : 128 - value);
+}
+
+}  // namespace vft
@@ -18,8 +18,15 @@ SdfTessellator::SdfTessellator() {}
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
  * @param fontSize Font size of glyph
+ *
+ * @return Composed glyph
  */
-Glyph SdfTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) {
+std::shared_ptr<const Glyph> SdfTessellator::composeGlyph(uint32_t glyphId,
+                                                          std::shared_ptr<vft::Font> font,
+                                                          unsigned int fontSize) {
+    VFONT_PROFILE_ZONE("SdfTessellator::composeGlyph");
+    VFONT_PROFILE_COUNTER("glyphs composed", 1);
+
     // Get glyph from .ttf file
     if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_RENDER)) {
         throw std::runtime_error("SdfTessellator::composeGlyph(): Error loading glyph");
@@ -59,10 +66,9 @@ Glyph SdfTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font>
         boundingBoxIndices = {0, 3, 1, 2, 1, 3};
     }
 
-    GlyphMesh mesh{vertices, {boundingBoxIndices}};
-    this->_currentGlyph.mesh = mesh;
+    this->_currentGlyph.mesh = GlyphMesh{vertices, {boundingBoxIndices}};
 
-    return this->_currentGlyph;
+    return this->_releaseGlyph();
 }
 
 }  // namespace vft
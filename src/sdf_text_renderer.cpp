@@ -18,6 +18,7 @@ SdfTextRenderer::SdfTextRenderer() {
  * @brief Recreates vertex and index buffers for all characters in text block
  */
 void SdfTextRenderer::update() {
+    VFONT_PROFILE_ZONE("SdfTextRenderer::update");
     this->_vertices.clear();
     this->_boundingBoxIndices.clear();
     this->_offsets.clear();
@@ -27,20 +28,24 @@ void SdfTextRenderer::update() {
 
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key{TessellationStrategy::SDF, character.getFont()->getFontFamily(),
+                         character.getGlyphId(), 0};
 
             if (!this->_offsets.contains(key)) {
                 // Insert glyph into cache
-                if (!this->_cache->exists(key)) {
-                    this->_cache->setGlyph(key,
-                                           this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(),
-                                                                            character.getFontSize()));
+                if (this->_cache->exists(key)) {
+                    VFONT_PROFILE_COUNTER("glyph cache hits", 1);
+                } else {
+                    VFONT_PROFILE_COUNTER("glyph cache misses", 1);
+                    this->_cache->setGlyph(key, this->_tessellator->composeGlyph(character.getGlyphId(),
+                                                                                 character.getFont(),
+                                                                                 character.getFontSize()));
                 }
 
                 // Check if glyph has geometry
-                const Glyph &glyph = this->_cache->getGlyph(key);
-                if (glyph.mesh.getVertexCount() == 0 ||
-                    glyph.mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX) == 0) {
+                std::shared_ptr<const Glyph> glyph = this->_cache->getGlyph(key);
+                if (glyph->mesh.getVertexCount() == 0 ||
+                    glyph->mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX) == 0) {
                     this->_offsets.insert({key, GlyphInfo{0, 0}});
                     continue;
                 }
@@ -48,7 +53,7 @@ void SdfTextRenderer::update() {
                 // Compute buffer offsets
                 this->_offsets.insert(
                     {key, GlyphInfo{boundingBoxIndexCount,
-                                    glyph.mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX)}});
+                                    glyph->mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX)}});
 
                 // Get uv coordinnates from font atlas
                 if (!this->_fontAtlases.contains(character.getFont()->getFontFamily())) {
@@ -57,32 +62,38 @@ void SdfTextRenderer::update() {
                         character.getFont()->getFontFamily() + " was not found");
                 }
 
-                FontAtlas::GlyphInfo glyphInfo =
-                    this->_fontAtlases.at(character.getFont()->getFontFamily()).getGlyph(character.getGlyphId());
-                glm::vec2 uvTopLeft = glyphInfo.uvTopLeft;
-                glm::vec2 uvBottomRight = glyphInfo.uvBottomRight;
-                glm::vec2 uvTopRight{uvBottomRight.x, uvTopLeft.y};
-                glm::vec2 uvBottomLeft{uvTopLeft.x, uvBottomRight.y};
-
-                // Insert bounding box vertices to vertex buffer
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(0), uvBottomLeft});
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(1), uvTopLeft});
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(2), uvTopRight});
-                this->_vertices.push_back(Vertex{glyph.mesh.getVertices().at(3), uvBottomRight});
+                // Bounding box vertices of each tier of font atlas follow each other, so the tier is selected by
+                // adding an offset to the bounding box indices
+                const FontAtlas &atlas = this->_fontAtlases.at(character.getFont()->getFontFamily());
+                unsigned int tierCount = atlas.getTierPixelSizes().size();
+                for (unsigned int tier = 0; tier < tierCount; tier++) {
+                    FontAtlas::GlyphInfo glyphInfo = atlas.getGlyph(character.getGlyphId(), tier);
+                    glm::vec2 uvTopLeft = glyphInfo.uvTopLeft;
+                    glm::vec2 uvBottomRight = glyphInfo.uvBottomRight;
+                    glm::vec2 uvTopRight{uvBottomRight.x, uvTopLeft.y};
+                    glm::vec2 uvBottomLeft{uvTopLeft.x, uvBottomRight.y};
+
+                    // Insert bounding box vertices to vertex buffer
+                    this->_vertices.push_back(Vertex{glyph->mesh.getVertices()[0], uvBottomLeft});
+                    this->_vertices.push_back(Vertex{glyph->mesh.getVertices()[1], uvTopLeft});
+                    this->_vertices.push_back(Vertex{glyph->mesh.getVertices()[2], uvTopRight});
+                    this->_vertices.push_back(Vertex{glyph->mesh.getVertices()[3], uvBottomRight});
+                }
 
                 // Insert bounding box indices to index buffer
                 this->_boundingBoxIndices.insert(
                     this->_boundingBoxIndices.end(),
-                    glyph.mesh.getIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).end());
+                    glyph->mesh.getIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).begin(),
+                    glyph->mesh.getIndices(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX).end());
 
                 // Add an offset to bounding box indices of current character
                 for (unsigned int j = boundingBoxIndexCount; j < this->_boundingBoxIndices.size(); j++) {
                     this->_boundingBoxIndices[j] += vertexCount;
                 }
 
-                vertexCount += glyph.mesh.getVertexCount();
-                boundingBoxIndexCount += glyph.mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX);
+                vertexCount += glyph->mesh.getVertexCount() * tierCount;
+                boundingBoxIndexCount +=
+                    glyph->mesh.getIndexCount(SdfTessellator::GLYPH_MESH_BOUNDING_BOX_BUFFER_INDEX);
             }
         }
     }
@@ -29,6 +29,7 @@ std::vector<std::vector<ShapedCharacter>> Shaper::shape(std::u32string text,
                                                         hb_direction_t direction,
                                                         hb_script_t script,
                                                         hb_language_t language) {
+    VFONT_PROFILE_ZONE("Shaper::shape");
     Shaper::_preprocessInput(text);
 
     // Get indices of line breaks in input text
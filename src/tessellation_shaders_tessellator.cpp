@@ -19,12 +19,12 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
         if (pThis->contourCount >= 2) {
             // Perform union of contours
             PolygonOperator polygonOperator{};
-            polygonOperator.join(pThis->_currentGlyph.mesh.getVertices(), pThis->_firstPolygon, pThis->_secondPolygon);
-            pThis->_currentGlyph.mesh.setVertices(polygonOperator.getVertices());
+            polygonOperator.join(pThis->_vertices, pThis->_firstPolygon, pThis->_secondPolygon);
+            pThis->_vertices = polygonOperator.getVertices();
             pThis->_firstPolygon = polygonOperator.getPolygon();
             pThis->_secondPolygon = {CircularDLL<Edge>{}};
 
-            pThis->vertexIndex = pThis->_currentGlyph.mesh.getVertexCount();
+            pThis->vertexIndex = pThis->_vertices.size();
         } else if (pThis->contourCount == 1) {
             pThis->_firstPolygon = pThis->_secondPolygon;
             pThis->_secondPolygon = {CircularDLL<Edge>{}};
@@ -34,7 +34,7 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
         glm::vec2 vertex{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t vertexIndex = pThis->_getVertexIndex(vertex);
         if (vertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(vertex);
+            pThis->_vertices.push_back(vertex);
             pThis->vertexIndex++;
         }
 
@@ -54,12 +54,12 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
         glm::vec2 endVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t endVertexIndex = pThis->_getVertexIndex(endVertex);
         if (endVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endVertex);
+            pThis->_vertices.push_back(endVertex);
             pThis->vertexIndex++;
         }
 
         // Create line segment
-        pThis->_currentGlyph.addLineSegment(Edge{pThis->lastVertexIndex, endVertexIndex});
+        pThis->_lineSegments.push_back(Edge{pThis->lastVertexIndex, endVertexIndex});
 
         // Add edge to polygon
         pThis->_secondPolygon[0].insertLast(Edge{pThis->lastVertexIndex, endVertexIndex});
@@ -81,7 +81,7 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
         glm::vec2 controlPoint{static_cast<float>(control->x), static_cast<float>(control->y)};
         uint32_t controlPointVertexIndex = pThis->_getVertexIndex(controlPoint);
         if (controlPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(controlPoint);
+            pThis->_vertices.push_back(controlPoint);
             pThis->vertexIndex++;
         }
 
@@ -89,13 +89,12 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
         glm::vec2 endPoint{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t endPointVertexIndex = pThis->_getVertexIndex(endPoint);
         if (endPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endPoint);
+            pThis->_vertices.push_back(endPoint);
             pThis->vertexIndex++;
         }
 
         // Create curve segment
-        pThis->_currentGlyph.addCurveSegment(
-            Curve{startPointVertexIndex, controlPointVertexIndex, endPointVertexIndex});
+        pThis->_curveSegments.push_back(Curve{startPointVertexIndex, controlPointVertexIndex, endPointVertexIndex});
 
         if (pThis->_isOnLeftSide(startPoint, endPoint, controlPoint)) {
             // Add only edge from start point to end point
@@ -120,16 +119,20 @@ TessellationShadersTessellator::TessellationShadersTessellator() {
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
  * @param fontSize Font size of glyph
+ *
+ * @return Composed glyph
  */
-Glyph TessellationShadersTessellator::composeGlyph(uint32_t glyphId,
-                                                   std::shared_ptr<vft::Font> font,
-                                                   unsigned int fontSize) {
+std::shared_ptr<const Glyph> TessellationShadersTessellator::composeGlyph(uint32_t glyphId,
+                                                                          std::shared_ptr<vft::Font> font,
+                                                                          unsigned int fontSize) {
+    VFONT_PROFILE_ZONE("TessellationShadersTessellator::composeGlyph");
+    VFONT_PROFILE_COUNTER("glyphs composed", 1);
+
     // Initialize polygons
     this->_firstPolygon = {CircularDLL<Edge>{}};
     this->_secondPolygon = {CircularDLL<Edge>{}};
 
-    GlyphKey key{font->getFontFamily(), glyphId, 0};
-    Glyph glyph = TessellationShadersTessellator::_composeGlyph(glyphId, font);
+    this->_composeGlyph(glyphId, font);
 
     std::vector<glm::vec2> vertices;
     std::vector<Edge> edges;
@@ -138,7 +141,7 @@ Glyph TessellationShadersTessellator::composeGlyph(uint32_t glyphId,
     if (this->contourCount >= 1) {
         // Perform union of contours
         PolygonOperator polygonOperator{};
-        polygonOperator.join(this->_currentGlyph.mesh.getVertices(), this->_firstPolygon, this->_secondPolygon);
+        polygonOperator.join(this->_vertices, this->_firstPolygon, this->_secondPolygon);
         vertices = polygonOperator.getVertices();
         std::vector<CircularDLL<Edge>> polygon = polygonOperator.getPolygon();
 
@@ -166,17 +169,16 @@ Glyph TessellationShadersTessellator::composeGlyph(uint32_t glyphId,
 
     // Index buffer for curve segments
     std::vector<uint32_t> curveIndices;
-    for (Curve curve : glyph.getCurveSegmentsIndices()) {
+    for (Curve curve : this->_curveSegments) {
         curveIndices.push_back(curve.start);
         curveIndices.push_back(curve.control);
         curveIndices.push_back(curve.end);
     }
 
     // Set vertex and index buffer for composed glyph
-    GlyphMesh mesh{vertices, {triangles, curveIndices}};
-    glyph.mesh = mesh;
+    this->_currentGlyph.mesh = GlyphMesh{vertices, {triangles, curveIndices}};
 
-    return glyph;
+    return this->_releaseGlyph();
 }
 
 /**
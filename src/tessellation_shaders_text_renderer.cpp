@@ -18,68 +18,64 @@ TessellationShadersTextRenderer::TessellationShadersTextRenderer() {
  * @brief Recreates vertex and index buffers for all characters in text block
  */
 void TessellationShadersTextRenderer::update() {
+    VFONT_PROFILE_ZONE("TessellationShadersTextRenderer::update");
     this->_vertices.clear();
     this->_lineSegmentsIndices.clear();
     this->_curveSegmentsIndices.clear();
     this->_offsets.clear();
 
-    uint32_t vertexCount = 0;
+    int32_t vertexCount = 0;
     uint32_t lineSegmentsIndexCount = 0;
     uint32_t curveSegmentsIndexCount = 0;
 
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+            GlyphKey key{TessellationStrategy::TESSELLATION_SHADERS, character.getFont()->getFontFamily(),
+                         character.getGlyphId(), 0};
 
             if (!this->_offsets.contains(key)) {
                 // Insert glyph into cache
-                if (!this->_cache->exists(key)) {
-                    this->_cache->setGlyph(key,
-                                           this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(),
-                                                                            character.getFontSize()));
+                if (this->_cache->exists(key)) {
+                    VFONT_PROFILE_COUNTER("glyph cache hits", 1);
+                } else {
+                    VFONT_PROFILE_COUNTER("glyph cache misses", 1);
+                    this->_cache->setGlyph(key, this->_tessellator->composeGlyph(character.getGlyphId(),
+                                                                                 character.getFont(),
+                                                                                 character.getFontSize()));
                 }
 
                 // Compute buffer offsets
-                const Glyph &glyph = this->_cache->getGlyph(key);
+                std::shared_ptr<const Glyph> glyph = this->_cache->getGlyph(key);
                 this->_offsets.insert(
                     {key,
                      GlyphInfo{
                          lineSegmentsIndexCount,
-                         glyph.mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX),
+                         glyph->mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX),
                          curveSegmentsIndexCount,
-                         glyph.mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX)}});
+                         glyph->mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX),
+                         vertexCount}});
 
                 // Create vertex buffer
-                this->_vertices.insert(this->_vertices.end(), glyph.mesh.getVertices().begin(),
-                                       glyph.mesh.getVertices().end());
+                std::vector<glm::i16vec2> vertices = glyph->mesh.getQuantizedVertices();
+                this->_vertices.insert(this->_vertices.end(), vertices.begin(), vertices.end());
 
-                // Create line segments index buffer
-                this->_lineSegmentsIndices.insert(
-                    this->_lineSegmentsIndices.end(),
-                    glyph.mesh.getIndices(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX).end());
+                // Create line segments index buffer, indices are rebased by the vertex offset when drawing
+                std::vector<uint16_t> lineSegmentsIndices =
+                    glyph->mesh.getCompactIndices(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+                this->_lineSegmentsIndices.insert(this->_lineSegmentsIndices.end(), lineSegmentsIndices.begin(),
+                                                  lineSegmentsIndices.end());
 
-                // Create curve segments index buffer
-                this->_curveSegmentsIndices.insert(
-                    this->_curveSegmentsIndices.end(),
-                    glyph.mesh.getIndices(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX).end());
+                // Create curve segments index buffer, indices are rebased by the vertex offset when drawing
+                std::vector<uint16_t> curveSegmentsIndices =
+                    glyph->mesh.getCompactIndices(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+                this->_curveSegmentsIndices.insert(this->_curveSegmentsIndices.end(), curveSegmentsIndices.begin(),
+                                                   curveSegmentsIndices.end());
 
-                // Add an offset to line segment indices of current character
-                for (int j = lineSegmentsIndexCount; j < this->_lineSegmentsIndices.size(); j++) {
-                    this->_lineSegmentsIndices.at(j) += vertexCount;
-                }
-
-                // Add an offset to curve segment indices of current character
-                for (int j = curveSegmentsIndexCount; j < this->_curveSegmentsIndices.size(); j++) {
-                    this->_curveSegmentsIndices.at(j) += vertexCount;
-                }
-
-                vertexCount += glyph.mesh.getVertexCount();
+                vertexCount += glyph->mesh.getVertexCount();
                 lineSegmentsIndexCount +=
-                    glyph.mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+                    glyph->mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
                 curveSegmentsIndexCount +=
-                    glyph.mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+                    glyph->mesh.getIndexCount(TessellationShadersTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
             }
         }
     }
@@ -18,7 +18,7 @@ Tessellator::Tessellator() {
         glm::vec2 newVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t newVertexIndex = pThis->_getVertexIndex(newVertex);
         if (newVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(newVertex);
+            pThis->_vertices.push_back(newVertex);
             pThis->vertexIndex++;
         }
 
@@ -37,12 +37,12 @@ Tessellator::Tessellator() {
         glm::vec2 newVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t newVertexIndex = pThis->_getVertexIndex(newVertex);
         if (newVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(newVertex);
+            pThis->_vertices.push_back(newVertex);
             pThis->vertexIndex++;
         }
 
         // Add line segment
-        pThis->_currentGlyph.addLineSegment(Edge{pThis->lastVertexIndex, newVertexIndex});
+        pThis->_lineSegments.push_back(Edge{pThis->lastVertexIndex, newVertexIndex});
 
         // Update glyph data
         pThis->lastVertex = newVertex;
@@ -57,19 +57,19 @@ Tessellator::Tessellator() {
         glm::vec2 controlPoint{static_cast<float>(control->x), static_cast<float>(control->y)};
         uint32_t controlPointIndex = pThis->_getVertexIndex(controlPoint);
         if (controlPointIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(controlPoint);
+            pThis->_vertices.push_back(controlPoint);
             pThis->vertexIndex++;
         }
 
         glm::vec2 endPoint{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t endPointIndex = pThis->_getVertexIndex(endPoint);
         if (endPointIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endPoint);
+            pThis->_vertices.push_back(endPoint);
             pThis->vertexIndex++;
         }
 
         // Add quadratic bezier curve segment
-        pThis->_currentGlyph.addCurveSegment(Curve{pThis->lastVertexIndex, controlPointIndex, endPointIndex});
+        pThis->_curveSegments.push_back(Curve{pThis->lastVertexIndex, controlPointIndex, endPointIndex});
 
         // Update glyph data
         pThis->lastVertex = endPoint;
@@ -85,12 +85,12 @@ Tessellator::Tessellator() {
 }
 
 /**
- * @brief Composes a glyph using freetype
+ * @brief Composes outlines and metrics of a glyph using freetype into the currently composed glyph
  *
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
  */
-Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
+void Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
     // Get glyph from .ttf file
     if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_NO_SCALE)) {
         throw std::runtime_error("Tessellator::_composeGlyph(): Error loading glyph");
@@ -104,6 +104,9 @@ Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
     this->contourStartVertexIndex = 0;
     this->contourCount = 0;
     this->_currentGlyph = Glyph{};
+    this->_vertices.clear();
+    this->_lineSegments.clear();
+    this->_curveSegments.clear();
 
     // Decompose outlines to vertices and vertex indices
     FT_Outline_Funcs outlineFunctions{.move_to = this->_moveToFunc,
@@ -121,12 +124,20 @@ Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
     this->_currentGlyph.setBearingY(slot->metrics.horiBearingY);
     this->_currentGlyph.setAdvanceX(slot->advance.x);
     this->_currentGlyph.setAdvanceY(slot->advance.y);
+}
 
-    return this->_currentGlyph;
+/**
+ * @brief Moves the currently composed glyph into one immutable shared allocation, so its mesh is not copied on its
+ * way to glyph caches and renderers
+ *
+ * @return Composed glyph
+ */
+std::shared_ptr<const Glyph> Tessellator::_releaseGlyph() {
+    return std::make_shared<const Glyph>(std::move(this->_currentGlyph));
 }
 
 /**
- * @brief Get index of given vertex from vertices of currently composed glyph
+ * @brief Get index of given vertex from outline vertices of currently composed glyph
  *
  * @param vertex Given vertex
  *
@@ -135,7 +146,7 @@ Glyph Tessellator::_composeGlyph(uint32_t glyphId, std::shared_ptr<Font> font) {
 uint32_t Tessellator::_getVertexIndex(const glm::vec2 &vertex) {
     uint32_t i = 0;
 
-    for (const glm::vec2 &glyphVertex : this->_currentGlyph.mesh.getVertices()) {
+    for (const glm::vec2 &glyphVertex : this->_vertices) {
         if (glm::distance(vertex, glyphVertex) <= 1.f) {
             return i;
         }
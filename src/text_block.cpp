@@ -108,6 +108,7 @@ void TextBlock::add(std::u32string text,
 
     // Set character positions
     this->_updateCharacterPositions(newSegmentCharacterGlobalIndex);
+    this->_updateBoundingBoxes();
 
     // onTextChange callback
     if (this->onTextChange) {
@@ -271,6 +272,8 @@ void TextBlock::remove(unsigned int start, unsigned int count) {
         this->_updateCharacterPositions(segmentCharacterGlobalIndex);
     }
 
+    this->_updateBoundingBoxes();
+
     if (this->onTextChange) {
         this->onTextChange();
     }
@@ -281,6 +284,7 @@ void TextBlock::remove(unsigned int start, unsigned int count) {
  */
 void TextBlock::clear() {
     this->_segments.clear();
+    this->_updateBoundingBoxes();
 }
 
 /**
@@ -360,6 +364,7 @@ void TextBlock::setLineSpacing(double lineSpacing) {
  */
 void TextBlock::setColor(glm::vec4 color) {
     this->_color = color;
+    this->_version++;
 }
 
 /**
@@ -417,6 +422,37 @@ std::vector<Character> TextBlock::getCharacters() {
     return characters;
 }
 
+/**
+ * @brief Get a range of renderable characters in text block, only segments containing the range are copied
+ *
+ * @param start Index of first character
+ * @param count Number of characters
+ *
+ * @return Characters in range
+ */
+std::vector<Character> TextBlock::getCharacters(unsigned int start, unsigned int count) {
+    std::vector<Character> characters;
+    characters.reserve(count);
+
+    unsigned int currentIndex = 0;
+    for (TextSegment &segment : this->_segments) {
+        unsigned int segmentCount = segment.getCharacterCount();
+        if (currentIndex + segmentCount > start) {
+            unsigned int localStart = start > currentIndex ? start - currentIndex : 0;
+            unsigned int localEnd = std::min(segmentCount, start + count - currentIndex);
+            characters.insert(characters.end(), std::next(segment.getCharacters().begin(), localStart),
+                              std::next(segment.getCharacters().begin(), localEnd));
+        }
+
+        currentIndex += segmentCount;
+        if (currentIndex >= start + count) {
+            break;
+        }
+    }
+
+    return characters;
+}
+
 /**
  * @brief Get number of renderable characters in text block
  *
@@ -513,6 +549,33 @@ int TextBlock::getWidth() const {
     return this->_width;
 }
 
+/**
+ * @brief Get bounding box of text block in world space
+ *
+ * @return Bounding box of all lines, empty if text block has no characters
+ */
+const BoundingBox &TextBlock::getBoundingBox() const {
+    return this->_boundingBox;
+}
+
+/**
+ * @brief Get bounding boxes of lines in world space
+ *
+ * @return Bounding boxes of lines ordered by their first character
+ */
+const std::vector<LineBoundingBox> &TextBlock::getLineBoundingBoxes() const {
+    return this->_lineBoundingBoxes;
+}
+
+/**
+ * @brief Get version of text block, renderers compare versions to find out whether recorded draw commands are outdated
+ *
+ * @return Version incremented whenever characters, their transforms or color change
+ */
+uint64_t TextBlock::getVersion() const {
+    return this->_version;
+}
+
 /**
  * @brief Get transform of text block
  *
@@ -547,6 +610,8 @@ void TextBlock::_updateTransform() {
             character.setTransform(this->getTransform());
         }
     }
+
+    this->_updateBoundingBoxes();
 }
 
 /**
@@ -555,6 +620,7 @@ void TextBlock::_updateTransform() {
  * @param start Index of starting character
  */
 void TextBlock::_updateCharacterPositions(unsigned int start) {
+    VFONT_PROFILE_ZONE("TextBlock::_updateCharacterPositions");
     std::pair<unsigned int, LineData> firstLine = this->_lineDivider.getLineOfCharacter(start);
 
     // Index of first character that needs recalculating position
@@ -595,6 +661,46 @@ void TextBlock::_updateCharacterPositions(unsigned int start) {
     }
 }
 
+/**
+ * @brief Compute bounding boxes of lines from line data and transform of text block. Glyph outlines are not known
+ * here, so boxes are padded by the line height to contain ascenders, descenders and shaper offsets
+ */
+void TextBlock::_updateBoundingBoxes() {
+    // Bounding boxes are updated after every change of characters or transform
+    this->_version++;
+
+    this->_lineBoundingBoxes.clear();
+    this->_boundingBox = BoundingBox{};
+
+    unsigned int characterCount = this->getCharacterCount();
+    if (characterCount == 0) {
+        return;
+    }
+
+    const std::map<unsigned int, LineData> &lines = this->_lineDivider.getLines();
+    for (auto line = lines.begin(); line != lines.end(); line++) {
+        unsigned int end = std::next(line) == lines.end() ? characterCount : std::next(line)->first;
+        if (line->first >= end) {
+            continue;
+        }
+
+        const LineData &data = line->second;
+        float x = 0;
+        if (this->_width > 0 && data.width <= this->_width) {
+            x = this->_textAlign->getLineOffset(data.width, this->_width).x;
+        }
+
+        // Characters are placed on baseline at y and their outlines extend upwards
+        float height = static_cast<float>(data.height);
+        BoundingBox localBoundingBox{glm::vec3(x - height, data.y - 2 * height, 0.f),
+                                     glm::vec3(x + data.width + height, data.y + height, 0.f)};
+
+        LineBoundingBox lineBoundingBox{line->first, end - line->first, localBoundingBox.transform(this->_transform)};
+        this->_boundingBox.add(lineBoundingBox.boundingBox);
+        this->_lineBoundingBoxes.push_back(lineBoundingBox);
+    }
+}
+
 /**
  * @brief Merge text segments if they have same properties
  *
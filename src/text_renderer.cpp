@@ -42,6 +42,7 @@ void TextRenderer::addFontAtlas(const FontAtlas &atlas) {
  */
 void TextRenderer::setUniformBuffers(UniformBufferObject ubo) {
     this->_ubo = ubo;
+    this->_viewFrustum = ViewFrustum{ubo.projection * ubo.view};
 }
 
 /**
@@ -56,7 +57,7 @@ void TextRenderer::setViewportSize(unsigned int width, unsigned int height) {
 }
 
 /**
- * @brief Set glyph cache used for rendering
+ * @brief Set glyph cache used for rendering, renderers of any strategy can share one cache
  *
  * @param cache Glyph cache
  */
@@ -64,4 +65,78 @@ void TextRenderer::setCache(std::shared_ptr<GlyphCache> cache) {
     this->_cache = cache;
 }
 
+/**
+ * @brief Set whether text blocks and lines outside of view frustum are skipped when drawing
+ *
+ * @param cpuCulling True if culling is enabled
+ */
+void TextRenderer::setCpuCulling(bool cpuCulling) {
+    this->_cpuCulling = cpuCulling;
+}
+
+/**
+ * @brief Get text blocks which can be visible. Text blocks do not notify the renderer about changes of their
+ * transforms, but their versions change with every change of bounding box, so the hierarchy is rebuilt only if a text
+ * block was added or any version differs from the versions it was built from
+ *
+ * @return Indices of visible text blocks in ascending order
+ */
+std::vector<unsigned int> TextRenderer::_getVisibleTextBlocks() {
+    if (!this->_cpuCulling) {
+        std::vector<unsigned int> textBlocks(this->_textBlocks.size());
+        std::iota(textBlocks.begin(), textBlocks.end(), 0);
+        return textBlocks;
+    }
+
+    std::vector<uint64_t> versions;
+    versions.reserve(this->_textBlocks.size());
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        versions.push_back(textBlock->getVersion());
+    }
+
+    if (versions != this->_textBlockHierarchyVersions) {
+        std::vector<BoundingBox> boundingBoxes;
+        boundingBoxes.reserve(this->_textBlocks.size());
+        for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+            boundingBoxes.push_back(textBlock->getBoundingBox());
+        }
+
+        this->_textBlockHierarchy.build(boundingBoxes);
+        this->_textBlockHierarchyVersions = std::move(versions);
+    }
+
+    return this->_textBlockHierarchy.query(this->_viewFrustum);
+}
+
+/**
+ * @brief Get which lines of all text blocks intersect view frustum. Lines are numbered in order of text blocks and
+ * lines in them
+ *
+ * @return Visibility of each line
+ */
+std::vector<bool> TextRenderer::_getVisibleLines() {
+    std::vector<unsigned int> firstLines;
+    firstLines.reserve(this->_textBlocks.size());
+
+    unsigned int lineCount = 0;
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        firstLines.push_back(lineCount);
+        lineCount += textBlock->getLineBoundingBoxes().size();
+    }
+
+    if (!this->_cpuCulling) {
+        return std::vector<bool>(lineCount, true);
+    }
+
+    std::vector<bool> visibleLines(lineCount, false);
+    for (unsigned int i : this->_getVisibleTextBlocks()) {
+        const std::vector<LineBoundingBox> &lines = this->_textBlocks.at(i)->getLineBoundingBoxes();
+        for (unsigned int j = 0; j < lines.size(); j++) {
+            visibleLines[firstLines[i] + j] = this->_viewFrustum.intersects(lines[j].boundingBox);
+        }
+    }
+
+    return visibleLines;
+}
+
 }  // namespace vft
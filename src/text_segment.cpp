@@ -177,6 +177,7 @@ hb_language_t TextSegment::getLanguage() const {
  * @brief Shape all code points in segment
  */
 void TextSegment::_shape() {
+    VFONT_PROFILE_ZONE("TextSegment::_shape");
     // Shape whole segment
     std::vector<std::vector<ShapedCharacter>> shaped =
         Shaper::shape(this->_text, this->_font, this->_fontSize, this->_direction, this->_script, this->_language);
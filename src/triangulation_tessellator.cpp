@@ -19,12 +19,12 @@ TriangulationTessellator::TriangulationTessellator() {
         if (pThis->contourCount >= 2) {
             // Perform union of contours
             PolygonOperator polygonOperator{};
-            polygonOperator.join(pThis->_currentGlyph.mesh.getVertices(), pThis->_firstPolygon, pThis->_secondPolygon);
-            pThis->_currentGlyph.mesh.setVertices(polygonOperator.getVertices());
+            polygonOperator.join(pThis->_vertices, pThis->_firstPolygon, pThis->_secondPolygon);
+            pThis->_vertices = polygonOperator.getVertices();
             pThis->_firstPolygon = polygonOperator.getPolygon();
             pThis->_secondPolygon = {CircularDLL<Edge>{}};
 
-            pThis->vertexIndex = pThis->_currentGlyph.mesh.getVertexCount();
+            pThis->vertexIndex = pThis->_vertices.size();
         } else if (pThis->contourCount == 1) {
             pThis->_firstPolygon = pThis->_secondPolygon;
             pThis->_secondPolygon = {CircularDLL<Edge>{}};
@@ -34,7 +34,7 @@ TriangulationTessellator::TriangulationTessellator() {
         glm::vec2 vertex{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t vertexIndex = pThis->_getVertexIndex(vertex);
         if (vertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(vertex);
+            pThis->_vertices.push_back(vertex);
             pThis->vertexIndex++;
         }
 
@@ -54,12 +54,12 @@ TriangulationTessellator::TriangulationTessellator() {
         glm::vec2 endVertex{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t endVertexIndex = pThis->_getVertexIndex(endVertex);
         if (endVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endVertex);
+            pThis->_vertices.push_back(endVertex);
             pThis->vertexIndex++;
         }
 
         // Create line segment
-        pThis->_currentGlyph.addLineSegment(Edge{pThis->lastVertexIndex, endVertexIndex});
+        pThis->_lineSegments.push_back(Edge{pThis->lastVertexIndex, endVertexIndex});
 
         // Add edge to polygon
         pThis->_secondPolygon[0].insertLast(Edge{pThis->lastVertexIndex, endVertexIndex});
@@ -80,7 +80,7 @@ TriangulationTessellator::TriangulationTessellator() {
         glm::vec2 controlPoint{static_cast<float>(control->x), static_cast<float>(control->y)};
         uint32_t controlPointVertexIndex = pThis->_getVertexIndex(controlPoint);
         if (controlPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(controlPoint);
+            pThis->_vertices.push_back(controlPoint);
             pThis->vertexIndex++;
         }
 
@@ -88,13 +88,12 @@ TriangulationTessellator::TriangulationTessellator() {
         glm::vec2 endPoint{static_cast<float>(to->x), static_cast<float>(to->y)};
         uint32_t endPointVertexIndex = pThis->_getVertexIndex(endPoint);
         if (endPointVertexIndex == pThis->vertexIndex) {
-            pThis->_currentGlyph.mesh.addVertex(endPoint);
+            pThis->_vertices.push_back(endPoint);
             pThis->vertexIndex++;
         }
 
         // Create curve segment
-        pThis->_currentGlyph.addCurveSegment(
-            Curve{pThis->lastVertexIndex, controlPointVertexIndex, endPointVertexIndex});
+        pThis->_curveSegments.push_back(Curve{pThis->lastVertexIndex, controlPointVertexIndex, endPointVertexIndex});
 
         // Adaptive subdivision of quadratic bezier curve
         std::array<glm::vec2, 3> curve{pThis->_font->getScalingVector(pThis->_fontSize) * startPoint,
@@ -111,7 +110,7 @@ TriangulationTessellator::TriangulationTessellator() {
             glm::vec2 newVertex{(1 - t) * (1 - t) * startPoint + 2 * (1 - t) * t * controlPoint + (t * t) * endPoint};
             uint32_t newVertexIndex = pThis->_getVertexIndex(newVertex);
             if (newVertexIndex == pThis->vertexIndex) {
-                pThis->_currentGlyph.mesh.addVertex(newVertex);
+                pThis->_vertices.push_back(newVertex);
                 pThis->vertexIndex++;
             }
 
@@ -135,8 +134,15 @@ TriangulationTessellator::TriangulationTessellator() {
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
  * @param fontSize Font size of glyph
+ *
+ * @return Composed glyph
  */
-Glyph TriangulationTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) {
+std::shared_ptr<const Glyph> TriangulationTessellator::composeGlyph(uint32_t glyphId,
+                                                                    std::shared_ptr<vft::Font> font,
+                                                                    unsigned int fontSize) {
+    VFONT_PROFILE_ZONE("TriangulationTessellator::composeGlyph");
+    VFONT_PROFILE_COUNTER("glyphs composed", 1);
+
     this->_font = font;
     this->_fontSize = fontSize;
 
@@ -144,8 +150,7 @@ Glyph TriangulationTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<v
     this->_firstPolygon = {CircularDLL<Edge>{}};
     this->_secondPolygon = {CircularDLL<Edge>{}};
 
-    GlyphKey key{font->getFontFamily(), glyphId, fontSize};
-    Glyph glyph = this->_composeGlyph(glyphId, font);
+    this->_composeGlyph(glyphId, font);
 
     std::vector<glm::vec2> vertices;
     std::vector<Edge> edges;
@@ -154,7 +159,7 @@ Glyph TriangulationTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<v
     if (this->contourCount >= 1) {
         // Perform union of contours
         PolygonOperator polygonOperator{};
-        polygonOperator.join(this->_currentGlyph.mesh.getVertices(), this->_firstPolygon, this->_secondPolygon);
+        polygonOperator.join(this->_vertices, this->_firstPolygon, this->_secondPolygon);
         vertices = polygonOperator.getVertices();
         std::vector<CircularDLL<Edge>> polygon = polygonOperator.getPolygon();
 
@@ -178,16 +183,53 @@ Glyph TriangulationTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<v
 
         // Triangulation
         triangles = GlyphCompositor::triangulate(vertices, edges);
+
+        // Reorder triangles for the post-transform vertex cache and vertices in order of their first use
+        if (this->_optimizeMesh) {
+            this->_vertexCacheStatistics.triangleCount += triangles.size() / 3;
+            this->_vertexCacheStatistics.cacheMissesBefore += MeshOptimizer::computeCacheMissCount(triangles);
+
+            triangles = MeshOptimizer::optimizeVertexCache(triangles, vertices.size());
+            MeshOptimizer::optimizeVertexFetch(vertices, triangles);
+
+            this->_vertexCacheStatistics.cacheMissesAfter += MeshOptimizer::computeCacheMissCount(triangles);
+        }
     }
 
-    GlyphMesh mesh{vertices, {triangles}};
-    glyph.mesh = mesh;
+    this->_currentGlyph.mesh = GlyphMesh{vertices, {triangles}};
 
     // Cleanup
     this->_firstPolygon.clear();
     this->_secondPolygon.clear();
 
-    return glyph;
+    return this->_releaseGlyph();
+}
+
+/**
+ * @brief Enables or disables reordering of composed glyph meshes for the post-transform vertex cache
+ *
+ * @param optimizeMesh True if glyph meshes should be optimized
+ */
+void TriangulationTessellator::setMeshOptimization(bool optimizeMesh) {
+    this->_optimizeMesh = optimizeMesh;
+}
+
+/**
+ * @brief Checks whether triangles and vertices of composed glyphs are reordered for the post-transform vertex cache
+ *
+ * @return True if glyph meshes are optimized
+ */
+bool TriangulationTessellator::getMeshOptimization() const {
+    return this->_optimizeMesh;
+}
+
+/**
+ * @brief Get vertex cache statistics accumulated over all glyphs composed with mesh optimization enabled
+ *
+ * @return Vertex cache statistics
+ */
+const VertexCacheStatistics &TriangulationTessellator::getVertexCacheStatistics() const {
+    return this->_vertexCacheStatistics;
 }
 
 /**
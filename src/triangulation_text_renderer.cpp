@@ -18,49 +18,72 @@ TriangulationTextRenderer::TriangulationTextRenderer() {
  * @brief Recreates vertex and index buffers for all characters in text block
  */
 void TriangulationTextRenderer::update() {
+    VFONT_PROFILE_ZONE("TriangulationTextRenderer::update");
     this->_vertices.clear();
     this->_indices.clear();
     this->_offsets.clear();
 
-    uint32_t vertexCount = 0;
+    int32_t vertexCount = 0;
     uint32_t indexCount = 0;
 
     for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
         for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), character.getFontSize()};
+            GlyphKey key{TessellationStrategy::TRIANGULATION, character.getFont()->getFontFamily(),
+                         character.getGlyphId(), character.getFontSize()};
 
             if (!this->_offsets.contains(key)) {
                 // Insert glyph into cache
-                if (!this->_cache->exists(key)) {
-                    this->_cache->setGlyph(key,
-                                           this->_tessellator->composeGlyph(character.getGlyphId(), character.getFont(),
-                                                                            character.getFontSize()));
+                if (this->_cache->exists(key)) {
+                    VFONT_PROFILE_COUNTER("glyph cache hits", 1);
+                } else {
+                    VFONT_PROFILE_COUNTER("glyph cache misses", 1);
+                    this->_cache->setGlyph(key, this->_tessellator->composeGlyph(character.getGlyphId(),
+                                                                                 character.getFont(),
+                                                                                 character.getFontSize()));
                 }
 
                 // Compute buffer offsets
-                const Glyph &glyph = this->_cache->getGlyph(key);
+                std::shared_ptr<const Glyph> glyph = this->_cache->getGlyph(key);
+                std::array<glm::vec2, 4> boundingBox = glyph->getBoundingBox();
                 this->_offsets.insert(
-                    {key, GlyphInfo{indexCount, glyph.mesh.getIndexCount(
-                                                    TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX)}});
+                    {key,
+                     GlyphInfo{indexCount,
+                               glyph->mesh.getIndexCount(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX),
+                               vertexCount,
+                               glm::vec4{boundingBox[0], boundingBox[2]}}});
 
-                // Insert glyph mesh into vertex and index buffer
-                this->_vertices.insert(this->_vertices.end(), glyph.mesh.getVertices().begin(),
-                                       glyph.mesh.getVertices().end());
-                this->_indices.insert(
-                    this->_indices.end(),
-                    glyph.mesh.getIndices(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX).begin(),
-                    glyph.mesh.getIndices(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX).end());
+                // Insert glyph mesh into vertex and index buffer, indices are rebased by the vertex offset when drawing
+                std::vector<glm::i16vec2> vertices = glyph->mesh.getQuantizedVertices();
+                this->_vertices.insert(this->_vertices.end(), vertices.begin(), vertices.end());
 
-                // Add an offset to line segment indices of current character
-                for (int j = indexCount; j < this->_indices.size(); j++) {
-                    this->_indices.at(j) += vertexCount;
-                }
+                std::vector<uint16_t> indices =
+                    glyph->mesh.getCompactIndices(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+                this->_indices.insert(this->_indices.end(), indices.begin(), indices.end());
 
-                vertexCount += glyph.mesh.getVertexCount();
-                indexCount += glyph.mesh.getIndexCount(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+                vertexCount += glyph->mesh.getVertexCount();
+                indexCount += glyph->mesh.getIndexCount(TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
             }
         }
     }
 }
 
+/**
+ * @brief Enables or disables reordering of glyph meshes for the post-transform vertex cache. Applies only to glyphs
+ * that are composed after the change, glyphs already stored in the glyph cache are not modified
+ *
+ * @param optimizeMesh True if glyph meshes should be optimized
+ */
+void TriangulationTextRenderer::setMeshOptimization(bool optimizeMesh) {
+    static_cast<TriangulationTessellator *>(this->_tessellator.get())->setMeshOptimization(optimizeMesh);
+}
+
+/**
+ * @brief Get vertex cache statistics of glyphs composed with mesh optimization enabled
+ *
+ * @return Vertex cache statistics
+ */
+const VertexCacheStatistics &TriangulationTextRenderer::getVertexCacheStatistics() const {
+    return static_cast<TriangulationTessellator *>(this->_tessellator.get())->getVertexCacheStatistics();
+}
+
 }  // namespace vft
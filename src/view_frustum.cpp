@@ -0,0 +1,64 @@
+/**
+ * @file view_frustum.cpp
+ * @author Christian Saloň
+ */
+
+#include "view_frustum.h"
+
+namespace vft {
+
+/**
+ * @brief Creates view frustum of identity view projection matrix
+ */
+ViewFrustum::ViewFrustum() : ViewFrustum{glm::mat4(1.f)} {}
+
+/**
+ * @brief Extracts frustum planes from view projection matrix
+ *
+ * @param viewProjection Projection matrix multiplied by view matrix
+ */
+ViewFrustum::ViewFrustum(const glm::mat4 &viewProjection) {
+    glm::vec4 row0{viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]};
+    glm::vec4 row1{viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]};
+    glm::vec4 row2{viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]};
+    glm::vec4 row3{viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]};
+
+    // Near plane uses the [-w, w] depth range, which also contains the [0, w] range used by vulkan
+    this->_planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+
+    for (glm::vec4 &plane : this->_planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0) {
+            plane /= length;
+        }
+    }
+}
+
+/**
+ * @brief Check whether bounding box is at least partially inside of frustum. Boxes near frustum corners can be
+ * reported as visible even if they are outside
+ *
+ * @param boundingBox Bounding box in world space
+ *
+ * @return True if bounding box can be visible
+ */
+bool ViewFrustum::intersects(const BoundingBox &boundingBox) const {
+    if (boundingBox.isEmpty()) {
+        return false;
+    }
+
+    for (const glm::vec4 &plane : this->_planes) {
+        // Corner of bounding box furthest in the direction of plane normal
+        glm::vec3 corner{plane.x >= 0 ? boundingBox.max.x : boundingBox.min.x,
+                         plane.y >= 0 ? boundingBox.max.y : boundingBox.min.y,
+                         plane.z >= 0 ? boundingBox.max.z : boundingBox.min.z};
+
+        if (glm::dot(glm::vec3(plane), corner) + plane.w < 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace vft
@@ -0,0 +1,316 @@
+/**
+ * @file vulkan_gpu_timer.cpp
+ * @author Christian Saloň
+ */
+
+#include "vulkan_gpu_timer.h"
+
+namespace vft {
+
+/**
+ * @brief Pipeline statistics recorded by timer, results are returned in the order of bits
+ */
+constexpr VkQueryPipelineStatisticFlags PIPELINE_STATISTICS =
+    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT;
+
+/**
+ * @brief Creates query pools for all frames in flight
+ *
+ * @param physicalDevice Vulkan physical device
+ * @param logicalDevice Vulkan logical device
+ * @param frameCount Maximum number of frames in flight
+ * @param pipelineStatistics Whether to record pipeline statistics, pipelineStatisticsQuery feature must be enabled
+ */
+VulkanGpuTimer::VulkanGpuTimer(VkPhysicalDevice physicalDevice,
+                               VkDevice logicalDevice,
+                               uint32_t frameCount,
+                               bool pipelineStatistics)
+    : _logicalDevice{logicalDevice} {
+    if (frameCount == 0) {
+        throw std::invalid_argument("VulkanGpuTimer::VulkanGpuTimer(): Frame count must be greater than 0");
+    }
+
+    VkPhysicalDeviceProperties deviceProperties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+    this->_timestampPeriod = deviceProperties.limits.timestampPeriod;
+
+    this->_frames.resize(frameCount);
+    for (Frame &frame : this->_frames) {
+        VkQueryPoolCreateInfo timestampPoolCreateInfo{};
+        timestampPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        timestampPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        timestampPoolCreateInfo.queryCount = MAX_TIMESTAMPS;
+
+        if (vkCreateQueryPool(this->_logicalDevice, &timestampPoolCreateInfo, nullptr, &frame.timestampPool) !=
+            VK_SUCCESS) {
+            throw std::runtime_error("VulkanGpuTimer::VulkanGpuTimer(): Error creating vulkan timestamp query pool");
+        }
+
+        if (!pipelineStatistics) {
+            continue;
+        }
+
+        VkQueryPoolCreateInfo statisticsPoolCreateInfo{};
+        statisticsPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        statisticsPoolCreateInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        statisticsPoolCreateInfo.queryCount = 1;
+        statisticsPoolCreateInfo.pipelineStatistics = PIPELINE_STATISTICS;
+
+        if (vkCreateQueryPool(this->_logicalDevice, &statisticsPoolCreateInfo, nullptr, &frame.statisticsPool) !=
+            VK_SUCCESS) {
+            throw std::runtime_error(
+                "VulkanGpuTimer::VulkanGpuTimer(): Error creating vulkan pipeline statistics query pool");
+        }
+    }
+}
+
+/**
+ * @brief Destroys query pools of all frames
+ */
+VulkanGpuTimer::~VulkanGpuTimer() {
+    for (Frame &frame : this->_frames) {
+        if (frame.timestampPool != nullptr)
+            vkDestroyQueryPool(this->_logicalDevice, frame.timestampPool, nullptr);
+        if (frame.statisticsPool != nullptr)
+            vkDestroyQueryPool(this->_logicalDevice, frame.statisticsPool, nullptr);
+    }
+}
+
+/**
+ * @brief Starts recording queries of a new frame. Results of the frame which used the same query pools are read first,
+ * then the pools are reset. Must be called outside of render pass, after the gpu finished the frame which is
+ * framesInFlight frames old
+ *
+ * @param commandBuffer Vulkan command buffer of new frame
+ * @param framesInFlight Number of frames that can be processed by the gpu concurrently
+ */
+void VulkanGpuTimer::beginFrame(VkCommandBuffer commandBuffer, uint32_t framesInFlight) {
+    if (framesInFlight == 0 || framesInFlight > this->_frames.size()) {
+        throw std::invalid_argument("VulkanGpuTimer::beginFrame(): Unsupported number of frames in flight");
+    }
+
+    Frame &frame = this->_frames.at(this->_frameIndex % framesInFlight);
+    this->_frameIndex++;
+
+    this->_collectResults(frame);
+
+    vkCmdResetQueryPool(commandBuffer, frame.timestampPool, 0, MAX_TIMESTAMPS);
+    if (frame.statisticsPool != nullptr)
+        vkCmdResetQueryPool(commandBuffer, frame.statisticsPool, 0, 1);
+
+    frame.scopes.clear();
+    frame.timestampCount = 0;
+    frame.hasStatistics = false;
+
+    this->_currentFrame = &frame;
+    this->_commandBuffer = commandBuffer;
+    this->_openScopes.clear();
+}
+
+/**
+ * @brief Finishes recording queries of current frame, its results are read when its query pools are reused
+ */
+void VulkanGpuTimer::endFrame() {
+    if (this->_currentFrame == nullptr) {
+        return;
+    }
+
+    if (!this->_openScopes.empty()) {
+        throw std::runtime_error("VulkanGpuTimer::endFrame(): All scopes must be ended before ending frame");
+    }
+
+    this->_currentFrame->isPending = true;
+    this->_currentFrame = nullptr;
+    this->_commandBuffer = nullptr;
+}
+
+/**
+ * @brief Writes timestamp at the start of named scope. Scopes can be nested, nothing is recorded if no frame is being
+ * recorded
+ *
+ * @param name Name of scope, samples of scopes with the same name are combined
+ */
+void VulkanGpuTimer::beginScope(const std::string &name) {
+    if (this->_currentFrame == nullptr) {
+        return;
+    }
+
+    Frame &frame = *this->_currentFrame;
+    if (frame.timestampCount + 2 > MAX_TIMESTAMPS) {
+        this->_openScopes.push_back(-1);
+        return;
+    }
+
+    Scope scope{name, frame.timestampCount, frame.timestampCount + 1};
+    frame.timestampCount += 2;
+
+    vkCmdWriteTimestamp(this->_commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.timestampPool,
+                        scope.beginQuery);
+
+    this->_openScopes.push_back(frame.scopes.size());
+    frame.scopes.push_back(scope);
+}
+
+/**
+ * @brief Writes timestamp at the end of the most recently started scope
+ */
+void VulkanGpuTimer::endScope() {
+    if (this->_currentFrame == nullptr) {
+        return;
+    }
+
+    if (this->_openScopes.empty()) {
+        throw std::runtime_error("VulkanGpuTimer::endScope(): No scope was started");
+    }
+
+    int scopeIndex = this->_openScopes.back();
+    this->_openScopes.pop_back();
+
+    if (scopeIndex < 0) {
+        return;
+    }
+
+    const Scope &scope = this->_currentFrame->scopes.at(scopeIndex);
+    vkCmdWriteTimestamp(this->_commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, this->_currentFrame->timestampPool,
+                        scope.endQuery);
+}
+
+/**
+ * @brief Starts pipeline statistics query, at most one query can be recorded in a frame
+ */
+void VulkanGpuTimer::beginPipelineStatistics() {
+    if (this->_currentFrame == nullptr || this->_currentFrame->statisticsPool == nullptr ||
+        this->_currentFrame->hasStatistics) {
+        return;
+    }
+
+    vkCmdBeginQuery(this->_commandBuffer, this->_currentFrame->statisticsPool, 0, 0);
+    this->_currentFrame->hasStatistics = true;
+}
+
+/**
+ * @brief Ends pipeline statistics query, must be recorded in the same subpass as beginPipelineStatistics()
+ */
+void VulkanGpuTimer::endPipelineStatistics() {
+    if (this->_currentFrame == nullptr || !this->_currentFrame->hasStatistics) {
+        return;
+    }
+
+    vkCmdEndQuery(this->_commandBuffer, this->_currentFrame->statisticsPool, 0);
+}
+
+/**
+ * @brief Adds sample measured outside of gpu queries, e.g. on the cpu
+ *
+ * @param name Name of scope
+ * @param microseconds Measured time in microseconds
+ */
+void VulkanGpuTimer::addSample(const std::string &name, double microseconds) {
+    std::deque<double> &samples = this->_samples[name];
+    samples.push_back(microseconds);
+
+    if (samples.size() > SAMPLE_COUNT) {
+        samples.pop_front();
+    }
+}
+
+/**
+ * @brief Computes rolling statistics of all scopes from their most recent samples
+ *
+ * @return Statistics of scopes (key: name of scope, value: statistics)
+ */
+std::map<std::string, TimingStatistics> VulkanGpuTimer::getTimingStatistics() const {
+    std::map<std::string, TimingStatistics> statistics;
+
+    for (const auto &[name, samples] : this->_samples) {
+        if (samples.empty()) {
+            continue;
+        }
+
+        std::vector<double> sorted(samples.begin(), samples.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0;
+        for (double sample : sorted) {
+            sum += sample;
+        }
+
+        TimingStatistics scopeStatistics{};
+        scopeStatistics.min = sorted.front();
+        scopeStatistics.average = sum / sorted.size();
+        scopeStatistics.p99 = sorted.at(std::min<size_t>(sorted.size() - 1, sorted.size() * 99 / 100));
+        scopeStatistics.last = samples.back();
+        scopeStatistics.sampleCount = sorted.size();
+
+        statistics.insert({name, scopeStatistics});
+    }
+
+    return statistics;
+}
+
+/**
+ * @brief Getter for pipeline statistics of the last measured frame
+ *
+ * @return Pipeline statistics, all zero if pipeline statistics are not recorded
+ */
+PipelineStatistics VulkanGpuTimer::getPipelineStatistics() const {
+    return this->_pipelineStatistics;
+}
+
+/**
+ * @brief Reads available query results of frame without waiting for the gpu. Results which are not available are
+ * dropped, because the query pool is reset right after
+ *
+ * @param frame Frame whose results are read
+ */
+void VulkanGpuTimer::_collectResults(Frame &frame) {
+    if (!frame.isPending) {
+        return;
+    }
+
+    frame.isPending = false;
+
+    if (frame.timestampCount > 0) {
+        // Every timestamp is followed by its availability
+        std::vector<uint64_t> results(2 * frame.timestampCount);
+        VkResult result = vkGetQueryPoolResults(
+            this->_logicalDevice, frame.timestampPool, 0, frame.timestampCount, results.size() * sizeof(uint64_t),
+            results.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result != VK_SUCCESS && result != VK_NOT_READY) {
+            throw std::runtime_error("VulkanGpuTimer::_collectResults(): Error reading vulkan timestamp queries");
+        }
+
+        for (const Scope &scope : frame.scopes) {
+            bool isAvailable = results[2 * scope.beginQuery + 1] != 0 && results[2 * scope.endQuery + 1] != 0;
+            if (isAvailable) {
+                uint64_t ticks = results[2 * scope.endQuery] - results[2 * scope.beginQuery];
+                this->addSample(scope.name, ticks * this->_timestampPeriod / 1000.0);
+            }
+        }
+    }
+
+    if (frame.hasStatistics) {
+        // Statistics are followed by availability
+        std::array<uint64_t, 6> results{};
+        VkResult result = vkGetQueryPoolResults(this->_logicalDevice, frame.statisticsPool, 0, 1, sizeof(results),
+                                                results.data(), sizeof(results),
+                                                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result != VK_SUCCESS && result != VK_NOT_READY) {
+            throw std::runtime_error(
+                "VulkanGpuTimer::_collectResults(): Error reading vulkan pipeline statistics queries");
+        }
+
+        if (results[5] != 0) {
+            this->_pipelineStatistics.inputAssemblyPrimitives = results[0];
+            this->_pipelineStatistics.vertexShaderInvocations = results[1];
+            this->_pipelineStatistics.clippingPrimitives = results[2];
+            this->_pipelineStatistics.fragmentShaderInvocations = results[3];
+            this->_pipelineStatistics.tessellationEvaluationShaderInvocations = results[4];
+        }
+    }
+}
+
+}  // namespace vft
@@ -0,0 +1,353 @@
+﻿/**
+ * @file vulkan_hybrid_text_renderer.cpp
+ * @author Christian Saloň
+ */
+
+#include "vulkan_hybrid_text_renderer.h"
+
+namespace vft {
+
+/**
+ * @brief Initialize backend renderers drawing small, medium and large characters, backend renderers share one glyph
+ * cache
+ */
+VulkanHybridTextRenderer::VulkanHybridTextRenderer(VkPhysicalDevice physicalDevice,
+                                                   VkDevice logicalDevice,
+                                                   VkQueue graphicsQueue,
+                                                   VkCommandPool commandPool,
+                                                   VkRenderPass renderPass,
+                                                   VkCommandBuffer commandBuffer,
+                                                   VkPipelineCache pipelineCache,
+                                                   const VkPhysicalDeviceFeatures &enabledFeatures)
+    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer,
+                         pipelineCache, enabledFeatures} {
+    this->_backends[0] =
+        std::make_unique<VulkanSdfTextRenderer>(physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass,
+                                                commandBuffer, pipelineCache, enabledFeatures);
+    this->_backends[1] = std::make_unique<VulkanWindingNumberTextRenderer>(
+        physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer, pipelineCache,
+        enabledFeatures);
+    this->_backends[2] = std::make_unique<VulkanTriangulationTextRenderer>(
+        physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer, pipelineCache,
+        enabledFeatures);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setCache(this->_cache);
+    }
+}
+
+/**
+ * @brief Add text block to all backend renderers, the hybrid renderer receives changes of text block
+ *
+ * @param text Text block
+ */
+void VulkanHybridTextRenderer::add(std::shared_ptr<TextBlock> text) {
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->add(text);
+    }
+
+    TextRenderer::add(text);
+    this->_invalidateDrawRecords();
+}
+
+/**
+ * @brief Records commands of all backend renderers which must be executed outside of a render pass
+ */
+void VulkanHybridTextRenderer::prepare() {
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->prepare();
+    }
+}
+
+/**
+ * @brief Assigns characters to backend renderers by their projected size and records draw commands of all backend
+ * renderers
+ */
+void VulkanHybridTextRenderer::draw() {
+    VFONT_PROFILE_ZONE("VulkanHybridTextRenderer::draw");
+    this->_updateDrawRecords();
+    this->_assignCharacters();
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->draw();
+    }
+}
+
+/**
+ * @brief Takes semaphores signaled by uploads of all backend renderers on the transfer queue
+ *
+ * @return Semaphores the graphics submit of current frame must wait for
+ */
+std::vector<VkSemaphore> VulkanHybridTextRenderer::takeTransferSemaphores() {
+    std::vector<VkSemaphore> semaphores;
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        std::vector<VkSemaphore> backendSemaphores = backend->takeTransferSemaphores();
+        semaphores.insert(semaphores.end(), backendSemaphores.begin(), backendSemaphores.end());
+    }
+
+    return semaphores;
+}
+
+/**
+ * @brief Updates all backend renderers after a text block changed
+ */
+void VulkanHybridTextRenderer::update() {
+    VFONT_PROFILE_ZONE("VulkanHybridTextRenderer::update");
+    this->_invalidateDrawRecords();
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->update();
+    }
+}
+
+/**
+ * @brief Add font atlas used by the backend renderer drawing small characters
+ *
+ * @param atlas Font atlas
+ */
+void VulkanHybridTextRenderer::addFontAtlas(const FontAtlas &atlas) {
+    this->_backends[0]->addFontAtlas(atlas);
+}
+
+/**
+ * @brief Set uniform buffer object used for rendering and for computing projected sizes of characters
+ *
+ * @param ubo Uniform buffer object
+ */
+void VulkanHybridTextRenderer::setUniformBuffers(UniformBufferObject ubo) {
+    VulkanTextRenderer::setUniformBuffers(ubo);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setUniformBuffers(ubo);
+    }
+}
+
+/**
+ * @brief Set viewport size
+ *
+ * @param width Viewport width
+ * @param height Viewport height
+ */
+void VulkanHybridTextRenderer::setViewportSize(unsigned int width, unsigned int height) {
+    VulkanTextRenderer::setViewportSize(width, height);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setViewportSize(width, height);
+    }
+}
+
+/**
+ * @brief Set glyph cache shared by all backend renderers
+ *
+ * @param cache Glyph cache
+ */
+void VulkanHybridTextRenderer::setCache(std::shared_ptr<GlyphCache> cache) {
+    VulkanTextRenderer::setCache(cache);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setCache(cache);
+    }
+}
+
+/**
+ * @brief Set whether text blocks and lines outside of view frustum are skipped when drawing
+ *
+ * @param cpuCulling True if culling is enabled
+ */
+void VulkanHybridTextRenderer::setCpuCulling(bool cpuCulling) {
+    VulkanTextRenderer::setCpuCulling(cpuCulling);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setCpuCulling(cpuCulling);
+    }
+}
+
+/**
+ * @brief Setter for vulkan command buffer of next frame of all backend renderers
+ *
+ * @param commandBuffer Vulkan command buffer
+ * @param frameIndex Index of frame in flight the command buffer belongs to
+ */
+void VulkanHybridTextRenderer::setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    VulkanTextRenderer::setCommandBuffer(commandBuffer, frameIndex);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setCommandBuffer(commandBuffer, frameIndex);
+    }
+}
+
+/**
+ * @brief Upload buffers of all backend renderers using a dedicated transfer queue
+ *
+ * @param transferQueue Vulkan queue supporting transfer operations
+ * @param transferCommandPool Vulkan command pool of transfer queue family
+ * @param transferQueueFamilyIndex Index of transfer queue family
+ * @param graphicsQueueFamilyIndex Index of graphics queue family
+ */
+void VulkanHybridTextRenderer::setTransferQueue(VkQueue transferQueue,
+                                                VkCommandPool transferCommandPool,
+                                                uint32_t transferQueueFamilyIndex,
+                                                uint32_t graphicsQueueFamilyIndex) {
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setTransferQueue(transferQueue, transferCommandPool, transferQueueFamilyIndex,
+                                  graphicsQueueFamilyIndex);
+    }
+}
+
+/**
+ * @brief Sets the number of frames in flight of all backend renderers
+ *
+ * @param framesInFlight Number of frames in flight
+ */
+void VulkanHybridTextRenderer::setFramesInFlight(uint32_t framesInFlight) {
+    VulkanTextRenderer::setFramesInFlight(framesInFlight);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setFramesInFlight(framesInFlight);
+    }
+}
+
+/**
+ * @brief Set timer measuring named scopes of commands recorded by backend renderers
+ *
+ * @param gpuTimer Gpu timer or nullptr to stop measuring, the timer must outlive the renderer
+ */
+void VulkanHybridTextRenderer::setGpuTimer(VulkanGpuTimer *gpuTimer) {
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setGpuTimer(gpuTimer);
+    }
+}
+
+/**
+ * @brief Set whether backend renderers record draw commands into secondary command buffers
+ *
+ * @param secondaryCommandBuffers True if secondary command buffers are used
+ */
+void VulkanHybridTextRenderer::setSecondaryCommandBuffers(bool secondaryCommandBuffers) {
+    VulkanTextRenderer::setSecondaryCommandBuffers(secondaryCommandBuffers);
+
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        backend->setSecondaryCommandBuffers(secondaryCommandBuffers);
+    }
+}
+
+/**
+ * @brief Set projected sizes where characters switch strategies
+ *
+ * @param thresholds Thresholds in pixels, the winding number threshold must not be smaller than the sdf threshold and
+ * hysteresis must be between 0 and 1
+ */
+void VulkanHybridTextRenderer::setThresholds(Thresholds thresholds) {
+    if (thresholds.sdfMaxSize < 0 || thresholds.windingNumberMaxSize < thresholds.sdfMaxSize ||
+        thresholds.hysteresis < 0 || thresholds.hysteresis >= 1) {
+        throw std::invalid_argument("VulkanHybridTextRenderer::setThresholds(): Thresholds are invalid");
+    }
+
+    this->_thresholds = thresholds;
+}
+
+/**
+ * @brief Sums statistics of memory allocators of all backend renderers
+ *
+ * @return Memory allocator statistics
+ */
+VulkanMemoryStatistics VulkanHybridTextRenderer::getMemoryStatistics() {
+    VulkanMemoryStatistics statistics{};
+    for (std::unique_ptr<VulkanTextRenderer> &backend : this->_backends) {
+        VulkanMemoryStatistics backendStatistics = backend->getMemoryStatistics();
+        statistics.blockCount += backendStatistics.blockCount;
+        statistics.allocationCount += backendStatistics.allocationCount;
+        statistics.blockBytes += backendStatistics.blockBytes;
+        statistics.allocatedBytes += backendStatistics.allocatedBytes;
+        statistics.deviceAllocationCount += backendStatistics.deviceAllocationCount;
+        statistics.deviceFreeCount += backendStatistics.deviceFreeCount;
+        statistics.totalAllocationCount += backendStatistics.totalAllocationCount;
+        statistics.peakBlockCount += backendStatistics.peakBlockCount;
+        statistics.peakAllocatedBytes += backendStatistics.peakAllocatedBytes;
+    }
+
+    return statistics;
+}
+
+/**
+ * @brief Getter for projected sizes where characters switch strategies
+ *
+ * @return Thresholds in pixels
+ */
+VulkanHybridTextRenderer::Thresholds VulkanHybridTextRenderer::getThresholds() const {
+    return this->_thresholds;
+}
+
+/**
+ * @brief Get number of characters assigned to each backend renderer in the last frame, ordered from sdf to
+ * triangulation
+ *
+ * @return Number of characters of each backend renderer
+ */
+std::array<unsigned int, VulkanHybridTextRenderer::BACKEND_COUNT> VulkanHybridTextRenderer::getAssignedCharacterCounts()
+    const {
+    return this->_assignedCharacterCounts;
+}
+
+/**
+ * @brief Stores model matrix and em square size of every character of all text blocks. Characters keep their backend
+ * renderer while they keep their index
+ */
+void VulkanHybridTextRenderer::_compileDrawRecords() {
+    VFONT_PROFILE_ZONE("VulkanHybridTextRenderer::_compileDrawRecords");
+    this->_characterSizes.clear();
+
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        for (const Character &character : textBlock->getCharacters()) {
+            this->_characterSizes.push_back(CharacterSize{
+                character.getModelMatrix(), static_cast<float>(character.getFont()->getFace()->units_per_EM)});
+        }
+    }
+
+    this->_assignments.resize(this->_characterSizes.size(), UNASSIGNED);
+}
+
+/**
+ * @brief Assigns every character to the backend renderer of its projected size. Assigned characters switch only after
+ * their size passes a threshold by the hysteresis, so characters near a threshold do not flicker between strategies
+ */
+void VulkanHybridTextRenderer::_assignCharacters() {
+    VFONT_PROFILE_ZONE("VulkanHybridTextRenderer::_assignCharacters");
+
+    std::array<float, BACKEND_COUNT - 1> thresholds{this->_thresholds.sdfMaxSize,
+                                                    this->_thresholds.windingNumberMaxSize};
+    for (std::vector<bool> &characterMask : this->_characterMasks) {
+        characterMask.assign(this->_characterSizes.size(), false);
+    }
+    this->_assignedCharacterCounts.fill(0);
+
+    for (unsigned int i = 0; i < this->_characterSizes.size(); i++) {
+        const CharacterSize &character = this->_characterSizes[i];
+        float size = this->_getProjectedSize(character.model, character.emSize);
+
+        uint8_t backend = this->_assignments[i];
+        if (backend == UNASSIGNED) {
+            backend = 0;
+            while (backend < thresholds.size() && size > thresholds[backend]) {
+                backend++;
+            }
+        } else {
+            while (backend < thresholds.size() && size > thresholds[backend] * (1 + this->_thresholds.hysteresis)) {
+                backend++;
+            }
+            while (backend > 0 && size < thresholds[backend - 1] * (1 - this->_thresholds.hysteresis)) {
+                backend--;
+            }
+        }
+
+        this->_assignments[i] = backend;
+        this->_characterMasks[backend][i] = true;
+        this->_assignedCharacterCounts[backend]++;
+    }
+
+    for (unsigned int i = 0; i < BACKEND_COUNT; i++) {
+        this->_backends[i]->setCharacterMask(this->_characterMasks[i]);
+    }
+}
+
+}  // namespace vft
@@ -0,0 +1,273 @@
+/**
+ * @file vulkan_memory_allocator.cpp
+ * @author Christian Saloň
+ */
+
+#include "vulkan_memory_allocator.h"
+
+namespace vft {
+
+/**
+ * @brief Creates memory allocator, no vulkan memory is allocated until the first allocation
+ *
+ * @param physicalDevice Vulkan physical device
+ * @param logicalDevice Vulkan logical device
+ * @param blockSize Size of memory blocks allocated from vulkan
+ */
+VulkanMemoryAllocator::VulkanMemoryAllocator(VkPhysicalDevice physicalDevice,
+                                             VkDevice logicalDevice,
+                                             VkDeviceSize blockSize)
+    : _physicalDevice{physicalDevice}, _logicalDevice{logicalDevice}, _blockSize{blockSize} {
+    if (blockSize == 0) {
+        throw std::invalid_argument(
+            "VulkanMemoryAllocator::VulkanMemoryAllocator(): Block size must be greater than 0");
+    }
+
+    vkGetPhysicalDeviceMemoryProperties(this->_physicalDevice, &this->_memoryProperties);
+}
+
+/**
+ * @brief Frees all memory blocks
+ */
+VulkanMemoryAllocator::~VulkanMemoryAllocator() {
+    for (std::unique_ptr<Block> &block : this->_blocks) {
+        if (block->mapped != nullptr)
+            vkUnmapMemory(this->_logicalDevice, block->memory);
+        vkFreeMemory(this->_logicalDevice, block->memory, nullptr);
+    }
+}
+
+/**
+ * @brief Sub-allocates memory satisfying given requirements. A new memory block is allocated only if no existing block
+ * of suitable memory type has a large enough free range
+ *
+ * @param requirements Vulkan memory requirements of buffer
+ * @param properties Required vulkan memory property flags
+ *
+ * @return Allocated memory range
+ */
+VulkanMemoryAllocation VulkanMemoryAllocator::allocate(VkMemoryRequirements requirements,
+                                                       VkMemoryPropertyFlags properties) {
+    uint32_t memoryTypeIndex = this->selectMemoryType(requirements.memoryTypeBits, properties);
+    VkDeviceSize alignment = requirements.alignment > 0 ? requirements.alignment : 1;
+
+    Block *selectedBlock = nullptr;
+    VkDeviceSize offset = 0;
+    for (std::unique_ptr<Block> &block : this->_blocks) {
+        if (block->memoryTypeIndex == memoryTypeIndex &&
+            this->_allocateFromBlock(*block, requirements.size, alignment, offset)) {
+            selectedBlock = block.get();
+            break;
+        }
+    }
+
+    if (selectedBlock == nullptr) {
+        selectedBlock = &this->_createBlock(std::max(this->_blockSize, requirements.size), memoryTypeIndex);
+        this->_allocateFromBlock(*selectedBlock, requirements.size, alignment, offset);
+    }
+
+    selectedBlock->allocationCount++;
+
+    this->_statistics.allocationCount++;
+    this->_statistics.totalAllocationCount++;
+    this->_statistics.allocatedBytes += requirements.size;
+    this->_statistics.peakAllocatedBytes =
+        std::max(this->_statistics.peakAllocatedBytes, this->_statistics.allocatedBytes);
+
+    VulkanMemoryAllocation allocation{};
+    allocation.memory = selectedBlock->memory;
+    allocation.offset = offset;
+    allocation.size = requirements.size;
+    allocation.mapped =
+        selectedBlock->mapped != nullptr ? static_cast<char *>(selectedBlock->mapped) + offset : nullptr;
+
+    return allocation;
+}
+
+/**
+ * @brief Returns memory range back to its memory block. Empty blocks are freed unless it is the last block of its
+ * memory type, which is kept for following allocations
+ *
+ * @param allocation Allocated memory range, it is reset after being freed
+ */
+void VulkanMemoryAllocator::free(VulkanMemoryAllocation &allocation) {
+    if (allocation.memory == nullptr)
+        return;
+
+    unsigned int blockIndex = 0;
+    while (blockIndex < this->_blocks.size() && this->_blocks.at(blockIndex)->memory != allocation.memory) {
+        blockIndex++;
+    }
+
+    if (blockIndex == this->_blocks.size()) {
+        throw std::invalid_argument("VulkanMemoryAllocator::free(): Allocation does not belong to this allocator");
+    }
+
+    Block &block = *this->_blocks.at(blockIndex);
+    VkDeviceSize offset = allocation.offset;
+    VkDeviceSize size = allocation.size;
+
+    // Merge with following free range
+    auto next = block.freeRanges.find(offset + size);
+    if (next != block.freeRanges.end()) {
+        size += next->second;
+        block.freeRanges.erase(next);
+    }
+
+    // Merge with preceding free range
+    auto inserted = block.freeRanges.insert({offset, size}).first;
+    if (inserted != block.freeRanges.begin()) {
+        auto previous = std::prev(inserted);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            block.freeRanges.erase(inserted);
+        }
+    }
+
+    block.allocationCount--;
+
+    this->_statistics.allocationCount--;
+    this->_statistics.allocatedBytes -= allocation.size;
+
+    allocation = VulkanMemoryAllocation{};
+
+    if (block.allocationCount == 0) {
+        bool isLastBlockOfType = std::none_of(
+            this->_blocks.begin(), this->_blocks.end(), [&block](const std::unique_ptr<Block> &other) {
+                return other.get() != &block && other->memoryTypeIndex == block.memoryTypeIndex;
+            });
+
+        if (!isLastBlockOfType || block.size > this->_blockSize) {
+            this->_destroyBlock(blockIndex);
+        }
+    }
+}
+
+/**
+ * @brief Selects a suitable memory type for vulkan allocation
+ *
+ * @param memoryTypeBits A bitmask specifying the memory type indices that are compatible
+ * @param properties The required memory property flags
+ *
+ * @return The index of a suitable memory type with specified properties
+ */
+uint32_t VulkanMemoryAllocator::selectMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) {
+    for (uint32_t i = 0; i < this->_memoryProperties.memoryTypeCount; i++) {
+        if ((memoryTypeBits & (1 << i)) &&
+            (this->_memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("VulkanMemoryAllocator::selectMemoryType(): Error selecting memory for vulkan buffer");
+}
+
+/**
+ * @brief Getter for allocator statistics
+ *
+ * @return Allocator statistics
+ */
+VulkanMemoryStatistics VulkanMemoryAllocator::getStatistics() {
+    return this->_statistics;
+}
+
+/**
+ * @brief Allocates a new memory block from vulkan, host visible blocks are persistently mapped
+ *
+ * @param size Size of memory block
+ * @param memoryTypeIndex Vulkan memory type of block
+ *
+ * @return Created memory block
+ */
+VulkanMemoryAllocator::Block &VulkanMemoryAllocator::_createBlock(VkDeviceSize size, uint32_t memoryTypeIndex) {
+    std::unique_ptr<Block> block = std::make_unique<Block>();
+    block->size = size;
+    block->memoryTypeIndex = memoryTypeIndex;
+    block->freeRanges.insert({0, size});
+
+    VkMemoryAllocateInfo memoryAllocateInfo{};
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.allocationSize = size;
+    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    if (vkAllocateMemory(this->_logicalDevice, &memoryAllocateInfo, nullptr, &block->memory) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanMemoryAllocator::_createBlock(): Error allocating vulkan memory block");
+    }
+
+    if (this->_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        if (vkMapMemory(this->_logicalDevice, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mapped) != VK_SUCCESS) {
+            vkFreeMemory(this->_logicalDevice, block->memory, nullptr);
+            throw std::runtime_error("VulkanMemoryAllocator::_createBlock(): Error mapping vulkan memory block");
+        }
+    }
+
+    this->_statistics.blockCount++;
+    this->_statistics.blockBytes += size;
+    this->_statistics.deviceAllocationCount++;
+    this->_statistics.peakBlockCount = std::max(this->_statistics.peakBlockCount, this->_statistics.blockCount);
+
+    this->_blocks.push_back(std::move(block));
+    return *this->_blocks.back();
+}
+
+/**
+ * @brief Frees memory block
+ *
+ * @param blockIndex Index of block in blocks vector
+ */
+void VulkanMemoryAllocator::_destroyBlock(unsigned int blockIndex) {
+    Block &block = *this->_blocks.at(blockIndex);
+
+    if (block.mapped != nullptr)
+        vkUnmapMemory(this->_logicalDevice, block.memory);
+    vkFreeMemory(this->_logicalDevice, block.memory, nullptr);
+
+    this->_statistics.blockCount--;
+    this->_statistics.blockBytes -= block.size;
+    this->_statistics.deviceFreeCount++;
+
+    this->_blocks.erase(this->_blocks.begin() + blockIndex);
+}
+
+/**
+ * @brief Finds the first free range of block that can hold an aligned allocation and removes it from the free list.
+ * Parts of the free range before and after the allocation stay in the free list
+ *
+ * @param block Memory block
+ * @param size Size of allocation
+ * @param alignment Required alignment of allocation offset
+ * @param offset Offset of allocation in block
+ *
+ * @return True if allocation fits into block, else false
+ */
+bool VulkanMemoryAllocator::_allocateFromBlock(Block &block,
+                                               VkDeviceSize size,
+                                               VkDeviceSize alignment,
+                                               VkDeviceSize &offset) {
+    for (auto range = block.freeRanges.begin(); range != block.freeRanges.end(); range++) {
+        VkDeviceSize rangeStart = range->first;
+        VkDeviceSize rangeEnd = range->first + range->second;
+        VkDeviceSize alignedStart = (rangeStart + alignment - 1) / alignment * alignment;
+
+        if (alignedStart + size > rangeEnd) {
+            continue;
+        }
+
+        block.freeRanges.erase(range);
+
+        if (alignedStart > rangeStart) {
+            block.freeRanges.insert({rangeStart, alignedStart - rangeStart});
+        }
+
+        if (alignedStart + size < rangeEnd) {
+            block.freeRanges.insert({alignedStart + size, rangeEnd - alignedStart - size});
+        }
+
+        offset = alignedStart;
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace vft
@@ -0,0 +1,125 @@
+/**
+ * @file vulkan_pipeline_cache.cpp
+ * @author Christian Saloň
+ */
+
+#include "vulkan_pipeline_cache.h"
+
+namespace vft {
+
+/**
+ * @brief Creates vulkan pipeline cache initialized with data from file if the data was created by the same device
+ *
+ * @param physicalDevice Vulkan physical device
+ * @param logicalDevice Vulkan logical device
+ * @param fileName Path to file containing pipeline cache data
+ */
+VulkanPipelineCache::VulkanPipelineCache(VkPhysicalDevice physicalDevice, VkDevice logicalDevice, std::string fileName)
+    : _physicalDevice{physicalDevice}, _logicalDevice{logicalDevice}, _fileName{fileName} {
+    std::vector<char> data = this->_loadCacheData();
+
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize = data.size();
+    pipelineCacheCreateInfo.pInitialData = data.size() > 0 ? data.data() : nullptr;
+
+    if (vkCreatePipelineCache(this->_logicalDevice, &pipelineCacheCreateInfo, nullptr, &this->_pipelineCache) !=
+        VK_SUCCESS) {
+        throw std::runtime_error("VulkanPipelineCache::VulkanPipelineCache(): Error creating vulkan pipeline cache");
+    }
+}
+
+/**
+ * @brief Saves pipeline cache data to file and destroys vulkan pipeline cache
+ */
+VulkanPipelineCache::~VulkanPipelineCache() {
+    if (this->_pipelineCache != nullptr) {
+        // Failing to save the cache only slows down the next startup
+        try {
+            this->save();
+        } catch (const std::exception &) {
+        }
+
+        vkDestroyPipelineCache(this->_logicalDevice, this->_pipelineCache, nullptr);
+    }
+}
+
+/**
+ * @brief Writes current pipeline cache data to file
+ */
+void VulkanPipelineCache::save() {
+    size_t size = 0;
+    if (vkGetPipelineCacheData(this->_logicalDevice, this->_pipelineCache, &size, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanPipelineCache::save(): Error getting size of vulkan pipeline cache data");
+    }
+
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(this->_logicalDevice, this->_pipelineCache, &size, data.data()) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanPipelineCache::save(): Error getting vulkan pipeline cache data");
+    }
+
+    std::ofstream file{this->_fileName, std::ios::binary | std::ios::trunc};
+    if (!file.is_open()) {
+        throw std::runtime_error("VulkanPipelineCache::save(): Error opening file " + this->_fileName);
+    }
+
+    file.write(data.data(), size);
+}
+
+/**
+ * @brief Getter for vulkan pipeline cache
+ *
+ * @return Vulkan pipeline cache
+ */
+VkPipelineCache VulkanPipelineCache::getPipelineCache() {
+    return this->_pipelineCache;
+}
+
+/**
+ * @brief Reads pipeline cache data from file
+ *
+ * @return Pipeline cache data or empty vector if file does not exist or data is not valid for current device
+ */
+std::vector<char> VulkanPipelineCache::_loadCacheData() {
+    std::ifstream file{this->_fileName, std::ios::ate | std::ios::binary};
+    if (!file.is_open()) {
+        return {};
+    }
+
+    size_t size = static_cast<size_t>(file.tellg());
+    std::vector<char> data(size);
+
+    file.seekg(0);
+    file.read(data.data(), size);
+
+    if (!file || !this->_isCacheDataValid(data)) {
+        return {};
+    }
+
+    return data;
+}
+
+/**
+ * @brief Checks whether pipeline cache data was created by the current device and driver
+ *
+ * @param data Pipeline cache data starting with pipeline cache header
+ *
+ * @return True if data can be used to initialize pipeline cache
+ */
+bool VulkanPipelineCache::_isCacheDataValid(const std::vector<char> &data) {
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(this->_physicalDevice, &properties);
+
+    return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+}  // namespace vft
@@ -15,18 +15,42 @@ VulkanSdfTextRenderer::VulkanSdfTextRenderer(VkPhysicalDevice physicalDevice,
                                              VkQueue graphicsQueue,
                                              VkCommandPool commandPool,
                                              VkRenderPass renderPass,
-                                             VkCommandBuffer commandBuffer)
-    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer} {
+                                             VkCommandBuffer commandBuffer,
+                                             VkPipelineCache pipelineCache,
+                                             const VkPhysicalDeviceFeatures &enabledFeatures)
+    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer,
+                         pipelineCache, enabledFeatures} {
+    // Font atlases are indexed in the fragment shader by push constants only if the logical device enables dynamic
+    // indexing, descriptor pool is sized by it
+    this->_fontAtlasArrayEnabled = this->_enabledFeatures.shaderSampledImageArrayDynamicIndexing;
     this->_initialize();
 
+    // Compressed font atlases are decompressed on the cpu if the device can not sample bc4 images
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(this->_physicalDevice, VK_FORMAT_BC4_UNORM_BLOCK, &formatProperties);
+    VkFormatFeatureFlags requiredFeatures =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    this->_bc4Supported = this->_enabledFeatures.textureCompressionBC &&
+                          (formatProperties.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+
     this->_createFontAtlasDescriptorSetLayout();
-    this->_createPipeline();
+    if (this->_fontAtlasArrayEnabled) {
+        this->_createFontAtlasDescriptorSet();
+        this->_createPipeline("shaders/sdf_array-frag.spv", this->_pipeline);
+        this->_createPipeline("shaders/msdf_array-frag.spv", this->_msdfPipeline);
+    } else {
+        this->_createPipeline("shaders/sdf-frag.spv", this->_pipeline);
+        this->_createPipeline("shaders/msdf-frag.spv", this->_msdfPipeline);
+    }
 }
 
 /**
  * @brief Deallocate memory and destroy vulkan text renderer
  */
 VulkanSdfTextRenderer::~VulkanSdfTextRenderer() {
+    // Wait until the gpu stops using vulkan objects of renderer
+    vkDeviceWaitIdle(this->_logicalDevice);
+
     // Destroy textures
     for (auto &texture : this->_fontTextures) {
         vkDestroySampler(this->_logicalDevice, texture.second.sampler, nullptr);
@@ -46,6 +70,8 @@ VulkanSdfTextRenderer::~VulkanSdfTextRenderer() {
         vkDestroyDescriptorSetLayout(this->_logicalDevice, this->_fontAtlasDescriptorSetLayout, nullptr);
 
     // Destroy pipeline
+    if (this->_msdfPipeline != nullptr)
+        vkDestroyPipeline(this->_logicalDevice, this->_msdfPipeline, nullptr);
     if (this->_pipeline != nullptr)
         vkDestroyPipeline(this->_logicalDevice, this->_pipeline, nullptr);
     if (this->_pipelineLayout != nullptr)
@@ -56,55 +82,82 @@ VulkanSdfTextRenderer::~VulkanSdfTextRenderer() {
  * @brief Add draw commands to the command buffer for drawing all glyphs in tracked text blocks
  */
 void VulkanSdfTextRenderer::draw() {
+    VFONT_PROFILE_ZONE("VulkanSdfTextRenderer::draw");
+    VulkanTextRenderer::draw();
+
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
         return;
     }
 
-    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipeline);
+    // Tiers of font atlases depend on the view, recorded draw commands are reused only if no tier changed
+    this->_updateDrawRecords();
+    if (this->_selectTiers()) {
+        this->_invalidateSecondaryCommandBuffers();
+    }
+
+    if (!this->_beginDrawCommands()) {
+        return;
+    }
 
     VkBuffer vertexBuffers[] = {this->_vertexBuffer};
     VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(this->_commandBuffer, 0, 1, vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(this->_commandBuffer, this->_boundingBoxIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-
-    std::string lastFontFamily = "";
-
-    // Draw bounding boxes
-    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
-        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};;
-
-            if (this->_offsets.at(key).boundingBoxCount > 0) {
-                if (character.getFont()->getFontFamily() != lastFontFamily) {
-                    // Bind descriptor sets if font texture should change
-                    std::array<VkDescriptorSet, 2> sets = {
-                        this->_uboDescriptorSet,
-                        this->_fontTextures.at(character.getFont()->getFontFamily()).descriptorSet};
-                    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                            this->_pipelineLayout, 0, sets.size(), sets.data(), 0, nullptr);
-
-                    lastFontFamily = character.getFont()->getFontFamily();
-                }
+    vkCmdBindVertexBuffers(this->_recordingCommandBuffer, 0, 1, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_boundingBoxIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+    // All font textures in descriptor array are in one descriptor set, pipelines share the pipeline layout so it stays
+    // bound
+    if (this->_fontAtlasArrayEnabled) {
+        std::array<VkDescriptorSet, 2> sets = {this->_uboDescriptorSet, this->_fontAtlasDescriptorSet};
+        vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipelineLayout,
+                                0, sets.size(), sets.data(), 1, &this->_uboOffset);
+    }
 
-                // Push constants
-                CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks.at(i)->getColor()};
-                vkCmdPushConstants(this->_commandBuffer, this->_pipelineLayout,
-                                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                                   sizeof(CharacterPushConstants), &pushConstants);
+    // Draw bounding boxes, draw records are sorted by pipelines and descriptor sets of font textures, so with the
+    // descriptor array characters of all fonts with the same format of font texture are drawn in one batch
+    VkPipeline boundPipeline = nullptr;
+    VkDescriptorSet boundDescriptorSet = nullptr;
+    for (const DrawRecordRange &range : this->_getVisibleDrawRecordRanges()) {
+        // Range never contains records of two pipelines or descriptor sets
+        const DrawRecord &firstRecord = this->_drawRecords[range.first];
+        if (firstRecord.pipeline != boundPipeline) {
+            // Bind pipeline if format of font texture should change
+            vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, firstRecord.pipeline);
+            boundPipeline = firstRecord.pipeline;
+        }
+
+        if (!this->_fontAtlasArrayEnabled && firstRecord.descriptorSet != boundDescriptorSet) {
+            // Bind descriptor sets if font texture should change
+            std::array<VkDescriptorSet, 2> sets = {this->_uboDescriptorSet, firstRecord.descriptorSet};
+            vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    this->_pipelineLayout, 0, sets.size(), sets.data(), 1, &this->_uboOffset);
+            boundDescriptorSet = firstRecord.descriptorSet;
+        }
 
-                vkCmdDrawIndexed(this->_commandBuffer, this->_offsets.at(key).boundingBoxCount, 1,
-                                 this->_offsets.at(key).boundingBoxOffset, 0, 0);
+        for (uint32_t i = range.first; i < range.first + range.count; i++) {
+            const DrawRecord &record = this->_drawRecords[i];
+            if (!this->_isCharacterDrawn(record)) {
+                continue;
             }
+
+            vkCmdPushConstants(this->_recordingCommandBuffer, this->_pipelineLayout,
+                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(SdfPushConstants),
+                               &this->_drawInstances[record.instance]);
+            vkCmdDrawIndexed(this->_recordingCommandBuffer, record.indexCount, 1, record.firstIndex,
+                             record.vertexOffset, 0);
         }
     }
+
+    this->_endDrawCommands();
 }
 
 /**
  * @brief Creates a new vertex and index buffer after a change in tracked text blocks
  */
 void VulkanSdfTextRenderer::update() {
+    VFONT_PROFILE_ZONE("VulkanSdfTextRenderer::update");
     SdfTextRenderer::update();
+    this->_invalidateDrawRecords();
 
     // Destroy vulkan buffers
     this->_destroyBuffer(this->_boundingBoxIndexBuffer, this->_boundingBoxIndexBufferMemory);
@@ -128,26 +181,47 @@ void VulkanSdfTextRenderer::update() {
 }
 
 /**
- * @brief Add font atlas and create the required vulkan objects used to rneder text using sdf textures
+ * @brief Add font atlas and create the required vulkan objects used to rneder text using sdf textures. Compressed font
+ * atlases are uploaded as bc4 images, which requires the textureCompressionBC feature enabled on the logical device if
+ * the physical device supports it. Texture is added to the descriptor array of font atlases if the logical device
+ * enables the shaderSampledImageArrayDynamicIndexing feature, otherwise it gets its own descriptor set
  *
  * @param atlas New font atlas
  */
 void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
+    if (this->_fontTextures.size() >= MAX_FONT_ATLASES) {
+        throw std::runtime_error("VulkanSdfTextRenderer::addFontAtlas(): Maximum number of font atlases reached");
+    }
+
     SdfTextRenderer::addFontAtlas(atlas);
+    this->_invalidateDrawRecords();
+
+    // Multi-channel sdfs are stored in four channels, because three channel formats are rarely supported
+    VkFormat format = atlas.getFormat() == FontAtlas::Format::MSDF ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8_UNORM;
+    VkPipeline pipeline = atlas.getFormat() == FontAtlas::Format::MSDF ? this->_msdfPipeline : this->_pipeline;
+
+    const uint8_t *textureData = atlas.getTexture().data();
+    VkDeviceSize size = atlas.getSize().x * atlas.getSize().y * atlas.getChannelCount();
+
+    std::vector<uint8_t> decompressedTexture;
+    if (atlas.isCompressed() && this->_bc4Supported) {
+        format = VK_FORMAT_BC4_UNORM_BLOCK;
+        size = atlas.getTexture().size();
+    } else if (atlas.isCompressed()) {
+        decompressedTexture = Bc4Encoder::decode(atlas.getTexture(), atlas.getSize().x, atlas.getSize().y);
+        textureData = decompressedTexture.data();
+    }
 
     // Create staging buffer
-    VkDeviceSize size = atlas.getSize().x * atlas.getSize().y;
     VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
+    VulkanMemoryAllocation stagingBufferMemory;
     this->_createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
                         stagingBufferMemory);
 
-    // Copy data from CPU to staging buffer
-    void *buffer;
-    vkMapMemory(this->_logicalDevice, stagingBufferMemory, 0, size, 0, &buffer);
-    memcpy(buffer, atlas.getTexture().data(), size);
-    vkUnmapMemory(this->_logicalDevice, stagingBufferMemory);
+    // Copy data from CPU to mapped staging buffer
+    memcpy(stagingBufferMemory.mapped, textureData, size);
+    VFONT_PROFILE_COUNTER("bytes uploaded", size);
 
     // Create vulkan image of font atlas
     VkImageCreateInfo imageCreateInfo{};
@@ -158,7 +232,7 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
     imageCreateInfo.extent.depth = 1;
     imageCreateInfo.mipLevels = 1;
     imageCreateInfo.arrayLayers = 1;
-    imageCreateInfo.format = VK_FORMAT_R8_UNORM;
+    imageCreateInfo.format = format;
     imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
@@ -187,18 +261,22 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
 
     vkBindImageMemory(this->_logicalDevice, image, imageMemory, 0);
 
-    this->_transitionImageLayout(image, VK_FORMAT_R8_UNORM, VK_IMAGE_LAYOUT_UNDEFINED,
+    // Layout transitions and copy are submitted in one command buffer, draws submitted later to the graphics queue
+    // are ordered after them by the last barrier
+    VkCommandBuffer commandBuffer = this->_beginOneTimeCommands();
+    this->_transitionImageLayout(commandBuffer, image, format, VK_IMAGE_LAYOUT_UNDEFINED,
                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    this->_copyBufferToImage(stagingBuffer, image, atlas.getSize().x, atlas.getSize().y);
-    this->_transitionImageLayout(image, VK_FORMAT_R8_UNORM, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    this->_copyBufferToImage(commandBuffer, stagingBuffer, image, atlas.getSize().x, atlas.getSize().y);
+    this->_transitionImageLayout(commandBuffer, image, format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    this->_endOneTimeCommands(commandBuffer);
 
     // Create vulkan image view
     VkImageViewCreateInfo imageViewCreateInfo{};
     imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     imageViewCreateInfo.image = image;
     imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    imageViewCreateInfo.format = VK_FORMAT_R8_UNORM;
+    imageViewCreateInfo.format = format;
     imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
     imageViewCreateInfo.subresourceRange.levelCount = 1;
@@ -231,15 +309,22 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
             "VulkanSdfTextRenderer::addFontAtlas(): Could not create vulkan sampler for font atlas");
     }
 
-    // Create descriptor set used when rendering with given font atlas
-    VkDescriptorSet descriptorSet = this->_createFontAtlasDescriptorSet(imageView, sampler);
+    // Font texture takes the next element of descriptor array of font atlases, or a descriptor set used when rendering
+    // with given font atlas
+    uint32_t index = this->_fontTextures.size();
+    VkDescriptorSet descriptorSet = nullptr;
+    if (!this->_fontAtlasArrayEnabled) {
+        descriptorSet = this->_createFontTextureDescriptorSet(imageView, sampler);
+    }
 
-    FontTexture texture{image, imageMemory, imageView, sampler, descriptorSet};
+    FontTexture texture{image, imageMemory, imageView, sampler, index, descriptorSet, pipeline};
     this->_fontTextures.insert({atlas.getFontFamily(), texture});
+    if (this->_fontAtlasArrayEnabled) {
+        this->_updateFontAtlasDescriptorSet();
+    }
 
-    // Destroy and deallocate memory from the staging buffer
-    vkDestroyBuffer(this->_logicalDevice, stagingBuffer, nullptr);
-    vkFreeMemory(this->_logicalDevice, stagingBufferMemory, nullptr);
+    // Staging buffer is destroyed after the gpu executes the copy
+    this->_destroyBuffer(stagingBuffer, stagingBufferMemory);
 }
 
 /**
@@ -248,17 +333,17 @@ void VulkanSdfTextRenderer::addFontAtlas(const FontAtlas &atlas) {
 void VulkanSdfTextRenderer::_createDescriptorPool() {
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
 
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSizes[0].descriptorCount = 1;
 
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[1].descriptorCount = 64;
+    poolSizes[1].descriptorCount = MAX_FONT_ATLASES;
 
     VkDescriptorPoolCreateInfo poolCreateInfo{};
     poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolCreateInfo.poolSizeCount = poolSizes.size();
     poolCreateInfo.pPoolSizes = poolSizes.data();
-    poolCreateInfo.maxSets = 65;
+    poolCreateInfo.maxSets = this->_fontAtlasArrayEnabled ? 2 : 1 + MAX_FONT_ATLASES;
 
     if (vkCreateDescriptorPool(this->_logicalDevice, &poolCreateInfo, nullptr, &this->_descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error(
@@ -267,13 +352,14 @@ void VulkanSdfTextRenderer::_createDescriptorPool() {
 }
 
 /**
- * @brief Create vulkan descriptor set layout for font atlases
+ * @brief Create vulkan descriptor set layout for font atlases, which are stored in one array if the logical device
+ * enables dynamic indexing
  */
 void VulkanSdfTextRenderer::_createFontAtlasDescriptorSetLayout() {
     VkDescriptorSetLayoutBinding layoutBinding{};
     layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     layoutBinding.binding = 0;
-    layoutBinding.descriptorCount = 1;
+    layoutBinding.descriptorCount = this->_fontAtlasArrayEnabled ? MAX_FONT_ATLASES : 1;
     layoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
     VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
@@ -290,14 +376,62 @@ void VulkanSdfTextRenderer::_createFontAtlasDescriptorSetLayout() {
 }
 
 /**
- * @brief Create vulkan descriptor set for font atlas
+ * @brief Allocate vulkan descriptor set containing all font atlases
+ */
+void VulkanSdfTextRenderer::_createFontAtlasDescriptorSet() {
+    VkDescriptorSetAllocateInfo allocateInfo{};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = this->_descriptorPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &this->_fontAtlasDescriptorSetLayout;
+
+    if (vkAllocateDescriptorSets(this->_logicalDevice, &allocateInfo, &this->_fontAtlasDescriptorSet) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(): Error allocating vulkan descriptor sets");
+    }
+}
+
+/**
+ * @brief Writes font textures into the descriptor array of font atlases. Unused elements are filled with the first
+ * font texture, so every element is valid
+ */
+void VulkanSdfTextRenderer::_updateFontAtlasDescriptorSet() {
+    if (this->_fontTextures.empty()) {
+        return;
+    }
+
+    // Descriptor set can not be updated while it is used by pending command buffers, font atlases are added rarely
+    vkDeviceWaitIdle(this->_logicalDevice);
+
+    std::vector<VkDescriptorImageInfo> imageInfos(MAX_FONT_ATLASES);
+    for (const auto &[fontFamily, texture] : this->_fontTextures) {
+        imageInfos[texture.index].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageInfos[texture.index].imageView = texture.imageView;
+        imageInfos[texture.index].sampler = texture.sampler;
+    }
+    std::fill(imageInfos.begin() + this->_fontTextures.size(), imageInfos.end(), imageInfos[0]);
+
+    VkWriteDescriptorSet writeDescriptorSet{};
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.dstSet = this->_fontAtlasDescriptorSet;
+    writeDescriptorSet.dstBinding = 0;
+    writeDescriptorSet.dstArrayElement = 0;
+    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writeDescriptorSet.descriptorCount = imageInfos.size();
+    writeDescriptorSet.pImageInfo = imageInfos.data();
+
+    vkUpdateDescriptorSets(this->_logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+}
+
+/**
+ * @brief Create vulkan descriptor set for font atlas, used if font atlases are not in one descriptor array
  *
  * @param imageView Vulkan image view of font atlas
- * @param sampler Vulkan smapler of font atlas
+ * @param sampler Vulkan sampler of font atlas
  *
  * @return Created vulkan descriptor set for font atlas
  */
-VkDescriptorSet VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(VkImageView imageView, VkSampler sampler) {
+VkDescriptorSet VulkanSdfTextRenderer::_createFontTextureDescriptorSet(VkImageView imageView, VkSampler sampler) {
     VkDescriptorSet descriptorSet{};
 
     VkDescriptorSetAllocateInfo allocateInfo{};
@@ -308,7 +442,7 @@ VkDescriptorSet VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(VkImageView
 
     if (vkAllocateDescriptorSets(this->_logicalDevice, &allocateInfo, &descriptorSet) != VK_SUCCESS) {
         throw std::runtime_error(
-            "VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(): Error allocating vulkan descriptor sets");
+            "VulkanSdfTextRenderer::_createFontTextureDescriptorSet(): Error allocating vulkan descriptor sets");
     }
 
     VkDescriptorImageInfo imageInfo{};
@@ -331,19 +465,19 @@ VkDescriptorSet VulkanSdfTextRenderer::_createFontAtlasDescriptorSet(VkImageView
 }
 
 /**
- * @brief Transitions an image from one layout to another
+ * @brief Records transition of an image from one layout to another
  *
+ * @param commandBuffer Vulkan command buffer the barrier is recorded into
  * @param image Vulkan image to transition
  * @param format Format of the image
  * @param oldLayout Current layout of the image
  * @param newLayout Target layout to transition the image to
  */
-void VulkanSdfTextRenderer::_transitionImageLayout(VkImage image,
+void VulkanSdfTextRenderer::_transitionImageLayout(VkCommandBuffer commandBuffer,
+                                                   VkImage image,
                                                    VkFormat format,
                                                    VkImageLayout oldLayout,
                                                    VkImageLayout newLayout) {
-    VkCommandBuffer commandBuffer = this->_beginOneTimeCommands();
-
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.oldLayout = oldLayout;
@@ -378,21 +512,22 @@ void VulkanSdfTextRenderer::_transitionImageLayout(VkImage image,
     }
 
     vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-    this->_endOneTimeCommands(commandBuffer);
 }
 
 /**
- * @brief Copy data from vulkan buffer to vulkan image
+ * @brief Records copy of data from vulkan buffer to vulkan image
  *
+ * @param commandBuffer Vulkan command buffer the copy is recorded into
  * @param buffer Source vulkan buffer
  * @param image Destination vulkan image
  * @param width Width of vulkan image
  * @param height Height of vulkan image
  */
-void VulkanSdfTextRenderer::_copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
-    VkCommandBuffer commandBuffer = this->_beginOneTimeCommands();
-
+void VulkanSdfTextRenderer::_copyBufferToImage(VkCommandBuffer commandBuffer,
+                                               VkBuffer buffer,
+                                               VkImage image,
+                                               uint32_t width,
+                                               uint32_t height) {
     VkBufferImageCopy region{};
     region.bufferOffset = 0;
     region.bufferRowLength = 0;
@@ -405,16 +540,17 @@ void VulkanSdfTextRenderer::_copyBufferToImage(VkBuffer buffer, VkImage image, u
     region.imageExtent = VkExtent3D{width, height, 1};
 
     vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    this->_endOneTimeCommands(commandBuffer);
 }
 
 /**
- * @brief Create vulkan pipeline for displaying glyphs using sdfs
+ * @brief Create vulkan pipeline for displaying glyphs using sdfs, pipeline layout is shared by all pipelines
+ *
+ * @param fragmentShaderFile Path to fragment shader sampling font textures
+ * @param pipeline Created vulkan pipeline
  */
-void VulkanSdfTextRenderer::_createPipeline() {
-    std::vector<char> vertexShaderCode = this->_readFile("shaders/sdf-vert.spv");
-    std::vector<char> fragmentShaderCode = this->_readFile("shaders/sdf-frag.spv");
+void VulkanSdfTextRenderer::_createPipeline(const std::string &fragmentShaderFile, VkPipeline &pipeline) {
+    std::vector<char> vertexShaderCode = this->_readShader("shaders/sdf-vert.spv");
+    std::vector<char> fragmentShaderCode = this->_readShader(fragmentShaderFile);
 
     VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
     VkShaderModule fragmentShaderModule = this->_createShaderModule(fragmentShaderCode);
@@ -507,7 +643,7 @@ void VulkanSdfTextRenderer::_createPipeline() {
     colorBlendStateCreateInfo.attachmentCount = 1;
 
     VkPushConstantRange pushConstantRange{};
-    pushConstantRange.size = sizeof(CharacterPushConstants);
+    pushConstantRange.size = sizeof(SdfPushConstants);
     pushConstantRange.offset = 0;
     pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -520,8 +656,9 @@ void VulkanSdfTextRenderer::_createPipeline() {
     pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
     pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
 
-    if (vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr, &this->_pipelineLayout) !=
-        VK_SUCCESS) {
+    if (this->_pipelineLayout == nullptr &&
+        vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr, &this->_pipelineLayout) !=
+            VK_SUCCESS) {
         throw std::runtime_error("VulkanSdfTextRenderer::_createPipeline(): Error creating vulkan pipeline layout");
     }
 
@@ -541,8 +678,8 @@ void VulkanSdfTextRenderer::_createPipeline() {
     graphicsPipelineCreateInfo.renderPass = this->_renderPass;
     graphicsPipelineCreateInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
-                                  &this->_pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, this->_pipelineCache, 1, &graphicsPipelineCreateInfo,
+                                  nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("VulkanSdfTextRenderer::_createPipeline(): Error creating vulkan graphics pipeline");
     }
 
@@ -550,4 +687,89 @@ void VulkanSdfTextRenderer::_createPipeline() {
     vkDestroyShaderModule(this->_logicalDevice, fragmentShaderModule, nullptr);
 }
 
+/**
+ * @brief Compiles a draw record and push constants for every character with a bounding box, so that drawing does not
+ * look up glyph offsets or font textures. Draw records are sorted by pipelines and descriptor sets of font textures,
+ * font textures in descriptor array are selected by push constants and share one descriptor set
+ */
+void VulkanSdfTextRenderer::_compileDrawRecords() {
+    VFONT_PROFILE_ZONE("VulkanSdfTextRenderer::_compileDrawRecords");
+    this->_drawInstances.clear();
+    this->_tierSelections.clear();
+
+    uint32_t line = 0;
+    uint32_t characterOffset = 0;
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        std::vector<Character> characters = textBlock->getCharacters();
+        for (const LineBoundingBox &lineBoundingBox : textBlock->getLineBoundingBoxes()) {
+            for (unsigned int i = lineBoundingBox.start; i < lineBoundingBox.start + lineBoundingBox.count; i++) {
+                const Character &character = characters[i];
+                GlyphKey key{TessellationStrategy::SDF, character.getFont()->getFontFamily(),
+                             character.getGlyphId(), 0};
+                const GlyphInfo &glyphInfo = this->_offsets.at(key);
+
+                if (glyphInfo.boundingBoxCount > 0) {
+                    const FontTexture &texture = this->_fontTextures.at(character.getFont()->getFontFamily());
+                    uint32_t instance = this->_drawInstances.size();
+                    this->_drawRecords.push_back(DrawRecord{texture.pipeline, texture.descriptorSet,
+                                                            glyphInfo.boundingBoxCount, glyphInfo.boundingBoxOffset, 0,
+                                                            instance, line, characterOffset + i});
+                    this->_drawInstances.push_back(
+                        SdfPushConstants{character.getModelMatrix(), textBlock->getColor(), texture.index});
+                    this->_tierSelections.push_back(TierSelection{
+                        static_cast<float>(character.getFont()->getFace()->units_per_EM),
+                        &this->_fontAtlases.at(character.getFont()->getFontFamily()).getTierPixelSizes()});
+                }
+            }
+
+            line++;
+        }
+
+        characterOffset += characters.size();
+    }
+
+    // Characters drawn with the same pipeline and descriptor set keep their order
+    std::stable_sort(this->_drawRecords.begin(), this->_drawRecords.end(),
+                     [](const DrawRecord &a, const DrawRecord &b) {
+                         if (a.pipeline != b.pipeline) {
+                             return std::less<VkPipeline>{}(a.pipeline, b.pipeline);
+                         }
+                         return std::less<VkDescriptorSet>{}(a.descriptorSet, b.descriptorSet);
+                     });
+}
+
+/**
+ * @brief Selects tier of font atlas for every drawn character by the projected size of its em square, the smallest
+ * tier not smaller than the projected size is used. Tier is selected by the vertex offset of draw record
+ *
+ * @return True if tier of any character changed
+ */
+bool VulkanSdfTextRenderer::_selectTiers() {
+    VFONT_PROFILE_ZONE("VulkanSdfTextRenderer::_selectTiers");
+
+    bool changed = false;
+    for (DrawRecord &record : this->_drawRecords) {
+        const TierSelection &selection = this->_tierSelections[record.instance];
+        const std::vector<unsigned int> &tierPixelSizes = *selection.tierPixelSizes;
+        if (tierPixelSizes.size() <= 1) {
+            continue;
+        }
+
+        // Characters crossing the camera plane have infinite size and use the largest tier
+        float size = this->_getProjectedSize(this->_drawInstances[record.instance].model, selection.emSize);
+        unsigned int tier = 0;
+        while (tier + 1 < tierPixelSizes.size() && tierPixelSizes[tier] < size) {
+            tier++;
+        }
+
+        int32_t vertexOffset = tier * BOUNDING_BOX_VERTEX_COUNT;
+        if (record.vertexOffset != vertexOffset) {
+            record.vertexOffset = vertexOffset;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
 }  // namespace vft
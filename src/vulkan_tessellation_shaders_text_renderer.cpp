@@ -10,13 +10,17 @@ namespace vft {
 /**
  * @brief Initialize vulkan text renderer
  */
-VulkanTessellationShadersTextRenderer::VulkanTessellationShadersTextRenderer(VkPhysicalDevice physicalDevice,
-                                                                             VkDevice logicalDevice,
-                                                                             VkQueue graphicsQueue,
-                                                                             VkCommandPool commandPool,
-                                                                             VkRenderPass renderPass,
-                                                                             VkCommandBuffer commandBuffer)
-    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer} {
+VulkanTessellationShadersTextRenderer::VulkanTessellationShadersTextRenderer(
+    VkPhysicalDevice physicalDevice,
+    VkDevice logicalDevice,
+    VkQueue graphicsQueue,
+    VkCommandPool commandPool,
+    VkRenderPass renderPass,
+    VkCommandBuffer commandBuffer,
+    VkPipelineCache pipelineCache,
+    const VkPhysicalDeviceFeatures &enabledFeatures)
+    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer,
+                         pipelineCache, enabledFeatures} {
     this->_initialize();
 
     this->_createLineSegmentsPipeline();
@@ -27,6 +31,9 @@ VulkanTessellationShadersTextRenderer::VulkanTessellationShadersTextRenderer(VkP
  * @brief Deallocate memory and destroy vulkan text renderer
  */
 VulkanTessellationShadersTextRenderer::~VulkanTessellationShadersTextRenderer() {
+    // Wait until the gpu stops using vulkan objects of renderer
+    vkDeviceWaitIdle(this->_logicalDevice);
+
     // Destroy vulkan buffers
     if (this->_lineSegmentsIndexBuffer != nullptr)
         this->_destroyBuffer(this->_lineSegmentsIndexBuffer, this->_lineSegmentsIndexBufferMemory);
@@ -52,71 +59,95 @@ VulkanTessellationShadersTextRenderer::~VulkanTessellationShadersTextRenderer()
  * @brief Add draw commands to the command buffer for drawing all glyphs in tracked text blocks
  */
 void VulkanTessellationShadersTextRenderer::draw() {
+    VFONT_PROFILE_ZONE("VulkanTessellationShadersTextRenderer::draw");
+    VulkanTextRenderer::draw();
+
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
         return;
     }
 
-    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_lineSegmentsPipeline);
-    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_lineSegmentsPipelineLayout, 0,
-                            1, &this->_uboDescriptorSet, 0, nullptr);
+    if (!this->_beginDrawCommands()) {
+        return;
+    }
+
+    vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_lineSegmentsPipeline);
+    vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            this->_lineSegmentsPipelineLayout, 0, 1, &this->_uboDescriptorSet, 1, &this->_uboOffset);
 
     VkBuffer vertexBuffers[] = {this->_vertexBuffer};
     VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(this->_commandBuffer, 0, 1, vertexBuffers, offsets);
+    vkCmdBindVertexBuffers(this->_recordingCommandBuffer, 0, 1, vertexBuffers, offsets);
+
+    // Line segments records precede curve segments records, each range contains records of one pipeline
+    this->_updateDrawRecords();
+    std::vector<DrawRecordRange> visibleRanges = this->_getVisibleDrawRecordRanges();
 
     // Draw line segments
-    vkCmdBindIndexBuffer(this->_commandBuffer, this->_lineSegmentsIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
-        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
-
-            if (this->_offsets.at(key).lineSegmentsCount > 0) {
-                CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor()};
-                vkCmdPushConstants(this->_commandBuffer, this->_lineSegmentsPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT,
-                                   0, sizeof(vft::CharacterPushConstants), &pushConstants);
-
-                vkCmdDrawIndexed(this->_commandBuffer, this->_offsets.at(key).lineSegmentsCount, 1,
-                                 this->_offsets.at(key).lineSegmentsOffset, 0, 0);
+    this->_beginTimingScope("line segments");
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_lineSegmentsIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+    for (const DrawRecordRange &range : visibleRanges) {
+        if (this->_drawRecords[range.first].pipeline != this->_lineSegmentsPipeline) {
+            continue;
+        }
+
+        for (uint32_t i = range.first; i < range.first + range.count; i++) {
+            const DrawRecord &record = this->_drawRecords[i];
+            if (!this->_isCharacterDrawn(record)) {
+                continue;
             }
+
+            vkCmdPushConstants(this->_recordingCommandBuffer, this->_lineSegmentsPipelineLayout,
+                               VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(vft::CharacterPushConstants),
+                               &this->_drawInstances[record.instance]);
+            vkCmdDrawIndexed(this->_recordingCommandBuffer, record.indexCount, 1, record.firstIndex,
+                             record.vertexOffset, 0);
         }
     }
+    this->_endTimingScope();
 
     // Draw curve segments
-    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_curveSegmentsPipeline);
-    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_curveSegmentsPipelineLayout,
-                            0, 1, &this->_uboDescriptorSet, 0, nullptr);
-
-    // vkCmdBindVertexBuffers(this->_commandBuffer, 0, 1, vertexBuffers, offsets);
-    vkCmdBindIndexBuffer(this->_commandBuffer, this->_curveSegmentsIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
-        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
-            const Glyph &glyph = this->_cache->getGlyph(key);
-
-            if (this->_offsets.at(key).curveSegmentsCount > 0) {
-                CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor()};
-                vkCmdPushConstants(this->_commandBuffer, this->_curveSegmentsPipelineLayout,
-                                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                                   sizeof(vft::CharacterPushConstants), &pushConstants);
-
-                ViewportPushConstants viewportPushConstants{this->_viewportWidth, this->_viewportHeight};
-                vkCmdPushConstants(this->_commandBuffer, this->_curveSegmentsPipelineLayout,
-                                   VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, sizeof(vft::CharacterPushConstants),
-                                   sizeof(ViewportPushConstants), &viewportPushConstants);
-
-                vkCmdDrawIndexed(this->_commandBuffer, this->_offsets.at(key).curveSegmentsCount, 1,
-                                 this->_offsets.at(key).curveSegmentsOffset, 0, 0);
+    this->_beginTimingScope("curve segments");
+    vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_curveSegmentsPipeline);
+    vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            this->_curveSegmentsPipelineLayout, 0, 1, &this->_uboDescriptorSet, 1, &this->_uboOffset);
+
+    ViewportPushConstants viewportPushConstants{this->_viewportWidth, this->_viewportHeight};
+    vkCmdPushConstants(this->_recordingCommandBuffer, this->_curveSegmentsPipelineLayout,
+                       VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, sizeof(vft::CharacterPushConstants),
+                       sizeof(ViewportPushConstants), &viewportPushConstants);
+
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_curveSegmentsIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+    for (const DrawRecordRange &range : visibleRanges) {
+        if (this->_drawRecords[range.first].pipeline != this->_curveSegmentsPipeline) {
+            continue;
+        }
+
+        for (uint32_t i = range.first; i < range.first + range.count; i++) {
+            const DrawRecord &record = this->_drawRecords[i];
+            if (!this->_isCharacterDrawn(record)) {
+                continue;
             }
+
+            vkCmdPushConstants(this->_recordingCommandBuffer, this->_curveSegmentsPipelineLayout,
+                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
+                               sizeof(vft::CharacterPushConstants), &this->_drawInstances[record.instance]);
+            vkCmdDrawIndexed(this->_recordingCommandBuffer, record.indexCount, 1, record.firstIndex,
+                             record.vertexOffset, 0);
         }
     }
+    this->_endTimingScope();
+
+    this->_endDrawCommands();
 }
 
 /**
  * @brief Creates a new vertex and index buffer after a change in tracked text blocks
  */
 void VulkanTessellationShadersTextRenderer::update() {
+    VFONT_PROFILE_ZONE("VulkanTessellationShadersTextRenderer::update");
     TessellationShadersTextRenderer::update();
+    this->_invalidateDrawRecords();
 
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
@@ -156,8 +187,8 @@ void VulkanTessellationShadersTextRenderer::update() {
  * @brief Create vulkan pipeline for displaying glyph's inner triangles
  */
 void VulkanTessellationShadersTextRenderer::_createLineSegmentsPipeline() {
-    std::vector<char> vertexShaderCode = this->_readFile("shaders/triangle-vert.spv");
-    std::vector<char> fragmentShaderCode = this->_readFile("shaders/triangle-frag.spv");
+    std::vector<char> vertexShaderCode = this->_readShader("shaders/triangle-vert.spv");
+    std::vector<char> fragmentShaderCode = this->_readShader("shaders/triangle-frag.spv");
 
     VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
     VkShaderModule fragmentShaderModule = this->_createShaderModule(fragmentShaderCode);
@@ -185,13 +216,13 @@ void VulkanTessellationShadersTextRenderer::_createLineSegmentsPipeline() {
 
     VkVertexInputBindingDescription vertexInputBindingDescription{};
     vertexInputBindingDescription.binding = 0;
-    vertexInputBindingDescription.stride = sizeof(glm::vec2);
+    vertexInputBindingDescription.stride = sizeof(glm::i16vec2);
     vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
     VkVertexInputAttributeDescription vertexInputAttributeDescription{};
     vertexInputAttributeDescription.binding = 0;
     vertexInputAttributeDescription.location = 0;
-    vertexInputAttributeDescription.format = VK_FORMAT_R32G32_SFLOAT;
+    vertexInputAttributeDescription.format = VK_FORMAT_R16G16_SINT;
     vertexInputAttributeDescription.offset = 0;
 
     VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
@@ -278,8 +309,8 @@ void VulkanTessellationShadersTextRenderer::_createLineSegmentsPipeline() {
     graphicsPipelineCreateInfo.renderPass = this->_renderPass;
     graphicsPipelineCreateInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
-                                  &this->_lineSegmentsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, this->_pipelineCache, 1, &graphicsPipelineCreateInfo,
+                                  nullptr, &this->_lineSegmentsPipeline) != VK_SUCCESS) {
         throw std::runtime_error(
             "VulkanTessellationShadersTextRenderer::_createLineSegmentsPipeline(): Error creating vulkan graphics "
             "pipeline");
@@ -293,10 +324,10 @@ void VulkanTessellationShadersTextRenderer::_createLineSegmentsPipeline() {
  * @brief Create vulkan pipeline for displaying glyph's curve segments
  */
 void VulkanTessellationShadersTextRenderer::_createCurveSegmentsPipeline() {
-    std::vector<char> vertexShaderCode = this->_readFile("shaders/curve-vert.spv");
-    std::vector<char> tcsCode = this->_readFile("shaders/curve-tesc.spv");
-    std::vector<char> tesCode = this->_readFile("shaders/curve-tese.spv");
-    std::vector<char> fragmentShaderCode = this->_readFile("shaders/curve-frag.spv");
+    std::vector<char> vertexShaderCode = this->_readShader("shaders/curve-vert.spv");
+    std::vector<char> tcsCode = this->_readShader("shaders/curve-tesc.spv");
+    std::vector<char> tesCode = this->_readShader("shaders/curve-tese.spv");
+    std::vector<char> fragmentShaderCode = this->_readShader("shaders/curve-frag.spv");
 
     VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
     VkShaderModule tcsShaderModule = this->_createShaderModule(tcsCode);
@@ -358,13 +389,13 @@ void VulkanTessellationShadersTextRenderer::_createCurveSegmentsPipeline() {
 
     VkVertexInputBindingDescription vertexInputBindingDescription{};
     vertexInputBindingDescription.binding = 0;
-    vertexInputBindingDescription.stride = sizeof(glm::vec2);
+    vertexInputBindingDescription.stride = sizeof(glm::i16vec2);
     vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
     VkVertexInputAttributeDescription vertexInputAttributeDescription{};
     vertexInputAttributeDescription.binding = 0;
     vertexInputAttributeDescription.location = 0;
-    vertexInputAttributeDescription.format = VK_FORMAT_R32G32_SFLOAT;
+    vertexInputAttributeDescription.format = VK_FORMAT_R16G16_SINT;
     vertexInputAttributeDescription.offset = 0;
 
     VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
@@ -461,8 +492,8 @@ void VulkanTessellationShadersTextRenderer::_createCurveSegmentsPipeline() {
     graphicsPipelineCreateInfo.renderPass = this->_renderPass;
     graphicsPipelineCreateInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
-                                  &this->_curveSegmentsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, this->_pipelineCache, 1, &graphicsPipelineCreateInfo,
+                                  nullptr, &this->_curveSegmentsPipeline) != VK_SUCCESS) {
         throw std::runtime_error(
             "VulkanTessellationShadersTextRenderer::_createCurveSegmentsPipeline(): Error creating vulkan graphics "
             "pipeline");
@@ -474,4 +505,56 @@ void VulkanTessellationShadersTextRenderer::_createCurveSegmentsPipeline() {
     vkDestroyShaderModule(this->_logicalDevice, fragmentShaderModule, nullptr);
 }
 
+/**
+ * @brief Compiles draw records and push constants for every character with line or curve segments, so that drawing
+ * does not look up glyph offsets. Draw records of line segments precede draw records of curve segments
+ */
+void VulkanTessellationShadersTextRenderer::_compileDrawRecords() {
+    VFONT_PROFILE_ZONE("VulkanTessellationShadersTextRenderer::_compileDrawRecords");
+    this->_drawInstances.clear();
+
+    std::vector<DrawRecord> curveSegmentsRecords;
+    uint32_t line = 0;
+    uint32_t characterOffset = 0;
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        std::vector<Character> characters = textBlock->getCharacters();
+        for (const LineBoundingBox &lineBoundingBox : textBlock->getLineBoundingBoxes()) {
+            for (unsigned int i = lineBoundingBox.start; i < lineBoundingBox.start + lineBoundingBox.count; i++) {
+                const Character &character = characters[i];
+                GlyphKey key{TessellationStrategy::TESSELLATION_SHADERS, character.getFont()->getFontFamily(),
+                             character.getGlyphId(), 0};
+                const GlyphInfo &glyphInfo = this->_offsets.at(key);
+
+                if (glyphInfo.lineSegmentsCount == 0 && glyphInfo.curveSegmentsCount == 0) {
+                    continue;
+                }
+
+                uint32_t instance = this->_drawInstances.size();
+                this->_drawInstances.push_back(
+                    CharacterPushConstants{character.getModelMatrix(), textBlock->getColor()});
+
+                if (glyphInfo.lineSegmentsCount > 0) {
+                    this->_drawRecords.push_back(DrawRecord{this->_lineSegmentsPipeline, nullptr,
+                                                            glyphInfo.lineSegmentsCount, glyphInfo.lineSegmentsOffset,
+                                                            glyphInfo.vertexOffset, instance, line,
+                                                            characterOffset + i});
+                }
+
+                if (glyphInfo.curveSegmentsCount > 0) {
+                    curveSegmentsRecords.push_back(DrawRecord{this->_curveSegmentsPipeline, nullptr,
+                                                              glyphInfo.curveSegmentsCount,
+                                                              glyphInfo.curveSegmentsOffset, glyphInfo.vertexOffset,
+                                                              instance, line, characterOffset + i});
+                }
+            }
+
+            line++;
+        }
+
+        characterOffset += characters.size();
+    }
+
+    this->_drawRecords.insert(this->_drawRecords.end(), curveSegmentsRecords.begin(), curveSegmentsRecords.end());
+}
+
 }  // namespace vft
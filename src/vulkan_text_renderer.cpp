@@ -8,28 +8,58 @@
 namespace vft {
 
 /**
- * @brief Initialize vulkan text renderer
+ * @brief Initialize vulkan text renderer. Optional device features, such as bc4 font atlases, dynamic indexing of font
+ * atlases or gpu culling, are used only if they are set in enabledFeatures, which should list features enabled on the
+ * logical device
  */
 VulkanTextRenderer::VulkanTextRenderer(VkPhysicalDevice physicalDevice,
                                        VkDevice logicalDevice,
                                        VkQueue graphicsQueue,
                                        VkCommandPool commandPool,
                                        VkRenderPass renderPass,
-                                       VkCommandBuffer commandBuffer)
+                                       VkCommandBuffer commandBuffer,
+                                       VkPipelineCache pipelineCache,
+                                       const VkPhysicalDeviceFeatures &enabledFeatures)
     : _physicalDevice{physicalDevice},
       _logicalDevice{logicalDevice},
       _graphicsQueue{graphicsQueue},
       _renderPass{renderPass},
       _commandPool{commandPool},
-      _commandBuffer{commandBuffer} {}
+      _commandBuffer{commandBuffer},
+      _pipelineCache{pipelineCache},
+      _enabledFeatures{enabledFeatures},
+      _recordingCommandBuffer{commandBuffer} {
+    this->_memoryAllocator = std::make_unique<VulkanMemoryAllocator>(this->_physicalDevice, this->_logicalDevice);
+    this->_uploadManager = std::make_unique<VulkanUploadManager>(this->_logicalDevice, this->_graphicsQueue,
+                                                                 this->_commandPool, this->_memoryAllocator.get());
+}
 
 /**
  * @brief Deallocate memory and destroy vulkan text renderer
  */
 VulkanTextRenderer::~VulkanTextRenderer() {
+    for (VkCommandBuffer &secondaryCommandBuffer : this->_secondaryCommandBuffers) {
+        if (secondaryCommandBuffer != nullptr)
+            vkFreeCommandBuffers(this->_logicalDevice, this->_commandPool, 1, &secondaryCommandBuffer);
+    }
+
     if (this->_uboBuffer != nullptr)
         this->_destroyBuffer(this->_uboBuffer, this->_uboMemory);
 
+    this->_destroyCullingBuffers();
+
+    // Destroy culling pipelines
+    if (this->_culledPipeline != nullptr)
+        vkDestroyPipeline(this->_logicalDevice, this->_culledPipeline, nullptr);
+    if (this->_culledPipelineLayout != nullptr)
+        vkDestroyPipelineLayout(this->_logicalDevice, this->_culledPipelineLayout, nullptr);
+    if (this->_cullingPipeline != nullptr)
+        vkDestroyPipeline(this->_logicalDevice, this->_cullingPipeline, nullptr);
+    if (this->_cullingPipelineLayout != nullptr)
+        vkDestroyPipelineLayout(this->_logicalDevice, this->_cullingPipelineLayout, nullptr);
+    if (this->_cullingDescriptorSetLayout != nullptr)
+        vkDestroyDescriptorSetLayout(this->_logicalDevice, this->_cullingDescriptorSetLayout, nullptr);
+
     if (this->_descriptorPool != nullptr)
         vkDestroyDescriptorPool(this->_logicalDevice, this->_descriptorPool, nullptr);
     if (this->_uboDescriptorSetLayout != nullptr)
@@ -37,25 +67,181 @@ VulkanTextRenderer::~VulkanTextRenderer() {
 }
 
 /**
- * @brief Set vulkan uniform buffer to the uniform buffer object
- * @param ubo
+ * @brief Starts a new frame and records commands which must be executed outside of a render pass before draw(), such
+ * as gpu culling. Call it once per frame before the render pass begins, it is optional for renderers which do not
+ * record such commands
  */
-void VulkanTextRenderer::setUniformBuffers(UniformBufferObject ubo) {
-    this->_ubo = ubo;
-    memcpy(this->_mappedUbo, &this->_ubo, sizeof(this->_ubo));
+void VulkanTextRenderer::prepare() {
+    this->_beginFrame();
+    this->_isFramePrepared = true;
+
+    this->_recordCulling();
 }
 
 /**
- * @brief Setter for vulkan command buffer
+ * @brief Starts a new frame unless prepare() already started it. Derived renderers call this before recording their
+ * draw commands
+ */
+void VulkanTextRenderer::draw() {
+    if (!this->_isFramePrepared) {
+        this->_beginFrame();
+    }
+
+    this->_isFramePrepared = false;
+}
+
+/**
+ * @brief Takes semaphores signaled by uploads on the transfer queue, the graphics submit of current frame must wait for
+ * them. Call it after draw()
+ *
+ * @return Semaphores to wait for, empty if no transfer queue is used
+ */
+std::vector<VkSemaphore> VulkanTextRenderer::takeTransferSemaphores() {
+    return this->_uploadManager->takeTransferSemaphores();
+}
+
+/**
+ * @brief Setter for vulkan command buffer of next frame. Index of frame selects the uniform buffer object, secondary
+ * command buffer and descriptor sets used by the frame, so they are reused only after the application waited for the
+ * frame which used them
  *
  * @param commandBuffer Vulkan command buffer
+ * @param frameIndex Index of frame in flight the command buffer belongs to, must be less than frames in flight
  */
-void VulkanTextRenderer::setCommandBuffer(VkCommandBuffer commandBuffer) {
+void VulkanTextRenderer::setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
     if (commandBuffer == nullptr) {
         throw std::invalid_argument("VulkanTextRenderer::setCommandBuffer(): Command buffer must not be null");
     }
 
+    if (frameIndex >= this->_framesInFlight) {
+        throw std::out_of_range(
+            "VulkanTextRenderer::setCommandBuffer(): Frame index must be less than frames in flight");
+    }
+
     this->_commandBuffer = commandBuffer;
+    this->_recordingCommandBuffer = commandBuffer;
+    this->_frameSlot = frameIndex;
+}
+
+/**
+ * @brief Upload buffers using a dedicated transfer queue, buffers created afterwards are shared by transfer and
+ * graphics queue families
+ *
+ * @param transferQueue Vulkan queue supporting transfer operations
+ * @param transferCommandPool Vulkan command pool of transfer queue family
+ * @param transferQueueFamilyIndex Index of transfer queue family
+ * @param graphicsQueueFamilyIndex Index of graphics queue family
+ */
+void VulkanTextRenderer::setTransferQueue(VkQueue transferQueue,
+                                          VkCommandPool transferCommandPool,
+                                          uint32_t transferQueueFamilyIndex,
+                                          uint32_t graphicsQueueFamilyIndex) {
+    this->_uploadManager->setTransferQueue(transferQueue, transferCommandPool, transferQueueFamilyIndex,
+                                           graphicsQueueFamilyIndex);
+}
+
+/**
+ * @brief Sets the number of frames the application records while the gpu renders previous frames. Every frame in flight
+ * gets its own uniform buffer object, which requires waiting for the gpu to become idle
+ *
+ * @param framesInFlight Number of frames in flight
+ */
+void VulkanTextRenderer::setFramesInFlight(uint32_t framesInFlight) {
+    if (framesInFlight == 0 || framesInFlight > MAX_FRAMES_IN_FLIGHT) {
+        throw std::invalid_argument(
+            "VulkanTextRenderer::setFramesInFlight(): Frames in flight must be between 1 and MAX_FRAMES_IN_FLIGHT");
+    }
+
+    if (framesInFlight == this->_framesInFlight) {
+        return;
+    }
+
+    // Descriptor set must not be updated while it is used by pending command buffers
+    vkDeviceWaitIdle(this->_logicalDevice);
+
+    this->_framesInFlight = framesInFlight;
+    this->_frameSlot = 0;
+    this->_uploadManager->setFramesInFlight(framesInFlight);
+    this->_invalidateSecondaryCommandBuffers();
+
+    if (this->_uboBuffer != nullptr) {
+        this->_destroyBuffer(this->_uboBuffer, this->_uboMemory);
+        this->_createUbo();
+        this->_updateUboDescriptorSet();
+    }
+}
+
+/**
+ * @brief Set timer measuring named scopes of recorded commands
+ *
+ * @param gpuTimer Gpu timer or nullptr to stop measuring, the timer must outlive the renderer
+ */
+void VulkanTextRenderer::setGpuTimer(VulkanGpuTimer *gpuTimer) {
+    this->_gpuTimer = gpuTimer;
+}
+
+/**
+ * @brief Set whether draw commands are recorded into secondary command buffers, which are executed again by following
+ * frames until text blocks, buffers or view change. The render pass must then be started with contents returned by
+ * getSubpassContents() and viewport and scissor are set by the renderer
+ *
+ * @param secondaryCommandBuffers True if secondary command buffers are used
+ */
+void VulkanTextRenderer::setSecondaryCommandBuffers(bool secondaryCommandBuffers) {
+    this->_useSecondaryCommandBuffers = secondaryCommandBuffers;
+    this->_invalidateSecondaryCommandBuffers();
+}
+
+/**
+ * @brief Set which characters are drawn, so that characters can be split between renderers. Characters culled on the
+ * gpu ignore the mask
+ *
+ * @param characterMask Flag of every character of all text blocks in order in which they were added, empty to draw all
+ * characters
+ */
+void VulkanTextRenderer::setCharacterMask(std::vector<bool> characterMask) {
+    this->_characterMask = std::move(characterMask);
+}
+
+/**
+ * @brief Enables or disables culling of characters outside of the view frustum on the gpu. Visible characters are
+ * drawn by one indirect draw per glyph, but only if prepare() is called before the render pass. The logical device
+ * must be created with the drawIndirectFirstInstance feature enabled. Supported by the triangulation and winding number
+ * renderers. The sdf renderer selects the atlas tier of every character on the cpu each frame, which changes the
+ * vertex offset of its draw, and the tessellation shaders renderer draws every character with two pipelines, so
+ * neither of them can replay one indirect draw per glyph
+ *
+ * @param gpuCulling True if characters should be culled on the gpu
+ */
+void VulkanTextRenderer::setGpuCulling(bool gpuCulling) {
+    if (gpuCulling == this->_gpuCulling) {
+        return;
+    }
+
+    if (gpuCulling) {
+        if (!this->_supportsGpuCulling()) {
+            throw std::runtime_error("VulkanTextRenderer::setGpuCulling(): Renderer does not support gpu culling");
+        }
+
+        if (!this->_enabledFeatures.drawIndirectFirstInstance) {
+            throw std::runtime_error(
+                "VulkanTextRenderer::setGpuCulling(): Logical device does not enable drawIndirectFirstInstance");
+        }
+
+        if (this->_cullingPipeline == nullptr) {
+            this->_initializeCulling();
+        }
+    }
+
+    this->_gpuCulling = gpuCulling;
+    this->_isCullingRecorded = false;
+    this->_invalidateSecondaryCommandBuffers();
+
+    if (this->_gpuCulling) {
+        this->_createCullingBuffers();
+    } else {
+        this->_destroyCullingBuffers();
+    }
 }
 
 /**
@@ -112,6 +298,35 @@ VkCommandBuffer VulkanTextRenderer::getCommandBuffer() {
     return this->_commandBuffer;
 }
 
+/**
+ * @brief Getter for number of frames in flight
+ *
+ * @return Number of frames in flight
+ */
+uint32_t VulkanTextRenderer::getFramesInFlight() {
+    return this->_framesInFlight;
+}
+
+/**
+ * @brief Get contents of subpass in which draw() is called
+ *
+ * @return Secondary command buffers contents if draw commands are recorded into secondary command buffers, otherwise
+ * inline contents
+ */
+VkSubpassContents VulkanTextRenderer::getSubpassContents() {
+    return this->_useSecondaryCommandBuffers ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                             : VK_SUBPASS_CONTENTS_INLINE;
+}
+
+/**
+ * @brief Getter for statistics of memory allocator used for vulkan buffers
+ *
+ * @return Memory allocator statistics
+ */
+VulkanMemoryStatistics VulkanTextRenderer::getMemoryStatistics() {
+    return this->_memoryAllocator->getStatistics();
+}
+
 /**
  * @brief Create descriptor pool and create the ubo descriptors
  */
@@ -124,25 +339,612 @@ void VulkanTextRenderer::_initialize() {
 }
 
 /**
- * @brief Create a vulkan buffer
+ * @brief Submits pending buffer uploads, destroys buffers no longer used by the gpu and writes the uniform buffer
+ * object into the slot of next frame
+ */
+void VulkanTextRenderer::_beginFrame() {
+    auto uploadStart = std::chrono::steady_clock::now();
+    this->_uploadManager->beginFrame();
+
+    // Uploads are submitted in their own command buffer, possibly to a transfer queue, so only cpu time is measured
+    if (this->_gpuTimer != nullptr) {
+        std::chrono::duration<double, std::micro> uploadTime = std::chrono::steady_clock::now() - uploadStart;
+        this->_gpuTimer->addSample("upload (cpu)", uploadTime.count());
+    }
+
+    // Slot of current frame was last read by the frame with the same index, which the application already waited for
+    this->_uboOffset = static_cast<uint32_t>(this->_frameSlot * this->_uboStride);
+    memcpy(static_cast<char *>(this->_mappedUbo) + this->_uboOffset, &this->_ubo, sizeof(this->_ubo));
+}
+
+/**
+ * @brief Start named timing scope if gpu timer is set. Secondary command buffers are executed by multiple frames with
+ * different queries, so scopes are not recorded into them
+ *
+ * @param name Name of scope
+ */
+void VulkanTextRenderer::_beginTimingScope(const std::string &name) {
+    if (this->_gpuTimer != nullptr && this->_recordingCommandBuffer == this->_commandBuffer)
+        this->_gpuTimer->beginScope(name);
+}
+
+/**
+ * @brief End most recently started timing scope if gpu timer is set
+ */
+void VulkanTextRenderer::_endTimingScope() {
+    if (this->_gpuTimer != nullptr && this->_recordingCommandBuffer == this->_commandBuffer)
+        this->_gpuTimer->endScope();
+}
+
+/**
+ * @brief Selects command buffer for draw commands. Without secondary command buffers, draw commands are recorded into
+ * the command buffer of frame. Otherwise the secondary command buffer of current frame is executed again if it was
+ * recorded with the same state, or it is recorded anew
+ *
+ * @return True if draw commands must be recorded into the recording command buffer, false if recorded commands were
+ * reused
+ */
+bool VulkanTextRenderer::_beginDrawCommands() {
+    if (!this->_useSecondaryCommandBuffers) {
+        this->_recordingCommandBuffer = this->_commandBuffer;
+        return true;
+    }
+
+    DrawState drawState = this->_getDrawState();
+    VkCommandBuffer &secondaryCommandBuffer = this->_secondaryCommandBuffers.at(this->_frameSlot);
+
+    if (secondaryCommandBuffer != nullptr && !this->_secondaryCommandBuffersOutdated.at(this->_frameSlot) &&
+        this->_recordedDrawStates.at(this->_frameSlot) == drawState) {
+        vkCmdExecuteCommands(this->_commandBuffer, 1, &secondaryCommandBuffer);
+        return false;
+    }
+
+    // Frame which executed the command buffer before has finished, command pool may not allow resetting it
+    if (secondaryCommandBuffer != nullptr) {
+        vkFreeCommandBuffers(this->_logicalDevice, this->_commandPool, 1, &secondaryCommandBuffer);
+        secondaryCommandBuffer = nullptr;
+    }
+
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    commandBufferAllocateInfo.commandPool = this->_commandPool;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(this->_logicalDevice, &commandBufferAllocateInfo, &secondaryCommandBuffer) !=
+        VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTextRenderer::_beginDrawCommands(): Error allocating vulkan secondary command buffer");
+    }
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = this->_renderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = nullptr;
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    if (vkBeginCommandBuffer(secondaryCommandBuffer, &commandBufferBeginInfo) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTextRenderer::_beginDrawCommands(): Error beginning vulkan secondary command buffer");
+    }
+
+    // Dynamic state is not inherited from the primary command buffer
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(this->_viewportWidth);
+    viewport.height = static_cast<float>(this->_viewportHeight);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = {this->_viewportWidth, this->_viewportHeight};
+
+    vkCmdSetViewport(secondaryCommandBuffer, 0, 1, &viewport);
+    vkCmdSetScissor(secondaryCommandBuffer, 0, 1, &scissor);
+
+    this->_recordedDrawStates.at(this->_frameSlot) = std::move(drawState);
+    this->_secondaryCommandBuffersOutdated.at(this->_frameSlot) = false;
+    this->_recordingCommandBuffer = secondaryCommandBuffer;
+
+    return true;
+}
+
+/**
+ * @brief Finishes recording of draw commands, a recorded secondary command buffer is executed by the command buffer of
+ * frame
+ */
+void VulkanTextRenderer::_endDrawCommands() {
+    if (this->_recordingCommandBuffer == this->_commandBuffer) {
+        return;
+    }
+
+    if (vkEndCommandBuffer(this->_recordingCommandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTextRenderer::_endDrawCommands(): Error recording vulkan secondary command buffer");
+    }
+
+    vkCmdExecuteCommands(this->_commandBuffer, 1, &this->_recordingCommandBuffer);
+    this->_recordingCommandBuffer = this->_commandBuffer;
+}
+
+/**
+ * @brief Marks secondary command buffers of all frames as outdated after buffers, descriptor sets or pipelines used by
+ * their commands were replaced
+ */
+void VulkanTextRenderer::_invalidateSecondaryCommandBuffers() {
+    this->_secondaryCommandBuffersOutdated.fill(true);
+}
+
+/**
+ * @brief Get state of tracked text blocks and view which draw commands depend on. The view matters only if characters
+ * are culled on the cpu
+ *
+ * @return Current draw state
+ */
+VulkanTextRenderer::DrawState VulkanTextRenderer::_getDrawState() {
+    DrawState drawState{};
+    drawState.textBlockVersions.reserve(this->_textBlocks.size());
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        drawState.textBlockVersions.push_back(textBlock->getVersion());
+    }
+
+    if (this->_cpuCulling) {
+        drawState.viewProjection = this->_ubo.projection * this->_ubo.view;
+    }
+
+    drawState.viewportWidth = this->_viewportWidth;
+    drawState.viewportHeight = this->_viewportHeight;
+    drawState.cpuCulling = this->_cpuCulling;
+    drawState.characterMask = this->_characterMask;
+
+    return drawState;
+}
+
+/**
+ * @brief Compiles draw records again if glyph offsets, descriptor sets or any tracked text block changed since they
+ * were compiled
+ */
+void VulkanTextRenderer::_updateDrawRecords() {
+    std::vector<uint64_t> versions;
+    versions.reserve(this->_textBlocks.size());
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        versions.push_back(textBlock->getVersion());
+    }
+
+    if (!this->_drawRecordsOutdated && versions == this->_drawRecordVersions) {
+        return;
+    }
+
+    this->_drawRecords.clear();
+    this->_compileDrawRecords();
+    this->_createLineDrawRecordRanges();
+
+    this->_drawRecordVersions = versions;
+    this->_drawRecordsOutdated = false;
+}
+
+/**
+ * @brief Finds the range of draw records of every line, so that drawing skips lines outside of the view without
+ * testing their draw records. Records are split into runs with the same pipeline and descriptor set and records of
+ * every run must be sorted by line
+ */
+void VulkanTextRenderer::_createLineDrawRecordRanges() {
+    this->_lineDrawRecordRanges.clear();
+
+    uint32_t lineCount = 0;
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        lineCount += textBlock->getLineBoundingBoxes().size();
+    }
+
+    for (uint32_t i = 0; i < this->_drawRecords.size(); i++) {
+        const DrawRecord &record = this->_drawRecords[i];
+        if (i == 0 || record.pipeline != this->_drawRecords[i - 1].pipeline ||
+            record.descriptorSet != this->_drawRecords[i - 1].descriptorSet) {
+            this->_lineDrawRecordRanges.emplace_back(lineCount);
+        }
+
+        DrawRecordRange &range = this->_lineDrawRecordRanges.back().at(record.line);
+        if (range.count == 0) {
+            range.first = i;
+        }
+        range.count++;
+    }
+}
+
+/**
+ * @brief Get ranges of draw records on visible lines. Ranges of consecutive lines are merged, but a range never
+ * contains records of two runs with different pipelines or descriptor sets
+ *
+ * @return Ranges of draw records in ascending order
+ */
+std::vector<VulkanTextRenderer::DrawRecordRange> VulkanTextRenderer::_getVisibleDrawRecordRanges() {
+    std::vector<bool> visibleLines = this->_getVisibleLines();
+    std::vector<DrawRecordRange> visibleRanges;
+
+    for (const std::vector<DrawRecordRange> &lineRanges : this->_lineDrawRecordRanges) {
+        size_t runStart = visibleRanges.size();
+        for (uint32_t line = 0; line < lineRanges.size(); line++) {
+            const DrawRecordRange &range = lineRanges[line];
+            if (range.count == 0 || !visibleLines[line]) {
+                continue;
+            }
+
+            if (visibleRanges.size() > runStart &&
+                visibleRanges.back().first + visibleRanges.back().count == range.first) {
+                visibleRanges.back().count += range.count;
+            } else {
+                visibleRanges.push_back(range);
+            }
+        }
+    }
+
+    return visibleRanges;
+}
+
+/**
+ * @brief Marks draw records and secondary command buffers as outdated after glyph offsets or descriptor sets used by
+ * them were replaced
+ */
+void VulkanTextRenderer::_invalidateDrawRecords() {
+    this->_drawRecordsOutdated = true;
+    this->_invalidateSecondaryCommandBuffers();
+}
+
+/**
+ * @brief Checks if character of draw record is drawn by this renderer
+ *
+ * @param record Draw record
+ *
+ * @return True if character mask is empty or contains the character
+ */
+bool VulkanTextRenderer::_isCharacterDrawn(const DrawRecord &record) const {
+    return this->_characterMask.empty() ||
+           (record.character < this->_characterMask.size() && this->_characterMask[record.character]);
+}
+
+/**
+ * @brief Projects sides of a square in the xy plane of model space with a corner in the origin to the viewport
+ *
+ * @param model Model matrix
+ * @param size Length of sides of square in model space
+ *
+ * @return Length in pixels of the longer projected side, infinity if the square crosses the camera plane
+ */
+float VulkanTextRenderer::_getProjectedSize(const glm::mat4 &model, float size) const {
+    glm::mat4 modelViewProjection = this->_ubo.projection * this->_ubo.view * model;
+    glm::vec4 origin = modelViewProjection * glm::vec4{0.f, 0.f, 0.f, 1.f};
+    glm::vec4 right = modelViewProjection * glm::vec4{size, 0.f, 0.f, 1.f};
+    glm::vec4 top = modelViewProjection * glm::vec4{0.f, size, 0.f, 1.f};
+
+    if (origin.w <= 0 || right.w <= 0 || top.w <= 0) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    glm::vec2 halfViewport{this->_viewportWidth / 2.f, this->_viewportHeight / 2.f};
+    glm::vec2 center = glm::vec2{origin} / origin.w;
+    float width = glm::length((glm::vec2{right} / right.w - center) * halfViewport);
+    float height = glm::length((glm::vec2{top} / top.w - center) * halfViewport);
+
+    return std::max(width, height);
+}
+
+/**
+ * @brief Creates descriptor sets and pipelines used by gpu culling. The descriptor pool of derived renderer must
+ * reserve three storage buffers for each frame in flight
+ */
+void VulkanTextRenderer::_initializeCulling() {
+    // Buffers with all characters, visible characters and draw commands
+    std::array<VkDescriptorSetLayoutBinding, 3> layoutBindings{};
+    for (uint32_t i = 0; i < layoutBindings.size(); i++) {
+        layoutBindings[i].binding = i;
+        layoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        layoutBindings[i].descriptorCount = 1;
+        layoutBindings[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+    layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutCreateInfo.bindingCount = layoutBindings.size();
+    layoutCreateInfo.pBindings = layoutBindings.data();
+
+    if (vkCreateDescriptorSetLayout(this->_logicalDevice, &layoutCreateInfo, nullptr,
+                                    &this->_cullingDescriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTextRenderer::_initializeCulling(): Error creating vulkan descriptor set layout");
+    }
+
+    std::array<VkDescriptorSetLayout, MAX_FRAMES_IN_FLIGHT> layouts;
+    layouts.fill(this->_cullingDescriptorSetLayout);
+
+    VkDescriptorSetAllocateInfo allocateInfo{};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocateInfo.descriptorPool = this->_descriptorPool;
+    allocateInfo.descriptorSetCount = layouts.size();
+    allocateInfo.pSetLayouts = layouts.data();
+
+    if (vkAllocateDescriptorSets(this->_logicalDevice, &allocateInfo, this->_cullingDescriptorSets.data()) !=
+        VK_SUCCESS) {
+        throw std::runtime_error("VulkanTextRenderer::_initializeCulling(): Error allocating vulkan descriptor sets");
+    }
+
+    // Compute pipeline culling characters
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.size = sizeof(CullingPushConstants);
+    pushConstantRange.offset = 0;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkPipelineLayoutCreateInfo cullingPipelineLayoutCreateInfo{};
+    cullingPipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    cullingPipelineLayoutCreateInfo.setLayoutCount = 1;
+    cullingPipelineLayoutCreateInfo.pSetLayouts = &this->_cullingDescriptorSetLayout;
+    cullingPipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+    cullingPipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+
+    if (vkCreatePipelineLayout(this->_logicalDevice, &cullingPipelineLayoutCreateInfo, nullptr,
+                               &this->_cullingPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanTextRenderer::_initializeCulling(): Error creating vulkan pipeline layout");
+    }
+
+    std::vector<char> computeShaderCode = this->_readShader("shaders/cull-comp.spv");
+    VkShaderModule computeShaderModule = this->_createShaderModule(computeShaderCode);
+
+    VkComputePipelineCreateInfo computePipelineCreateInfo{};
+    computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    computePipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    computePipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    computePipelineCreateInfo.stage.module = computeShaderModule;
+    computePipelineCreateInfo.stage.pName = "main";
+    computePipelineCreateInfo.layout = this->_cullingPipelineLayout;
+
+    VkResult result = vkCreateComputePipelines(this->_logicalDevice, this->_pipelineCache, 1,
+                                               &computePipelineCreateInfo, nullptr, &this->_cullingPipeline);
+    vkDestroyShaderModule(this->_logicalDevice, computeShaderModule, nullptr);
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("VulkanTextRenderer::_initializeCulling(): Error creating vulkan compute pipeline");
+    }
+
+    // Graphics pipeline reading characters from the culling descriptor set
+    this->_createCulledPipeline();
+}
+
+/**
+ * @brief Checks if the renderer can draw characters culled on the gpu
+ *
+ * @return True if derived renderer creates a culled pipeline and provides culling instances
+ */
+bool VulkanTextRenderer::_supportsGpuCulling() const {
+    return false;
+}
+
+/**
+ * @brief Creates the graphics pipeline and its layout which draws characters whose indices were written into the
+ * visible characters buffer by the culling compute shader
+ */
+void VulkanTextRenderer::_createCulledPipeline() {}
+
+/**
+ * @brief Collects all characters tested by the culling compute shader and one indirect draw command for each glyph
+ *
+ * @param instances Characters of all tracked text blocks
+ * @param drawCommands Draw commands with the number of characters of glyph as instance count
+ */
+void VulkanTextRenderer::_collectCullingInstances(std::vector<CullingInstance> &instances,
+                                                  std::vector<VkDrawIndexedIndirectCommand> &drawCommands) {}
+
+/**
+ * @brief Creates buffers with all characters and one indirect draw command for each glyph. Every draw command
+ * reserves a range of the visible characters buffer large enough for all characters with its glyph
+ */
+void VulkanTextRenderer::_createCullingBuffers() {
+    this->_destroyCullingBuffers();
+
+    std::vector<CullingInstance> instances;
+    std::vector<VkDrawIndexedIndirectCommand> drawCommands;
+    this->_collectCullingInstances(instances, drawCommands);
+
+    if (instances.empty()) {
+        return;
+    }
+
+    // Instance counts are incremented by the culling compute shader
+    uint32_t firstInstance = 0;
+    for (VkDrawIndexedIndirectCommand &drawCommand : drawCommands) {
+        drawCommand.firstInstance = firstInstance;
+        firstInstance += drawCommand.instanceCount;
+        drawCommand.instanceCount = 0;
+    }
+
+    this->_cullingInstanceCount = instances.size();
+    this->_drawCommandCount = drawCommands.size();
+
+    VkDeviceSize instanceBufferSize = sizeof(CullingInstance) * instances.size();
+    this->_stageAndCreateVulkanBuffer(instances.data(), instanceBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                      this->_instanceBuffer, this->_instanceBufferMemory);
+
+    VkDeviceSize drawCommandBufferSize = sizeof(VkDrawIndexedIndirectCommand) * drawCommands.size();
+    this->_stageAndCreateVulkanBuffer(drawCommands.data(), drawCommandBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                      this->_drawCommandTemplateBuffer, this->_drawCommandTemplateBufferMemory);
+    this->_createBuffer(drawCommandBufferSize,
+                        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, this->_drawCommandBuffer, this->_drawCommandBufferMemory);
+
+    VkDeviceSize visibleInstanceBufferSize = sizeof(uint32_t) * instances.size();
+    this->_createBuffer(visibleInstanceBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, this->_visibleInstanceBuffer,
+                        this->_visibleInstanceBufferMemory);
+
+    this->_cullingDescriptorSetsOutdated.fill(true);
+}
+
+/**
+ * @brief Destroys buffers used by gpu culling
+ */
+void VulkanTextRenderer::_destroyCullingBuffers() {
+    this->_destroyBuffer(this->_instanceBuffer, this->_instanceBufferMemory);
+    this->_destroyBuffer(this->_visibleInstanceBuffer, this->_visibleInstanceBufferMemory);
+    this->_destroyBuffer(this->_drawCommandBuffer, this->_drawCommandBufferMemory);
+    this->_destroyBuffer(this->_drawCommandTemplateBuffer, this->_drawCommandTemplateBufferMemory);
+
+    this->_cullingInstanceCount = 0;
+    this->_drawCommandCount = 0;
+}
+
+/**
+ * @brief Points the culling descriptor set of a frame to the current culling buffers
+ *
+ * @param frameSlot Index of frame in flight whose descriptor set is updated
+ */
+void VulkanTextRenderer::_updateCullingDescriptorSet(uint32_t frameSlot) {
+    std::array<VkBuffer, 3> buffers = {this->_instanceBuffer, this->_visibleInstanceBuffer, this->_drawCommandBuffer};
+    std::array<VkDescriptorBufferInfo, 3> bufferInfos{};
+    std::array<VkWriteDescriptorSet, 3> writeDescriptorSets{};
+
+    for (uint32_t i = 0; i < buffers.size(); i++) {
+        bufferInfos[i].buffer = buffers[i];
+        bufferInfos[i].offset = 0;
+        bufferInfos[i].range = VK_WHOLE_SIZE;
+
+        writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeDescriptorSets[i].dstSet = this->_cullingDescriptorSets.at(frameSlot);
+        writeDescriptorSets[i].dstBinding = i;
+        writeDescriptorSets[i].dstArrayElement = 0;
+        writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writeDescriptorSets[i].descriptorCount = 1;
+        writeDescriptorSets[i].pBufferInfo = &bufferInfos[i];
+    }
+
+    vkUpdateDescriptorSets(this->_logicalDevice, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
+
+    this->_cullingDescriptorSetsOutdated.at(frameSlot) = false;
+}
+
+/**
+ * @brief If gpu culling is enabled, records the compute pass which tests bounding boxes of all characters against the
+ * view frustum and fills indirect draw commands with visible characters
+ */
+void VulkanTextRenderer::_recordCulling() {
+    if (!this->_gpuCulling || this->_cullingInstanceCount == 0) {
+        return;
+    }
+
+    // Descriptor set of current frame is not used by the gpu, because the frame using it before has finished
+    if (this->_cullingDescriptorSetsOutdated.at(this->_frameSlot)) {
+        this->_updateCullingDescriptorSet(this->_frameSlot);
+    }
+
+    this->_beginTimingScope("culling");
+
+    // Previous frames may still read draw commands and visible characters
+    vkCmdPipelineBarrier(this->_commandBuffer,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0,
+                         nullptr, 0, nullptr);
+
+    // Reset instance counts of draw commands
+    VkBufferCopy copyRegion{};
+    copyRegion.size = sizeof(VkDrawIndexedIndirectCommand) * this->_drawCommandCount;
+    vkCmdCopyBuffer(this->_commandBuffer, this->_drawCommandTemplateBuffer, this->_drawCommandBuffer, 1, &copyRegion);
+
+    VkMemoryBarrier resetBarrier{};
+    resetBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(this->_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                         1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+    // Cull characters
+    CullingPushConstants pushConstants{this->_ubo.projection * this->_ubo.view, this->_cullingInstanceCount};
+
+    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->_cullingPipeline);
+    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->_cullingPipelineLayout, 0, 1,
+                            &this->_cullingDescriptorSets.at(this->_frameSlot), 0, nullptr);
+    vkCmdPushConstants(this->_commandBuffer, this->_cullingPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                       sizeof(CullingPushConstants), &pushConstants);
+    vkCmdDispatch(this->_commandBuffer,
+                  (this->_cullingInstanceCount + CULLING_WORK_GROUP_SIZE - 1) / CULLING_WORK_GROUP_SIZE, 1, 1);
+
+    // Draw commands and visible characters are read by the following indirect draws
+    VkMemoryBarrier cullingBarrier{};
+    cullingBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    cullingBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    cullingBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(this->_commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1,
+                         &cullingBarrier, 0, nullptr, 0, nullptr);
+
+    this->_endTimingScope();
+
+    this->_isCullingRecorded = true;
+}
+
+/**
+ * @brief Checks if prepare() recorded culling for current frame. Commands drawing culled characters are not reused by
+ * frames which did not cull them and vice versa, so secondary command buffers are invalidated when this changes. Call
+ * it once per draw() before _beginDrawCommands()
+ *
+ * @return True if characters of current frame must be drawn by _drawCulledCommands()
+ */
+bool VulkanTextRenderer::_takeCullingRecorded() {
+    bool isCullingRecorded = this->_isCullingRecorded;
+    this->_isCullingRecorded = false;
+
+    if (isCullingRecorded != this->_isCulledDrawRecorded) {
+        this->_isCulledDrawRecorded = isCullingRecorded;
+        this->_invalidateSecondaryCommandBuffers();
+    }
+
+    return isCullingRecorded;
+}
+
+/**
+ * @brief Add indirect draw commands for characters which passed gpu culling, the culled pipeline with its descriptor
+ * sets and vertex and index buffers must be bound
+ */
+void VulkanTextRenderer::_drawCulledCommands() {
+    // One draw per glyph, so that the multiDrawIndirect feature is not required
+    for (uint32_t i = 0; i < this->_drawCommandCount; i++) {
+        vkCmdDrawIndexedIndirect(this->_recordingCommandBuffer, this->_drawCommandBuffer,
+                                 i * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
+
+/**
+ * @brief Create a vulkan buffer bound to memory sub-allocated by the memory allocator
  *
  * @param size Size of buffer
  * @param usage Vulkan buffer usage flags
  * @param properties Vulkan memory property flags
  * @param buffer Handle to vulkan buffer
- * @param bufferMemory Handle to vulkan buffer memory
+ * @param bufferMemory Memory range of vulkan buffer, host visible memory is mapped
  */
 void VulkanTextRenderer::_createBuffer(VkDeviceSize size,
                                        VkBufferUsageFlags usage,
                                        VkMemoryPropertyFlags properties,
                                        VkBuffer &buffer,
-                                       VkDeviceMemory &bufferMemory) {
+                                       VulkanMemoryAllocation &bufferMemory) {
     VkBufferCreateInfo bufferCreateInfo{};
     bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferCreateInfo.size = size;
     bufferCreateInfo.usage = usage;
     bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+    // Buffers uploaded by a dedicated transfer queue are accessed by multiple queue families
+    const std::vector<uint32_t> &queueFamilyIndices = this->_uploadManager->getQueueFamilyIndices();
+    if (queueFamilyIndices.size() > 1) {
+        bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferCreateInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilyIndices.size());
+        bufferCreateInfo.pQueueFamilyIndices = queueFamilyIndices.data();
+    }
+
     if (vkCreateBuffer(this->_logicalDevice, &bufferCreateInfo, nullptr, &buffer) != VK_SUCCESS) {
         throw std::runtime_error("VulkanTextRenderer::_createBuffer(): Error creating vulkan buffer");
     }
@@ -150,20 +952,19 @@ void VulkanTextRenderer::_createBuffer(VkDeviceSize size,
     VkMemoryRequirements memoryRequirements;
     vkGetBufferMemoryRequirements(this->_logicalDevice, buffer, &memoryRequirements);
 
-    VkMemoryAllocateInfo memoryAllocateInfo{};
-    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    memoryAllocateInfo.allocationSize = memoryRequirements.size;
-    memoryAllocateInfo.memoryTypeIndex = _selectMemoryType(memoryRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(this->_logicalDevice, &memoryAllocateInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+    try {
+        bufferMemory = this->_memoryAllocator->allocate(memoryRequirements, properties);
+    } catch (const std::runtime_error &) {
+        vkDestroyBuffer(this->_logicalDevice, buffer, nullptr);
+        buffer = nullptr;
         throw std::runtime_error("VulkanTextRenderer::_createBuffer(): Error allocating vulkan buffer memory");
     }
 
-    vkBindBufferMemory(this->_logicalDevice, buffer, bufferMemory, 0);
+    vkBindBufferMemory(this->_logicalDevice, buffer, bufferMemory.memory, bufferMemory.offset);
 }
 
 /**
- * @brief Selects a suitable memory type for Vulkan allocation.
+ * @brief Selects a suitable memory type for Vulkan allocation using memory properties cached by the memory allocator.
  *
  * @param memoryType A bitmask specifying the memory type indices that are compatible
  * @param properties The required memory property flags
@@ -171,45 +972,15 @@ void VulkanTextRenderer::_createBuffer(VkDeviceSize size,
  * @return The index of a suitable memory type with specified properties
  */
 uint32_t VulkanTextRenderer::_selectMemoryType(uint32_t memoryType, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memoryProperties;
-    vkGetPhysicalDeviceMemoryProperties(this->_physicalDevice, &memoryProperties);
-
-    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
-        if ((memoryType & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-
-    throw std::runtime_error("VulkanTextRenderer::_selectMemoryType(): Error selecting memory for vulkan buffer");
-}
-
-/**
- * @brief Copies data from one vulkan buffer to another
- *
- * This function records and submits a temporaray command buffer to copy data from the source buffer to the destination
- * buffer
- *
- * @param sourceBuffer Vulkan buffer containing the source data
- * @param destinationBuffer Vulkan buffer to copy data into
- * @param bufferSize The size of the data to copy, in bytes
- */
-void VulkanTextRenderer::_copyBuffer(VkBuffer sourceBuffer, VkBuffer destinationBuffer, VkDeviceSize bufferSize) {
-    VkCommandBuffer commandBuffer = this->_beginOneTimeCommands();
-
-    VkBufferCopy copyRegion{};
-    copyRegion.srcOffset = 0;
-    copyRegion.dstOffset = 0;
-    copyRegion.size = bufferSize;
-    vkCmdCopyBuffer(commandBuffer, sourceBuffer, destinationBuffer, 1, &copyRegion);
-
-    this->_endOneTimeCommands(commandBuffer);
+    return this->_memoryAllocator->selectMemoryType(memoryType, properties);
 }
 
 /**
  * @brief Stages data and creates a vulkan buffer with the given usage
  *
- * This function first creates a temporary staging buffer in host-visible memory, copies the provided data into it, and
- * then transfers the data to the final vulkan buffer with the specified usage flags
+ * This function creates the final vulkan buffer with the specified usage flags and passes the data to the upload
+ * manager, which copies it into a staging buffer and records the transfer. The transfer is submitted before the next
+ * draw without waiting for the gpu
  *
  * @param data Pointer to the data to be copied
  * @param size Size of the data to be copied in bytes
@@ -221,47 +992,21 @@ void VulkanTextRenderer::_stageAndCreateVulkanBuffer(void *data,
                                                      VkDeviceSize size,
                                                      VkBufferUsageFlags destinationUsage,
                                                      VkBuffer &destinationBuffer,
-                                                     VkDeviceMemory &destinationMemory) {
-    // Create staging buffer
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    this->_createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer,
-                        stagingBufferMemory);
-
-    // Copy data from CPU to staging buffer
-    void *buffer;
-    vkMapMemory(this->_logicalDevice, stagingBufferMemory, 0, size, 0, &buffer);
-    memcpy(buffer, data, size);
-    vkUnmapMemory(this->_logicalDevice, stagingBufferMemory);
-
-    // Copy data from staging buffer to newly created vulkan buffer
+                                                     VulkanMemoryAllocation &destinationMemory) {
     this->_createBuffer(size, destinationUsage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                         destinationBuffer, destinationMemory);
-    this->_copyBuffer(stagingBuffer, destinationBuffer, size);
-
-    // Destroy and deallocate memory from the staging buffer
-    vkDestroyBuffer(this->_logicalDevice, stagingBuffer, nullptr);
-    vkFreeMemory(this->_logicalDevice, stagingBufferMemory, nullptr);
+    this->_uploadManager->upload(data, size, destinationBuffer);
 }
 
 /**
- * @brief Destroys a vulkan buffer and frees its associated memory.
+ * @brief Destroys a vulkan buffer and returns its memory to the memory allocator. Destruction is deferred until frames
+ * in flight no longer use the buffer, so the gpu is not stalled.
  *
- * @param buffer The vulkan buffer to be destroyed. It will be set to nullptr after destruction.
- * @param bufferMemory The vulkan device memory associated with the buffer. It will be set to nullptr after being freed.
+ * @param buffer The vulkan buffer to be destroyed. It will be set to nullptr.
+ * @param bufferMemory The memory range associated with the buffer. It will be reset.
  */
-void VulkanTextRenderer::_destroyBuffer(VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
-    if (buffer == nullptr)
-        return;
-
-    vkDeviceWaitIdle(this->_logicalDevice);
-
-    vkDestroyBuffer(this->_logicalDevice, buffer, nullptr);
-    vkFreeMemory(this->_logicalDevice, bufferMemory, nullptr);
-
-    buffer = nullptr;
-    bufferMemory = nullptr;
+void VulkanTextRenderer::_destroyBuffer(VkBuffer &buffer, VulkanMemoryAllocation &bufferMemory) {
+    this->_uploadManager->destroyBuffer(buffer, bufferMemory);
 }
 
 /**
@@ -289,22 +1034,14 @@ VkCommandBuffer VulkanTextRenderer::_beginOneTimeCommands() {
 }
 
 /**
- * @brief End and destroy command buffer used for one time commands
+ * @brief End command buffer used for one time commands and submit it to the graphics queue. The upload manager frees
+ * it once its fence is signaled, so the cpu does not wait for the gpu. Buffers used by the commands must be destroyed
+ * by _destroyBuffer()
  *
- * @param commandBuffer Command buffer to destroy
+ * @param commandBuffer Command buffer to submit
  */
 void VulkanTextRenderer::_endOneTimeCommands(VkCommandBuffer commandBuffer) {
-    vkEndCommandBuffer(commandBuffer);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    vkQueueSubmit(this->_graphicsQueue, 1, &submitInfo, nullptr);
-    vkQueueWaitIdle(this->_graphicsQueue);
-
-    vkFreeCommandBuffers(this->_logicalDevice, this->_commandPool, 1, &commandBuffer);
+    this->_uploadManager->submit(commandBuffer, this->_commandPool);
 }
 
 /**
@@ -331,6 +1068,23 @@ std::vector<char> VulkanTextRenderer::_readFile(std::string fileName) {
     return buffer;
 }
 
+/**
+ * @brief Returns the spir-v code of shader. Shaders embedded into the library are used without accessing the file
+ * system, other shaders are read from file
+ *
+ * @param fileName Path of compiled shader file, e.g. "shaders/sdf-vert.spv"
+ *
+ * @return Spir-v code of shader in bytes
+ */
+std::vector<char> VulkanTextRenderer::_readShader(std::string fileName) {
+    const EmbeddedShaders::Shader *shader = EmbeddedShaders::find(fileName);
+    if (shader == nullptr) {
+        return this->_readFile(fileName);
+    }
+
+    return std::vector<char>(shader->code, shader->code + shader->size);
+}
+
 /**
  * @brief Creates a vulkan shader module from the shader code
  *
@@ -354,16 +1108,23 @@ VkShaderModule VulkanTextRenderer::_createShaderModule(const std::vector<char> &
 }
 
 /**
- * @brief Created a vulkan buffer with the contents of the uniform buffer object
+ * @brief Creates a vulkan buffer with one uniform buffer object for every frame in flight, each aligned for use as a
+ * dynamic uniform buffer offset
  */
 void VulkanTextRenderer::_createUbo() {
-    VkDeviceSize bufferSize = sizeof(vft::UniformBufferObject);
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(this->_physicalDevice, &properties);
+
+    VkDeviceSize alignment = properties.limits.minUniformBufferOffsetAlignment;
+    this->_uboStride = (sizeof(vft::UniformBufferObject) + alignment - 1) / alignment * alignment;
+
+    VkDeviceSize bufferSize = this->_uboStride * this->_framesInFlight;
 
     this->_createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, this->_uboBuffer,
                         this->_uboMemory);
 
-    vkMapMemory(this->_logicalDevice, this->_uboMemory, 0, bufferSize, 0, &this->_mappedUbo);
+    this->_mappedUbo = this->_uboMemory.mapped;
 }
 
 /**
@@ -371,7 +1132,7 @@ void VulkanTextRenderer::_createUbo() {
  */
 void VulkanTextRenderer::_createDescriptorPool() {
     VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSize.descriptorCount = static_cast<uint32_t>(2);
 
     VkDescriptorPoolCreateInfo poolCreateInfo{};
@@ -391,7 +1152,7 @@ void VulkanTextRenderer::_createDescriptorPool() {
  */
 void VulkanTextRenderer::_createUboDescriptorSetLayout() {
     VkDescriptorSetLayoutBinding layoutBinding{};
-    layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     layoutBinding.binding = 0;
     layoutBinding.descriptorCount = 1;
     layoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT |
@@ -424,6 +1185,14 @@ void VulkanTextRenderer::_createUboDescriptorSet() {
             "VulkanTextRenderer::_createUboDescriptorSet(): Error allocating vulkan descriptor sets");
     }
 
+    this->_updateUboDescriptorSet();
+}
+
+/**
+ * @brief Points the uniform buffer descriptor set to the uniform buffer objects, the object of current frame is
+ * selected by dynamic offset when binding the descriptor set
+ */
+void VulkanTextRenderer::_updateUboDescriptorSet() {
     VkDescriptorBufferInfo descriptorBufferInfo{};
     descriptorBufferInfo.buffer = this->_uboBuffer;
     descriptorBufferInfo.offset = 0;
@@ -434,7 +1203,7 @@ void VulkanTextRenderer::_createUboDescriptorSet() {
     writeDescriptorSet.dstSet = this->_uboDescriptorSet;
     writeDescriptorSet.dstBinding = 0;
     writeDescriptorSet.dstArrayElement = 0;
-    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     writeDescriptorSet.descriptorCount = 1;
     writeDescriptorSet.pBufferInfo = &descriptorBufferInfo;
 
@@ -30,6 +30,13 @@ void VulkanTextRendererDecorator::add(std::shared_ptr<TextBlock> text) {
     this->_renderer->add(text);
 }
 
+/**
+ * @brief Delegate prepare() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::prepare() {
+    this->_renderer->prepare();
+}
+
 /**
  * @brief Delegate draw() to wrapped vulkan text renderer
  */
@@ -37,6 +44,13 @@ void VulkanTextRendererDecorator::draw() {
     this->_renderer->draw();
 }
 
+/**
+ * @brief Delegate takeTransferSemaphores() to wrapped vulkan text renderer
+ */
+std::vector<VkSemaphore> VulkanTextRendererDecorator::takeTransferSemaphores() {
+    return this->_renderer->takeTransferSemaphores();
+}
+
 /**
  * @brief Delegate update() to wrapped vulkan text renderer
  */
@@ -65,11 +79,43 @@ void VulkanTextRendererDecorator::setCache(std::shared_ptr<GlyphCache> cache) {
     this->_renderer->setCache(cache);
 }
 
+/**
+ * @brief Delegate setCpuCulling() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setCpuCulling(bool cpuCulling) {
+    this->_renderer->setCpuCulling(cpuCulling);
+}
+
 /**
  * @brief Delegate setCommandBuffer() to wrapped vulkan text renderer
  */
-void VulkanTextRendererDecorator::setCommandBuffer(VkCommandBuffer commandBuffer) {
-    this->_renderer->setCommandBuffer(commandBuffer);
+void VulkanTextRendererDecorator::setCommandBuffer(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    this->_renderer->setCommandBuffer(commandBuffer, frameIndex);
+}
+
+/**
+ * @brief Delegate setTransferQueue() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setTransferQueue(VkQueue transferQueue,
+                                                   VkCommandPool transferCommandPool,
+                                                   uint32_t transferQueueFamilyIndex,
+                                                   uint32_t graphicsQueueFamilyIndex) {
+    this->_renderer->setTransferQueue(transferQueue, transferCommandPool, transferQueueFamilyIndex,
+                                      graphicsQueueFamilyIndex);
+}
+
+/**
+ * @brief Delegate setFramesInFlight() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setFramesInFlight(uint32_t framesInFlight) {
+    this->_renderer->setFramesInFlight(framesInFlight);
+}
+
+/**
+ * @brief Delegate setSecondaryCommandBuffers() to wrapped vulkan text renderer
+ */
+void VulkanTextRendererDecorator::setSecondaryCommandBuffers(bool secondaryCommandBuffers) {
+    this->_renderer->setSecondaryCommandBuffers(secondaryCommandBuffers);
 }
 
 /**
@@ -114,6 +160,27 @@ VkCommandBuffer VulkanTextRendererDecorator::getCommandBuffer() {
     return this->_renderer->getCommandBuffer();
 }
 
+/**
+ * @brief Delegate getFramesInFlight() to wrapped vulkan text renderer
+ */
+uint32_t VulkanTextRendererDecorator::getFramesInFlight() {
+    return this->_renderer->getFramesInFlight();
+}
+
+/**
+ * @brief Delegate getSubpassContents() to wrapped vulkan text renderer
+ */
+VkSubpassContents VulkanTextRendererDecorator::getSubpassContents() {
+    return this->_renderer->getSubpassContents();
+}
+
+/**
+ * @brief Delegate getMemoryStatistics() to wrapped vulkan text renderer
+ */
+VulkanMemoryStatistics VulkanTextRendererDecorator::getMemoryStatistics() {
+    return this->_renderer->getMemoryStatistics();
+}
+
 /**
  * @brief Delegate addFontAtlas() to wrapped vulkan text renderer
  *
@@ -123,4 +190,13 @@ void VulkanTextRendererDecorator::addFontAtlas(const FontAtlas &atlas) {
     this->_renderer->addFontAtlas(atlas);
 }
 
+/**
+ * @brief Getter for wrapped vulkan text renderer
+ *
+ * @return Wrapped vulkan text renderer
+ */
+VulkanTextRenderer *VulkanTextRendererDecorator::getRenderer() {
+    return this->_renderer;
+}
+
 }  // namespace vft
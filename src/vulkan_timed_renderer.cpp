@@ -11,79 +11,81 @@ namespace vft {
  * @brief VulkanTimedRenderer constructor
  *
  * @param renderer Wrapped vulkan text renderer
+ * @param pipelineStatistics Whether to record pipeline statistics, pipelineStatisticsQuery feature must be enabled
  */
-VulkanTimedRenderer::VulkanTimedRenderer(VulkanTextRenderer *renderer) : VulkanTextRendererDecorator{renderer} {
-    this->_timestampPeriod = this->_getTimestampPeriod();
-
-    // Create vulkan query pool
-    VkQueryPoolCreateInfo queryPoolCreateInfo{};
-    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
-    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
-    queryPoolCreateInfo.queryCount = 2;
-
-    if (vkCreateQueryPool(this->_renderer->getLogicalDevice(), &queryPoolCreateInfo, nullptr, &this->_queryPool) !=
-        VK_SUCCESS) {
-        throw std::runtime_error("VulkanTimedRenderer::initialize(): Error creating vulkan timestamp query pool");
-    }
+VulkanTimedRenderer::VulkanTimedRenderer(VulkanTextRenderer *renderer, bool pipelineStatistics)
+    : VulkanTextRendererDecorator{renderer} {
+    this->_gpuTimer =
+        std::make_unique<VulkanGpuTimer>(this->_renderer->getPhysicalDevice(), this->_renderer->getLogicalDevice(),
+                                         VulkanTextRenderer::MAX_FRAMES_IN_FLIGHT, pipelineStatistics);
+    this->_renderer->setGpuTimer(this->_gpuTimer.get());
 }
 
 /**
  * @brief VulkanTimedRenderer destructor
  */
 VulkanTimedRenderer::~VulkanTimedRenderer() {
-    if (this->_queryPool != nullptr)
-        vkDestroyQueryPool(this->_renderer->getLogicalDevice(), this->_queryPool, nullptr);
+    // Query pools must not be destroyed while used by pending command buffers
+    vkDeviceWaitIdle(this->_renderer->getLogicalDevice());
+    this->_renderer->setGpuTimer(nullptr);
 }
 
 /**
- * @brief  Add draw commands to the command buffer and add timestamps at top and bottom of pipeline
+ * @brief Read results of the frame which used the same query pools, reset them and measure commands recorded before
+ * the render pass
  */
-void VulkanTimedRenderer::draw() {
-    vkCmdWriteTimestamp(this->_renderer->getCommandBuffer(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, this->_queryPool, 0);
+void VulkanTimedRenderer::prepare() {
+    this->_gpuTimer->beginFrame(this->_renderer->getCommandBuffer(), this->_renderer->getFramesInFlight());
+    this->_isFramePrepared = true;
 
-    VulkanTextRendererDecorator::draw();
-
-    vkCmdWriteTimestamp(this->_renderer->getCommandBuffer(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, this->_queryPool, 1);
+    VulkanTextRendererDecorator::prepare();
 }
 
 /**
- * @brief Read timestamps and get draw time
- *
- * @return Draw time
+ * @brief Add draw commands to the command buffer and measure them with timestamps and pipeline statistics. Draw
+ * commands reused in secondary command buffers are not measured
  */
-double VulkanTimedRenderer::readTimestamps() {
-    vkCmdResetQueryPool(this->_renderer->getCommandBuffer(), this->_queryPool, 0, 2);
+void VulkanTimedRenderer::draw() {
+    if (!this->_isFramePrepared) {
+        VulkanTextRendererDecorator::draw();
+        return;
+    }
 
-    uint64_t timestamps[2];
-    VkResult result =
-        vkGetQueryPoolResults(this->_renderer->getLogicalDevice(), this->_queryPool, 0, 2, sizeof(timestamps),
-                              timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
-    if (result != VK_SUCCESS) {
-        throw std::runtime_error(
-            "VulkanTimedRenderer::readTimestamps(): Error reading timestamps from vulkan query pool");
+    // Only secondary command buffers can be executed in the render pass if draw commands are reused
+    bool isDrawMeasured = this->_renderer->getSubpassContents() == VK_SUBPASS_CONTENTS_INLINE;
+    if (isDrawMeasured) {
+        this->_gpuTimer->beginPipelineStatistics();
+        this->_gpuTimer->beginScope("draw");
     }
 
-    double time = (timestamps[1] - timestamps[0]) * this->_timestampPeriod;
-    return time;
+    VulkanTextRendererDecorator::draw();
+
+    if (isDrawMeasured) {
+        this->_gpuTimer->endScope();
+        this->_gpuTimer->endPipelineStatistics();
+    }
+    this->_gpuTimer->endFrame();
+
+    this->_isFramePrepared = false;
 }
 
 /**
- * @brief Reset vulkan query pool
+ * @brief Get rolling statistics of all measured scopes. Results of a frame become available once the gpu finished
+ * it and its query pools are reused
+ *
+ * @return Statistics in microseconds (key: name of scope, value: statistics)
  */
-void VulkanTimedRenderer::resetQueryPool() {
-    vkCmdResetQueryPool(this->_renderer->getCommandBuffer(), this->_queryPool, 0, 2);
+std::map<std::string, TimingStatistics> VulkanTimedRenderer::getTimingStatistics() {
+    return this->_gpuTimer->getTimingStatistics();
 }
 
 /**
- * @brief Get vulkan timestamp period of physical device
+ * @brief Get pipeline statistics of the last measured frame
  *
- * @return Timestamp period of physical device
+ * @return Pipeline statistics, all zero if pipeline statistics are not recorded
  */
-double VulkanTimedRenderer::_getTimestampPeriod() {
-    VkPhysicalDeviceProperties deviceProperties{};
-    vkGetPhysicalDeviceProperties(this->_renderer->getPhysicalDevice(), &deviceProperties);
-
-    return deviceProperties.limits.timestampPeriod;
+PipelineStatistics VulkanTimedRenderer::getPipelineStatistics() {
+    return this->_gpuTimer->getPipelineStatistics();
 }
 
-};  // namespace vft
\ No newline at end of file
+}  // namespace vft
@@ -15,8 +15,11 @@ VulkanTriangulationTextRenderer::VulkanTriangulationTextRenderer(VkPhysicalDevic
                                                                  VkQueue graphicsQueue,
                                                                  VkCommandPool commandPool,
                                                                  VkRenderPass renderPass,
-                                                                 VkCommandBuffer commandBuffer)
-    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer} {
+                                                                 VkCommandBuffer commandBuffer,
+                                                                 VkPipelineCache pipelineCache,
+                                                                 const VkPhysicalDeviceFeatures &enabledFeatures)
+    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer,
+                         pipelineCache, enabledFeatures} {
     this->_initialize();
 
     this->_createPipeline();
@@ -26,6 +29,9 @@ VulkanTriangulationTextRenderer::VulkanTriangulationTextRenderer(VkPhysicalDevic
  * @brief Deallocate memory and destroy vulkan text renderer
  */
 VulkanTriangulationTextRenderer::~VulkanTriangulationTextRenderer() {
+    // Wait until the gpu stops using vulkan objects of renderer
+    vkDeviceWaitIdle(this->_logicalDevice);
+
     // Destroy vulkan buffers
     if (this->_indexBuffer != nullptr)
         this->_destroyBuffer(this->_indexBuffer, this->_indexBufferMemory);
@@ -43,41 +49,65 @@ VulkanTriangulationTextRenderer::~VulkanTriangulationTextRenderer() {
  * @brief Add draw commands to the command buffer for drawing all glyphs in tracked text blocks
  */
 void VulkanTriangulationTextRenderer::draw() {
+    VFONT_PROFILE_ZONE("VulkanTriangulationTextRenderer::draw");
+    VulkanTextRenderer::draw();
+
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
         return;
     }
 
-    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipeline);
-    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipelineLayout, 0, 1,
-                            &this->_uboDescriptorSet, 0, nullptr);
+    bool isCullingRecorded = this->_takeCullingRecorded();
+
+    if (!this->_beginDrawCommands()) {
+        return;
+    }
+
+    if (isCullingRecorded) {
+        this->_drawCulled();
+        this->_endDrawCommands();
+        return;
+    }
+
+    vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipeline);
+    vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipelineLayout, 0, 1,
+                            &this->_uboDescriptorSet, 1, &this->_uboOffset);
 
     VkBuffer vertexBuffers[] = {this->_vertexBuffer};
     VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(this->_commandBuffer, 0, 1, vertexBuffers, offsets);
-
-    vkCmdBindIndexBuffer(this->_commandBuffer, this->_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    for (int i = 0; i < this->_textBlocks.size(); i++) {
-        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), character.getFontSize()};
+    vkCmdBindVertexBuffers(this->_recordingCommandBuffer, 0, 1, vertexBuffers, offsets);
 
-            if (this->_offsets.at(key).indicesCount > 0) {
-                vft::CharacterPushConstants pushConstants{character.getModelMatrix(), this->_textBlocks[i]->getColor()};
-                vkCmdPushConstants(this->_commandBuffer, this->_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
-                                   sizeof(vft::CharacterPushConstants), &pushConstants);
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_indexBuffer, 0, VK_INDEX_TYPE_UINT16);
 
-                vkCmdDrawIndexed(this->_commandBuffer, this->_offsets.at(key).indicesCount, 1,
-                                 this->_offsets.at(key).indicesOffset, 0, 0);
+    this->_updateDrawRecords();
+    for (const DrawRecordRange &range : this->_getVisibleDrawRecordRanges()) {
+        for (uint32_t i = range.first; i < range.first + range.count; i++) {
+            const DrawRecord &record = this->_drawRecords[i];
+            if (!this->_isCharacterDrawn(record)) {
+                continue;
             }
+
+            vkCmdPushConstants(this->_recordingCommandBuffer, this->_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                               sizeof(vft::CharacterPushConstants), &this->_drawInstances[record.instance]);
+            vkCmdDrawIndexed(this->_recordingCommandBuffer, record.indexCount, 1, record.firstIndex,
+                             record.vertexOffset, 0);
         }
     }
+
+    this->_endDrawCommands();
 }
 
 /**
  * @brief Creates a new vertex and index buffer after a change in tracked text blocks
  */
 void VulkanTriangulationTextRenderer::update() {
+    VFONT_PROFILE_ZONE("VulkanTriangulationTextRenderer::update");
     TriangulationTextRenderer::update();
+    this->_invalidateDrawRecords();
+
+    if (this->_gpuCulling) {
+        this->_createCullingBuffers();
+    }
 
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
@@ -99,12 +129,67 @@ void VulkanTriangulationTextRenderer::update() {
                                       this->_indexBuffer, this->_indexBufferMemory);
 }
 
+/**
+ * @brief Creates a vulkan descriptor pool for the uniform buffer and buffers used by gpu culling
+ */
+void VulkanTriangulationTextRenderer::_createDescriptorPool() {
+    std::array<VkDescriptorPoolSize, 2> poolSizes{};
+
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    poolSizes[0].descriptorCount = 1;
+
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount = 3 * MAX_FRAMES_IN_FLIGHT;
+
+    VkDescriptorPoolCreateInfo poolCreateInfo{};
+    poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolCreateInfo.poolSizeCount = poolSizes.size();
+    poolCreateInfo.pPoolSizes = poolSizes.data();
+    poolCreateInfo.maxSets = 1 + MAX_FRAMES_IN_FLIGHT;
+
+    if (vkCreateDescriptorPool(this->_logicalDevice, &poolCreateInfo, nullptr, &this->_descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTriangulationTextRenderer::_createDescriptorPool(): Error creating vulkan descriptor pool");
+    }
+}
+
 /**
  * @brief Create vulkan pipeline for displaying glyph's triangles
  */
 void VulkanTriangulationTextRenderer::_createPipeline() {
-    std::vector<char> vertexShaderCode = this->_readFile("shaders/triangle-vert.spv");
-    std::vector<char> fragmentShaderCode = this->_readFile("shaders/triangle-frag.spv");
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.size = sizeof(vft::CharacterPushConstants);
+    pushConstantRange.offset = 0;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = 1;
+    pipelineLayoutCreateInfo.pSetLayouts = &this->_uboDescriptorSetLayout;
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+
+    if (vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr, &this->_pipelineLayout) !=
+        VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTriangulationTextRenderer::_createPipeline(): Error creating vulkan pipeline layout");
+    }
+
+    this->_createGraphicsPipeline("shaders/triangle-vert.spv", this->_pipelineLayout, this->_pipeline);
+}
+
+/**
+ * @brief Create vulkan graphics pipeline for displaying glyph's triangles
+ *
+ * @param vertexShaderFile Name of compiled vertex shader
+ * @param pipelineLayout Vulkan pipeline layout
+ * @param pipeline Created vulkan pipeline
+ */
+void VulkanTriangulationTextRenderer::_createGraphicsPipeline(const std::string &vertexShaderFile,
+                                                              VkPipelineLayout pipelineLayout,
+                                                              VkPipeline &pipeline) {
+    std::vector<char> vertexShaderCode = this->_readShader(vertexShaderFile);
+    std::vector<char> fragmentShaderCode = this->_readShader("shaders/triangle-frag.spv");
 
     VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
     VkShaderModule fragmentShaderModule = this->_createShaderModule(fragmentShaderCode);
@@ -132,13 +217,13 @@ void VulkanTriangulationTextRenderer::_createPipeline() {
 
     VkVertexInputBindingDescription vertexInputBindingDescription{};
     vertexInputBindingDescription.binding = 0;
-    vertexInputBindingDescription.stride = sizeof(glm::vec2);
+    vertexInputBindingDescription.stride = sizeof(glm::i16vec2);
     vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
     VkVertexInputAttributeDescription vertexInputAttributeDescription{};
     vertexInputAttributeDescription.binding = 0;
     vertexInputAttributeDescription.location = 0;
-    vertexInputAttributeDescription.format = VK_FORMAT_R32G32_SFLOAT;
+    vertexInputAttributeDescription.format = VK_FORMAT_R16G16_SINT;
     vertexInputAttributeDescription.offset = 0;
 
     VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{};
@@ -190,24 +275,6 @@ void VulkanTriangulationTextRenderer::_createPipeline() {
     colorBlendStateCreateInfo.attachmentCount = 1;
     colorBlendStateCreateInfo.pAttachments = &colorBlendAttachmentState;
 
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.size = sizeof(vft::CharacterPushConstants);
-    pushConstantRange.offset = 0;
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
-    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutCreateInfo.setLayoutCount = 1;
-    pipelineLayoutCreateInfo.pSetLayouts = &this->_uboDescriptorSetLayout;
-    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
-    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
-
-    if (vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr, &this->_pipelineLayout) !=
-        VK_SUCCESS) {
-        throw std::runtime_error(
-            "VulkanTriangulationTextRenderer::_createPipeline(): Error creating vulkan pipeline layout");
-    }
-
     VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
     graphicsPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     graphicsPipelineCreateInfo.stageCount = 2;
@@ -220,18 +287,146 @@ void VulkanTriangulationTextRenderer::_createPipeline() {
     graphicsPipelineCreateInfo.pDepthStencilState = nullptr;
     graphicsPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
     graphicsPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
-    graphicsPipelineCreateInfo.layout = this->_pipelineLayout;
+    graphicsPipelineCreateInfo.layout = pipelineLayout;
     graphicsPipelineCreateInfo.renderPass = this->_renderPass;
     graphicsPipelineCreateInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
-                                  &this->_pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, this->_pipelineCache, 1, &graphicsPipelineCreateInfo,
+                                  nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error(
-            "VulkanTriangulationTextRenderer::_createPipeline(): Error creating vulkan graphics pipeline");
+            "VulkanTriangulationTextRenderer::_createGraphicsPipeline(): Error creating vulkan graphics pipeline");
     }
 
     vkDestroyShaderModule(this->_logicalDevice, vertexShaderModule, nullptr);
     vkDestroyShaderModule(this->_logicalDevice, fragmentShaderModule, nullptr);
 }
 
+/**
+ * @brief Compiles a draw record and push constants for every character with triangles, so that drawing does not look
+ * up glyph offsets
+ */
+void VulkanTriangulationTextRenderer::_compileDrawRecords() {
+    VFONT_PROFILE_ZONE("VulkanTriangulationTextRenderer::_compileDrawRecords");
+    this->_drawInstances.clear();
+
+    uint32_t line = 0;
+    uint32_t characterOffset = 0;
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        std::vector<Character> characters = textBlock->getCharacters();
+        for (const LineBoundingBox &lineBoundingBox : textBlock->getLineBoundingBoxes()) {
+            for (unsigned int i = lineBoundingBox.start; i < lineBoundingBox.start + lineBoundingBox.count; i++) {
+                const Character &character = characters[i];
+                GlyphKey key{TessellationStrategy::TRIANGULATION, character.getFont()->getFontFamily(),
+                             character.getGlyphId(), character.getFontSize()};
+                const GlyphInfo &glyphInfo = this->_offsets.at(key);
+
+                if (glyphInfo.indicesCount > 0) {
+                    uint32_t instance = this->_drawInstances.size();
+                    this->_drawRecords.push_back(DrawRecord{this->_pipeline, nullptr, glyphInfo.indicesCount,
+                                                            glyphInfo.indicesOffset, glyphInfo.vertexOffset, instance,
+                                                            line, characterOffset + i});
+                    this->_drawInstances.push_back(
+                        CharacterPushConstants{character.getModelMatrix(), textBlock->getColor()});
+                }
+            }
+
+            line++;
+        }
+
+        characterOffset += characters.size();
+    }
+}
+
+/**
+ * @brief Checks if the renderer can draw characters culled on the gpu
+ *
+ * @return True, characters are drawn by one indirect draw per glyph
+ */
+bool VulkanTriangulationTextRenderer::_supportsGpuCulling() const {
+    return true;
+}
+
+/**
+ * @brief Creates the graphics pipeline reading model matrices of visible characters from storage buffers
+ */
+void VulkanTriangulationTextRenderer::_createCulledPipeline() {
+    std::array<VkDescriptorSetLayout, 2> setLayouts = {this->_uboDescriptorSetLayout,
+                                                       this->_cullingDescriptorSetLayout};
+
+    VkPipelineLayoutCreateInfo culledPipelineLayoutCreateInfo{};
+    culledPipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    culledPipelineLayoutCreateInfo.setLayoutCount = setLayouts.size();
+    culledPipelineLayoutCreateInfo.pSetLayouts = setLayouts.data();
+
+    if (vkCreatePipelineLayout(this->_logicalDevice, &culledPipelineLayoutCreateInfo, nullptr,
+                               &this->_culledPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanTriangulationTextRenderer::_createCulledPipeline(): Error creating vulkan pipeline layout");
+    }
+
+    this->_createGraphicsPipeline("shaders/triangle_culled-vert.spv", this->_culledPipelineLayout,
+                                  this->_culledPipeline);
+}
+
+/**
+ * @brief Collects all characters with triangles and one indirect draw command for each glyph
+ *
+ * @param instances Characters of all tracked text blocks
+ * @param drawCommands Draw commands with the number of characters of glyph as instance count
+ */
+void VulkanTriangulationTextRenderer::_collectCullingInstances(
+    std::vector<CullingInstance> &instances,
+    std::vector<VkDrawIndexedIndirectCommand> &drawCommands) {
+    std::unordered_map<GlyphKey, uint32_t, GlyphKeyHash> drawCommandIndices;
+
+    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
+        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
+            GlyphKey key{TessellationStrategy::TRIANGULATION, character.getFont()->getFontFamily(),
+                         character.getGlyphId(), character.getFontSize()};
+            const GlyphInfo &glyphInfo = this->_offsets.at(key);
+
+            if (glyphInfo.indicesCount == 0) {
+                continue;
+            }
+
+            auto [drawCommandIndex, inserted] = drawCommandIndices.try_emplace(key, drawCommands.size());
+            if (inserted) {
+                VkDrawIndexedIndirectCommand drawCommand{};
+                drawCommand.indexCount = glyphInfo.indicesCount;
+                drawCommand.firstIndex = glyphInfo.indicesOffset;
+                drawCommand.vertexOffset = glyphInfo.vertexOffset;
+                drawCommands.push_back(drawCommand);
+            }
+
+            // Count characters of glyph to reserve space for its visible characters
+            drawCommands.at(drawCommandIndex->second).instanceCount++;
+
+            CullingInstance instance{};
+            instance.model = character.getModelMatrix();
+            instance.color = this->_textBlocks[i]->getColor();
+            instance.boundingBox = glyphInfo.boundingBox;
+            instance.drawCommandIndex = drawCommandIndex->second;
+            instances.push_back(instance);
+        }
+    }
+}
+
+/**
+ * @brief Add indirect draw commands for characters which passed gpu culling
+ */
+void VulkanTriangulationTextRenderer::_drawCulled() {
+    vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_culledPipeline);
+
+    std::array<VkDescriptorSet, 2> sets = {this->_uboDescriptorSet, this->_cullingDescriptorSets.at(this->_frameSlot)};
+    vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            this->_culledPipelineLayout, 0, sets.size(), sets.data(), 1, &this->_uboOffset);
+
+    VkBuffer vertexBuffers[] = {this->_vertexBuffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(this->_recordingCommandBuffer, 0, 1, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_indexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+    this->_drawCulledCommands();
+}
+
 }  // namespace vft
@@ -0,0 +1,471 @@
+/**
+ * @file vulkan_upload_manager.cpp
+ * @author Christian Saloň
+ */
+
+#include "vulkan_upload_manager.h"
+
+namespace vft {
+
+/**
+ * @brief Creates upload manager which submits copies to the graphics queue
+ *
+ * @param logicalDevice Vulkan logical device
+ * @param graphicsQueue Vulkan graphics queue
+ * @param graphicsCommandPool Vulkan command pool of graphics queue family
+ * @param memoryAllocator Allocator of memory for staging buffers
+ * @param framesInFlight Number of frames that can be processed by the gpu concurrently
+ */
+VulkanUploadManager::VulkanUploadManager(VkDevice logicalDevice,
+                                         VkQueue graphicsQueue,
+                                         VkCommandPool graphicsCommandPool,
+                                         VulkanMemoryAllocator *memoryAllocator,
+                                         uint32_t framesInFlight)
+    : _logicalDevice{logicalDevice},
+      _memoryAllocator{memoryAllocator},
+      _graphicsQueue{graphicsQueue},
+      _graphicsCommandPool{graphicsCommandPool} {
+    this->setFramesInFlight(framesInFlight);
+}
+
+/**
+ * @brief Waits until the gpu is idle and destroys all staging and retired buffers, fences and semaphores
+ */
+VulkanUploadManager::~VulkanUploadManager() {
+    vkDeviceWaitIdle(this->_logicalDevice);
+
+    if (this->_recordingBatch.commandBuffer != nullptr) {
+        vkEndCommandBuffer(this->_recordingBatch.commandBuffer);
+        this->_releaseBatch(this->_recordingBatch);
+    }
+
+    for (Batch &batch : this->_pendingBatches) {
+        vkDestroyFence(this->_logicalDevice, batch.fence, nullptr);
+        this->_releaseBatch(batch);
+    }
+
+    for (RetiredBuffer &retired : this->_retiredBuffers) {
+        vkDestroyBuffer(this->_logicalDevice, retired.buffer, nullptr);
+        this->_memoryAllocator->free(retired.memory);
+    }
+
+    for (VkFence fence : this->_freeFences) {
+        vkDestroyFence(this->_logicalDevice, fence, nullptr);
+    }
+
+    for (VkSemaphore semaphore : this->_transferSemaphores) {
+        vkDestroySemaphore(this->_logicalDevice, semaphore, nullptr);
+    }
+
+    for (UsedSemaphore &used : this->_usedSemaphores) {
+        vkDestroySemaphore(this->_logicalDevice, used.semaphore, nullptr);
+    }
+
+    for (VkSemaphore semaphore : this->_freeSemaphores) {
+        vkDestroySemaphore(this->_logicalDevice, semaphore, nullptr);
+    }
+}
+
+/**
+ * @brief Copies data into a staging buffer and records a copy into the destination buffer. The copy is executed after
+ * the next call to flush() or beginFrame()
+ *
+ * @param data Pointer to the data to be copied
+ * @param size Size of the data in bytes
+ * @param destinationBuffer Vulkan buffer created with transfer destination usage
+ * @param destinationOffset Offset in destination buffer
+ */
+void VulkanUploadManager::upload(const void *data,
+                                 VkDeviceSize size,
+                                 VkBuffer destinationBuffer,
+                                 VkDeviceSize destinationOffset) {
+    VFONT_PROFILE_ZONE("VulkanUploadManager::upload");
+    if (size == 0) {
+        return;
+    }
+
+    if (this->_recordingBatch.commandBuffer == nullptr) {
+        this->_beginBatch();
+    }
+
+    // Create staging buffer in host visible memory
+    VkBufferCreateInfo bufferCreateInfo{};
+    bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCreateInfo.size = size;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer stagingBuffer;
+    if (vkCreateBuffer(this->_logicalDevice, &bufferCreateInfo, nullptr, &stagingBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanUploadManager::upload(): Error creating vulkan staging buffer");
+    }
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(this->_logicalDevice, stagingBuffer, &memoryRequirements);
+
+    VulkanMemoryAllocation stagingMemory = this->_memoryAllocator->allocate(
+        memoryRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    vkBindBufferMemory(this->_logicalDevice, stagingBuffer, stagingMemory.memory, stagingMemory.offset);
+
+    memcpy(stagingMemory.mapped, data, size);
+    VFONT_PROFILE_COUNTER("bytes uploaded", size);
+
+    this->_recordingBatch.stagingBuffers.push_back(stagingBuffer);
+    this->_recordingBatch.stagingMemory.push_back(stagingMemory);
+
+    // Record copy from staging buffer
+    VkBufferCopy copyRegion{};
+    copyRegion.srcOffset = 0;
+    copyRegion.dstOffset = destinationOffset;
+    copyRegion.size = size;
+    vkCmdCopyBuffer(this->_recordingBatch.commandBuffer, stagingBuffer, destinationBuffer, 1, &copyRegion);
+}
+
+/**
+ * @brief Submits all recorded copies. When copies are submitted to the graphics queue, a memory barrier makes them
+ * visible to all following draw, compute and copy commands. Copies submitted to the transfer queue signal a semaphore
+ * which the application takes by takeTransferSemaphores(), so the cpu never waits for them
+ */
+void VulkanUploadManager::flush() {
+    VFONT_PROFILE_ZONE("VulkanUploadManager::flush");
+    if (this->_recordingBatch.commandBuffer == nullptr) {
+        return;
+    }
+
+    Batch &batch = this->_recordingBatch;
+
+    if (this->_transferQueue == nullptr) {
+        VkMemoryBarrier memoryBarrier{};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                      VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+
+        vkCmdPipelineBarrier(batch.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanUploadManager::flush(): Error recording vulkan command buffer");
+    }
+
+    if (this->_transferQueue != nullptr) {
+        VkSemaphore semaphore = this->_acquireSemaphore();
+        this->_submitBatch(batch, this->_transferQueue, semaphore);
+        this->_transferSemaphores.push_back(semaphore);
+    } else {
+        this->_submitBatch(batch, this->_graphicsQueue, nullptr);
+    }
+
+    this->_recordingBatch = Batch{};
+}
+
+/**
+ * @brief Submits command buffer recorded by the caller to the graphics queue, the command buffer is freed once the gpu
+ * executed it without the cpu waiting for it. Buffers used by the commands must be destroyed by destroyBuffer()
+ *
+ * @param commandBuffer Recorded vulkan command buffer
+ * @param commandPool Vulkan command pool of graphics queue family the command buffer was allocated from
+ */
+void VulkanUploadManager::submit(VkCommandBuffer commandBuffer, VkCommandPool commandPool) {
+    // Recorded copies are submitted first, so batches are executed in the order of their serial numbers
+    this->flush();
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanUploadManager::submit(): Error recording vulkan command buffer");
+    }
+
+    Batch batch{};
+    batch.serial = this->_submittedSerial + 1;
+    batch.commandBuffer = commandBuffer;
+    batch.commandPool = commandPool;
+    this->_submitBatch(batch, this->_graphicsQueue, nullptr);
+}
+
+/**
+ * @brief Submits recorded copies and frees resources the gpu no longer uses, must be called once per frame before
+ * recording draw commands. Only fences which are already signaled are collected, so the cpu never waits for the gpu
+ */
+void VulkanUploadManager::beginFrame() {
+    this->_frame++;
+    this->_recycleSemaphores();
+
+    this->flush();
+    this->_collectCompletedBatches();
+    this->_destroyRetiredBuffers();
+}
+
+/**
+ * @brief Destroys vulkan buffer after all frames which could use it and all copies into it were executed
+ *
+ * @param buffer The vulkan buffer to be destroyed. It will be set to nullptr.
+ * @param bufferMemory The memory range associated with the buffer. It will be reset.
+ */
+void VulkanUploadManager::destroyBuffer(VkBuffer &buffer, VulkanMemoryAllocation &bufferMemory) {
+    if (buffer == nullptr)
+        return;
+
+    RetiredBuffer retired{};
+    retired.buffer = buffer;
+    retired.memory = bufferMemory;
+    retired.frame = this->_frame;
+    retired.batchSerial = this->_submittedSerial + (this->_recordingBatch.commandBuffer != nullptr ? 1 : 0);
+    this->_retiredBuffers.push_back(retired);
+
+    buffer = nullptr;
+    bufferMemory = VulkanMemoryAllocation{};
+}
+
+/**
+ * @brief Submit copies to a dedicated transfer queue. Buffers created afterwards must be shared by transfer and
+ * graphics queue families, see getQueueFamilyIndices()
+ *
+ * @param transferQueue Vulkan queue supporting transfer operations
+ * @param transferCommandPool Vulkan command pool of transfer queue family
+ * @param transferQueueFamilyIndex Index of transfer queue family
+ * @param graphicsQueueFamilyIndex Index of graphics queue family
+ */
+void VulkanUploadManager::setTransferQueue(VkQueue transferQueue,
+                                           VkCommandPool transferCommandPool,
+                                           uint32_t transferQueueFamilyIndex,
+                                           uint32_t graphicsQueueFamilyIndex) {
+    if (transferQueue == nullptr || transferCommandPool == nullptr) {
+        throw std::invalid_argument(
+            "VulkanUploadManager::setTransferQueue(): Transfer queue and command pool must not be null");
+    }
+
+    this->flush();
+
+    this->_transferQueue = transferQueue;
+    this->_transferCommandPool = transferCommandPool;
+    this->_queueFamilyIndices.clear();
+
+    if (transferQueueFamilyIndex != graphicsQueueFamilyIndex) {
+        this->_queueFamilyIndices = {graphicsQueueFamilyIndex, transferQueueFamilyIndex};
+    }
+}
+
+/**
+ * @brief Set number of frames that can be processed by the gpu concurrently, which determines how long destroyed
+ * buffers are kept alive
+ *
+ * @param framesInFlight Number of frames in flight
+ */
+void VulkanUploadManager::setFramesInFlight(uint32_t framesInFlight) {
+    if (framesInFlight == 0) {
+        throw std::invalid_argument(
+            "VulkanUploadManager::setFramesInFlight(): Frames in flight must be greater than 0");
+    }
+
+    this->_framesInFlight = framesInFlight;
+}
+
+/**
+ * @brief Getter for queue families which access uploaded buffers
+ *
+ * @return Indices of queue families if buffers must be created with concurrent sharing mode, else empty vector
+ */
+const std::vector<uint32_t> &VulkanUploadManager::getQueueFamilyIndices() {
+    return this->_queueFamilyIndices;
+}
+
+/**
+ * @brief Takes semaphores signaled by copies submitted to the transfer queue since the last call. Call it after draw()
+ * and wait for all returned semaphores in the graphics submit of current frame at the vertex input, draw indirect,
+ * shader and transfer stages. Semaphores are reused after framesInFlight frames
+ *
+ * @return Semaphores to wait for, empty if copies are submitted to the graphics queue
+ */
+std::vector<VkSemaphore> VulkanUploadManager::takeTransferSemaphores() {
+    std::vector<VkSemaphore> semaphores = std::move(this->_transferSemaphores);
+    this->_transferSemaphores.clear();
+
+    for (VkSemaphore semaphore : semaphores) {
+        this->_usedSemaphores.push_back(UsedSemaphore{semaphore, this->_frame});
+    }
+
+    return semaphores;
+}
+
+/**
+ * @brief Getter for number of frames that can be processed by the gpu concurrently
+ *
+ * @return Number of frames in flight
+ */
+uint32_t VulkanUploadManager::getFramesInFlight() {
+    return this->_framesInFlight;
+}
+
+/**
+ * @brief Allocates and begins command buffer for next batch of copies
+ */
+void VulkanUploadManager::_beginBatch() {
+    VkCommandPool commandPool =
+        this->_transferCommandPool != nullptr ? this->_transferCommandPool : this->_graphicsCommandPool;
+
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.commandPool = commandPool;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(this->_logicalDevice, &commandBufferAllocateInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanUploadManager::_beginBatch(): Error allocating vulkan command buffer");
+    }
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo) != VK_SUCCESS) {
+        vkFreeCommandBuffers(this->_logicalDevice, commandPool, 1, &commandBuffer);
+        throw std::runtime_error("VulkanUploadManager::_beginBatch(): Error beginning vulkan command buffer");
+    }
+
+    this->_recordingBatch.serial = this->_submittedSerial + 1;
+    this->_recordingBatch.commandBuffer = commandBuffer;
+    this->_recordingBatch.commandPool = commandPool;
+}
+
+/**
+ * @brief Submits ended command buffer of batch to the queue and tracks the batch until the gpu executes it
+ *
+ * @param batch Batch with ended command buffer, it is moved into pending batches
+ * @param queue Vulkan queue the command buffer is submitted to
+ * @param signalSemaphore Vulkan semaphore signaled after execution or nullptr
+ */
+void VulkanUploadManager::_submitBatch(Batch &batch, VkQueue queue, VkSemaphore signalSemaphore) {
+    batch.fence = this->_acquireFence();
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.commandBuffer;
+    submitInfo.signalSemaphoreCount = signalSemaphore != nullptr ? 1 : 0;
+    submitInfo.pSignalSemaphores = &signalSemaphore;
+
+    if (vkQueueSubmit(queue, 1, &submitInfo, batch.fence) != VK_SUCCESS) {
+        throw std::runtime_error("VulkanUploadManager::_submitBatch(): Error submitting vulkan command buffer");
+    }
+
+    this->_submittedSerial = batch.serial;
+    this->_pendingBatches.push_back(std::move(batch));
+}
+
+/**
+ * @brief Takes unsignaled fence from the free fences or creates a new one
+ *
+ * @return Vulkan fence
+ */
+VkFence VulkanUploadManager::_acquireFence() {
+    if (this->_freeFences.empty()) {
+        VkFenceCreateInfo fenceCreateInfo{};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+        VkFence fence;
+        if (vkCreateFence(this->_logicalDevice, &fenceCreateInfo, nullptr, &fence) != VK_SUCCESS) {
+            throw std::runtime_error("VulkanUploadManager::_acquireFence(): Error creating vulkan fence");
+        }
+
+        return fence;
+    }
+
+    VkFence fence = this->_freeFences.back();
+    this->_freeFences.pop_back();
+    return fence;
+}
+
+/**
+ * @brief Takes unsignaled semaphore from the free semaphores or creates a new one
+ *
+ * @return Vulkan semaphore
+ */
+VkSemaphore VulkanUploadManager::_acquireSemaphore() {
+    if (this->_freeSemaphores.empty()) {
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        VkSemaphore semaphore;
+        if (vkCreateSemaphore(this->_logicalDevice, &semaphoreCreateInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("VulkanUploadManager::_acquireSemaphore(): Error creating vulkan semaphore");
+        }
+
+        return semaphore;
+    }
+
+    VkSemaphore semaphore = this->_freeSemaphores.back();
+    this->_freeSemaphores.pop_back();
+    return semaphore;
+}
+
+/**
+ * @brief Frees staging buffers and command buffers of executed batches, fences are only queried so the cpu does not
+ * wait for the gpu
+ */
+void VulkanUploadManager::_collectCompletedBatches() {
+    while (!this->_pendingBatches.empty() &&
+           vkGetFenceStatus(this->_logicalDevice, this->_pendingBatches.front().fence) == VK_SUCCESS) {
+        Batch &batch = this->_pendingBatches.front();
+
+        vkResetFences(this->_logicalDevice, 1, &batch.fence);
+        this->_freeFences.push_back(batch.fence);
+
+        this->_completedSerial = batch.serial;
+        this->_releaseBatch(batch);
+        this->_pendingBatches.pop_front();
+    }
+}
+
+/**
+ * @brief Frees staging buffers and command buffer of batch
+ *
+ * @param batch Batch which is not used by the gpu
+ */
+void VulkanUploadManager::_releaseBatch(Batch &batch) {
+    for (unsigned int i = 0; i < batch.stagingBuffers.size(); i++) {
+        vkDestroyBuffer(this->_logicalDevice, batch.stagingBuffers.at(i), nullptr);
+        this->_memoryAllocator->free(batch.stagingMemory.at(i));
+    }
+
+    vkFreeCommandBuffers(this->_logicalDevice, batch.commandPool, 1, &batch.commandBuffer);
+
+    batch.stagingBuffers.clear();
+    batch.stagingMemory.clear();
+    batch.commandBuffer = nullptr;
+}
+
+/**
+ * @brief Frees semaphores waited for by frames which were started framesInFlight frames ago, their graphics submits
+ * were executed so the semaphores are unsignaled again
+ */
+void VulkanUploadManager::_recycleSemaphores() {
+    while (!this->_usedSemaphores.empty() &&
+           this->_usedSemaphores.front().frame + this->_framesInFlight <= this->_frame) {
+        this->_freeSemaphores.push_back(this->_usedSemaphores.front().semaphore);
+        this->_usedSemaphores.pop_front();
+    }
+}
+
+/**
+ * @brief Destroys retired buffers which are no longer used by frames in flight or by pending copies. The application
+ * must wait for completion of a frame before it starts recording the frame which is framesInFlight frames later
+ */
+void VulkanUploadManager::_destroyRetiredBuffers() {
+    while (!this->_retiredBuffers.empty()) {
+        RetiredBuffer &retired = this->_retiredBuffers.front();
+
+        if (retired.frame + this->_framesInFlight > this->_frame || retired.batchSerial > this->_completedSerial) {
+            break;
+        }
+
+        vkDestroyBuffer(this->_logicalDevice, retired.buffer, nullptr);
+        this->_memoryAllocator->free(retired.memory);
+        this->_retiredBuffers.pop_front();
+    }
+}
+
+}  // namespace vft
@@ -15,12 +15,15 @@ VulkanWindingNumberTextRenderer::VulkanWindingNumberTextRenderer(VkPhysicalDevic
                                                                  VkQueue graphicsQueue,
                                                                  VkCommandPool commandPool,
                                                                  VkRenderPass renderPass,
-                                                                 VkCommandBuffer commandBuffer)
-    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer} {
+                                                                 VkCommandBuffer commandBuffer,
+                                                                 VkPipelineCache pipelineCache,
+                                                                 const VkPhysicalDeviceFeatures &enabledFeatures)
+    : VulkanTextRenderer{physicalDevice, logicalDevice, graphicsQueue, commandPool, renderPass, commandBuffer,
+                         pipelineCache, enabledFeatures} {
     this->_initialize();
 
     this->_createSegmentsDescriptorSetLayout();
-    this->_createSegmentsDescriptorSet();
+    this->_createSegmentsDescriptorSets();
     this->_createSegmentsPipeline();
 }
 
@@ -28,6 +31,9 @@ VulkanWindingNumberTextRenderer::VulkanWindingNumberTextRenderer(VkPhysicalDevic
  * @brief Deallocate memory and destroy vulkan text renderer
  */
 VulkanWindingNumberTextRenderer::~VulkanWindingNumberTextRenderer() {
+    // Wait until the gpu stops using vulkan objects of renderer
+    vkDeviceWaitIdle(this->_logicalDevice);
+
     // Destroy vulkan buffers
     if (this->_boundingBoxIndexBuffer != nullptr)
         this->_destroyBuffer(this->_boundingBoxIndexBuffer, this->_boundingBoxIndexBufferMemory);
@@ -51,50 +57,74 @@ VulkanWindingNumberTextRenderer::~VulkanWindingNumberTextRenderer() {
  * @brief Add draw commands to the command buffer for drawing all glyphs in tracked text blocks
  */
 void VulkanWindingNumberTextRenderer::draw() {
+    VFONT_PROFILE_ZONE("VulkanWindingNumberTextRenderer::draw");
+    VulkanTextRenderer::draw();
+
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
         return;
     }
 
-    vkCmdBindPipeline(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_segmentsPipeline);
+    // Descriptor set of current frame is not used by the gpu, because the frame using it before has finished
+    if (this->_segmentsDescriptorSetsOutdated.at(this->_frameSlot)) {
+        this->_updateSegmentsDescriptorSet(this->_frameSlot);
+    }
 
-    std::array<VkDescriptorSet, 2> sets = {this->_uboDescriptorSet, this->_segmentsDescriptorSet};
-    vkCmdBindDescriptorSets(this->_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_segmentsPipelineLayout, 0,
-                            sets.size(), sets.data(), 0, nullptr);
+    bool isCullingRecorded = this->_takeCullingRecorded();
 
-    VkBuffer vertexBuffers[] = {this->_vertexBuffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(this->_commandBuffer, 0, 1, vertexBuffers, offsets);
+    if (!this->_beginDrawCommands()) {
+        return;
+    }
 
-    // Draw line and curve segments
-    vkCmdBindIndexBuffer(this->_commandBuffer, this->_boundingBoxIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
-        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
-            GlyphKey key{character.getFont()->getFontFamily(), character.getGlyphId(), 0};
+    if (isCullingRecorded) {
+        this->_drawCulled();
+        this->_endDrawCommands();
+        return;
+    }
 
-            if (this->_offsets.at(key).boundingBoxCount > 0) {
-                SegmentsInfo segmentsInfo = this->_segmentsInfo.at(this->_offsets.at(key).segmentsInfoOffset);
+    vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_segmentsPipeline);
 
-                CharacterPushConstants pushConstants{
-                    character.getModelMatrix(),           this->_textBlocks.at(i)->getColor(),
-                    segmentsInfo.lineSegmentsStartIndex,  segmentsInfo.lineSegmentsCount,
-                    segmentsInfo.curveSegmentsStartIndex, segmentsInfo.curveSegmentsCount};
-                vkCmdPushConstants(this->_commandBuffer, this->_segmentsPipelineLayout,
-                                   VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0,
-                                   sizeof(CharacterPushConstants), &pushConstants);
+    std::array<VkDescriptorSet, 2> sets = {this->_uboDescriptorSet, this->_segmentsDescriptorSets.at(this->_frameSlot)};
+    vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            this->_segmentsPipelineLayout, 0, sets.size(), sets.data(), 1, &this->_uboOffset);
+
+    VkBuffer vertexBuffers[] = {this->_vertexBuffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(this->_recordingCommandBuffer, 0, 1, vertexBuffers, offsets);
 
-                vkCmdDrawIndexed(this->_commandBuffer, this->_offsets.at(key).boundingBoxCount, 1,
-                                 this->_offsets.at(key).boundingBoxOffset, 0, 0);
+    // Draw line and curve segments
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_boundingBoxIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+    this->_updateDrawRecords();
+    for (const DrawRecordRange &range : this->_getVisibleDrawRecordRanges()) {
+        for (uint32_t i = range.first; i < range.first + range.count; i++) {
+            const DrawRecord &record = this->_drawRecords[i];
+            if (!this->_isCharacterDrawn(record)) {
+                continue;
             }
+
+            vkCmdPushConstants(this->_recordingCommandBuffer, this->_segmentsPipelineLayout,
+                               VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(CharacterPushConstants),
+                               &this->_drawInstances[record.instance]);
+            vkCmdDrawIndexed(this->_recordingCommandBuffer, record.indexCount, 1, record.firstIndex,
+                             record.vertexOffset, 0);
         }
     }
+
+    this->_endDrawCommands();
 }
 
 /**
  * @brief Creates a new vertex, index and ssbo buffer after a change in tracked text blocks
  */
 void VulkanWindingNumberTextRenderer::update() {
+    VFONT_PROFILE_ZONE("VulkanWindingNumberTextRenderer::update");
     WindingNumberTextRenderer::update();
+    this->_invalidateDrawRecords();
+
+    if (this->_gpuCulling) {
+        this->_createCullingBuffers();
+    }
 
     // Check if there are characters to render
     if (this->_vertices.size() == 0) {
@@ -125,22 +155,22 @@ void VulkanWindingNumberTextRenderer::update() {
 }
 
 /**
- * @brief Create vulkan descriptor pool
+ * @brief Create vulkan descriptor pool for the uniform buffer, segments and buffers used by gpu culling
  */
 void VulkanWindingNumberTextRenderer::_createDescriptorPool() {
     std::array<VkDescriptorPoolSize, 2> poolSizes = {};
 
-    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSizes[0].descriptorCount = static_cast<uint32_t>(1);
 
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSizes[1].descriptorCount = static_cast<uint32_t>(1);
+    poolSizes[1].descriptorCount = static_cast<uint32_t>(4 * MAX_FRAMES_IN_FLIGHT);
 
     VkDescriptorPoolCreateInfo poolCreateInfo{};
     poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolCreateInfo.poolSizeCount = poolSizes.size();
     poolCreateInfo.pPoolSizes = poolSizes.data();
-    poolCreateInfo.maxSets = static_cast<uint32_t>(2);
+    poolCreateInfo.maxSets = static_cast<uint32_t>(1 + 2 * MAX_FRAMES_IN_FLIGHT);
 
     if (vkCreateDescriptorPool(this->_logicalDevice, &poolCreateInfo, nullptr, &(this->_descriptorPool)) !=
         VK_SUCCESS) {
@@ -174,53 +204,105 @@ void VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSetLayout() {
 }
 
 /**
- * @brief Create vulkan ssbo descriptor set
+ * @brief Create vulkan ssbo descriptor sets, one for each frame in flight
  */
-void VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSet() {
+void VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSets() {
+    std::array<VkDescriptorSetLayout, MAX_FRAMES_IN_FLIGHT> layouts;
+    layouts.fill(this->_segmentsDescriptorSetLayout);
+
     VkDescriptorSetAllocateInfo allocateInfo{};
     allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocateInfo.descriptorPool = this->_descriptorPool;
-    allocateInfo.descriptorSetCount = 1;
-    allocateInfo.pSetLayouts = &this->_segmentsDescriptorSetLayout;
+    allocateInfo.descriptorSetCount = layouts.size();
+    allocateInfo.pSetLayouts = layouts.data();
 
-    if (vkAllocateDescriptorSets(this->_logicalDevice, &allocateInfo, &this->_segmentsDescriptorSet) != VK_SUCCESS) {
+    if (vkAllocateDescriptorSets(this->_logicalDevice, &allocateInfo, this->_segmentsDescriptorSets.data()) !=
+        VK_SUCCESS) {
         throw std::runtime_error(
-            "VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSet(): Error allocating vulkan descriptor sets");
+            "VulkanWindingNumberTextRenderer::_createSegmentsDescriptorSets(): Error allocating vulkan descriptor "
+            "sets");
     }
 }
 
 /**
- * @brief Create vulkan ssbo containing line and curve segments of all glyphs
+ * @brief Create vulkan ssbo containing quantized segments and horizontal bands of all glyphs. Descriptor sets are
+ * updated by draw() once the frames which used them have finished
  */
 void VulkanWindingNumberTextRenderer::_createSsbo() {
     VkDeviceSize segmentsBufferSize = sizeof(this->_segments.at(0)) * this->_segments.size();
     this->_stageAndCreateVulkanBuffer(this->_segments.data(), segmentsBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
                                       this->_segmentsBuffer, this->_segmentsBufferMemory);
 
-    VkDescriptorBufferInfo lineSegmentsBufferInfo{};
-    lineSegmentsBufferInfo.buffer = this->_segmentsBuffer;
-    lineSegmentsBufferInfo.offset = 0;
-    lineSegmentsBufferInfo.range = segmentsBufferSize;
+    this->_segmentsDescriptorSetsOutdated.fill(true);
+}
+
+/**
+ * @brief Points the ssbo descriptor set of a frame to the current segments buffer
+ *
+ * @param frameSlot Index of frame in flight whose descriptor set is updated
+ */
+void VulkanWindingNumberTextRenderer::_updateSegmentsDescriptorSet(uint32_t frameSlot) {
+    VkDescriptorBufferInfo segmentsBufferInfo{};
+    segmentsBufferInfo.buffer = this->_segmentsBuffer;
+    segmentsBufferInfo.offset = 0;
+    segmentsBufferInfo.range = VK_WHOLE_SIZE;
 
     std::array<VkWriteDescriptorSet, 1> writeDescriptorSets = {};
 
     writeDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    writeDescriptorSets[0].dstSet = this->_segmentsDescriptorSet;
+    writeDescriptorSets[0].dstSet = this->_segmentsDescriptorSets.at(frameSlot);
     writeDescriptorSets[0].dstBinding = 0;
     writeDescriptorSets[0].dstArrayElement = 0;
     writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     writeDescriptorSets[0].descriptorCount = 1;
-    writeDescriptorSets[0].pBufferInfo = &lineSegmentsBufferInfo;
+    writeDescriptorSets[0].pBufferInfo = &segmentsBufferInfo;
 
     vkUpdateDescriptorSets(this->_logicalDevice, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
+
+    this->_segmentsDescriptorSetsOutdated.at(frameSlot) = false;
 }
 
 /**
  * @brief Create vulkan pipeline for displaying glyph using the winding number algorithm
  */
 void VulkanWindingNumberTextRenderer::_createSegmentsPipeline() {
-    std::vector<char> vertexShaderCode = this->_readFile("shaders/winding_number-vert.spv");
-    std::vector<char> fragmentShaderCode = this->_readFile("shaders/winding_number-frag.spv");
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.size = sizeof(CharacterPushConstants);
+    pushConstantRange.offset = 0;
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts = {this->_uboDescriptorSetLayout,
+                                                                 this->_segmentsDescriptorSetLayout};
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = descriptorSetLayouts.size();
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
+    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+
+    if (vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr,
+                               &this->_segmentsPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanWindingNumberTextRenderer::_createSegmentsPipeline(): Error creating vulkan pipeline layout");
+    }
+
+    this->_createGraphicsPipeline("shaders/winding_number-vert.spv", this->_segmentsPipelineLayout,
+                                  this->_segmentsPipeline);
+}
+
+/**
+ * @brief Create vulkan graphics pipeline for displaying glyph using the winding number algorithm
+ *
+ * @param vertexShaderFile Name of compiled vertex shader
+ * @param pipelineLayout Vulkan pipeline layout
+ * @param pipeline Created vulkan pipeline
+ */
+void VulkanWindingNumberTextRenderer::_createGraphicsPipeline(const std::string &vertexShaderFile,
+                                                              VkPipelineLayout pipelineLayout,
+                                                              VkPipeline &pipeline) {
+    std::vector<char> vertexShaderCode = this->_readShader(vertexShaderFile);
+    std::vector<char> fragmentShaderCode = this->_readShader("shaders/winding_number-frag.spv");
 
     VkShaderModule vertexShaderModule = this->_createShaderModule(vertexShaderCode);
     VkShaderModule fragmentShaderModule = this->_createShaderModule(fragmentShaderCode);
@@ -306,27 +388,6 @@ void VulkanWindingNumberTextRenderer::_createSegmentsPipeline() {
     colorBlendStateCreateInfo.attachmentCount = 1;
     colorBlendStateCreateInfo.pAttachments = &colorBlendAttachmentState;
 
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.size = sizeof(CharacterPushConstants);
-    pushConstantRange.offset = 0;
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    std::array<VkDescriptorSetLayout, 2> descriptorSetLayouts = {this->_uboDescriptorSetLayout,
-                                                                 this->_segmentsDescriptorSetLayout};
-
-    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
-    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutCreateInfo.setLayoutCount = descriptorSetLayouts.size();
-    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
-    pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
-    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
-
-    if (vkCreatePipelineLayout(this->_logicalDevice, &pipelineLayoutCreateInfo, nullptr,
-                               &this->_segmentsPipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error(
-            "VulkanWindingNumberTextRenderer::_createSegmentsPipeline(): Error creating vulkan pipeline layout");
-    }
-
     VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
     graphicsPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     graphicsPipelineCreateInfo.stageCount = 2;
@@ -339,18 +400,151 @@ void VulkanWindingNumberTextRenderer::_createSegmentsPipeline() {
     graphicsPipelineCreateInfo.pDepthStencilState = nullptr;
     graphicsPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
     graphicsPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
-    graphicsPipelineCreateInfo.layout = this->_segmentsPipelineLayout;
+    graphicsPipelineCreateInfo.layout = pipelineLayout;
     graphicsPipelineCreateInfo.renderPass = this->_renderPass;
     graphicsPipelineCreateInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(this->_logicalDevice, nullptr, 1, &graphicsPipelineCreateInfo, nullptr,
-                                  &this->_segmentsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(this->_logicalDevice, this->_pipelineCache, 1, &graphicsPipelineCreateInfo,
+                                  nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error(
-            "VulkanWindingNumberTextRenderer::_createSegmentsPipeline(): Error creating vulkan graphics pipeline");
+            "VulkanWindingNumberTextRenderer::_createGraphicsPipeline(): Error creating vulkan graphics pipeline");
     }
 
     vkDestroyShaderModule(this->_logicalDevice, vertexShaderModule, nullptr);
     vkDestroyShaderModule(this->_logicalDevice, fragmentShaderModule, nullptr);
 }
 
+/**
+ * @brief Compiles a draw record and push constants for every character with a bounding box, so that drawing does not
+ * look up glyph offsets
+ */
+void VulkanWindingNumberTextRenderer::_compileDrawRecords() {
+    VFONT_PROFILE_ZONE("VulkanWindingNumberTextRenderer::_compileDrawRecords");
+    this->_drawInstances.clear();
+
+    uint32_t line = 0;
+    uint32_t characterOffset = 0;
+    for (const std::shared_ptr<TextBlock> &textBlock : this->_textBlocks) {
+        std::vector<Character> characters = textBlock->getCharacters();
+        for (const LineBoundingBox &lineBoundingBox : textBlock->getLineBoundingBoxes()) {
+            for (unsigned int i = lineBoundingBox.start; i < lineBoundingBox.start + lineBoundingBox.count; i++) {
+                const Character &character = characters[i];
+                GlyphKey key{TessellationStrategy::WINDING_NUMBER, character.getFont()->getFontFamily(),
+                             character.getGlyphId(), 0};
+                const GlyphInfo &glyphInfo = this->_offsets.at(key);
+
+                if (glyphInfo.boundingBoxCount > 0) {
+                    uint32_t instance = this->_drawInstances.size();
+                    this->_drawRecords.push_back(DrawRecord{this->_segmentsPipeline, nullptr,
+                                                            glyphInfo.boundingBoxCount, glyphInfo.boundingBoxOffset,
+                                                            0, instance, line, characterOffset + i});
+                    this->_drawInstances.push_back(CharacterPushConstants{
+                        character.getModelMatrix(), textBlock->getColor(), glyphInfo.segmentsStartIndex});
+                }
+            }
+
+            line++;
+        }
+
+        characterOffset += characters.size();
+    }
+}
+
+/**
+ * @brief Checks if the renderer can draw characters culled on the gpu
+ *
+ * @return True, characters are drawn by one indirect draw per glyph
+ */
+bool VulkanWindingNumberTextRenderer::_supportsGpuCulling() const {
+    return true;
+}
+
+/**
+ * @brief Creates the graphics pipeline reading model matrices, colors and segment offsets of visible characters from
+ * storage buffers
+ */
+void VulkanWindingNumberTextRenderer::_createCulledPipeline() {
+    std::array<VkDescriptorSetLayout, 3> setLayouts = {
+        this->_uboDescriptorSetLayout, this->_segmentsDescriptorSetLayout, this->_cullingDescriptorSetLayout};
+
+    VkPipelineLayoutCreateInfo culledPipelineLayoutCreateInfo{};
+    culledPipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    culledPipelineLayoutCreateInfo.setLayoutCount = setLayouts.size();
+    culledPipelineLayoutCreateInfo.pSetLayouts = setLayouts.data();
+
+    if (vkCreatePipelineLayout(this->_logicalDevice, &culledPipelineLayoutCreateInfo, nullptr,
+                               &this->_culledPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error(
+            "VulkanWindingNumberTextRenderer::_createCulledPipeline(): Error creating vulkan pipeline layout");
+    }
+
+    this->_createGraphicsPipeline("shaders/winding_number_culled-vert.spv", this->_culledPipelineLayout,
+                                  this->_culledPipeline);
+}
+
+/**
+ * @brief Collects all characters with a bounding box and one indirect draw command for each glyph, the start of
+ * glyph's segments is passed to the culled vertex shader as glyph data
+ *
+ * @param instances Characters of all tracked text blocks
+ * @param drawCommands Draw commands with the number of characters of glyph as instance count
+ */
+void VulkanWindingNumberTextRenderer::_collectCullingInstances(
+    std::vector<CullingInstance> &instances,
+    std::vector<VkDrawIndexedIndirectCommand> &drawCommands) {
+    std::unordered_map<GlyphKey, uint32_t, GlyphKeyHash> drawCommandIndices;
+
+    for (unsigned int i = 0; i < this->_textBlocks.size(); i++) {
+        for (const Character &character : this->_textBlocks[i]->getCharacters()) {
+            GlyphKey key{TessellationStrategy::WINDING_NUMBER, character.getFont()->getFontFamily(),
+                         character.getGlyphId(), 0};
+            const GlyphInfo &glyphInfo = this->_offsets.at(key);
+
+            if (glyphInfo.boundingBoxCount == 0) {
+                continue;
+            }
+
+            // Bounding box indices are already offset by the vertices of previous glyphs
+            auto [drawCommandIndex, inserted] = drawCommandIndices.try_emplace(key, drawCommands.size());
+            if (inserted) {
+                VkDrawIndexedIndirectCommand drawCommand{};
+                drawCommand.indexCount = glyphInfo.boundingBoxCount;
+                drawCommand.firstIndex = glyphInfo.boundingBoxOffset;
+                drawCommand.vertexOffset = 0;
+                drawCommands.push_back(drawCommand);
+            }
+
+            // Count characters of glyph to reserve space for its visible characters
+            drawCommands.at(drawCommandIndex->second).instanceCount++;
+
+            CullingInstance instance{};
+            instance.model = character.getModelMatrix();
+            instance.color = this->_textBlocks[i]->getColor();
+            instance.boundingBox = glyphInfo.boundingBox;
+            instance.drawCommandIndex = drawCommandIndex->second;
+            instance.glyphData = glyphInfo.segmentsStartIndex;
+            instances.push_back(instance);
+        }
+    }
+}
+
+/**
+ * @brief Add indirect draw commands for characters which passed gpu culling
+ */
+void VulkanWindingNumberTextRenderer::_drawCulled() {
+    vkCmdBindPipeline(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_culledPipeline);
+
+    std::array<VkDescriptorSet, 3> sets = {this->_uboDescriptorSet, this->_segmentsDescriptorSets.at(this->_frameSlot),
+                                           this->_cullingDescriptorSets.at(this->_frameSlot)};
+    vkCmdBindDescriptorSets(this->_recordingCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            this->_culledPipelineLayout, 0, sets.size(), sets.data(), 1, &this->_uboOffset);
+
+    VkBuffer vertexBuffers[] = {this->_vertexBuffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(this->_recordingCommandBuffer, 0, 1, vertexBuffers, offsets);
+    vkCmdBindIndexBuffer(this->_recordingCommandBuffer, this->_boundingBoxIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+    this->_drawCulledCommands();
+}
+
 }  // namespace vft
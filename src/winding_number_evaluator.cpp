@@ -0,0 +1,402 @@
+/**
+ * @file winding_number_evaluator.cpp
+ * @author Christian Saloň
+ */
+
+#include "winding_number_evaluator.h"
+
+namespace vft {
+
+/**
+ * @brief Computes winding number of position by testing the original outline segments of glyph, before curves were
+ * split into y-monotonic parts
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param position Position in font units
+ *
+ * @return Winding number
+ */
+float WindingNumberEvaluator::computeOutlineWindingNumber(const Glyph &glyph, glm::vec2 position) {
+    std::span<const glm::vec2> vertices = glyph.mesh.getVertices();
+    std::span<const uint32_t> lineIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
+    std::span<const uint32_t> curveIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_OUTLINE_CURVE_BUFFER_INDEX);
+
+    float windingNumber = 0;
+
+    for (unsigned int i = 0; i < lineIndices.size(); i += 2) {
+        windingNumber += WindingNumberEvaluator::_rayIntersectsOutlineLineSegment(position, vertices[lineIndices[i]],
+                                                                                  vertices[lineIndices[i + 1]]);
+    }
+
+    for (unsigned int i = 0; i < curveIndices.size(); i += 3) {
+        windingNumber += WindingNumberEvaluator::_rayIntersectsOutlineCurveSegment(
+            position, vertices[curveIndices[i]], vertices[curveIndices[i + 1]], vertices[curveIndices[i + 2]]);
+    }
+
+    return windingNumber;
+}
+
+/**
+ * @brief Computes winding number of position by testing all y-monotonic line and curve segments of glyph
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param position Position in font units
+ *
+ * @return Winding number
+ */
+float WindingNumberEvaluator::computeWindingNumber(const Glyph &glyph, glm::vec2 position) {
+    std::span<const glm::vec2> vertices = glyph.mesh.getVertices();
+    std::span<const uint32_t> lineIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
+    std::span<const uint32_t> curveIndices =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_CURVE_BUFFER_INDEX);
+
+    float windingNumber = 0;
+
+    for (unsigned int i = 0; i < lineIndices.size(); i += 2) {
+        windingNumber += WindingNumberEvaluator::rayIntersectsLineSegment(position, vertices[lineIndices[i]],
+                                                                          vertices[lineIndices[i + 1]]);
+    }
+
+    for (unsigned int i = 0; i < curveIndices.size(); i += 3) {
+        windingNumber += WindingNumberEvaluator::rayIntersectsCurveSegment(
+            position, vertices[curveIndices[i]], vertices[curveIndices[i + 1]], vertices[curveIndices[i + 2]]);
+    }
+
+    return windingNumber;
+}
+
+/**
+ * @brief Computes winding number of position by testing only segments in the horizontal band containing the position,
+ * same as the winding number fragment shader
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param position Position in font units
+ *
+ * @return Winding number
+ */
+float WindingNumberEvaluator::computeBandedWindingNumber(const Glyph &glyph, glm::vec2 position) {
+    std::span<const uint32_t> segments =
+        glyph.mesh.getIndices(WindingNumberTessellator::GLYPH_MESH_SEGMENTS_BUFFER_INDEX);
+
+    float windingNumber = 0;
+
+    uint32_t bandCount = segments[0] & ~WindingNumberTessellator::WIDE_ENTRIES_FLAG;
+    uint32_t entrySize = (segments[0] & WindingNumberTessellator::WIDE_ENTRIES_FLAG) ? 2 : 1;
+    if (bandCount == 0) {
+        return windingNumber;
+    }
+
+    // Transform position into space of quantized points
+    uint32_t pointsStart = segments[1];
+    glm::vec2 boundsMin{std::bit_cast<float>(segments[2]), std::bit_cast<float>(segments[3])};
+    glm::vec2 boundsSize{std::bit_cast<float>(segments[4]), std::bit_cast<float>(segments[5])};
+    position = (position - boundsMin) / boundsSize;
+
+    // Select band containing the position
+    int band = static_cast<int>(std::floor(position.y * bandCount));
+    band = std::clamp(band, 0, static_cast<int>(bandCount) - 1);
+
+    uint32_t entriesStart = segments[WindingNumberTessellator::SEGMENTS_HEADER_SIZE + 2 * band];
+    uint32_t entriesCount = segments[WindingNumberTessellator::SEGMENTS_HEADER_SIZE + 2 * band + 1];
+
+    for (uint32_t i = entriesStart; i < entriesStart + entriesCount * entrySize; i += entrySize) {
+        uint32_t startPointIndex = entrySize == 2 ? segments[i] : segments[i] & 0xffff;
+        uint32_t maxX = entrySize == 2 ? segments[i + 1] : segments[i] >> 16;
+
+        // Segments are sorted by max x, so all remaining segments are on the left of the position
+        if (WindingNumberEvaluator::_unpackUnorm16(maxX) < position.x) {
+            break;
+        }
+
+        uint32_t pointIndex = pointsStart + startPointIndex;
+        windingNumber += WindingNumberEvaluator::rayIntersectsCurveSegment(
+            position, WindingNumberEvaluator::_unpackPoint(segments[pointIndex]),
+            WindingNumberEvaluator::_unpackPoint(segments[pointIndex + 1]),
+            WindingNumberEvaluator::_unpackPoint(segments[pointIndex + 2]));
+    }
+
+    return windingNumber;
+}
+
+/**
+ * @brief Rasterizes glyph's bounding box into a coverage mask by evaluating the winding number at pixel centers
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param width Width of coverage mask in pixels
+ * @param height Height of coverage mask in pixels
+ * @param method Segments and algorithm used to compute the winding number
+ *
+ * @return Coverage mask, 255 for pixels inside of glyph and 0 for pixels outside, first row is the top of glyph
+ */
+std::vector<uint8_t> WindingNumberEvaluator::rasterize(const Glyph &glyph,
+                                                       unsigned int width,
+                                                       unsigned int height,
+                                                       WindingNumberMethod method) {
+    std::vector<uint8_t> mask(width * height, 0);
+
+    std::array<glm::vec2, 4> boundingBox = glyph.getBoundingBox();
+    glm::vec2 bottomLeft = boundingBox.at(0);
+    glm::vec2 size = boundingBox.at(2) - boundingBox.at(0);
+
+    for (unsigned int y = 0; y < height; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            glm::vec2 position{bottomLeft.x + (x + 0.5f) * size.x / width,
+                               bottomLeft.y + size.y - (y + 0.5f) * size.y / height};
+
+            float windingNumber = 0;
+            switch (method) {
+                case WindingNumberMethod::OUTLINE:
+                    windingNumber = WindingNumberEvaluator::computeOutlineWindingNumber(glyph, position);
+                    break;
+                case WindingNumberMethod::SEGMENTS:
+                    windingNumber = WindingNumberEvaluator::computeWindingNumber(glyph, position);
+                    break;
+                case WindingNumberMethod::BANDS:
+                    windingNumber = WindingNumberEvaluator::computeBandedWindingNumber(glyph, position);
+                    break;
+            }
+
+            if (windingNumber != 0) {
+                mask.at(y * width + x) = 255;
+            }
+        }
+    }
+
+    return mask;
+}
+
+/**
+ * @brief Computes winding of line segment for ray cast from position to the right. Segments are crossed on a
+ * half-open interval in y, so endpoints shared by consecutive segments are counted once
+ *
+ * @param position Origin of ray
+ * @param start Start of line segment
+ * @param end End of line segment
+ *
+ * @return Winding of line segment
+ */
+float WindingNumberEvaluator::rayIntersectsLineSegment(glm::vec2 position, glm::vec2 start, glm::vec2 end) {
+    // Check if ray crosses line segment, horizontal line segments are never crossed
+    if ((start.y <= position.y) == (end.y <= position.y)) {
+        return 0.f;
+    }
+
+    // Check if intersection is to the right of ray
+    float xIntersection = start.x + (position.y - start.y) * (end.x - start.x) / (end.y - start.y);
+    return xIntersection > position.x ? (end.y > start.y ? 1.f : -1.f) : 0.f;
+}
+
+/**
+ * @brief Computes winding of y-monotonic quadratic bezier curve segment for ray cast from position to the right.
+ * Segments are crossed on a half-open interval in y, so endpoints shared by consecutive segments are counted once
+ *
+ * @param position Origin of ray
+ * @param start Start of curve segment
+ * @param control Control point of curve segment
+ * @param end End of curve segment
+ *
+ * @return Winding of curve segment
+ */
+float WindingNumberEvaluator::rayIntersectsCurveSegment(glm::vec2 position,
+                                                        glm::vec2 start,
+                                                        glm::vec2 control,
+                                                        glm::vec2 end) {
+    // Check if ray crosses curve segment
+    if ((start.y <= position.y) == (end.y <= position.y)) {
+        return 0.f;
+    }
+
+    // Quadratic formula coefficients
+    float direction = end.y > start.y ? 1.f : -1.f;
+    float a = start.y - 2 * control.y + end.y;
+    float b = 2 * (control.y - start.y);
+    float c = start.y - position.y;
+
+    // Single root in range [0, 1] given by the numerically stable form of the quadratic formula
+    float t = -2 * direction * c / std::max(std::abs(b) + std::sqrt(std::max(b * b - 4 * a * c, 0.f)), 1e-20f);
+    t = std::clamp(t, 0.f, 1.f);
+
+    // Check if intersection is to the right of ray
+    float xIntersection = (1 - t) * (1 - t) * start.x + 2 * (1 - t) * t * control.x + t * t * end.x;
+    return xIntersection > position.x ? direction : 0.f;
+}
+
+/**
+ * @brief Computes winding of outline line segment for ray cast from position to the right, intersections with
+ * endpoints count as half of winding
+ *
+ * @param position Origin of ray
+ * @param start Start of line segment
+ * @param end End of line segment
+ *
+ * @return Winding of line segment
+ */
+float WindingNumberEvaluator::_rayIntersectsOutlineLineSegment(glm::vec2 position, glm::vec2 start, glm::vec2 end) {
+    // Check if ray and line segment are parallel
+    if (start.y == end.y) {
+        return 0.f;
+    }
+
+    glm::vec2 directionVector = end - start;
+    float directionConstant = directionVector.y > 0 ? 1.f : -1.f;
+
+    // Intersection is at line's start or end point, return winding of 0.5 or -0.5 based on direction vector
+    if (position.y == start.y) {
+        return position.x > start.x ? 0.f : directionConstant / 2;
+    }
+    if (position.y == end.y) {
+        return position.x > end.x ? 0.f : directionConstant / 2;
+    }
+
+    // Ensure line's start point is below end point
+    if (start.y > end.y) {
+        std::swap(start, end);
+    }
+
+    // Ray is above or below line
+    if (position.y < start.y || position.y > end.y) {
+        return 0.f;
+    }
+
+    // Check if intersection is to the right of ray
+    float xIntersection = start.x + (position.y - start.y) * (end.x - start.x) / (end.y - start.y);
+    if (std::abs(position.x - xIntersection) <= 0.1) {
+        return 0.f;
+    } else if (xIntersection > position.x) {
+        return directionConstant;
+    }
+
+    return 0.f;
+}
+
+/**
+ * @brief Computes winding of outline quadratic bezier curve segment for ray cast from position to the right by
+ * solving for both roots
+ *
+ * @param position Origin of ray
+ * @param start Start of curve segment
+ * @param control Control point of curve segment
+ * @param end End of curve segment
+ *
+ * @return Winding of curve segment
+ */
+float WindingNumberEvaluator::_rayIntersectsOutlineCurveSegment(glm::vec2 position,
+                                                                glm::vec2 start,
+                                                                glm::vec2 control,
+                                                                glm::vec2 end) {
+    float winding = 0.f;
+
+    // Check if ray is above or below curve
+    if ((position.y < start.y && position.y < control.y && position.y < end.y) ||
+        (position.y > start.y && position.y > control.y && position.y > end.y)) {
+        return winding;
+    }
+
+    // Quadratic formula coefficients
+    double a = start.y - 2 * control.y + end.y;
+    double b = 2 * (control.y - start.y);
+    double c = start.y - position.y;
+
+    // Curve is actually a line
+    if (a == 0) {
+        return WindingNumberEvaluator::_rayIntersectsOutlineLineSegment(position, start, end);
+    }
+
+    // Quadratic formula roots
+    double sqrtD = std::sqrt(b * b - 4 * a * c);
+    double t0 = (-b + sqrtD) / (2 * a);
+    double t1 = (-b - sqrtD) / (2 * a);
+
+    // Compute winding for roots
+    winding += WindingNumberEvaluator::_getWindingForQuadraticRoot(t0, position, start, control, end, a, b);
+    winding += WindingNumberEvaluator::_getWindingForQuadraticRoot(t1, position, start, control, end, a, b);
+
+    return winding;
+}
+
+/**
+ * @brief Get direction of quadratic bezier curve at parameter t
+ *
+ * @param t Curve parameter
+ * @param a Quadratic coefficient
+ * @param b Linear coefficient
+ *
+ * @return 1 if curve is pointing up, -1 if pointing down, otherwise 0
+ */
+float WindingNumberEvaluator::_getQuadraticDerivativeWinding(double t, double a, double b) {
+    double d = 2 * a * t + b;
+
+    if (d > 0) {
+        return 1;
+    } else if (d < 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Computes winding of one root of the quadratic equation of curve and ray
+ *
+ * @param t Root of the quadratic equation
+ * @param position Origin of ray
+ * @param start Start of curve segment
+ * @param control Control point of curve segment
+ * @param end End of curve segment
+ * @param a Quadratic coefficient
+ * @param b Linear coefficient
+ *
+ * @return Winding of root
+ */
+float WindingNumberEvaluator::_getWindingForQuadraticRoot(double t,
+                                                          glm::vec2 position,
+                                                          glm::vec2 start,
+                                                          glm::vec2 control,
+                                                          glm::vec2 end,
+                                                          double a,
+                                                          double b) {
+    // X coordinate of intersection
+    double xIntersection = (1 - t) * (1 - t) * start.x + 2 * (1 - t) * t * control.x + t * t * end.x;
+
+    // Check if intersection is on curve start or end points
+    if (position.y == start.y && xIntersection >= position.x && t >= -0.1 && t <= 0.1) {
+        return WindingNumberEvaluator::_getQuadraticDerivativeWinding(0, a, b) / 2;
+    } else if (position.y == end.y && xIntersection >= position.x && t >= 0.9 && t <= 1.1) {
+        return WindingNumberEvaluator::_getQuadraticDerivativeWinding(1, a, b) / 2;
+    }
+
+    // Check if root is in range (0, 1) and intersection is on the right from ray
+    if (t > 0 && t < 1 && xIntersection >= position.x) {
+        return WindingNumberEvaluator::_getQuadraticDerivativeWinding(t, a, b);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Converts 16-bit unsigned normalized integer to float, same as unpackUnorm2x16 in glsl
+ *
+ * @param value Quantized value stored in the low 16 bits
+ *
+ * @return Value in range [0, 1]
+ */
+float WindingNumberEvaluator::_unpackUnorm16(uint32_t value) {
+    return static_cast<float>(value & 0xffff) / WindingNumberTessellator::QUANTIZATION_SCALE;
+}
+
+/**
+ * @brief Converts quantized point from the segments buffer to normalized coordinates
+ *
+ * @param point X in the low 16 bits and y in the high 16 bits
+ *
+ * @return Point with coordinates in range [0, 1]
+ */
+glm::vec2 WindingNumberEvaluator::_unpackPoint(uint32_t point) {
+    return glm::vec2{WindingNumberEvaluator::_unpackUnorm16(point),
+                     WindingNumberEvaluator::_unpackUnorm16(point >> 16)};
+}
+
+}  // namespace vft
@@ -18,14 +18,30 @@ WindingNumberTessellator::WindingNumberTessellator() {}
  * @param glyphId Id of glyph to compose
  * @param font Font of glyph
  * @param fontSize Font size of glyph
+ *
+ * @return Composed glyph
  */
-Glyph WindingNumberTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<vft::Font> font, unsigned int fontSize) {
-    GlyphKey key{font->getFontFamily(), glyphId, 0};
-    Glyph glyph = this->_composeGlyph(glyphId, font);
+std::shared_ptr<const Glyph> WindingNumberTessellator::composeGlyph(uint32_t glyphId,
+                                                                    std::shared_ptr<vft::Font> font,
+                                                                    unsigned int fontSize) {
+    VFONT_PROFILE_ZONE("WindingNumberTessellator::composeGlyph");
+    VFONT_PROFILE_COUNTER("glyphs composed", 1);
+
+    this->_composeGlyph(glyphId, font);
 
-    std::vector<glm::vec2> vertices = glyph.mesh.getVertices();
-    std::vector<Edge> lineSegments = glyph.getLineSegmentsIndices();
-    std::vector<Curve> curveSegments = glyph.getCurveSegmentsIndices();
+    // Curves split at extrema and the bounding box add vertices to the outline vertices
+    std::vector<glm::vec2> &vertices = this->_vertices;
+
+    // Create curve segments index buffer with curves split into y-monotonic parts and with the original curves
+    std::vector<uint32_t> curveIndices;
+    std::vector<uint32_t> outlineCurveIndices;
+    for (Curve curve : this->_curveSegments) {
+        this->_splitCurveAtExtremum(curve, vertices, curveIndices);
+
+        outlineCurveIndices.push_back(curve.start);
+        outlineCurveIndices.push_back(curve.control);
+        outlineCurveIndices.push_back(curve.end);
+    }
 
     // Create bounding box indices that form two triangles
     uint32_t newVertexIndex = vertices.size();
@@ -33,7 +49,7 @@ Glyph WindingNumberTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<v
                                                 newVertexIndex + 2, newVertexIndex + 1, newVertexIndex + 3};
 
     // Add bounding box vertices to vertex buffer if neccessary
-    std::array<glm::vec2, 4> boundingBoxVertices = glyph.getBoundingBox();
+    std::array<glm::vec2, 4> boundingBoxVertices = this->_currentGlyph.getBoundingBox();
     for (glm::vec2 vertex : boundingBoxVertices) {
         vertices.push_back(vertex);
         newVertexIndex++;
@@ -41,23 +57,250 @@ Glyph WindingNumberTessellator::composeGlyph(uint32_t glyphId, std::shared_ptr<v
 
     // Create line segments index buffer
     std::vector<uint32_t> lineIndices;
-    for (Edge edge : lineSegments) {
+    for (Edge edge : this->_lineSegments) {
         lineIndices.push_back(edge.first);
         lineIndices.push_back(edge.second);
     }
 
-    // Create curve segments index buffer
-    std::vector<uint32_t> curveIndices;
-    for (Curve curve : curveSegments) {
-        curveIndices.push_back(curve.start);
-        curveIndices.push_back(curve.control);
-        curveIndices.push_back(curve.end);
+    // Create quantized segments split into horizontal bands
+    std::vector<uint32_t> segments = this->_createSegmentsBuffer(vertices, lineIndices, curveIndices);
+
+    this->_currentGlyph.mesh =
+        GlyphMesh{vertices, {boundingBoxIndices, curveIndices, lineIndices, segments, outlineCurveIndices}};
+
+    return this->_releaseGlyph();
+}
+
+/**
+ * @brief Splits quadratic bezier curve at its extremum in y, so that both parts are monotonic in y. A monotonic curve
+ * intersects a horizontal ray at most once, which lets the fragment shader compute a single root.
+ *
+ * @param curve Curve to split
+ * @param vertices Glyph's vertex buffer, new vertices created by the split are added to it
+ * @param curveIndices Curve segments index buffer where the resulting curves are added
+ */
+void WindingNumberTessellator::_splitCurveAtExtremum(Curve curve,
+                                                     std::vector<glm::vec2> &vertices,
+                                                     std::vector<uint32_t> &curveIndices) {
+    glm::vec2 start = vertices.at(curve.start);
+    glm::vec2 control = vertices.at(curve.control);
+    glm::vec2 end = vertices.at(curve.end);
+
+    // Parameter of the extremum, where the derivative in y is zero
+    float denominator = start.y - 2 * control.y + end.y;
+    float t = denominator != 0 ? (start.y - control.y) / denominator : 0;
+
+    // Curve is already monotonic
+    if (t <= 0 || t >= 1) {
+        curveIndices.insert(curveIndices.end(), {curve.start, curve.control, curve.end});
+        return;
     }
 
-    GlyphMesh mesh{vertices, {boundingBoxIndices, curveIndices, lineIndices}};
-    glyph.mesh = mesh;
+    // Split curve using de Casteljau's algorithm, tangent at the extremum is horizontal so the new control points
+    // share y with the split point
+    glm::vec2 firstControl = start + t * (control - start);
+    glm::vec2 secondControl = control + t * (end - control);
+    glm::vec2 middle = firstControl + t * (secondControl - firstControl);
+    firstControl.y = middle.y;
+    secondControl.y = middle.y;
+
+    uint32_t firstControlIndex = vertices.size();
+    uint32_t middleIndex = firstControlIndex + 1;
+    uint32_t secondControlIndex = firstControlIndex + 2;
+    vertices.insert(vertices.end(), {firstControl, middle, secondControl});
+
+    curveIndices.insert(curveIndices.end(),
+                        {curve.start, firstControlIndex, middleIndex, middleIndex, secondControlIndex, curve.end});
+}
+
+/**
+ * @brief Creates a compact buffer of glyph's segments split into horizontal bands, which is read by the winding number
+ * fragment shader.
+ *
+ * All segments are stored as quadratic bezier curves, line segments use the midpoint as their control point. Points
+ * are quantized to 16-bit unsigned normalized integers relative to the bounds of all segments and consecutive segments
+ * of a contour share their endpoints. Each band lists only segments that overlap it in y, sorted by their max x in
+ * descending order, so a ray cast to the right can stop at the first segment left of it.
+ *
+ * Layout of the returned buffer (floats are stored as their bit representation):
+ * - header: band count, offset of points, min x, min y, width and height of bounds of all segments
+ * - band ranges: offset and count of entries for each band
+ * - entries: index of segment's start point in the low 16 bits and max x of segment in the high 16 bits
+ * - points: x in the low 16 bits and y in the high 16 bits
+ *
+ * Glyphs with more points than fit into 16 bits store each entry as two values, index of start point and max x, and
+ * set WIDE_ENTRIES_FLAG in the band count.
+ *
+ * Offsets are relative to the start of the buffer and point indices are relative to the offset of points.
+ *
+ * @param vertices Glyph's vertex buffer
+ * @param lineIndices Line segments index buffer
+ * @param curveIndices Y-monotonic curve segments index buffer
+ *
+ * @return Buffer containing quantized segments and horizontal bands
+ */
+std::vector<uint32_t> WindingNumberTessellator::_createSegmentsBuffer(const std::vector<glm::vec2> &vertices,
+                                                                      const std::vector<uint32_t> &lineIndices,
+                                                                      const std::vector<uint32_t> &curveIndices) {
+    struct Segment {
+        uint32_t start;
+        uint32_t control;
+        uint32_t end;
+    };
+
+    // Collect line and curve segments, line segments have no control point
+    std::vector<Segment> segments;
+    for (unsigned int i = 0; i < lineIndices.size(); i += 2) {
+        segments.push_back(Segment{lineIndices.at(i), NO_CONTROL_POINT, lineIndices.at(i + 1)});
+    }
+    for (unsigned int i = 0; i < curveIndices.size(); i += 3) {
+        segments.push_back(Segment{curveIndices.at(i), curveIndices.at(i + 1), curveIndices.at(i + 2)});
+    }
+
+    // Glyph without segments has no bands
+    if (segments.size() == 0) {
+        return std::vector<uint32_t>(SEGMENTS_HEADER_SIZE, 0);
+    }
+
+    // Compute bounds of all segments
+    glm::vec2 boundsMin = vertices.at(segments.at(0).start);
+    glm::vec2 boundsMax = boundsMin;
+    for (const Segment &segment : segments) {
+        for (uint32_t index : {segment.start, segment.control, segment.end}) {
+            if (index != NO_CONTROL_POINT) {
+                boundsMin = glm::min(boundsMin, vertices.at(index));
+                boundsMax = glm::max(boundsMax, vertices.at(index));
+            }
+        }
+    }
+    glm::vec2 boundsSize = glm::max(boundsMax - boundsMin, glm::vec2{1.f, 1.f});
+
+    auto quantize = [&vertices, boundsMin, boundsSize](uint32_t index) {
+        glm::vec2 normalized = (vertices.at(index) - boundsMin) / boundsSize;
+        return glm::uvec2{glm::round(glm::clamp(normalized, 0.f, 1.f) * static_cast<float>(QUANTIZATION_SCALE))};
+    };
+
+    // Order segments into chains where each segment starts at the end of the previous one
+    std::unordered_multimap<uint32_t, uint32_t> segmentsByStart;
+    for (uint32_t i = 0; i < segments.size(); i++) {
+        segmentsByStart.insert({segments.at(i).start, i});
+    }
+
+    std::vector<glm::uvec2> points;
+    std::vector<uint32_t> startPointIndices(segments.size());
+    std::vector<bool> visited(segments.size(), false);
+
+    for (uint32_t i = 0; i < segments.size(); i++) {
+        uint32_t current = i;
+        bool continuesChain = false;
+
+        while (!visited.at(current)) {
+            visited.at(current) = true;
+            const Segment &segment = segments.at(current);
+
+            // Start point is shared with the end point of previous segment in chain
+            if (!continuesChain) {
+                points.push_back(quantize(segment.start));
+            }
+            startPointIndices.at(current) = points.size() - 1;
+
+            glm::uvec2 start = points.back();
+            glm::uvec2 end = quantize(segment.end);
+            points.push_back(segment.control == NO_CONTROL_POINT ? (start + end + glm::uvec2{1, 1}) / 2u
+                                                                 : quantize(segment.control));
+            points.push_back(end);
+
+            // Find next unvisited segment in chain
+            auto [first, last] = segmentsByStart.equal_range(segment.end);
+            auto next = std::find_if(first, last, [&visited](const auto &pair) { return !visited.at(pair.second); });
+            if (next == last) {
+                break;
+            }
+
+            current = next->second;
+            continuesChain = true;
+        }
+    }
+
+    bool wideEntries = points.size() > MAX_PACKED_POINT_COUNT;
+    uint32_t entrySize = wideEntries ? 2 : 1;
+
+    // Compute quantized bounds of segments
+    struct SegmentBounds {
+        uint32_t minY;
+        uint32_t maxY;
+        uint32_t maxX;
+    };
+
+    std::vector<SegmentBounds> segmentBounds;
+    for (uint32_t startPointIndex : startPointIndices) {
+        glm::uvec2 start = points.at(startPointIndex);
+        glm::uvec2 control = points.at(startPointIndex + 1);
+        glm::uvec2 end = points.at(startPointIndex + 2);
+
+        segmentBounds.push_back(SegmentBounds{std::min({start.y, control.y, end.y}),
+                                              std::max({start.y, control.y, end.y}),
+                                              std::max({start.x, control.x, end.x})});
+    }
+
+    // Assign segments to all bands they overlap
+    uint32_t bandCount =
+        std::clamp(static_cast<unsigned int>(segments.size()) / SEGMENTS_PER_BAND, 1u, MAX_BAND_COUNT);
+    float bandScale = static_cast<float>(bandCount) / QUANTIZATION_SCALE;
+
+    std::vector<std::vector<uint32_t>> bands(bandCount);
+    for (uint32_t i = 0; i < segmentBounds.size(); i++) {
+        int firstBand = static_cast<int>(std::floor(segmentBounds.at(i).minY * bandScale - BAND_EPSILON));
+        int lastBand = static_cast<int>(std::floor(segmentBounds.at(i).maxY * bandScale + BAND_EPSILON));
+
+        firstBand = std::clamp(firstBand, 0, static_cast<int>(bandCount) - 1);
+        lastBand = std::clamp(lastBand, 0, static_cast<int>(bandCount) - 1);
+
+        for (int j = firstBand; j <= lastBand; j++) {
+            bands.at(j).push_back(i);
+        }
+    }
+
+    // Sort segments in bands by max x in descending order
+    for (std::vector<uint32_t> &band : bands) {
+        std::sort(band.begin(), band.end(), [&segmentBounds](uint32_t first, uint32_t second) {
+            return segmentBounds.at(first).maxX > segmentBounds.at(second).maxX;
+        });
+    }
+
+    // Create segments buffer
+    std::vector<uint32_t> segmentsBuffer = {wideEntries ? bandCount | WIDE_ENTRIES_FLAG : bandCount,
+                                            0,
+                                            std::bit_cast<uint32_t>(boundsMin.x),
+                                            std::bit_cast<uint32_t>(boundsMin.y),
+                                            std::bit_cast<uint32_t>(boundsSize.x),
+                                            std::bit_cast<uint32_t>(boundsSize.y)};
+
+    uint32_t entriesOffset = SEGMENTS_HEADER_SIZE + 2 * bandCount;
+    for (const std::vector<uint32_t> &band : bands) {
+        segmentsBuffer.push_back(entriesOffset);
+        segmentsBuffer.push_back(band.size());
+        entriesOffset += band.size() * entrySize;
+    }
+
+    for (const std::vector<uint32_t> &band : bands) {
+        for (uint32_t segmentIndex : band) {
+            if (wideEntries) {
+                segmentsBuffer.push_back(startPointIndices.at(segmentIndex));
+                segmentsBuffer.push_back(segmentBounds.at(segmentIndex).maxX);
+            } else {
+                segmentsBuffer.push_back(startPointIndices.at(segmentIndex) |
+                                         (segmentBounds.at(segmentIndex).maxX << 16));
+            }
+        }
+    }
+
+    segmentsBuffer.at(1) = segmentsBuffer.size();
+    for (glm::uvec2 point : points) {
+        segmentsBuffer.push_back(point.x | (point.y << 16));
+    }
 
-    return glyph;
+    return segmentsBuffer;
 }
 
 }  // namespace vft
@@ -0,0 +1,860 @@
+﻿/**
+ * @file main.cpp
+ * @author Christian Saloň
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <VFONT/bc4_encoder.h>
+#include <VFONT/font.h>
+#include <VFONT/font_atlas.h>
+#include <VFONT/glyph_cache.h>
+#include <VFONT/sdf_generator.h>
+#include <VFONT/tessellation_shaders_tessellator.h>
+#include <VFONT/triangulation_tessellator.h>
+#include <VFONT/winding_number_evaluator.h>
+#include <VFONT/winding_number_tessellator.h>
+
+/** Number of heap allocations made by tests, counted by the replaced global operator new */
+std::atomic<unsigned long> allocationCount{0};
+/** Number of heap allocations which were not freed yet */
+std::atomic<long> liveAllocationCount{0};
+/** Size in bytes of heap allocations counted in bufferAllocationCount, set to the size of a glyph buffer */
+std::atomic<std::size_t> bufferSize{0};
+/** Number of heap allocations of bufferSize bytes */
+std::atomic<unsigned long> bufferAllocationCount{0};
+
+void *operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == bufferSize.load(std::memory_order_relaxed)) {
+        bufferAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        liveAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        return pointer;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *pointer) noexcept {
+    if (pointer != nullptr) {
+        liveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t size) noexcept {
+    if (pointer != nullptr) {
+        liveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    std::free(pointer);
+}
+
+/**
+ * @brief Font atlas exposing the header of font atlas files, so tests can corrupt its fields
+ */
+class FontAtlasFile : public vft::FontAtlas {
+public:
+    using vft::FontAtlas::FileHeader;
+};
+
+/**
+ * @brief Checks whether an edge of glyph is within given distance of position, approximations of the outline moving
+ * edges by at most this distance can classify only such positions differently
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param position Position in font units
+ * @param distance Distance in font units along each axis
+ *
+ * @return True if winding number of all y-monotonic segments changes within distance of position
+ */
+bool isNearEdge(const vft::Glyph &glyph, glm::vec2 position, glm::vec2 distance) {
+    bool inside = vft::WindingNumberEvaluator::computeWindingNumber(glyph, position) != 0;
+    for (float y = -1.f; y <= 1.f; y++) {
+        for (float x = -1.f; x <= 1.f; x++) {
+            glm::vec2 neighbour = position + glm::vec2{x, y} * distance;
+            if ((vft::WindingNumberEvaluator::computeWindingNumber(glyph, neighbour) != 0) != inside) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Compares coverage masks of printable ascii glyphs using all y-monotonic segments with masks using quantized
+ * horizontal bands, which must match except for pixels within one quantization step of a glyph edge. Quantization
+ * moves points of segments in horizontal bands by at most one step
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if coverage masks using all y-monotonic segments and quantized horizontal bands match
+ */
+bool testWindingNumberBands(std::string fontFile) {
+    constexpr unsigned int resolution = 128;
+
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    vft::WindingNumberTessellator tessellator{};
+
+    unsigned long mismatches = 0;
+    unsigned long edgeMismatches = 0;
+    for (uint32_t codePoint = 0x21; codePoint < 0x7f; codePoint++) {
+        uint32_t glyphId = FT_Get_Char_Index(font->getFace(), codePoint);
+        std::shared_ptr<const vft::Glyph> glyph = tessellator.composeGlyph(glyphId, font);
+
+        std::span<const uint32_t> segments =
+            glyph->mesh.getIndices(vft::WindingNumberTessellator::GLYPH_MESH_SEGMENTS_BUFFER_INDEX);
+        glm::vec2 step = glm::vec2{std::bit_cast<float>(segments[4]), std::bit_cast<float>(segments[5])} /
+                         static_cast<float>(vft::WindingNumberTessellator::QUANTIZATION_SCALE);
+
+        std::vector<uint8_t> segmentsMask = vft::WindingNumberEvaluator::rasterize(
+            *glyph, resolution, resolution, vft::WindingNumberMethod::SEGMENTS);
+        std::vector<uint8_t> bandsMask =
+            vft::WindingNumberEvaluator::rasterize(*glyph, resolution, resolution, vft::WindingNumberMethod::BANDS);
+
+        std::array<glm::vec2, 4> boundingBox = glyph->getBoundingBox();
+        glm::vec2 size = boundingBox.at(2) - boundingBox.at(0);
+        for (unsigned int i = 0; i < resolution * resolution; i++) {
+            if (segmentsMask[i] == bandsMask[i]) {
+                continue;
+            }
+
+            // Same pixel position as in WindingNumberEvaluator::rasterize()
+            glm::vec2 position{boundingBox.at(0).x + (i % resolution + 0.5f) * size.x / resolution,
+                               boundingBox.at(0).y + size.y - (i / resolution + 0.5f) * size.y / resolution};
+            if (isNearEdge(*glyph, position, step)) {
+                edgeMismatches++;
+            } else {
+                mismatches++;
+            }
+        }
+    }
+
+    std::cout << "Pixels differing between all segments and horizontal bands: " << mismatches << std::endl;
+    std::cout << "Pixels within one quantization step of an edge differing between all segments and horizontal bands: "
+              << edgeMismatches << std::endl;
+
+    return mismatches == 0;
+}
+
+/**
+ * @brief Rasterizes coverage mask of the original outline of glyph with curves flattened into line segments. Mask does
+ * not depend on the way the tessellator splits curves and its pixels are at the same positions as in
+ * WindingNumberEvaluator::rasterize()
+ *
+ * @param glyph Glyph composed by the winding number tessellator
+ * @param resolution Width and height of mask
+ * @param tolerance Maximum distance in font units of flattened curves from the original curves
+ *
+ * @return Coverage mask, 255 for pixels inside of glyph
+ */
+std::vector<uint8_t> rasterizeFlattenedOutline(const vft::Glyph &glyph, unsigned int resolution, float tolerance) {
+    std::span<const glm::vec2> vertices = glyph.mesh.getVertices();
+    std::span<const uint32_t> lineIndices =
+        glyph.mesh.getIndices(vft::WindingNumberTessellator::GLYPH_MESH_LINE_BUFFER_INDEX);
+    std::span<const uint32_t> curveIndices =
+        glyph.mesh.getIndices(vft::WindingNumberTessellator::GLYPH_MESH_OUTLINE_CURVE_BUFFER_INDEX);
+
+    std::vector<std::array<glm::vec2, 2>> lines;
+    for (unsigned int i = 0; i < lineIndices.size(); i += 2) {
+        lines.push_back({vertices[lineIndices[i]], vertices[lineIndices[i + 1]]});
+    }
+
+    // Uniformly subdivided quadratic curve deviates from its chords by at most |p0 - 2 * p1 + p2| / (4 * n^2)
+    for (unsigned int i = 0; i < curveIndices.size(); i += 3) {
+        glm::vec2 start = vertices[curveIndices[i]];
+        glm::vec2 control = vertices[curveIndices[i + 1]];
+        glm::vec2 end = vertices[curveIndices[i + 2]];
+
+        float curvature = glm::length(start - 2.f * control + end);
+        unsigned int count = std::max(1u, static_cast<unsigned int>(std::ceil(std::sqrt(curvature / (4 * tolerance)))));
+
+        glm::vec2 previous = start;
+        for (unsigned int j = 1; j <= count; j++) {
+            float t = static_cast<float>(j) / count;
+            glm::vec2 current = j == count ? end : (1 - t) * (1 - t) * start + 2 * t * (1 - t) * control + t * t * end;
+            lines.push_back({previous, current});
+            previous = current;
+        }
+    }
+
+    std::vector<uint8_t> mask(resolution * resolution, 0);
+
+    std::array<glm::vec2, 4> boundingBox = glyph.getBoundingBox();
+    glm::vec2 bottomLeft = boundingBox.at(0);
+    glm::vec2 size = boundingBox.at(2) - boundingBox.at(0);
+
+    // Every row is crossed by lines on a half-open interval in y once, pixels sum windings of crossings on their right
+    std::vector<std::pair<float, int>> crossings;
+    for (unsigned int y = 0; y < resolution; y++) {
+        float positionY = bottomLeft.y + size.y - (y + 0.5f) * size.y / resolution;
+
+        crossings.clear();
+        for (const auto &[start, end] : lines) {
+            if ((start.y <= positionY) != (end.y <= positionY)) {
+                float crossingX = start.x + (positionY - start.y) * (end.x - start.x) / (end.y - start.y);
+                crossings.push_back({crossingX, end.y > start.y ? 1 : -1});
+            }
+        }
+
+        for (unsigned int x = 0; x < resolution; x++) {
+            float positionX = bottomLeft.x + (x + 0.5f) * size.x / resolution;
+
+            int windingNumber = 0;
+            for (const auto &[crossingX, winding] : crossings) {
+                if (crossingX > positionX) {
+                    windingNumber += winding;
+                }
+            }
+
+            if (windingNumber != 0) {
+                mask.at(y * resolution + x) = 255;
+            }
+        }
+    }
+
+    return mask;
+}
+
+/**
+ * @brief Compares coverage masks of printable ascii glyphs using y-monotonic segments, each solved for a single root,
+ * with masks of the original outline with flattened curves, which must match except for pixels within flattening
+ * tolerance of a glyph edge
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if coverage masks using y-monotonic segments match masks of the flattened outline
+ */
+bool testWindingNumberMonotonicCurves(std::string fontFile) {
+    constexpr unsigned int resolution = 128;
+    constexpr float tolerance = 0.01f;
+
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    vft::WindingNumberTessellator tessellator{};
+
+    unsigned long segmentsMismatches = 0;
+
+    for (uint32_t codePoint = 0x21; codePoint < 0x7f; codePoint++) {
+        uint32_t glyphId = FT_Get_Char_Index(font->getFace(), codePoint);
+        std::shared_ptr<const vft::Glyph> glyph = tessellator.composeGlyph(glyphId, font);
+
+        std::vector<uint8_t> segmentsMask = vft::WindingNumberEvaluator::rasterize(
+            *glyph, resolution, resolution, vft::WindingNumberMethod::SEGMENTS);
+        std::vector<uint8_t> referenceMask = rasterizeFlattenedOutline(*glyph, resolution, tolerance);
+
+        std::array<glm::vec2, 4> boundingBox = glyph->getBoundingBox();
+        glm::vec2 size = boundingBox.at(2) - boundingBox.at(0);
+        for (unsigned int i = 0; i < resolution * resolution; i++) {
+            if (segmentsMask[i] == referenceMask[i]) {
+                continue;
+            }
+
+            // Same pixel position as in WindingNumberEvaluator::rasterize()
+            glm::vec2 position{boundingBox.at(0).x + (i % resolution + 0.5f) * size.x / resolution,
+                               boundingBox.at(0).y + size.y - (i / resolution + 0.5f) * size.y / resolution};
+            if (!isNearEdge(*glyph, position, glm::vec2{tolerance})) {
+                segmentsMismatches++;
+            }
+        }
+    }
+
+    if (segmentsMismatches != 0) {
+        std::cout << "Pixels of y-monotonic segments differing from flattened outline: " << segmentsMismatches
+                  << std::endl;
+    }
+
+    return segmentsMismatches == 0;
+}
+
+/**
+ * @brief Gets triangles of triangulated glyph as positions of their vertices. Vertices of each triangle are rotated to
+ * start at the smallest position, keeping the winding, and triangles are sorted, so meshes with reordered vertices and
+ * triangles can be compared
+ *
+ * @param glyph Glyph composed by the triangulation tessellator
+ *
+ * @return Sorted triangles, each stored as x and y of its three vertices
+ */
+std::vector<std::array<float, 6>> getSortedTriangles(const vft::Glyph &glyph) {
+    std::span<const glm::vec2> vertices = glyph.mesh.getVertices();
+    std::span<const uint32_t> indices =
+        glyph.mesh.getIndices(vft::TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+
+    std::vector<std::array<float, 6>> triangles;
+    triangles.reserve(indices.size() / 3);
+    for (unsigned int i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<std::pair<float, float>, 3> positions{};
+        for (unsigned int j = 0; j < 3; j++) {
+            glm::vec2 vertex = vertices[indices[i + j]];
+            positions[j] = {vertex.x, vertex.y};
+        }
+        std::rotate(positions.begin(), std::min_element(positions.begin(), positions.end()), positions.end());
+
+        triangles.push_back({positions[0].first, positions[0].second, positions[1].first, positions[1].second,
+                             positions[2].first, positions[2].second});
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+/**
+ * @brief Triangulates printable ascii glyphs with and without mesh optimization, optimized meshes must contain the
+ * same triangles, compared by positions of their vertices, and every vertex used by them exactly once. Average cache
+ * miss ratio of the post-transform vertex cache must not increase by optimization
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if optimized meshes contain the same triangles and the average cache miss ratio did not increase
+ */
+bool testVertexCacheOptimization(std::string fontFile) {
+    // Font size used for adaptive subdivision of curves
+    constexpr unsigned int fontSize = 16;
+
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    vft::TriangulationTessellator tessellator{};
+    vft::TriangulationTessellator optimizingTessellator{};
+    optimizingTessellator.setMeshOptimization(true);
+
+    bool passed = true;
+    for (uint32_t codePoint = 0x21; codePoint < 0x7f; codePoint++) {
+        uint32_t glyphId = FT_Get_Char_Index(font->getFace(), codePoint);
+        std::shared_ptr<const vft::Glyph> glyph = tessellator.composeGlyph(glyphId, font, fontSize);
+        std::shared_ptr<const vft::Glyph> optimizedGlyph = optimizingTessellator.composeGlyph(glyphId, font, fontSize);
+
+        // Optimization stores vertices in order of their first use, vertices not used by any triangle are dropped
+        std::span<const uint32_t> indices =
+            glyph->mesh.getIndices(vft::TriangulationTessellator::GLYPH_MESH_TRIANGLE_BUFFER_INDEX);
+        std::set<uint32_t> usedVertices{indices.begin(), indices.end()};
+        if (optimizedGlyph->mesh.getVertexCount() != usedVertices.size()) {
+            std::cout << "Character " << static_cast<char>(codePoint) << ": " << optimizedGlyph->mesh.getVertexCount()
+                      << " vertices after optimization, " << usedVertices.size() << " before" << std::endl;
+            passed = false;
+        }
+
+        if (getSortedTriangles(*optimizedGlyph) != getSortedTriangles(*glyph)) {
+            std::cout << "Character " << static_cast<char>(codePoint) << ": Triangles differ after optimization"
+                      << std::endl;
+            passed = false;
+        }
+    }
+
+    const vft::VertexCacheStatistics &statistics = optimizingTessellator.getVertexCacheStatistics();
+    if (statistics.triangleCount == 0 || statistics.getAcmrAfter() > statistics.getAcmrBefore()) {
+        std::cout << "Triangles: " << statistics.triangleCount << std::endl;
+        std::cout << "ACMR before optimization: " << statistics.getAcmrBefore() << std::endl;
+        std::cout << "ACMR after optimization: " << statistics.getAcmrAfter() << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Generates signed distance fields of printable ascii glyphs from segments of the winding number tessellator
+ * and compares them with the freetype sdf rasterizer
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if all bitmaps have the same size as freetype bitmaps and their error is within bounds
+ */
+bool testSdfGenerator(std::string fontFile) {
+    // Size of em square in pixels
+    constexpr unsigned int pixelSize = 64;
+    // Bounds of the absolute error of 8-bit distances against freetype, both round distances differently
+    constexpr double maxMeanError = 1.0;
+    constexpr unsigned int maxError = 4;
+
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    font->setPixelSize(pixelSize);
+    glm::vec2 scale = font->getScalingVector(pixelSize);
+
+    vft::WindingNumberTessellator tessellator{};
+    vft::SdfGenerator generator{};
+
+    bool passed = true;
+    unsigned long pixelCount = 0;
+    unsigned long totalError = 0;
+    unsigned int error = 0;
+
+    for (uint32_t codePoint = 0x21; codePoint < 0x7f; codePoint++) {
+        uint32_t glyphId = FT_Get_Char_Index(font->getFace(), codePoint);
+        std::shared_ptr<const vft::Glyph> glyph = tessellator.composeGlyph(glyphId, font);
+
+        vft::SdfGenerator::Bitmap bitmap = generator.generate(*glyph, scale);
+
+        // Hinting moves points of outline, freetype has to render the same outline as the generator
+        if (FT_Load_Glyph(font->getFace(), glyphId, FT_LOAD_NO_HINTING) ||
+            FT_Render_Glyph(font->getFace()->glyph, FT_RENDER_MODE_SDF)) {
+            throw std::runtime_error("Error rasterizing sdf bitmap using freetype");
+        }
+
+        const FT_Bitmap &reference = font->getFace()->glyph->bitmap;
+        if (reference.width != bitmap.width || reference.rows != bitmap.height) {
+            std::cout << "Character " << static_cast<char>(codePoint) << ": Bitmap size " << bitmap.width << " x "
+                      << bitmap.height << ", freetype " << reference.width << " x " << reference.rows << std::endl;
+            passed = false;
+            continue;
+        }
+
+        pixelCount += bitmap.pixels.size();
+        for (unsigned int i = 0; i < bitmap.pixels.size(); i++) {
+            unsigned int pixelError =
+                std::abs(static_cast<int>(bitmap.pixels[i]) - static_cast<int>(reference.buffer[i]));
+            totalError += pixelError;
+            error = std::max(error, pixelError);
+        }
+    }
+
+    double meanError = static_cast<double>(totalError) / std::max(pixelCount, 1ul);
+    if (pixelCount == 0) {
+        std::cout << "No bitmap was compared" << std::endl;
+        passed = false;
+    }
+    if (meanError > maxMeanError) {
+        std::cout << "Mean absolute error: " << meanError << ", bound " << maxMeanError << std::endl;
+        passed = false;
+    }
+    if (error > maxError) {
+        std::cout << "Max absolute error: " << error << ", bound " << maxError << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Compresses a tiered sdf font atlas of all glyphs in font into bc4 blocks and compares decompressed distances
+ * with the original ones
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if compressed texture is half the size of the original and its error is within bounds
+ */
+bool testAtlasCompression(std::string fontFile) {
+    // Bounds of the absolute error of decompressed 8-bit distances
+    constexpr double maxMeanError = 0.5;
+    constexpr double maxEdgeMeanError = 2.5;
+    // Bound of the ratio of pixels classified on the other side of the edge after decompression
+    constexpr double maxFlippedRatio = 0.005;
+
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    vft::FontAtlas atlas{font, vft::FontAtlas::Format::TIERED_SDF};
+    std::vector<uint8_t> original{atlas.getTexture().begin(), atlas.getTexture().end()};
+
+    atlas.compress();
+
+    std::vector<uint8_t> decompressed =
+        vft::Bc4Encoder::decode(atlas.getTexture(), atlas.getSize().x, atlas.getSize().y);
+
+    // Pixels within a quarter of spread from the edge decide the shape of rendered glyphs
+    unsigned long totalError = 0;
+    unsigned long edgePixelCount = 0;
+    unsigned long edgeError = 0;
+    unsigned long flippedPixels = 0;
+    for (unsigned int i = 0; i < original.size(); i++) {
+        unsigned int error = std::abs(static_cast<int>(original[i]) - static_cast<int>(decompressed[i]));
+        totalError += error;
+
+        if (original[i] >= 96 && original[i] < 160) {
+            edgePixelCount++;
+            edgeError += error;
+        }
+        if ((original[i] >= 128) != (decompressed[i] >= 128)) {
+            flippedPixels++;
+        }
+    }
+
+    bool passed = true;
+    if (original.empty()) {
+        std::cout << "Font atlas texture is empty" << std::endl;
+        passed = false;
+    }
+
+    // Bc4 stores every 4x4 block of 8-bit pixels in 8 bytes
+    double sizeRatio = static_cast<double>(atlas.getTexture().size()) / std::max(original.size(), std::size_t{1});
+    if (sizeRatio != 0.5) {
+        std::cout << "Size ratio: " << sizeRatio << " (" << atlas.getTexture().size() << " B of " << original.size()
+                  << " B), expected 0.5" << std::endl;
+        passed = false;
+    }
+
+    double meanError = static_cast<double>(totalError) / std::max(original.size(), std::size_t{1});
+    if (meanError > maxMeanError) {
+        std::cout << "Mean absolute error: " << meanError << ", bound " << maxMeanError << std::endl;
+        passed = false;
+    }
+
+    double edgeMeanError = static_cast<double>(edgeError) / std::max(edgePixelCount, 1ul);
+    if (edgeMeanError > maxEdgeMeanError) {
+        std::cout << "Mean absolute error near edges: " << edgeMeanError << ", bound " << maxEdgeMeanError
+                  << std::endl;
+        passed = false;
+    }
+
+    double flippedRatio = static_cast<double>(flippedPixels) / std::max(original.size(), std::size_t{1});
+    if (flippedRatio > maxFlippedRatio) {
+        std::cout << "Pixels with flipped inside test: " << flippedPixels << ", ratio " << flippedRatio << ", bound "
+                  << maxFlippedRatio << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Counts heap buffers of glyph, its mesh stores vertices and all index buffers in one buffer
+ *
+ * @param glyph Glyph
+ *
+ * @return Number of buffers
+ */
+unsigned long countGlyphBuffers(const vft::Glyph &glyph) {
+    return !glyph.mesh.getVertices().empty() || !glyph.mesh.getAllIndices().empty();
+}
+
+/**
+ * @brief Gets size in bytes of the buffer storing vertices and all index buffers of glyph mesh
+ *
+ * @param glyph Glyph
+ *
+ * @return Size of buffer in bytes
+ */
+std::size_t getGlyphBufferSize(const vft::Glyph &glyph) {
+    return glyph.mesh.getVertices().size_bytes() + glyph.mesh.getAllIndices().size_bytes();
+}
+
+/**
+ * @brief Composes printable ascii glyphs with every outline tessellator and inserts them into a glyph cache. Composing
+ * a glyph must allocate each of its buffers once and keep only the buffers and one shared allocation of the glyph.
+ * Caching it must not allocate any buffer, only the nodes a cache of null glyphs allocates for the same keys
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if no glyph buffer was copied on the way into the cache
+ */
+bool testGlyphAllocations(std::string fontFile) {
+    // Font size used for adaptive subdivision of curves
+    constexpr unsigned int fontSize = 16;
+
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+
+    std::vector<std::pair<vft::TessellationStrategy, std::unique_ptr<vft::Tessellator>>> tessellators;
+    tessellators.emplace_back(vft::TessellationStrategy::TRIANGULATION,
+                              std::make_unique<vft::TriangulationTessellator>());
+    tessellators.emplace_back(vft::TessellationStrategy::TESSELLATION_SHADERS,
+                              std::make_unique<vft::TessellationShadersTessellator>());
+    tessellators.emplace_back(vft::TessellationStrategy::WINDING_NUMBER,
+                              std::make_unique<vft::WindingNumberTessellator>());
+    std::array<std::string, 3> names{"Triangulation", "Tessellation shaders", "Winding number"};
+
+    bool passed = true;
+    for (unsigned int i = 0; i < tessellators.size(); i++) {
+        const auto &[strategy, tessellator] = tessellators[i];
+        vft::GlyphCache cache{};
+        vft::GlyphCache nodeCache{};
+
+        for (uint32_t codePoint = 0x21; codePoint < 0x7f; codePoint++) {
+            uint32_t glyphId = FT_Get_Char_Index(font->getFace(), codePoint);
+            vft::GlyphKey key{strategy, font->getFontFamily(), glyphId, fontSize};
+
+            // Size of buffer is known once the glyph was composed, temporary buffers of the tessellator already grew
+            std::shared_ptr<const vft::Glyph> glyph = tessellator->composeGlyph(glyphId, font, fontSize);
+            unsigned long bufferCount = countGlyphBuffers(*glyph);
+            bufferSize = bufferCount > 0 ? getGlyphBufferSize(*glyph) : std::numeric_limits<std::size_t>::max();
+            glyph.reset();
+
+            unsigned long bufferStart = bufferAllocationCount.load();
+            long liveStart = liveAllocationCount.load();
+            glyph = tessellator->composeGlyph(glyphId, font, fontSize);
+            unsigned long composeBuffers = bufferAllocationCount.load() - bufferStart;
+            long keptAllocations = liveAllocationCount.load() - liveStart;
+
+            // Glyph and its control block share one allocation
+            if (composeBuffers != bufferCount || keptAllocations != static_cast<long>(bufferCount) + 1) {
+                std::cout << names[i] << ", character " << static_cast<char>(codePoint) << ": " << composeBuffers
+                          << " buffer allocations and " << keptAllocations << " kept allocations when composing "
+                          << bufferCount << " buffers" << std::endl;
+                passed = false;
+            }
+
+            bufferStart = bufferAllocationCount.load();
+            unsigned long start = allocationCount.load();
+            cache.setGlyph(key, glyph);
+            bool shared = cache.getGlyph(key) == glyph;
+            unsigned long cacheAllocations = allocationCount.load() - start;
+            unsigned long cacheBuffers = bufferAllocationCount.load() - bufferStart;
+
+            start = allocationCount.load();
+            nodeCache.setGlyph(key, nullptr);
+            nodeCache.getGlyph(key);
+            unsigned long nodeAllocations = allocationCount.load() - start;
+
+            if (!shared || cacheBuffers != 0 || cacheAllocations != nodeAllocations) {
+                std::cout << names[i] << ", character " << static_cast<char>(codePoint) << ": "
+                          << (shared ? "shared" : "not shared") << " by cache, " << cacheBuffers
+                          << " buffer allocations and " << cacheAllocations << " allocations when caching, "
+                          << nodeAllocations << " allocations of nodes" << std::endl;
+                passed = false;
+            }
+        }
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Reads whole file
+ *
+ * @param fileName Path to file
+ *
+ * @return Content of file
+ */
+std::vector<uint8_t> readFile(const std::filesystem::path &fileName) {
+    std::ifstream file{fileName, std::ios::binary};
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file " + fileName.string());
+    }
+
+    return std::vector<uint8_t>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+/**
+ * @brief Writes data to file, replacing its content
+ *
+ * @param fileName Path to file
+ * @param data Content of file
+ */
+void writeFile(const std::filesystem::path &fileName, const std::vector<uint8_t> &data) {
+    std::ofstream file{fileName, std::ios::binary};
+    file.write(reinterpret_cast<const char *>(data.data()), data.size());
+    if (!file) {
+        throw std::runtime_error("Error writing file " + fileName.string());
+    }
+}
+
+/**
+ * @brief Compares parameters, texture and glyph UVs of font atlas loaded from file with the saved font atlas
+ *
+ * @param saved Font atlas written to file
+ * @param loaded Font atlas loaded from file
+ * @param font Font of font atlases
+ * @param characters Characters in font atlases
+ *
+ * @return True if font atlases are the same
+ */
+bool isSameFontAtlas(const vft::FontAtlas &saved,
+                     const vft::FontAtlas &loaded,
+                     std::shared_ptr<vft::Font> font,
+                     const std::u32string &characters) {
+    if (saved.getFontFamily() != loaded.getFontFamily() || saved.getFormat() != loaded.getFormat() ||
+        saved.getSize() != loaded.getSize() || saved.getTierPixelSizes() != loaded.getTierPixelSizes() ||
+        saved.isCompressed() != loaded.isCompressed() ||
+        !std::ranges::equal(saved.getTexture(), loaded.getTexture())) {
+        return false;
+    }
+
+    for (char32_t character : characters) {
+        uint32_t glyphId = FT_Get_Char_Index(font->getFace(), character);
+        for (unsigned int tier = 0; tier < saved.getTierPixelSizes().size(); tier++) {
+            vft::FontAtlas::GlyphInfo savedGlyph = saved.getGlyph(glyphId, tier);
+            vft::FontAtlas::GlyphInfo loadedGlyph = loaded.getGlyph(glyphId, tier);
+            if (savedGlyph.uvTopLeft != loadedGlyph.uvTopLeft ||
+                savedGlyph.uvBottomRight != loadedGlyph.uvBottomRight) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Saves font atlases of printable ascii characters in every format, including a compressed one, to file and
+ * compares them with font atlases loaded from the file
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if all loaded font atlases are the same as saved ones
+ */
+bool testFontAtlasSaveLoad(std::string fontFile) {
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    std::filesystem::path fileName = std::filesystem::temp_directory_path() / "vfont_tests_save_load.atlas";
+
+    std::u32string characters{};
+    for (char32_t codePoint = 0x21; codePoint < 0x7f; codePoint++) {
+        characters.push_back(codePoint);
+    }
+
+    std::array<std::pair<vft::FontAtlas::Format, bool>, 4> formats{{{vft::FontAtlas::Format::SDF, false},
+                                                                     {vft::FontAtlas::Format::MSDF, false},
+                                                                     {vft::FontAtlas::Format::TIERED_SDF, false},
+                                                                     {vft::FontAtlas::Format::TIERED_SDF, true}}};
+    std::array<std::string, 4> names{"Sdf", "Multi-channel sdf", "Tiered sdf", "Compressed tiered sdf"};
+
+    bool passed = true;
+    for (unsigned int i = 0; i < formats.size(); i++) {
+        const auto &[format, compress] = formats[i];
+
+        vft::FontAtlas atlas{font, characters, format};
+        if (compress) {
+            atlas.compress();
+        }
+        atlas.save(font, fileName.string());
+
+        // Loaded font atlas maps the file until it is destroyed
+        {
+            vft::FontAtlas loaded = vft::FontAtlas::load(font, fileName.string());
+            bool same = isSameFontAtlas(atlas, loaded, font, characters);
+            std::cout << names[i] << ": " << (same ? "same" : "different") << std::endl;
+            passed = passed && same;
+        }
+    }
+
+    std::filesystem::remove(fileName);
+    return passed;
+}
+
+/**
+ * @brief Writes data to file and loads it as font atlas
+ *
+ * @param font Font the font atlas was generated from
+ * @param fileName Path to file
+ * @param data Content of font atlas file
+ *
+ * @return True if loading font atlas threw an error
+ */
+bool isRejected(std::shared_ptr<vft::Font> font,
+                const std::filesystem::path &fileName,
+                const std::vector<uint8_t> &data) {
+    writeFile(fileName, data);
+
+    try {
+        vft::FontAtlas::load(font, fileName.string());
+    } catch (const std::runtime_error &e) {
+        std::cout << "  " << e.what() << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Corrupts fields of a saved font atlas file one by one and checks that loading the file fails instead of
+ * reading out of bounds or returning a font atlas not matching the font
+ *
+ * @param fontFile Path to .ttf font file
+ *
+ * @return True if the intact file was loaded and all corrupted files were rejected
+ */
+bool testFontAtlasCorruptedFiles(std::string fontFile) {
+    std::shared_ptr<vft::Font> font = std::make_shared<vft::Font>(fontFile);
+    std::filesystem::path fileName = std::filesystem::temp_directory_path() / "vfont_tests_corrupted.atlas";
+
+    vft::FontAtlas atlas{font, U"ABCabc123", vft::FontAtlas::Format::SDF};
+    atlas.save(font, fileName.string());
+    std::vector<uint8_t> data = readFile(fileName);
+
+    bool passed = !isRejected(font, fileName, data);
+    std::cout << "Intact file: " << (passed ? "loaded" : "rejected") << std::endl;
+
+    std::vector<std::pair<std::string, std::function<void(FontAtlasFile::FileHeader &)>>> corruptions{
+        {"Magic", [](FontAtlasFile::FileHeader &header) { header.magic[0] = 'X'; }},
+        {"Version", [](FontAtlasFile::FileHeader &header) { header.version++; }},
+        {"Font hash", [](FontAtlasFile::FileHeader &header) { header.fontHash ^= 1; }},
+        {"Pixel size", [](FontAtlasFile::FileHeader &header) { header.pixelSize++; }},
+        {"Spread", [](FontAtlasFile::FileHeader &header) { header.spread++; }},
+        {"Format", [](FontAtlasFile::FileHeader &header) { header.format = std::numeric_limits<uint32_t>::max(); }},
+        {"Tier count", [](FontAtlasFile::FileHeader &header) { header.tierCount = 0; }},
+        {"Glyph table overlapping texture",
+         [](FontAtlasFile::FileHeader &header) { header.glyphCount = std::numeric_limits<uint32_t>::max(); }},
+        {"Texture offset beyond end of file",
+         [&data](FontAtlasFile::FileHeader &header) { header.textureOffset = data.size() + 1; }},
+        {"Texture beyond end of file", [](FontAtlasFile::FileHeader &header) { header.textureSize++; }},
+        {"Texture size", [](FontAtlasFile::FileHeader &header) { header.textureSize--; }},
+    };
+
+    for (const auto &[name, corrupt] : corruptions) {
+        std::vector<uint8_t> corrupted = data;
+        FontAtlasFile::FileHeader header{};
+        std::memcpy(&header, corrupted.data(), sizeof(header));
+        corrupt(header);
+        std::memcpy(corrupted.data(), &header, sizeof(header));
+
+        bool rejected = isRejected(font, fileName, corrupted);
+        std::cout << name << ": " << (rejected ? "rejected" : "loaded") << std::endl;
+        passed = passed && rejected;
+    }
+
+    // Texture of truncated file ends beyond end of file
+    std::vector<uint8_t> truncated{data.begin(), data.end() - 1};
+    bool rejected = isRejected(font, fileName, truncated);
+    std::cout << "Truncated file: " << (rejected ? "rejected" : "loaded") << std::endl;
+    passed = passed && rejected;
+
+    std::filesystem::remove(fileName);
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::cerr << "./vfont_tests <test> <path_to_font>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string test = argv[1];
+    std::string font = argv[2];
+
+    try {
+        bool passed = false;
+        if (test == "winding_number_bands") {
+            passed = testWindingNumberBands(font);
+        } else if (test == "winding_number_monotonic_curves") {
+            passed = testWindingNumberMonotonicCurves(font);
+        } else if (test == "vertex_cache_optimization") {
+            passed = testVertexCacheOptimization(font);
+        } else if (test == "sdf_generator") {
+            passed = testSdfGenerator(font);
+        } else if (test == "atlas_compression") {
+            passed = testAtlasCompression(font);
+        } else if (test == "glyph_allocations") {
+            passed = testGlyphAllocations(font);
+        } else if (test == "font_atlas_save_load") {
+            passed = testFontAtlasSaveLoad(font);
+        } else if (test == "font_atlas_corrupted_files") {
+            passed = testFontAtlasCorruptedFiles(font);
+        } else {
+            std::cerr << "Unknown test " << test << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << (passed ? "Passed" : "Failed") << std::endl;
+        return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}